@@ -0,0 +1,479 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "arena.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include arena functionality.  This #if is closed at the very bottom of
+ * this file.  If you want to include arenas then ensure configUSE_ARENAS is set
+ * to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_ARENAS == 1 )
+
+/* The size of the arena structure rounded up so the storage that follows it in
+ * a dynamically allocated arena is correctly aligned. */
+    #define arenaSTRUCT_SIZE                                                                 \
+    ( ( sizeof( Arena_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Bits set in ucFlags. */
+    #define arenaFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+    typedef struct ArenaDef_t
+    {
+        uint8_t * pucStorage;               /**< Points to the first byte of the arena's storage, which is aligned to portBYTE_ALIGNMENT. */
+        size_t xSize;                       /**< The number of bytes of storage, a multiple of portBYTE_ALIGNMENT. */
+        size_t xUsed;                       /**< The number of bytes allocated since the arena was created or last reset. */
+        size_t xMaxUsed;                    /**< The largest value xUsed has had. */
+        struct ArenaDef_t ** ppxTaskArenas; /**< Points to the head of the list of arenas of the task the arena is attached to, or NULL if it is not attached. */
+        struct ArenaDef_t * pxNextArena;    /**< The next arena attached to the same task. */
+        uint8_t ucFlags;
+    } Arena_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the dynamic and static create functions to initialise a
+ * newly allocated arena structure.
+ */
+    static void prvInitialiseNewArena( Arena_t * const pxArena,
+                                       uint8_t * pucStorage,
+                                       size_t xSizeInBytes,
+                                       uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Frees the memory of an arena that is not attached to a task.
+ */
+    static void prvFreeArena( Arena_t * const pxArena ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewArena( Arena_t * const pxArena,
+                                       uint8_t * pucStorage,
+                                       size_t xSizeInBytes,
+                                       uint8_t ucFlags )
+    {
+        size_t xOffset;
+
+        /* Skip the bytes before the first aligned address, and drop any
+         * bytes at the end that cannot make up a whole aligned unit, so every
+         * allocation is aligned. */
+        xOffset = ( size_t ) ( ( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT - ( ( portPOINTER_SIZE_TYPE ) pucStorage & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+        if( xOffset > xSizeInBytes )
+        {
+            xOffset = xSizeInBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memset( ( void * ) pxArena, 0x00, sizeof( Arena_t ) );
+        pxArena->pucStorage = pucStorage + xOffset;
+        pxArena->xSize = ( xSizeInBytes - xOffset ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+        pxArena->ucFlags = ucFlags;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeArena( Arena_t * const pxArena )
+    {
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            if( ( pxArena->ucFlags & arenaFLAGS_IS_STATICALLY_ALLOCATED ) == 0 )
+            {
+                vPortFree( pxArena );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            vPortFree( pxArena );
+        }
+        #else
+        {
+            /* The arena was allocated statically, so there is nothing to
+             * free. */
+            ( void ) pxArena;
+        }
+        #endif /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        ArenaHandle_t xArenaCreate( size_t xSizeInBytes )
+        {
+            Arena_t * pxArena = NULL;
+            uint8_t * pucAllocatedMemory;
+
+            traceENTER_xArenaCreate( xSizeInBytes );
+
+            configASSERT( xSizeInBytes > ( size_t ) 0 );
+
+            /* Check for addition overflow before allocating the structure and
+             * the storage in one block, as is done for queues. */
+            if( xSizeInBytes <= ( SIZE_MAX - arenaSTRUCT_SIZE ) )
+            {
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( arenaSTRUCT_SIZE + xSizeInBytes );
+
+                if( pucAllocatedMemory != NULL )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxArena = ( Arena_t * ) pucAllocatedMemory;
+
+                    prvInitialiseNewArena( pxArena,
+                                           pucAllocatedMemory + arenaSTRUCT_SIZE,
+                                           xSizeInBytes,
+                                           0 );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xArenaCreate( pxArena );
+
+            return pxArena;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        ArenaHandle_t xArenaCreateStatic( size_t xSizeInBytes,
+                                          uint8_t * pucArenaStorage,
+                                          StaticArena_t * pxStaticArena )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            Arena_t * const pxArena = ( Arena_t * ) pxStaticArena;
+            ArenaHandle_t xReturn = NULL;
+
+            traceENTER_xArenaCreateStatic( xSizeInBytes, pucArenaStorage, pxStaticArena );
+
+            configASSERT( pucArenaStorage );
+            configASSERT( pxStaticArena );
+            configASSERT( xSizeInBytes > ( size_t ) 0 );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticArena_t equals the size of the real
+                 * arena structure. */
+                volatile size_t xSize = sizeof( StaticArena_t );
+                configASSERT( xSize == sizeof( Arena_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucArenaStorage != NULL ) && ( pxStaticArena != NULL ) )
+            {
+                prvInitialiseNewArena( pxArena,
+                                       pucArenaStorage,
+                                       xSizeInBytes,
+                                       arenaFLAGS_IS_STATICALLY_ALLOCATED );
+                xReturn = pxArena;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xArenaCreateStatic( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vArenaDelete( ArenaHandle_t xArena )
+    {
+        Arena_t * const pxArena = xArena;
+
+        traceENTER_vArenaDelete( xArena );
+
+        configASSERT( pxArena );
+
+        #if ( INCLUDE_vTaskDelete == 1 )
+        {
+            vArenaDetachFromTask( pxArena );
+        }
+        #endif
+
+        prvFreeArena( pxArena );
+
+        traceRETURN_vArenaDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvArenaMalloc( ArenaHandle_t xArena,
+                          size_t xWantedSize )
+    {
+        Arena_t * const pxArena = xArena;
+        void * pvReturn = NULL;
+        size_t xAdditionalRequiredSize;
+
+        traceENTER_pvArenaMalloc( xArena, xWantedSize );
+
+        configASSERT( pxArena );
+
+        /* Round the size up so the next allocation is also aligned. */
+        xAdditionalRequiredSize = ( size_t ) ( ( ( size_t ) portBYTE_ALIGNMENT - ( xWantedSize & ( size_t ) portBYTE_ALIGNMENT_MASK ) ) & ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+        /* The arena is only used by one task, so no critical section is needed
+         * to advance xUsed.  Comparing against the free space, rather than
+         * adding to xUsed, avoids any overflow. */
+        if( ( xWantedSize > ( size_t ) 0 ) &&
+            ( xWantedSize <= ( pxArena->xSize - pxArena->xUsed ) ) &&
+            ( xAdditionalRequiredSize <= ( ( pxArena->xSize - pxArena->xUsed ) - xWantedSize ) ) )
+        {
+            pvReturn = ( void * ) &( pxArena->pucStorage[ pxArena->xUsed ] );
+            pxArena->xUsed += xWantedSize + xAdditionalRequiredSize;
+
+            if( pxArena->xUsed > pxArena->xMaxUsed )
+            {
+                pxArena->xMaxUsed = pxArena->xUsed;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_pvArenaMalloc( pvReturn );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vArenaReset( ArenaHandle_t xArena )
+    {
+        Arena_t * const pxArena = xArena;
+
+        traceENTER_vArenaReset( xArena );
+
+        configASSERT( pxArena );
+
+        pxArena->xUsed = ( size_t ) 0;
+
+        traceRETURN_vArenaReset();
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xArenaGetFreeSize( ArenaHandle_t xArena )
+    {
+        const Arena_t * const pxArena = xArena;
+        size_t xReturn;
+
+        traceENTER_xArenaGetFreeSize( xArena );
+
+        configASSERT( pxArena );
+
+        xReturn = pxArena->xSize - pxArena->xUsed;
+
+        traceRETURN_xArenaGetFreeSize( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xArenaGetMinimumEverFreeSize( ArenaHandle_t xArena )
+    {
+        const Arena_t * const pxArena = xArena;
+        size_t xReturn;
+
+        traceENTER_xArenaGetMinimumEverFreeSize( xArena );
+
+        configASSERT( pxArena );
+
+        xReturn = pxArena->xSize - pxArena->xMaxUsed;
+
+        traceRETURN_xArenaGetMinimumEverFreeSize( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+
+        BaseType_t xArenaAttachToTask( ArenaHandle_t xArena,
+                                       TaskHandle_t xTask )
+        {
+            Arena_t * const pxArena = xArena;
+            Arena_t ** const ppxTaskArenas = ppxTaskGetArenas( xTask );
+            BaseType_t xReturn = pdFAIL;
+
+            traceENTER_xArenaAttachToTask( xArena, xTask );
+
+            configASSERT( pxArena );
+
+            /* The critical section keeps the task's list of arenas consistent
+             * if arenas are attached to or detached from the same task by more
+             * than one task at once. */
+            taskENTER_CRITICAL();
+            {
+                if( pxArena->ppxTaskArenas == NULL )
+                {
+                    pxArena->ppxTaskArenas = ppxTaskArenas;
+                    pxArena->pxNextArena = *ppxTaskArenas;
+                    *ppxTaskArenas = pxArena;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            traceRETURN_xArenaAttachToTask( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+
+        void vArenaDetachFromTask( ArenaHandle_t xArena )
+        {
+            Arena_t * const pxArena = xArena;
+            Arena_t * pxIterator;
+
+            traceENTER_vArenaDetachFromTask( xArena );
+
+            configASSERT( pxArena );
+
+            taskENTER_CRITICAL();
+            {
+                if( pxArena->ppxTaskArenas != NULL )
+                {
+                    pxIterator = *( pxArena->ppxTaskArenas );
+
+                    if( pxIterator == pxArena )
+                    {
+                        *( pxArena->ppxTaskArenas ) = pxArena->pxNextArena;
+                    }
+                    else
+                    {
+                        /* A task only has a few arenas, so a linear search of
+                         * its list is acceptable. */
+                        while( ( pxIterator != NULL ) && ( pxIterator->pxNextArena != pxArena ) )
+                        {
+                            pxIterator = pxIterator->pxNextArena;
+                        }
+
+                        configASSERT( pxIterator );
+
+                        if( pxIterator != NULL )
+                        {
+                            pxIterator->pxNextArena = pxArena->pxNextArena;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    pxArena->ppxTaskArenas = NULL;
+                    pxArena->pxNextArena = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            traceRETURN_vArenaDetachFromTask();
+        }
+
+    #endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+
+        void vArenaDeleteTaskArenas( struct ArenaDef_t * pxFirstArena )
+        {
+            Arena_t * pxArena = pxFirstArena;
+            Arena_t * pxNextArena;
+
+            /* The task has been deleted, so no other task can reach its list
+             * of arenas any more. */
+            while( pxArena != NULL )
+            {
+                pxNextArena = pxArena->pxNextArena;
+                pxArena->ppxTaskArenas = NULL;
+                pxArena->pxNextArena = NULL;
+                prvFreeArena( pxArena );
+                pxArena = pxNextArena;
+            }
+        }
+
+    #endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include arena functionality.  If you want to include arenas then ensure
+ * configUSE_ARENAS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_ARENAS == 1 */
@@ -0,0 +1,702 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "core_channel.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include core channel functionality.  This #if is closed at the very bottom
+ * of this file.  If you want to include core channels then ensure
+ * configUSE_CORE_CHANNELS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_CORE_CHANNELS == 1 )
+
+/* Bits set in ucFlags. */
+    #define ccFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/* The head and tail indexes run from 0 to ( 2 * xLength ) - 1, so a full
+ * channel (head and tail xLength apart) can be told apart from an empty one
+ * (head equal to tail) without leaving a byte of the buffer unused. */
+    #define ccINDEX_TO_OFFSET( pxChannel, xIndex ) \
+    ( ( ( xIndex ) < ( pxChannel )->xLength ) ? ( xIndex ) : ( ( xIndex ) - ( pxChannel )->xLength ) )
+
+    typedef struct CoreChannelDef_t
+    {
+        volatile size_t xHead;                       /**< Index of the next byte to write.  Only written by the sender. */
+        volatile size_t xTail;                       /**< Index of the next byte to read.  Only written by the receiver. */
+        size_t xLength;                              /**< The size of the buffer pointed to by pucBuffer. */
+        uint8_t * pucBuffer;                         /**< Points to the ring buffer itself. */
+        volatile TaskHandle_t xTaskWaitingToReceive; /**< Holds the handle of a task waiting for data, or NULL.  Only written by the receiver. */
+        volatile TaskHandle_t xTaskWaitingToSend;    /**< Holds the handle of a task waiting for space, or NULL.  Only written by the sender. */
+        volatile size_t xSpaceWanted;                /**< The space the task waiting to send is waiting for. */
+        volatile BaseType_t xReceiverCoreID;         /**< The core on which xTaskWaitingToReceive blocked. */
+        volatile BaseType_t xSenderCoreID;           /**< The core on which xTaskWaitingToSend blocked. */
+        struct CoreChannelDef_t * pxNext;            /**< Links all the channels so the signal handler can find the waiting tasks. */
+        uint8_t ucFlags;
+    } CoreChannel_t;
+
+/*-----------------------------------------------------------*/
+
+/* All the channels that currently exist.  Only modified from within a
+ * critical section, and only walked from within a critical section by
+ * vCoreChannelHandleSignalFromISR(). */
+    PRIVILEGED_DATA static CoreChannel_t * pxCoreChannelList = NULL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the dynamic and static create functions to initialise a
+ * newly allocated channel structure and add it to pxCoreChannelList.
+ */
+    static void prvInitialiseNewCoreChannel( CoreChannel_t * const pxChannel,
+                                             size_t xBufferSizeBytes,
+                                             uint8_t * const pucBuffer,
+                                             uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of bytes between xTail and xHead.
+ */
+    static size_t prvBytesInChannel( const CoreChannel_t * const pxChannel,
+                                     size_t xHead,
+                                     size_t xTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves xIndex xCount bytes forward, wrapping at 2 * xLength.
+ */
+    static size_t prvAdvanceIndex( const CoreChannel_t * const pxChannel,
+                                   size_t xIndex,
+                                   size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies as many of the xCount bytes as fit into the channel, publishes them
+ * to the receiver, then signals the receiver's core if the receiver is
+ * blocked.  Does not call any kernel functions.  Returns the number of bytes
+ * written.
+ */
+    static size_t prvWriteToChannel( CoreChannel_t * const pxChannel,
+                                     const uint8_t * pucData,
+                                     size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * The receive side equivalent of prvWriteToChannel().
+ */
+    static size_t prvReadFromChannel( CoreChannel_t * const pxChannel,
+                                      uint8_t * pucData,
+                                      size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewCoreChannel( CoreChannel_t * const pxChannel,
+                                             size_t xBufferSizeBytes,
+                                             uint8_t * const pucBuffer,
+                                             uint8_t ucFlags )
+    {
+        ( void ) memset( ( void * ) pxChannel, 0x00, sizeof( CoreChannel_t ) );
+        pxChannel->xLength = xBufferSizeBytes;
+        pxChannel->pucBuffer = pucBuffer;
+        pxChannel->ucFlags = ucFlags;
+
+        taskENTER_CRITICAL();
+        {
+            pxChannel->pxNext = pxCoreChannelList;
+            pxCoreChannelList = pxChannel;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvBytesInChannel( const CoreChannel_t * const pxChannel,
+                                     size_t xHead,
+                                     size_t xTail )
+    {
+        size_t xCount;
+
+        if( xHead >= xTail )
+        {
+            xCount = xHead - xTail;
+        }
+        else
+        {
+            xCount = ( xHead + ( pxChannel->xLength * ( size_t ) 2 ) ) - xTail;
+        }
+
+        return xCount;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvAdvanceIndex( const CoreChannel_t * const pxChannel,
+                                   size_t xIndex,
+                                   size_t xCount )
+    {
+        size_t xNewIndex = xIndex + xCount;
+
+        if( xNewIndex >= ( pxChannel->xLength * ( size_t ) 2 ) )
+        {
+            xNewIndex -= pxChannel->xLength * ( size_t ) 2;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewIndex;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvWriteToChannel( CoreChannel_t * const pxChannel,
+                                     const uint8_t * pucData,
+                                     size_t xCount )
+    {
+        const size_t xHead = pxChannel->xHead;
+        size_t xOffset;
+        size_t xFirstLength;
+        TaskHandle_t xWaitingTask;
+
+        xCount = configMIN( xCount, pxChannel->xLength - prvBytesInChannel( pxChannel, xHead, pxChannel->xTail ) );
+
+        if( xCount > ( size_t ) 0 )
+        {
+            /* Do not write over bytes the receiver may still be reading - the
+             * tail index must be read before the buffer is written. */
+            portDATA_MEMORY_BARRIER();
+
+            xOffset = ccINDEX_TO_OFFSET( pxChannel, xHead );
+            xFirstLength = configMIN( xCount, pxChannel->xLength - xOffset );
+            ( void ) memcpy( ( void * ) &( pxChannel->pucBuffer[ xOffset ] ), ( const void * ) pucData, xFirstLength );
+
+            if( xCount > xFirstLength )
+            {
+                ( void ) memcpy( ( void * ) pxChannel->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The data must be visible to the other core before the head
+             * index that makes it available. */
+            portDATA_MEMORY_BARRIER();
+            pxChannel->xHead = prvAdvanceIndex( pxChannel, xHead, xCount );
+
+            /* Pairs with the barrier the receiver executes between
+             * publishing xTaskWaitingToReceive and checking for data, so
+             * either the receiver sees the new head or this sees the
+             * receiver waiting. */
+            portDATA_MEMORY_BARRIER();
+            xWaitingTask = pxChannel->xTaskWaitingToReceive;
+
+            if( xWaitingTask != NULL )
+            {
+                portCORE_CHANNEL_SIGNAL( pxChannel->xReceiverCoreID );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xCount;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvReadFromChannel( CoreChannel_t * const pxChannel,
+                                      uint8_t * pucData,
+                                      size_t xCount )
+    {
+        const size_t xTail = pxChannel->xTail;
+        size_t xNewTail;
+        size_t xOffset;
+        size_t xFirstLength;
+        TaskHandle_t xWaitingTask;
+
+        xCount = configMIN( xCount, prvBytesInChannel( pxChannel, pxChannel->xHead, xTail ) );
+
+        if( xCount > ( size_t ) 0 )
+        {
+            /* The head index must be read before the data it publishes. */
+            portDATA_MEMORY_BARRIER();
+
+            xOffset = ccINDEX_TO_OFFSET( pxChannel, xTail );
+            xFirstLength = configMIN( xCount, pxChannel->xLength - xOffset );
+            ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxChannel->pucBuffer[ xOffset ] ), xFirstLength );
+
+            if( xCount > xFirstLength )
+            {
+                ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( const void * ) pxChannel->pucBuffer, xCount - xFirstLength );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Finish reading the data before handing the space back to the
+             * sender. */
+            portDATA_MEMORY_BARRIER();
+            xNewTail = prvAdvanceIndex( pxChannel, xTail, xCount );
+            pxChannel->xTail = xNewTail;
+
+            /* See the matching comment in prvWriteToChannel().  The sender is
+             * only signalled once enough space has been freed to satisfy it. */
+            portDATA_MEMORY_BARRIER();
+            xWaitingTask = pxChannel->xTaskWaitingToSend;
+
+            if( ( xWaitingTask != NULL ) &&
+                ( ( pxChannel->xLength - prvBytesInChannel( pxChannel, pxChannel->xHead, xNewTail ) ) >= pxChannel->xSpaceWanted ) )
+            {
+                portCORE_CHANNEL_SIGNAL( pxChannel->xSenderCoreID );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xCount;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        CoreChannelHandle_t xCoreChannelCreate( size_t xBufferSizeBytes )
+        {
+            CoreChannel_t * pxChannel = NULL;
+            uint8_t * pucAllocatedMemory;
+
+            traceENTER_xCoreChannelCreate( xBufferSizeBytes );
+
+            configASSERT( xBufferSizeBytes > ( size_t ) 0 );
+
+            /* The indexes count up to twice the buffer size, and the structure
+             * and the buffer are allocated in one block. */
+            if( ( xBufferSizeBytes > ( size_t ) 0 ) &&
+                ( xBufferSizeBytes <= ( SIZE_MAX / ( size_t ) 2 ) ) &&
+                ( xBufferSizeBytes <= ( SIZE_MAX - sizeof( CoreChannel_t ) ) ) )
+            {
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( CoreChannel_t ) + xBufferSizeBytes );
+
+                if( pucAllocatedMemory != NULL )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxChannel = ( CoreChannel_t * ) pucAllocatedMemory;
+
+                    prvInitialiseNewCoreChannel( pxChannel,
+                                                 xBufferSizeBytes,
+                                                 pucAllocatedMemory + sizeof( CoreChannel_t ),
+                                                 0 );
+
+                    traceCORE_CHANNEL_CREATE( pxChannel );
+                }
+                else
+                {
+                    traceCORE_CHANNEL_CREATE_FAILED();
+                }
+            }
+            else
+            {
+                traceCORE_CHANNEL_CREATE_FAILED();
+            }
+
+            traceRETURN_xCoreChannelCreate( pxChannel );
+
+            return pxChannel;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        CoreChannelHandle_t xCoreChannelCreateStatic( size_t xBufferSizeBytes,
+                                                      uint8_t * pucChannelStorage,
+                                                      StaticCoreChannel_t * pxStaticChannel )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            CoreChannel_t * const pxChannel = ( CoreChannel_t * ) pxStaticChannel;
+            CoreChannelHandle_t xReturn;
+
+            traceENTER_xCoreChannelCreateStatic( xBufferSizeBytes, pucChannelStorage, pxStaticChannel );
+
+            configASSERT( pucChannelStorage );
+            configASSERT( pxStaticChannel );
+            configASSERT( xBufferSizeBytes > ( size_t ) 0 );
+            configASSERT( xBufferSizeBytes <= ( SIZE_MAX / ( size_t ) 2 ) );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticCoreChannel_t equals the size of the
+                 * real channel structure. */
+                volatile size_t xSize = sizeof( StaticCoreChannel_t );
+                configASSERT( xSize == sizeof( CoreChannel_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucChannelStorage != NULL ) && ( pxStaticChannel != NULL ) )
+            {
+                prvInitialiseNewCoreChannel( pxChannel,
+                                             xBufferSizeBytes,
+                                             pucChannelStorage,
+                                             ccFLAGS_IS_STATICALLY_ALLOCATED );
+
+                traceCORE_CHANNEL_CREATE( pxChannel );
+
+                xReturn = ( CoreChannelHandle_t ) pxStaticChannel;
+            }
+            else
+            {
+                xReturn = NULL;
+                traceCORE_CHANNEL_CREATE_FAILED();
+            }
+
+            traceRETURN_xCoreChannelCreateStatic( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vCoreChannelDelete( CoreChannelHandle_t xCoreChannel )
+    {
+        CoreChannel_t * const pxChannel = xCoreChannel;
+        CoreChannel_t ** ppxLink;
+
+        traceENTER_vCoreChannelDelete( xCoreChannel );
+
+        configASSERT( pxChannel );
+        configASSERT( pxChannel->xTaskWaitingToReceive == NULL );
+        configASSERT( pxChannel->xTaskWaitingToSend == NULL );
+
+        traceCORE_CHANNEL_DELETE( xCoreChannel );
+
+        taskENTER_CRITICAL();
+        {
+            for( ppxLink = &pxCoreChannelList; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNext ) )
+            {
+                if( *ppxLink == pxChannel )
+                {
+                    *ppxLink = pxChannel->pxNext;
+                    break;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( pxChannel->ucFlags & ccFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* The structure and the buffer were allocated using a single
+                 * call to pvPortMalloc(). */
+                vPortFree( ( void * ) pxChannel );
+            }
+            #else
+            {
+                /* Should not be possible to get here, ucFlags must be corrupt.
+                 * Force an assert. */
+                configASSERT( xCoreChannel == ( CoreChannelHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure was not allocated dynamically and cannot be freed -
+             * just scrub it so future use will assert. */
+            ( void ) memset( pxChannel, 0x00, sizeof( CoreChannel_t ) );
+        }
+
+        traceRETURN_vCoreChannelDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xCoreChannelSend( CoreChannelHandle_t xCoreChannel,
+                             const void * pvTxData,
+                             size_t xDataLengthBytes,
+                             TickType_t xTicksToWait )
+    {
+        CoreChannel_t * const pxChannel = xCoreChannel;
+        size_t xRequiredSpace;
+        size_t xBytesSent;
+        TimeOut_t xTimeOut;
+
+        traceENTER_xCoreChannelSend( xCoreChannel, pvTxData, xDataLengthBytes, xTicksToWait );
+
+        configASSERT( pxChannel );
+        configASSERT( pvTxData );
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Wait for room for the whole of the data, or for the whole
+             * channel to be empty if the data is larger than the channel. */
+            xRequiredSpace = configMIN( xDataLengthBytes, pxChannel->xLength );
+
+            if( xCoreChannelSpacesAvailable( xCoreChannel ) < xRequiredSpace )
+            {
+                /* Cannot block if the scheduler is suspended. */
+                #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+                {
+                    configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+                }
+                #endif
+
+                /* Only one task can send to a channel. */
+                configASSERT( pxChannel->xTaskWaitingToSend == NULL );
+
+                vTaskSetTimeOutState( &xTimeOut );
+
+                do
+                {
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, configCORE_CHANNEL_NOTIFICATION_INDEX );
+
+                    pxChannel->xSpaceWanted = xRequiredSpace;
+                    pxChannel->xSenderCoreID = ( BaseType_t ) portGET_CORE_ID();
+                    portDATA_MEMORY_BARRIER();
+                    pxChannel->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+
+                    /* See the comments in prvWriteToChannel(). */
+                    portDATA_MEMORY_BARRIER();
+
+                    if( xCoreChannelSpacesAvailable( xCoreChannel ) < xRequiredSpace )
+                    {
+                        traceBLOCKING_ON_CORE_CHANNEL_SEND( xCoreChannel );
+                        ( void ) xTaskNotifyWaitIndexed( configCORE_CHANNEL_NOTIFICATION_INDEX, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxChannel->xTaskWaitingToSend = NULL;
+                } while( ( xCoreChannelSpacesAvailable( xCoreChannel ) < xRequiredSpace ) &&
+                         ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xBytesSent = prvWriteToChannel( pxChannel, ( const uint8_t * ) pvTxData, xDataLengthBytes );
+
+        traceCORE_CHANNEL_SEND( xCoreChannel, xBytesSent );
+
+        traceRETURN_xCoreChannelSend( xBytesSent );
+
+        return xBytesSent;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xCoreChannelReceive( CoreChannelHandle_t xCoreChannel,
+                                void * pvRxData,
+                                size_t xBufferLengthBytes,
+                                TickType_t xTicksToWait )
+    {
+        CoreChannel_t * const pxChannel = xCoreChannel;
+        size_t xReceivedLength;
+        TimeOut_t xTimeOut;
+
+        traceENTER_xCoreChannelReceive( xCoreChannel, pvRxData, xBufferLengthBytes, xTicksToWait );
+
+        configASSERT( pxChannel );
+        configASSERT( pvRxData );
+
+        if( ( xTicksToWait != ( TickType_t ) 0 ) && ( xCoreChannelBytesAvailable( xCoreChannel ) == ( size_t ) 0 ) )
+        {
+            /* Cannot block if the scheduler is suspended. */
+            #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+            }
+            #endif
+
+            /* Only one task can receive from a channel. */
+            configASSERT( pxChannel->xTaskWaitingToReceive == NULL );
+
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                ( void ) xTaskNotifyStateClearIndexed( NULL, configCORE_CHANNEL_NOTIFICATION_INDEX );
+
+                pxChannel->xReceiverCoreID = ( BaseType_t ) portGET_CORE_ID();
+                portDATA_MEMORY_BARRIER();
+                pxChannel->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+
+                /* See the comments in prvWriteToChannel(). */
+                portDATA_MEMORY_BARRIER();
+
+                if( xCoreChannelBytesAvailable( xCoreChannel ) == ( size_t ) 0 )
+                {
+                    traceBLOCKING_ON_CORE_CHANNEL_RECEIVE( xCoreChannel );
+                    ( void ) xTaskNotifyWaitIndexed( configCORE_CHANNEL_NOTIFICATION_INDEX, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxChannel->xTaskWaitingToReceive = NULL;
+            } while( ( xCoreChannelBytesAvailable( xCoreChannel ) == ( size_t ) 0 ) &&
+                     ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReceivedLength = prvReadFromChannel( pxChannel, ( uint8_t * ) pvRxData, xBufferLengthBytes );
+
+        traceCORE_CHANNEL_RECEIVE( xCoreChannel, xReceivedLength );
+
+        traceRETURN_xCoreChannelReceive( xReceivedLength );
+
+        return xReceivedLength;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xCoreChannelBytesAvailable( CoreChannelHandle_t xCoreChannel )
+    {
+        const CoreChannel_t * const pxChannel = xCoreChannel;
+        size_t xReturn;
+
+        traceENTER_xCoreChannelBytesAvailable( xCoreChannel );
+
+        configASSERT( pxChannel );
+
+        xReturn = prvBytesInChannel( pxChannel, pxChannel->xHead, pxChannel->xTail );
+
+        traceRETURN_xCoreChannelBytesAvailable( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xCoreChannelSpacesAvailable( CoreChannelHandle_t xCoreChannel )
+    {
+        const CoreChannel_t * const pxChannel = xCoreChannel;
+        size_t xReturn;
+
+        traceENTER_xCoreChannelSpacesAvailable( xCoreChannel );
+
+        configASSERT( pxChannel );
+
+        xReturn = pxChannel->xLength - prvBytesInChannel( pxChannel, pxChannel->xHead, pxChannel->xTail );
+
+        traceRETURN_xCoreChannelSpacesAvailable( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vCoreChannelHandleSignalFromISR( BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        CoreChannel_t * pxChannel;
+        TaskHandle_t xWaitingTask;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_vCoreChannelHandleSignalFromISR( pxHigherPriorityTaskWoken );
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            /* The signal does not say which channel raised it.  Only the
+             * waiting task clears its handle, so a task that stops waiting
+             * between the handle being read and being notified just sees a
+             * spurious notification, which the wait loops tolerate. */
+            for( pxChannel = pxCoreChannelList; pxChannel != NULL; pxChannel = pxChannel->pxNext )
+            {
+                xWaitingTask = pxChannel->xTaskWaitingToReceive;
+
+                if( ( xWaitingTask != NULL ) &&
+                    ( prvBytesInChannel( pxChannel, pxChannel->xHead, pxChannel->xTail ) > ( size_t ) 0 ) )
+                {
+                    ( void ) xTaskNotifyIndexedFromISR( xWaitingTask, configCORE_CHANNEL_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xWaitingTask = pxChannel->xTaskWaitingToSend;
+
+                if( ( xWaitingTask != NULL ) &&
+                    ( ( pxChannel->xLength - prvBytesInChannel( pxChannel, pxChannel->xHead, pxChannel->xTail ) ) >= pxChannel->xSpaceWanted ) )
+                {
+                    ( void ) xTaskNotifyIndexedFromISR( xWaitingTask, configCORE_CHANNEL_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_vCoreChannelHandleSignalFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include core channel functionality.  If you want to include core channels
+ * then ensure configUSE_CORE_CHANNELS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_CORE_CHANNELS == 1 */
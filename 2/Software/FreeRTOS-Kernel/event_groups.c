@@ -56,6 +56,16 @@
         EventBits_t uxEventBits;
         List_t xTasksWaitingForBits; /**< List of tasks waiting for a bit to be set. */
 
+        #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+            EventBits_t uxGeneralWaitBits;                                   /**< Superset of the bits waited for by the tasks in xTasksWaitingForBits. */
+            List_t xTasksWaitingForBit[ configEVENT_GROUP_INDEXED_BITS ]; /**< Tasks waiting for nothing but the single bit that indexes the list. */
+        #endif
+
+        #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+            UBaseType_t uxLockCount;      /**< Non-zero while a task is accessing the wait lists, during which interrupts do not access them. */
+            EventBits_t uxBitsSetFromISR; /**< Bits set from interrupts while the event group was locked. */
+        #endif
+
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxEventGroupNumber;
         #endif
@@ -65,6 +75,30 @@
         #endif
     } EventGroup_t;
 
+/*
+ * With configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR set to 1 an interrupt sets bits,
+ * and unblocks the tasks waiting for them, from a critical section.  Tasks
+ * access the wait lists with the scheduler suspended, so they lock the event
+ * group while doing so.  Interrupts do not access the wait lists of a locked
+ * event group.  Instead they add the bits to uxBitsSetFromISR, and the task
+ * sets them when it unlocks the event group - in the same way the queue lock
+ * defers the unblocking of tasks waiting on a queue.  Must be called with the
+ * scheduler suspended.
+ */
+    #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+        #define prvLockEventGroup( pxEventBits ) \
+    taskENTER_CRITICAL();                        \
+    {                                            \
+        ( ( pxEventBits )->uxLockCount )++;      \
+    }                                            \
+    taskEXIT_CRITICAL()
+
+        static void prvUnlockEventGroup( EventGroup_t * const pxEventBits ) PRIVILEGED_FUNCTION;
+    #else
+        #define prvLockEventGroup( pxEventBits )
+        #define prvUnlockEventGroup( pxEventBits )
+    #endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -79,6 +113,54 @@
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the event group's wait lists.
+ */
+    static void prvInitialiseWaitLists( EventGroup_t * const pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the list a task waiting for uxBitsToWaitFor is placed in.  When
+ * configEVENT_GROUP_INDEXED_BITS is greater than zero a task waiting for a
+ * single indexed bit is placed in the list dedicated to that bit, so setting
+ * the bit unblocks it without testing its wait condition.  All other tasks are
+ * placed in xTasksWaitingForBits, and the bits they wait for are recorded so
+ * xEventGroupSetBits() only walks that list when it can unblock something.
+ * Must be called with the scheduler suspended.
+ */
+    static List_t * prvSelectWaitList( EventGroup_t * const pxEventBits,
+                                       const EventBits_t uxBitsToWaitFor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task waiting on the indexed bits within uxBitsToSet, returning
+ * the bits that must be cleared because a task that was unblocked specified
+ * it should clear the bits on exit.  Called from prvSetBits(), after
+ * uxBitsToSet has been set in the event group.
+ */
+    #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        static EventBits_t prvUnblockIndexedWaiters( EventGroup_t * const pxEventBits,
+                                                     const EventBits_t uxBitsToSet,
+                                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Set uxBitsToSet in the event group, then unblock the tasks whose wait
+ * condition is now met.  pxHigherPriorityTaskWoken is NULL when called with
+ * the scheduler suspended and the event group locked.  Otherwise it is called
+ * from a critical section by xEventGroupSetBitsFromISR(), with the event group
+ * unlocked.
+ */
+    static void prvSetBits( EventGroup_t * const pxEventBits,
+                            const EventBits_t uxBitsToSet,
+                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the task that owns pxEventListItem, using the method that matches
+ * the context prvSetBits() was called from.
+ */
+    static void prvUnblockTask( ListItem_t * pxEventListItem,
+                                const EventBits_t uxEventBits,
+                                BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------*/
 
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -111,7 +193,7 @@
             if( pxEventBits != NULL )
             {
                 pxEventBits->uxEventBits = 0;
-                vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+                prvInitialiseWaitLists( pxEventBits );
 
                 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
@@ -156,7 +238,7 @@
             if( pxEventBits != NULL )
             {
                 pxEventBits->uxEventBits = 0;
-                vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+                prvInitialiseWaitLists( pxEventBits );
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -203,6 +285,7 @@
         #endif
 
         vTaskSuspendAll();
+        prvLockEventGroup( pxEventBits );
         {
             uxOriginalBitValue = pxEventBits->uxEventBits;
 
@@ -228,7 +311,7 @@
                     /* Store the bits that the calling task is waiting for in the
                      * task's event list item so the kernel knows when a match is
                      * found.  Then enter the blocked state. */
-                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    vTaskPlaceOnUnorderedEventList( prvSelectWaitList( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                     /* This assignment is obsolete as uxReturn will get set after
                      * the task unblocks, but some compilers mistakenly generate a
@@ -245,6 +328,7 @@
                 }
             }
         }
+        prvUnlockEventGroup( pxEventBits );
         xAlreadyYielded = xTaskResumeAll();
 
         if( xTicksToWait != ( TickType_t ) 0 )
@@ -334,6 +418,7 @@
         #endif
 
         vTaskSuspendAll();
+        prvLockEventGroup( pxEventBits );
         {
             const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -391,7 +476,7 @@
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                vTaskPlaceOnUnorderedEventList( prvSelectWaitList( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
                 /* This is obsolete as it will get set after the task unblocks, but
                  * some compilers mistakenly generate a warning about the variable
@@ -401,6 +486,7 @@
                 traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
             }
         }
+        prvUnlockEventGroup( pxEventBits );
         xAlreadyYielded = xTaskResumeAll();
 
         if( xTicksToWait != ( TickType_t ) 0 )
@@ -547,13 +633,7 @@
     EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                     const EventBits_t uxBitsToSet )
     {
-        ListItem_t * pxListItem;
-        ListItem_t * pxNext;
-        ListItem_t const * pxListEnd;
-        List_t const * pxList;
-        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
         EventGroup_t * pxEventBits = xEventGroup;
-        BaseType_t xMatchFound = pdFALSE;
 
         traceENTER_xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
@@ -562,80 +642,14 @@
         configASSERT( xEventGroup );
         configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-        pxList = &( pxEventBits->xTasksWaitingForBits );
-        pxListEnd = listGET_END_MARKER( pxList );
         vTaskSuspendAll();
+        prvLockEventGroup( pxEventBits );
         {
             traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-            pxListItem = listGET_HEAD_ENTRY( pxList );
-
-            /* Set the bits. */
-            pxEventBits->uxEventBits |= uxBitsToSet;
-
-            /* See if the new bit value should unblock any tasks. */
-            while( pxListItem != pxListEnd )
-            {
-                pxNext = listGET_NEXT( pxListItem );
-                uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-                xMatchFound = pdFALSE;
-
-                /* Split the bits waited for from the control bits. */
-                uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-                uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-                if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-                {
-                    /* Just looking for single bit being set. */
-                    if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                    {
-                        xMatchFound = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-                {
-                    /* All bits are set. */
-                    xMatchFound = pdTRUE;
-                }
-                else
-                {
-                    /* Need all bits to be set, but not all the bits were set. */
-                }
-
-                if( xMatchFound != pdFALSE )
-                {
-                    /* The bits match.  Should the bits be cleared on exit? */
-                    if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-                    {
-                        uxBitsToClear |= uxBitsWaitedFor;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Store the actual event flag value in the task's event list
-                     * item before removing the task from the event list.  The
-                     * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                     * that is was unblocked due to its required bits matching, rather
-                     * than because it timed out. */
-                    vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-                }
-
-                /* Move onto the next list item.  Note pxListItem->pxNext is not
-                 * used here as the list item may have been removed from the event list
-                 * and inserted into the ready/pending reading list. */
-                pxListItem = pxNext;
-            }
-
-            /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-             * bit was set in the control word. */
-            pxEventBits->uxEventBits &= ~uxBitsToClear;
+            prvSetBits( pxEventBits, uxBitsToSet, NULL );
         }
+        prvUnlockEventGroup( pxEventBits );
         ( void ) xTaskResumeAll();
 
         traceRETURN_xEventGroupSetBits( pxEventBits->uxEventBits );
@@ -648,25 +662,40 @@
     {
         EventGroup_t * pxEventBits = xEventGroup;
         const List_t * pxTasksWaitingForBits;
+        UBaseType_t uxList;
 
         traceENTER_vEventGroupDelete( xEventGroup );
 
         configASSERT( pxEventBits );
 
-        pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
-
         vTaskSuspendAll();
+        prvLockEventGroup( pxEventBits );
         {
             traceEVENT_GROUP_DELETE( xEventGroup );
 
-            while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+            /* List 0 is the general list, lists 1 onwards the indexed lists. */
+            for( uxList = 0; uxList <= ( UBaseType_t ) configEVENT_GROUP_INDEXED_BITS; uxList++ )
             {
-                /* Unblock the task, returning 0 as the event list is being deleted
-                 * and cannot therefore have any bits set. */
-                configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-                vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+                {
+                    pxTasksWaitingForBits = ( uxList == 0U ) ? &( pxEventBits->xTasksWaitingForBits ) : &( pxEventBits->xTasksWaitingForBit[ uxList - 1U ] );
+                }
+                #else
+                {
+                    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+                }
+                #endif
+
+                while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                {
+                    /* Unblock the task, returning 0 as the event list is being deleted
+                     * and cannot therefore have any bits set. */
+                    configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+                    vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
             }
         }
+        prvUnlockEventGroup( pxEventBits );
         ( void ) xTaskResumeAll();
 
         #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
@@ -772,6 +801,334 @@
     }
 /*-----------------------------------------------------------*/
 
+    static void prvSetBits( EventGroup_t * const pxEventBits,
+                            const EventBits_t uxBitsToSet,
+                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ListItem_t * pxListItem;
+        ListItem_t * pxNext;
+        ListItem_t const * pxListEnd;
+        List_t const * pxList;
+        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+        BaseType_t xMatchFound = pdFALSE;
+
+        #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+            EventBits_t uxGeneralWaitBits = 0;
+        #endif
+
+        pxList = &( pxEventBits->xTasksWaitingForBits );
+        pxListEnd = listGET_END_MARKER( pxList );
+        pxListItem = listGET_HEAD_ENTRY( pxList );
+
+        /* Set the bits. */
+        pxEventBits->uxEventBits |= uxBitsToSet;
+
+        #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        {
+            /* Tasks waiting on a single indexed bit are unblocked without
+             * testing their wait condition. */
+            uxBitsToClear |= prvUnblockIndexedWaiters( pxEventBits, uxBitsToSet, pxHigherPriorityTaskWoken );
+
+            /* A task in the general list was not unblocked by the bits that
+             * were already set, so can only be unblocked now if it waits for
+             * at least one of the bits being set.  Skip the walk if none of
+             * the remaining tasks do. */
+            if( ( uxBitsToSet & pxEventBits->uxGeneralWaitBits ) == ( EventBits_t ) 0 )
+            {
+                uxGeneralWaitBits = pxEventBits->uxGeneralWaitBits;
+                pxListItem = ( ListItem_t * ) pxListEnd;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configEVENT_GROUP_INDEXED_BITS */
+
+        /* See if the new bit value should unblock any tasks. */
+        while( pxListItem != pxListEnd )
+        {
+            pxNext = listGET_NEXT( pxListItem );
+            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+            xMatchFound = pdFALSE;
+
+            /* Split the bits waited for from the control bits. */
+            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+            {
+                /* Just looking for single bit being set. */
+                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+                {
+                    xMatchFound = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+            {
+                /* All bits are set. */
+                xMatchFound = pdTRUE;
+            }
+            else
+            {
+                /* Need all bits to be set, but not all the bits were set. */
+            }
+
+            if( xMatchFound != pdFALSE )
+            {
+                /* The bits match.  Should the bits be cleared on exit? */
+                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                {
+                    uxBitsToClear |= uxBitsWaitedFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Store the actual event flag value in the task's event list
+                 * item before removing the task from the event list.  The
+                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+                 * that is was unblocked due to its required bits matching, rather
+                 * than because it timed out. */
+                prvUnblockTask( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+                {
+                    /* Recalculate the bits waited for by the tasks that remain
+                     * in the list, dropping those of tasks that have timed out
+                     * since the bits were last calculated. */
+                    uxGeneralWaitBits |= uxBitsWaitedFor;
+                }
+                #endif
+            }
+
+            /* Move onto the next list item.  Note pxListItem->pxNext is not
+             * used here as the list item may have been removed from the event list
+             * and inserted into the ready/pending reading list. */
+            pxListItem = pxNext;
+        }
+
+        #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        {
+            pxEventBits->uxGeneralWaitBits = uxGeneralWaitBits;
+        }
+        #endif
+
+        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+         * bit was set in the control word. */
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUnblockTask( ListItem_t * pxEventListItem,
+                                const EventBits_t uxEventBits,
+                                BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+        {
+            if( pxHigherPriorityTaskWoken != NULL )
+            {
+                if( xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, uxEventBits ) != pdFALSE )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                vTaskRemoveFromUnorderedEventList( pxEventListItem, uxEventBits );
+            }
+        }
+        #else /* if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 ) */
+        {
+            ( void ) pxHigherPriorityTaskWoken;
+            vTaskRemoveFromUnorderedEventList( pxEventListItem, uxEventBits );
+        }
+        #endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+
+        static void prvUnlockEventGroup( EventGroup_t * const pxEventBits )
+        {
+            EventBits_t uxBitsSetFromISR;
+
+            /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+            /* Bits set by interrupts while the event group was locked were held
+             * in uxBitsSetFromISR, and the tasks waiting for them have not been
+             * unblocked yet.  Set them now, repeating until no more arrive, before
+             * the last lock is released. */
+            do
+            {
+                taskENTER_CRITICAL();
+                {
+                    uxBitsSetFromISR = 0;
+
+                    if( pxEventBits->uxLockCount == ( UBaseType_t ) 1U )
+                    {
+                        uxBitsSetFromISR = pxEventBits->uxBitsSetFromISR;
+                        pxEventBits->uxBitsSetFromISR = 0;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( uxBitsSetFromISR == ( EventBits_t ) 0 )
+                    {
+                        ( pxEventBits->uxLockCount )--;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( uxBitsSetFromISR != ( EventBits_t ) 0 )
+                {
+                    prvSetBits( pxEventBits, uxBitsSetFromISR, NULL );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            } while( uxBitsSetFromISR != ( EventBits_t ) 0 );
+        }
+
+    #endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseWaitLists( EventGroup_t * const pxEventBits )
+    {
+        vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+        #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        {
+            UBaseType_t uxBit;
+
+            pxEventBits->uxGeneralWaitBits = 0;
+
+            for( uxBit = 0; uxBit < ( UBaseType_t ) configEVENT_GROUP_INDEXED_BITS; uxBit++ )
+            {
+                vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+            }
+        }
+        #endif /* configEVENT_GROUP_INDEXED_BITS */
+
+        #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+        {
+            pxEventBits->uxLockCount = 0;
+            pxEventBits->uxBitsSetFromISR = 0;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static List_t * prvSelectWaitList( EventGroup_t * const pxEventBits,
+                                       const EventBits_t uxBitsToWaitFor )
+    {
+        List_t * pxList;
+
+        #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        {
+            UBaseType_t uxBit = 0;
+
+            /* Exactly one bit is set if clearing the lowest set bit leaves
+             * nothing.  uxBitsToWaitFor is never zero. */
+            if( ( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1 ) ) == ( EventBits_t ) 0 ) &&
+                ( uxBitsToWaitFor < ( ( EventBits_t ) 1 << configEVENT_GROUP_INDEXED_BITS ) ) )
+            {
+                while( ( uxBitsToWaitFor >> uxBit ) != ( EventBits_t ) 1 )
+                {
+                    uxBit++;
+                }
+
+                pxList = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+            }
+            else
+            {
+                pxEventBits->uxGeneralWaitBits |= uxBitsToWaitFor;
+                pxList = &( pxEventBits->xTasksWaitingForBits );
+            }
+        }
+        #else /* if ( configEVENT_GROUP_INDEXED_BITS > 0 ) */
+        {
+            ( void ) uxBitsToWaitFor;
+            pxList = &( pxEventBits->xTasksWaitingForBits );
+        }
+        #endif /* configEVENT_GROUP_INDEXED_BITS */
+
+        return pxList;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+
+        static EventBits_t prvUnblockIndexedWaiters( EventGroup_t * const pxEventBits,
+                                                     const EventBits_t uxBitsToSet,
+                                                     BaseType_t * const pxHigherPriorityTaskWoken )
+        {
+            EventBits_t uxBitsToClear = 0;
+            EventBits_t uxBitsRemaining;
+            UBaseType_t uxBit = 0;
+            List_t const * pxList;
+            ListItem_t * pxListItem;
+
+            uxBitsRemaining = uxBitsToSet & ( ( ( EventBits_t ) 1 << configEVENT_GROUP_INDEXED_BITS ) - ( EventBits_t ) 1 );
+
+            /* Only the lists of the bits being set are visited. */
+            while( uxBitsRemaining != ( EventBits_t ) 0 )
+            {
+                if( ( uxBitsRemaining & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+                {
+                    pxList = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+                    /* Every task in the list waits for this bit alone, so all of
+                     * them are unblocked. */
+                    while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+                    {
+                        pxListItem = listGET_HEAD_ENTRY( pxList );
+
+                        if( ( listGET_LIST_ITEM_VALUE( pxListItem ) & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                        {
+                            uxBitsToClear |= ( EventBits_t ) 1 << uxBit;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        prvUnblockTask( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET, pxHigherPriorityTaskWoken );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxBitsRemaining >>= 1;
+                uxBit++;
+            }
+
+            return uxBitsToClear;
+        }
+
+    #endif /* configEVENT_GROUP_INDEXED_BITS */
+/*-----------------------------------------------------------*/
+
     static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits )
@@ -809,7 +1166,60 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+
+        BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                              const EventBits_t uxBitsToSet,
+                                              BaseType_t * pxHigherPriorityTaskWoken )
+        {
+            EventGroup_t * pxEventBits = xEventGroup;
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken );
+
+            configASSERT( xEventGroup );
+            configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+            /* RTOS ports that support interrupt nesting have the concept of a
+             * maximum system call (or maximum API call) interrupt priority.  See
+             * xQueueGenericSendFromISR(). */
+            portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+            uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+            {
+                traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+                if( pxEventBits->uxLockCount == ( UBaseType_t ) 0U )
+                {
+                    /* No task is accessing the wait lists, so the bits can be set
+                     * and the waiting tasks unblocked directly. */
+                    prvSetBits( pxEventBits, uxBitsToSet, &xHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    /* A task is accessing the wait lists.  It will set the bits
+                     * when it unlocks the event group. */
+                    pxEventBits->uxBitsSetFromISR |= uxBitsToSet;
+                }
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xEventGroupSetBitsFromISR( pdPASS );
+
+            return pdPASS;
+        }
+
+    #elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                               const EventBits_t uxBitsToSet,
@@ -827,7 +1237,7 @@
             return xReturn;
         }
 
-    #endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+    #endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
 /*-----------------------------------------------------------*/
 
     #if ( configUSE_TRACE_FACILITY == 1 )
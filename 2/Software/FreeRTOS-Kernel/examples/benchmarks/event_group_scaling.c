@@ -0,0 +1,179 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of xEventGroupSetBits() as the number of tasks blocked on
+ * the event group grows.
+ *
+ * For each waiter count the benchmark blocks that many tasks on an event group
+ * then repeatedly sets and clears bit 0, which none of the tasks wait for.  In
+ * the "single" column every task waits for one of bits 1 to 23, in the "pair"
+ * column every task waits for two of those bits to both be set.  Without
+ * configEVENT_GROUP_INDEXED_BITS the cost of each set grows with the number of
+ * waiters in both columns, as every waiting task is tested.  With it, the cost
+ * should stay flat.
+ *
+ * Build with -DBENCH_EVENT_GROUP_INDEXED_BITS=0 and =24 to compare.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#define benchMAX_WAITERS         128
+#define benchITERATIONS          20000
+#define benchFIRST_WAITED_BIT    1
+#define benchWAITED_BITS         23
+
+#define benchWAITER_PRIORITY     ( tskIDLE_PRIORITY + 1 )
+#define benchMAIN_PRIORITY       ( tskIDLE_PRIORITY + 2 )
+
+static EventGroupHandle_t xEventGroup;
+static volatile UBaseType_t uxWaitersExited;
+
+static const UBaseType_t uxWaiterCounts[] = { 1, 8, 32, 64, benchMAX_WAITERS };
+
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void * pvParameters )
+{
+    EventBits_t uxBitsToWaitFor = ( EventBits_t ) ( uintptr_t ) pvParameters;
+
+    /* Returns when the event group is deleted. */
+    ( void ) xEventGroupWaitBits( xEventGroup, uxBitsToWaitFor, pdFALSE, pdTRUE, portMAX_DELAY );
+
+    taskENTER_CRITICAL();
+    {
+        uxWaitersExited++;
+    }
+    taskEXIT_CRITICAL();
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static double prvMeasure( UBaseType_t uxWaiters,
+                          BaseType_t xWaitForPair )
+{
+    UBaseType_t uxWaiter, uxBit;
+    EventBits_t uxBitsToWaitFor;
+    uint64_t ullStart, ullElapsed;
+    uint32_t ulIteration;
+
+    xEventGroup = xEventGroupCreate();
+    configASSERT( xEventGroup );
+    uxWaitersExited = 0;
+
+    for( uxWaiter = 0; uxWaiter < uxWaiters; uxWaiter++ )
+    {
+        uxBit = benchFIRST_WAITED_BIT + ( uxWaiter % benchWAITED_BITS );
+        uxBitsToWaitFor = ( EventBits_t ) 1 << uxBit;
+
+        if( xWaitForPair != pdFALSE )
+        {
+            uxBit = benchFIRST_WAITED_BIT + ( ( uxWaiter + 1U ) % benchWAITED_BITS );
+            uxBitsToWaitFor |= ( EventBits_t ) 1 << uxBit;
+        }
+
+        if( xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) uxBitsToWaitFor, benchWAITER_PRIORITY, NULL ) != pdPASS )
+        {
+            printf( "Failed to create waiter %u\n", ( unsigned ) uxWaiter );
+            exit( 1 );
+        }
+    }
+
+    /* Let the waiters block. */
+    vTaskDelay( pdMS_TO_TICKS( 20 ) );
+
+    ullStart = prvNanoseconds();
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ( void ) xEventGroupSetBits( xEventGroup, ( EventBits_t ) 1 );
+        ( void ) xEventGroupClearBits( xEventGroup, ( EventBits_t ) 1 );
+    }
+
+    ullElapsed = prvNanoseconds() - ullStart;
+
+    /* Deleting the event group unblocks the waiters, which then delete
+     * themselves. */
+    vEventGroupDelete( xEventGroup );
+
+    while( uxWaitersExited < uxWaiters )
+    {
+        vTaskDelay( pdMS_TO_TICKS( 5 ) );
+    }
+
+    return ( double ) ullElapsed / ( double ) benchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    size_t x;
+    double dSingle, dPair;
+
+    ( void ) pvParameters;
+
+    printf( "configEVENT_GROUP_INDEXED_BITS = %d\n", configEVENT_GROUP_INDEXED_BITS );
+    printf( "%8s %14s %14s\n", "waiters", "single ns/set", "pair ns/set" );
+
+    for( x = 0; x < ( sizeof( uxWaiterCounts ) / sizeof( uxWaiterCounts[ 0 ] ) ); x++ )
+    {
+        dSingle = prvMeasure( uxWaiterCounts[ x ], pdFALSE );
+        dPair = prvMeasure( uxWaiterCounts[ x ], pdTRUE );
+        printf( "%8u %14.1f %14.1f\n", ( unsigned ) uxWaiterCounts[ x ], dSingle, dPair );
+    }
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, benchMAIN_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
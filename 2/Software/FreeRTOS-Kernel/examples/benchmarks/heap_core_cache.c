@@ -0,0 +1,238 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures allocation throughput with one task allocating and freeing small
+ * blocks on each core.
+ *
+ * Each worker task keeps up to benchSLOTS allocations live.  Every operation
+ * picks one of the task's slots at random, and frees the allocation in it if
+ * there is one, or allocates a block of between benchMIN_SIZE and benchMAX_SIZE
+ * bytes into it if there is not.  The controlling task releases all the workers
+ * at once and times how long they take to finish, then prints the combined
+ * number of operations per second.  Without configHEAP_USE_CORE_CACHES every
+ * call suspends the scheduler, which serialises the cores.  With it most calls
+ * are served from the calling core's cache without touching shared state.
+ *
+ * When configUSE_CORE_AFFINITY is 1 each worker is pinned to its own core.  The
+ * GCC_POSIX port has a single core, so there the workers run one after the
+ * other and the result measures the cost of each call rather than how well the
+ * heap scales.  rp2350/CMakeLists.txt builds this file for both cores of the
+ * RP2350 with the pico-sdk to measure the scaling.
+ *
+ * On the host, build with -DBENCH_HEAP_CORE_CACHES=0 and =1 to compare.  The
+ * RP2350 build produces heap_core_cache_0 and heap_core_cache_1.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef PICO_ON_DEVICE
+    #include "pico/stdlib.h"
+#else
+    #include <time.h>
+#endif
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchWORKERS              2
+#define benchOPERATIONS           1000000
+#define benchSLOTS                64
+#define benchMIN_SIZE             8
+#define benchMAX_SIZE             128
+
+#define benchWORKER_PRIORITY      ( tskIDLE_PRIORITY + 1 )
+#define benchCONTROL_PRIORITY     ( tskIDLE_PRIORITY + 2 )
+
+static TaskHandle_t xControlTask = NULL;
+static TaskHandle_t xWorkerTasks[ benchWORKERS ];
+static size_t xWorkerFailures[ benchWORKERS ];
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    #ifdef PICO_ON_DEVICE
+    {
+        return time_us_64() * 1000ULL;
+    }
+    #else
+    {
+        struct timespec xNow;
+
+        ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+        return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    size_t xWorker = ( size_t ) pvParameters, xOperation, xSlot, xSize;
+    uint8_t * pucSlots[ benchSLOTS ] = { NULL };
+    uint32_t ulRandom = ( uint32_t ) xWorker + 1U;
+
+    /* Wait to be released with the other workers. */
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    for( xOperation = 0; xOperation < benchOPERATIONS; xOperation++ )
+    {
+        /* Each worker has its own generator so the workers share nothing but
+         * the heap. */
+        ulRandom = ( ulRandom * 1103515245U ) + 12345U;
+        xSlot = ( ulRandom >> 8 ) % benchSLOTS;
+
+        if( pucSlots[ xSlot ] != NULL )
+        {
+            vPortFree( pucSlots[ xSlot ] );
+            pucSlots[ xSlot ] = NULL;
+        }
+        else
+        {
+            xSize = benchMIN_SIZE + ( ( ulRandom >> 16 ) % ( benchMAX_SIZE - benchMIN_SIZE + 1U ) );
+            pucSlots[ xSlot ] = pvPortMalloc( xSize );
+
+            if( pucSlots[ xSlot ] != NULL )
+            {
+                /* Touch the memory so the allocator cannot get away with not
+                 * handing it out. */
+                pucSlots[ xSlot ][ 0 ] = ( uint8_t ) xSlot;
+                pucSlots[ xSlot ][ xSize - 1U ] = ( uint8_t ) xSlot;
+            }
+            else
+            {
+                xWorkerFailures[ xWorker ]++;
+            }
+        }
+    }
+
+    for( xSlot = 0; xSlot < benchSLOTS; xSlot++ )
+    {
+        vPortFree( pucSlots[ xSlot ] );
+    }
+
+    #if ( configHEAP_USE_CORE_CACHES == 1 )
+    {
+        /* Return this core's cached blocks so the heap statistics printed at the
+         * end show the heap as it was before the run. */
+        vPortHeapFlushCoreCache();
+    }
+    #endif
+
+    ( void ) xTaskNotifyGive( xControlTask );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    size_t xWorker, xFailures = 0;
+    uint64_t ullStart, ullElapsed;
+    HeapStats_t xStats;
+
+    ( void ) pvParameters;
+
+    xControlTask = xTaskGetCurrentTaskHandle();
+
+    for( xWorker = 0; xWorker < benchWORKERS; xWorker++ )
+    {
+        ( void ) xTaskCreate( prvWorkerTask, "Worker", configMINIMAL_STACK_SIZE * 2U, ( void * ) xWorker, benchWORKER_PRIORITY, &( xWorkerTasks[ xWorker ] ) );
+
+        #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+        {
+            vTaskCoreAffinitySet( xWorkerTasks[ xWorker ], ( UBaseType_t ) 1U << ( xWorker % configNUMBER_OF_CORES ) );
+        }
+        #endif
+    }
+
+    printf( "heap_%d.c, configHEAP_USE_CORE_CACHES %d, %d cores, %u workers, %u operations per worker\n",
+            BENCH_HEAP,
+            configHEAP_USE_CORE_CACHES,
+            configNUMBER_OF_CORES,
+            ( unsigned ) benchWORKERS,
+            ( unsigned ) benchOPERATIONS );
+
+    ullStart = prvNanoseconds();
+
+    for( xWorker = 0; xWorker < benchWORKERS; xWorker++ )
+    {
+        ( void ) xTaskNotifyGive( xWorkerTasks[ xWorker ] );
+    }
+
+    for( xWorker = 0; xWorker < benchWORKERS; xWorker++ )
+    {
+        ( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+        xFailures += xWorkerFailures[ xWorker ];
+    }
+
+    ullElapsed = prvNanoseconds() - ullStart;
+
+    vPortGetHeapStats( &xStats );
+
+    printf( "%10s %12s %12s %10s\n", "ms", "ops/s", "ns/op", "failures" );
+    printf( "%10.1f %12.0f %12.1f %10u\n",
+            ( double ) ullElapsed / 1e6,
+            ( double ) ( benchWORKERS * benchOPERATIONS ) * 1e9 / ( double ) ullElapsed,
+            ( double ) ullElapsed / ( double ) ( benchWORKERS * benchOPERATIONS ),
+            ( unsigned ) xFailures );
+    printf( "%u bytes free in %u blocks, %u successful allocations, %u successful frees\n",
+            ( unsigned ) xStats.xAvailableHeapSpaceInBytes,
+            ( unsigned ) xStats.xNumberOfFreeBlocks,
+            ( unsigned ) xStats.xNumberOfSuccessfulAllocations,
+            ( unsigned ) xStats.xNumberOfSuccessfulFrees );
+
+    #ifdef PICO_ON_DEVICE
+    {
+        vTaskDelete( NULL );
+    }
+    #else
+    {
+        exit( 0 );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    #ifdef PICO_ON_DEVICE
+    {
+        stdio_init_all();
+    }
+    #endif
+
+    ( void ) xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 4U, NULL, benchCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,240 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the time taken by pvPortMalloc() and vPortFree() under random
+ * allocation workloads.
+ *
+ * Each workload keeps up to a fixed number of allocations live.  Every
+ * operation picks a slot at random, and frees the allocation in it if there is
+ * one, or allocates a block of random size into it if there is not.  The heap
+ * therefore fragments as the run goes on.  Every call is timed, and the average,
+ * 99th percentile and worst case times are printed, along with the number of
+ * free blocks left at the end.  heap_4.c walks its free list on every
+ * allocation and free, so its times grow with the number of free blocks.
+ * heap_6.c should keep its times, and in particular its worst case, flat.
+ * When run on the host the worst case also includes the host descheduling the
+ * thread, so the 99th percentile is the better guide.
+ *
+ * Build with -DBENCH_HEAP=4 and =6 to compare.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchMAX_SLOTS         4000
+#define benchOPERATIONS        200000
+
+#define benchMAIN_PRIORITY     ( tskIDLE_PRIORITY + 1 )
+
+typedef struct
+{
+    const char * pcName;
+    size_t xSlots;
+    size_t xMinSize;
+    size_t xMaxSize;
+    uint32_t ulLargePercent; /* Percentage of allocations sized between xMaxSize and 32 * xMaxSize. */
+} Workload_t;
+
+static const Workload_t xWorkloads[] =
+{
+    { "small", 4000, 8,   128, 0  },
+    { "mixed", 4000, 8,   256, 10 },
+    { "large", 400,  256, 1024, 50 }
+};
+
+static void * pvSlots[ benchMAX_SLOTS ];
+static uint32_t ulMallocTimes[ benchOPERATIONS ];
+static uint32_t ulFreeTimes[ benchOPERATIONS ];
+static uint32_t ulRandom = 1U;
+
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ulRandom = ( ulRandom * 1103515245U ) + 12345U;
+
+    return ulRandom >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompare( const void * pv1,
+                       const void * pv2 )
+{
+    uint32_t ul1 = *( const uint32_t * ) pv1, ul2 = *( const uint32_t * ) pv2;
+
+    return ( ul1 > ul2 ) - ( ul1 < ul2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintTimes( const char * pcName,
+                           const char * pcFunction,
+                           uint32_t * pulTimes,
+                           size_t xCount )
+{
+    size_t x;
+    uint64_t ullTotal = 0;
+
+    if( xCount == 0 )
+    {
+        return;
+    }
+
+    for( x = 0; x < xCount; x++ )
+    {
+        ullTotal += pulTimes[ x ];
+    }
+
+    qsort( pulTimes, xCount, sizeof( pulTimes[ 0 ] ), prvCompare );
+
+    printf( "%-8s %-8s %8u %10.1f %10u %10u\n",
+            pcName,
+            pcFunction,
+            ( unsigned ) xCount,
+            ( double ) ullTotal / ( double ) xCount,
+            ( unsigned ) pulTimes[ ( xCount * 99U ) / 100U ],
+            ( unsigned ) pulTimes[ xCount - 1U ] );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvRandomSize( const Workload_t * pxWorkload )
+{
+    size_t xMin = pxWorkload->xMinSize, xMax = pxWorkload->xMaxSize;
+
+    if( ( prvRandom() % 100U ) < pxWorkload->ulLargePercent )
+    {
+        xMin = xMax;
+        xMax *= 32U;
+    }
+
+    return xMin + ( prvRandom() % ( xMax - xMin + 1U ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunWorkload( const Workload_t * pxWorkload )
+{
+    size_t xOperation, xSlot, xMallocs = 0, xFrees = 0, xFailures = 0;
+    uint64_t ullStart;
+    uint32_t ulElapsed;
+    HeapStats_t xStats;
+
+    for( xOperation = 0; xOperation < benchOPERATIONS; xOperation++ )
+    {
+        xSlot = prvRandom() % pxWorkload->xSlots;
+
+        if( pvSlots[ xSlot ] != NULL )
+        {
+            ullStart = prvNanoseconds();
+            vPortFree( pvSlots[ xSlot ] );
+            ulElapsed = ( uint32_t ) ( prvNanoseconds() - ullStart );
+
+            pvSlots[ xSlot ] = NULL;
+            ulFreeTimes[ xFrees++ ] = ulElapsed;
+        }
+        else
+        {
+            size_t xSize = prvRandomSize( pxWorkload );
+
+            ullStart = prvNanoseconds();
+            pvSlots[ xSlot ] = pvPortMalloc( xSize );
+            ulElapsed = ( uint32_t ) ( prvNanoseconds() - ullStart );
+
+            if( pvSlots[ xSlot ] != NULL )
+            {
+                /* Touch the memory so the allocator cannot get away with not
+                 * handing it out. */
+                ( void ) memset( pvSlots[ xSlot ], 0xa5, xSize );
+                ulMallocTimes[ xMallocs++ ] = ulElapsed;
+            }
+            else
+            {
+                xFailures++;
+            }
+        }
+    }
+
+    vPortGetHeapStats( &xStats );
+
+    prvPrintTimes( pxWorkload->pcName, "malloc", ulMallocTimes, xMallocs );
+    prvPrintTimes( pxWorkload->pcName, "free", ulFreeTimes, xFrees );
+    printf( "%-8s %u failed allocations, %u free blocks, largest free block %u bytes\n",
+            pxWorkload->pcName,
+            ( unsigned ) xFailures,
+            ( unsigned ) xStats.xNumberOfFreeBlocks,
+            ( unsigned ) xStats.xSizeOfLargestFreeBlockInBytes );
+
+    for( xSlot = 0; xSlot < pxWorkload->xSlots; xSlot++ )
+    {
+        vPortFree( pvSlots[ xSlot ] );
+        pvSlots[ xSlot ] = NULL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    size_t x;
+
+    ( void ) pvParameters;
+
+    printf( "heap_%d.c, %u operations per workload\n", BENCH_HEAP, ( unsigned ) benchOPERATIONS );
+    printf( "%-8s %-8s %8s %10s %10s %10s\n", "workload", "function", "calls", "avg ns", "p99 ns", "max ns" );
+
+    for( x = 0; x < ( sizeof( xWorkloads ) / sizeof( xWorkloads[ 0 ] ) ); x++ )
+    {
+        prvRunWorkload( &( xWorkloads[ x ] ) );
+    }
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, benchMAIN_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
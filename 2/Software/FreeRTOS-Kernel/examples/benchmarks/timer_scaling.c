@@ -0,0 +1,240 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of the timer service task processing start, reset and
+ * stop commands as the number of active timers grows.
+ *
+ * For each timer count the benchmark starts that many one-shot timers with
+ * random periods that are long enough for none of them to expire during the
+ * run.  It then sends batches of commands to the timer service task, which
+ * runs at a lower priority so it processes each batch in one go, and times how
+ * long it takes to work through each batch.  With the sorted timer lists the
+ * cost of a start or reset grows with the number of active timers.  With
+ * configUSE_TIMER_WHEEL it should stay flat.
+ *
+ * Build with -DBENCH_USE_TIMER_WHEEL=0 and =1 to compare.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define benchMAX_TIMERS       10000
+#define benchCOMMANDS         4096
+#define benchBATCH_SIZE       ( configTIMER_QUEUE_LENGTH - 1 )
+#define benchMIN_PERIOD       ( ( TickType_t ) 100000 )
+#define benchMAX_PERIOD       ( ( TickType_t ) 600000 )
+
+#define benchMAIN_PRIORITY    ( configTIMER_TASK_PRIORITY + 1 )
+
+typedef enum
+{
+    eStart,
+    eReset,
+    eStop
+} BenchCommand_t;
+
+static TimerHandle_t xTimers[ benchMAX_TIMERS ];
+static TaskHandle_t xBenchmarkTask;
+static uint32_t ulRandom = 1U;
+
+static const UBaseType_t uxTimerCounts[] = { 100, 1000, benchMAX_TIMERS };
+
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ulRandom = ( ulRandom * 1103515245U ) + 12345U;
+
+    return ulRandom >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    /* The periods are chosen so no timer expires during the benchmark. */
+    ( void ) xTimer;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchDone( void * pvParameter1,
+                          uint32_t ulParameter2 )
+{
+    ( void ) pvParameter1;
+    ( void ) ulParameter2;
+
+    ( void ) xTaskNotifyGive( xBenchmarkTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForTimerTask( void )
+{
+    /* The timer service task runs the pended function after processing every
+     * command queued before it. */
+    ( void ) xTimerPendFunctionCall( prvBatchDone, NULL, 0, portMAX_DELAY );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendCommand( BenchCommand_t eCommand,
+                            TimerHandle_t xTimer )
+{
+    BaseType_t xResult;
+
+    switch( eCommand )
+    {
+        case eStart:
+            xResult = xTimerStart( xTimer, portMAX_DELAY );
+            break;
+
+        case eReset:
+            xResult = xTimerReset( xTimer, portMAX_DELAY );
+            break;
+
+        default:
+            xResult = xTimerStop( xTimer, portMAX_DELAY );
+            break;
+    }
+
+    configASSERT( xResult == pdPASS );
+    ( void ) xResult;
+}
+/*-----------------------------------------------------------*/
+
+static double prvMeasure( UBaseType_t uxTimers,
+                          BenchCommand_t eCommand,
+                          UBaseType_t uxCommands )
+{
+    UBaseType_t uxSent = 0, uxInBatch;
+    uint64_t ullStart, ullElapsed = 0;
+
+    while( uxSent < uxCommands )
+    {
+        ullStart = prvNanoseconds();
+
+        for( uxInBatch = 0; ( uxInBatch < benchBATCH_SIZE ) && ( uxSent < uxCommands ); uxInBatch++ )
+        {
+            if( eCommand == eReset )
+            {
+                prvSendCommand( eCommand, xTimers[ prvRandom() % uxTimers ] );
+            }
+            else
+            {
+                prvSendCommand( eCommand, xTimers[ uxSent ] );
+            }
+
+            uxSent++;
+        }
+
+        /* The timer service task does not run until this task blocks. */
+        prvWaitForTimerTask();
+        ullElapsed += prvNanoseconds() - ullStart;
+    }
+
+    return ( double ) ullElapsed / ( double ) uxCommands;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    size_t x;
+    UBaseType_t uxTimers, uxTimer;
+    double dStart, dReset, dStop;
+
+    ( void ) pvParameters;
+
+    xBenchmarkTask = xTaskGetCurrentTaskHandle();
+
+    printf( "configUSE_TIMER_WHEEL = %d\n", configUSE_TIMER_WHEEL );
+    printf( "%8s %14s %14s %14s\n", "timers", "start ns/cmd", "reset ns/cmd", "stop ns/cmd" );
+
+    for( x = 0; x < ( sizeof( uxTimerCounts ) / sizeof( uxTimerCounts[ 0 ] ) ); x++ )
+    {
+        uxTimers = uxTimerCounts[ x ];
+
+        for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+        {
+            xTimers[ uxTimer ] = xTimerCreate( "Bench",
+                                               benchMIN_PERIOD + ( prvRandom() % ( benchMAX_PERIOD - benchMIN_PERIOD ) ),
+                                               pdFALSE,
+                                               NULL,
+                                               prvTimerCallback );
+
+            if( xTimers[ uxTimer ] == NULL )
+            {
+                printf( "Failed to create timer %u\n", ( unsigned ) uxTimer );
+                exit( 1 );
+            }
+        }
+
+        /* Starting the timers in order fills the active timers as it goes, so
+         * the start column is the average over a growing number of active
+         * timers. */
+        dStart = prvMeasure( uxTimers, eStart, uxTimers );
+        dReset = prvMeasure( uxTimers, eReset, benchCOMMANDS );
+        dStop = prvMeasure( uxTimers, eStop, uxTimers );
+
+        printf( "%8u %14.1f %14.1f %14.1f\n", ( unsigned ) uxTimers, dStart, dReset, dStop );
+
+        for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+        {
+            ( void ) xTimerDelete( xTimers[ uxTimer ], portMAX_DELAY );
+        }
+
+        prvWaitForTimerTask();
+    }
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4U, NULL, benchMAIN_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
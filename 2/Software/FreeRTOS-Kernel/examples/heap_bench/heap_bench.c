@@ -0,0 +1,729 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Replays an allocation trace against the heap the executable was built with,
+ * and writes the results as a JSON object on stdout.
+ *
+ * The build produces one executable per heap, heap_bench_1 to heap_bench_6,
+ * all from this file.  Each run replays one trace, given on the command line
+ * as either the name of a synthetic trace or the path of a recorded one:
+ *
+ *     heap_bench_4 mixed
+ *     heap_bench_4 traces/event_group_scaling.trace
+ *
+ * A trace is a list of allocations and frees.  The whole trace is built in
+ * host memory before the scheduler starts, so building it does not touch the
+ * heap under test, then a task replays it.  Every pvPortMalloc() and
+ * vPortFree() call is timed, including allocations that fail.  The results
+ * give:
+ *
+ * - the mean, 50th, 90th, 99th and 99.9th percentile and worst case time of
+ *   each function;
+ * - the peak number of bytes the trace held live;
+ * - the peak fragmentation, sampled every benchSAMPLE_INTERVAL events and at
+ *   every failure, as 1 - ( largest free block / free bytes );
+ * - the number of failed allocations, and the state of the heap at each
+ *   failure point.  A failure point is the first failed allocation after a
+ *   free, so it marks where the heap stopped keeping up with the trace each
+ *   time the trace gave memory back.  Only the first benchMAX_FAILURE_POINTS
+ *   are written.
+ *
+ * Values a heap cannot provide are written as null.  heap_1.c cannot free, so
+ * its frees are counted but not made.  heap_2.c and heap_3.c do not report
+ * their largest free block, and heap_3.c, which wraps the C library, does not
+ * report its free bytes either.
+ *
+ * heap_bench.py runs every heap against every trace and merges the results.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchSYNTHETIC_EVENTS    200000
+#define benchSAMPLE_INTERVAL     256
+#define benchMAX_FAILURE_POINTS  8
+
+#define benchMAIN_PRIORITY       ( tskIDLE_PRIORITY + 1 )
+
+/* What the heap under test can report. */
+#define benchHEAP_CAN_FREE                ( BENCH_HEAP != 1 )
+#define benchHEAP_REPORTS_FREE_BYTES      ( BENCH_HEAP != 3 )
+#define benchHEAP_REPORTS_LARGEST_BLOCK   ( ( BENCH_HEAP == 1 ) || ( BENCH_HEAP >= 4 ) )
+
+typedef enum
+{
+    eMalloc,
+    eFree
+} EventType_t;
+
+typedef struct
+{
+    EventType_t eType;
+    uint32_t ulId;   /* Allocations are numbered from 0 in the order they are made. */
+    uint32_t ulSize; /* Bytes requested, only used by eMalloc. */
+} Event_t;
+
+typedef struct
+{
+    Event_t * pxEvents;
+    size_t xEvents;
+    size_t xCapacity;
+    uint32_t ulAllocations;
+} Trace_t;
+
+typedef struct
+{
+    const char * pcName;
+    const char * pcDescription;
+    void ( * pxGenerate )( Trace_t * pxTrace );
+} SyntheticTrace_t;
+
+typedef struct
+{
+    size_t xEvent;
+    size_t xSize;
+    size_t xLiveBytes;
+    size_t xFreeBytes;
+    size_t xLargestFreeBlock;
+} Failure_t;
+
+static void prvGenerateSmall( Trace_t * pxTrace );
+static void prvGenerateMixed( Trace_t * pxTrace );
+static void prvGenerateFifo( Trace_t * pxTrace );
+static void prvGenerateFill( Trace_t * pxTrace );
+
+static const SyntheticTrace_t xSyntheticTraces[] =
+{
+    { "small", "random allocations of 8 to 128 bytes and frees, up to 2000 live",  prvGenerateSmall },
+    { "mixed", "as small, but up to 256 bytes with one in ten up to 8 KiB",        prvGenerateMixed },
+    { "fifo",  "messages of 16 to 1024 bytes freed in the order allocated",        prvGenerateFifo  },
+    { "fill",  "fill the heap, free two blocks in three, then refill with larger", prvGenerateFill  }
+};
+
+static const char * pcTraceName;
+static Trace_t xTrace;
+static uint32_t ulRandom = 1U;
+
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ulRandom = ( ulRandom * 1103515245U ) + 12345U;
+
+    return ulRandom >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandomBetween( uint32_t ulMin,
+                                  uint32_t ulMax )
+{
+    return ulMin + ( prvRandom() % ( ulMax - ulMin + 1U ) );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvHostAllocate( size_t xSize )
+{
+    /* Trace and result storage comes from the C library, never from the heap
+     * under test. */
+    void * pvReturn = calloc( 1, xSize );
+
+    if( pvReturn == NULL )
+    {
+        fprintf( stderr, "out of host memory\n" );
+        exit( 1 );
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddEvent( Trace_t * pxTrace,
+                         EventType_t eType,
+                         uint32_t ulId,
+                         uint32_t ulSize )
+{
+    if( pxTrace->xEvents == pxTrace->xCapacity )
+    {
+        pxTrace->xCapacity = ( pxTrace->xCapacity == 0 ) ? 1024 : ( pxTrace->xCapacity * 2U );
+        pxTrace->pxEvents = realloc( pxTrace->pxEvents, pxTrace->xCapacity * sizeof( Event_t ) );
+
+        if( pxTrace->pxEvents == NULL )
+        {
+            fprintf( stderr, "out of host memory\n" );
+            exit( 1 );
+        }
+    }
+
+    pxTrace->pxEvents[ pxTrace->xEvents ].eType = eType;
+    pxTrace->pxEvents[ pxTrace->xEvents ].ulId = ulId;
+    pxTrace->pxEvents[ pxTrace->xEvents ].ulSize = ulSize;
+    pxTrace->xEvents++;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvAddMalloc( Trace_t * pxTrace,
+                              uint32_t ulSize )
+{
+    uint32_t ulId = pxTrace->ulAllocations++;
+
+    prvAddEvent( pxTrace, eMalloc, ulId, ulSize );
+
+    return ulId;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGenerateChurn( Trace_t * pxTrace,
+                              uint32_t ulSlots,
+                              uint32_t ulMinSize,
+                              uint32_t ulMaxSize,
+                              uint32_t ulLargePercent )
+{
+    /* Each slot holds the id of a live allocation plus one, or 0 when empty.
+     * Every event picks a slot at random and frees the allocation in it, or
+     * allocates into it if it is empty. */
+    uint32_t * pulSlots = prvHostAllocate( ulSlots * sizeof( uint32_t ) );
+    uint32_t ulSlot, ulSize;
+
+    while( pxTrace->xEvents < benchSYNTHETIC_EVENTS )
+    {
+        ulSlot = prvRandom() % ulSlots;
+
+        if( pulSlots[ ulSlot ] != 0U )
+        {
+            prvAddEvent( pxTrace, eFree, pulSlots[ ulSlot ] - 1U, 0 );
+            pulSlots[ ulSlot ] = 0U;
+        }
+        else
+        {
+            if( ( prvRandom() % 100U ) < ulLargePercent )
+            {
+                ulSize = prvRandomBetween( ulMaxSize, 8192U );
+            }
+            else
+            {
+                ulSize = prvRandomBetween( ulMinSize, ulMaxSize );
+            }
+
+            pulSlots[ ulSlot ] = prvAddMalloc( pxTrace, ulSize ) + 1U;
+        }
+    }
+
+    free( pulSlots );
+}
+/*-----------------------------------------------------------*/
+
+static void prvGenerateSmall( Trace_t * pxTrace )
+{
+    prvGenerateChurn( pxTrace, 2000U, 8U, 128U, 0U );
+}
+/*-----------------------------------------------------------*/
+
+static void prvGenerateMixed( Trace_t * pxTrace )
+{
+    prvGenerateChurn( pxTrace, 2000U, 8U, 256U, 10U );
+}
+/*-----------------------------------------------------------*/
+
+static void prvGenerateFifo( Trace_t * pxTrace )
+{
+    /* Up to 256 messages in flight.  Between 1 and 4 are sent, then between 1
+     * and 4 of the oldest are received, so the number in flight wanders. */
+    const uint32_t ulWindow = 256U;
+    uint32_t ulOldest = 0U, ulCount;
+
+    while( pxTrace->xEvents < benchSYNTHETIC_EVENTS )
+    {
+        for( ulCount = prvRandomBetween( 1U, 4U ); ( ulCount > 0U ) && ( ( pxTrace->ulAllocations - ulOldest ) < ulWindow ); ulCount-- )
+        {
+            ( void ) prvAddMalloc( pxTrace, prvRandomBetween( 16U, 1024U ) );
+        }
+
+        for( ulCount = prvRandomBetween( 1U, 4U ); ( ulCount > 0U ) && ( ulOldest < pxTrace->ulAllocations ); ulCount-- )
+        {
+            prvAddEvent( pxTrace, eFree, ulOldest++, 0 );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvGenerateFill( Trace_t * pxTrace )
+{
+    /* Ask for twice the heap in blocks of 16 to 1024 bytes, so the heap fills
+     * and the rest of the requests fail.  Then free two blocks in every three,
+     * which leaves two thirds of the heap free in holes that are only big
+     * enough for blocks of 1025 to 2048 bytes if the heap merges adjacent free
+     * blocks, and ask for the heap again in blocks of that size.  The second
+     * failure point shows how well the heap copes with the holes. */
+    uint32_t ulFirst, ulId, ulRequested, ulSize;
+
+    ulFirst = pxTrace->ulAllocations;
+
+    for( ulRequested = 0; ulRequested < ( uint32_t ) ( configTOTAL_HEAP_SIZE * 2U ); ulRequested += ulSize )
+    {
+        ulSize = prvRandomBetween( 16U, 1024U );
+        ( void ) prvAddMalloc( pxTrace, ulSize );
+    }
+
+    for( ulId = ulFirst; ulId < pxTrace->ulAllocations; ulId++ )
+    {
+        if( ( ( ulId - ulFirst ) % 3U ) != 2U )
+        {
+            prvAddEvent( pxTrace, eFree, ulId, 0 );
+        }
+    }
+
+    for( ulRequested = 0; ulRequested < ( uint32_t ) configTOTAL_HEAP_SIZE; ulRequested += ulSize )
+    {
+        ulSize = prvRandomBetween( 1025U, 2048U );
+        ( void ) prvAddMalloc( pxTrace, ulSize );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvHash( uintptr_t uxAddress,
+                       size_t xMask )
+{
+    return ( size_t ) ( ( ( uint64_t ) uxAddress * 0x9e3779b97f4a7c15ULL ) >> 20 ) & xMask;
+}
+/*-----------------------------------------------------------*/
+
+static int prvLoadTrace( Trace_t * pxTrace,
+                         const char * pcPath )
+{
+    /* A recorded trace has one line per call:
+     *
+     *     m <address> <bytes>
+     *     f <address>
+     *
+     * Addresses are only used to match each free to its allocation, and are
+     * mapped to allocation ids through an open addressing table.  Lines that
+     * do not match either form are ignored, as are frees of addresses that
+     * were allocated before the recording started. */
+    FILE * pxFile = fopen( pcPath, "r" );
+    char cLine[ 128 ], cType, cAddress[ 64 ];
+    unsigned long ulSize;
+    uintptr_t * puxAddresses;
+    uint32_t * pulIds;
+    uintptr_t uxAddress;
+    size_t xLines = 0, xMask, xSlot;
+
+    if( pxFile == NULL )
+    {
+        return -1;
+    }
+
+    while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+    {
+        xLines++;
+    }
+
+    /* At least twice as many slots as lines, so the table never fills. */
+    for( xMask = 1023U; xMask < ( xLines * 2U ); xMask = ( xMask << 1 ) | 1U )
+    {
+    }
+
+    puxAddresses = prvHostAllocate( ( xMask + 1U ) * sizeof( uintptr_t ) );
+    pulIds = prvHostAllocate( ( xMask + 1U ) * sizeof( uint32_t ) );
+    rewind( pxFile );
+
+    while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+    {
+        ulSize = 0;
+
+        if( ( sscanf( cLine, " %c %63s %lu", &cType, cAddress, &ulSize ) < 2 ) || ( ( cType != 'm' ) && ( cType != 'f' ) ) )
+        {
+            continue;
+        }
+
+        /* A failed allocation is recorded with a NULL address, which glibc
+         * prints as "(nil)" and strtoull() reads as 0. */
+        uxAddress = ( uintptr_t ) strtoull( cAddress, NULL, 16 );
+
+        for( xSlot = prvHash( uxAddress, xMask ); ( puxAddresses[ xSlot ] != 0U ) && ( puxAddresses[ xSlot ] != uxAddress ); xSlot = ( xSlot + 1U ) & xMask )
+        {
+        }
+
+        if( cType == 'm' )
+        {
+            if( ( uxAddress != 0U ) && ( puxAddresses[ xSlot ] == 0U ) )
+            {
+                puxAddresses[ xSlot ] = uxAddress;
+            }
+
+            pulIds[ xSlot ] = prvAddMalloc( pxTrace, ( uint32_t ) ulSize ) + 1U;
+        }
+        else if( ( uxAddress != 0U ) && ( puxAddresses[ xSlot ] == uxAddress ) && ( pulIds[ xSlot ] != 0U ) )
+        {
+            /* The slot keeps the address so the probe sequences through it
+             * stay intact, and is reused if the address is allocated again. */
+            prvAddEvent( pxTrace, eFree, pulIds[ xSlot ] - 1U, 0 );
+            pulIds[ xSlot ] = 0U;
+        }
+    }
+
+    ( void ) fclose( pxFile );
+    free( puxAddresses );
+    free( pulIds );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetFreeSpace( size_t * pxFreeBytes,
+                             size_t * pxLargestFreeBlock )
+{
+    #if ( BENCH_HEAP >= 4 )
+    {
+        HeapStats_t xStats;
+
+        vPortGetHeapStats( &xStats );
+        *pxFreeBytes = xStats.xAvailableHeapSpaceInBytes;
+        *pxLargestFreeBlock = xStats.xSizeOfLargestFreeBlockInBytes;
+    }
+    #elif ( benchHEAP_REPORTS_FREE_BYTES == 1 )
+    {
+        /* heap_1.c never frees, so its free space is one block. */
+        *pxFreeBytes = xPortGetFreeHeapSize();
+        *pxLargestFreeBlock = ( BENCH_HEAP == 1 ) ? *pxFreeBytes : 0U;
+    }
+    #else
+    {
+        *pxFreeBytes = 0U;
+        *pxLargestFreeBlock = 0U;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompare( const void * pv1,
+                       const void * pv2 )
+{
+    uint32_t ul1 = *( const uint32_t * ) pv1, ul2 = *( const uint32_t * ) pv2;
+
+    return ( ul1 > ul2 ) - ( ul1 < ul2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintSize( const char * pcName,
+                          size_t xValue,
+                          BaseType_t xValid,
+                          const char * pcSeparator )
+{
+    if( xValid != pdFALSE )
+    {
+        printf( "\"%s\": %lu%s", pcName, ( unsigned long ) xValue, pcSeparator );
+    }
+    else
+    {
+        printf( "\"%s\": null%s", pcName, pcSeparator );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintTimes( const char * pcName,
+                           uint32_t * pulTimes,
+                           size_t xCount )
+{
+    static const uint32_t ulPerMille[] = { 500, 900, 990, 999 };
+    static const char * const pcPercentiles[] = { "p50_ns", "p90_ns", "p99_ns", "p999_ns" };
+    uint64_t ullTotal = 0;
+    size_t x;
+
+    printf( "  \"%s\": { \"calls\": %lu", pcName, ( unsigned long ) xCount );
+
+    if( xCount > 0U )
+    {
+        for( x = 0; x < xCount; x++ )
+        {
+            ullTotal += pulTimes[ x ];
+        }
+
+        qsort( pulTimes, xCount, sizeof( pulTimes[ 0 ] ), prvCompare );
+
+        printf( ", \"mean_ns\": %.1f", ( double ) ullTotal / ( double ) xCount );
+
+        for( x = 0; x < ( sizeof( ulPerMille ) / sizeof( ulPerMille[ 0 ] ) ); x++ )
+        {
+            printf( ", \"%s\": %u", pcPercentiles[ x ], ( unsigned ) pulTimes[ ( xCount * ulPerMille[ x ] ) / 1000U ] );
+        }
+
+        printf( ", \"max_ns\": %u", ( unsigned ) pulTimes[ xCount - 1U ] );
+    }
+    else
+    {
+        printf( ", \"mean_ns\": null, \"p50_ns\": null, \"p90_ns\": null, \"p99_ns\": null, \"p999_ns\": null, \"max_ns\": null" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintString( const char * pcName,
+                            const char * pcValue )
+{
+    printf( "  \"%s\": \"", pcName );
+
+    for( ; *pcValue != '\0'; pcValue++ )
+    {
+        if( ( *pcValue == '"' ) || ( *pcValue == '\\' ) )
+        {
+            putchar( '\\' );
+        }
+
+        putchar( *pcValue );
+    }
+
+    printf( "\",\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReplayTask( void * pvParameters )
+{
+    void ** ppvBlocks = prvHostAllocate( ( xTrace.ulAllocations + 1U ) * sizeof( void * ) );
+    uint32_t * pulSizes = prvHostAllocate( ( xTrace.ulAllocations + 1U ) * sizeof( uint32_t ) );
+    uint32_t * pulMallocTimes = prvHostAllocate( ( xTrace.xEvents + 1U ) * sizeof( uint32_t ) );
+    uint32_t * pulFreeTimes = prvHostAllocate( ( xTrace.xEvents + 1U ) * sizeof( uint32_t ) );
+    size_t xEvent, xMallocs = 0, xFrees = 0, xFreesNotMade = 0, xFailures = 0;
+    size_t xLiveBytes = 0, xPeakLiveBytes = 0, xStartFreeBytes, xMinFreeBytes, xFreeBytes, xLargestFreeBlock;
+    double dFragmentation, dPeakFragmentation = 0.0;
+    Failure_t xFailurePoints[ benchMAX_FAILURE_POINTS ];
+    size_t xFailurePoint, xFailurePointCount = 0;
+    BaseType_t xFreedSinceFailure = pdTRUE;
+    const Event_t * pxEvent;
+    uint64_t ullStart;
+    uint32_t ulElapsed;
+
+    ( void ) pvParameters;
+
+    prvGetFreeSpace( &xStartFreeBytes, &xLargestFreeBlock );
+    xMinFreeBytes = xStartFreeBytes;
+
+    for( xEvent = 0; xEvent < xTrace.xEvents; xEvent++ )
+    {
+        pxEvent = &( xTrace.pxEvents[ xEvent ] );
+
+        if( pxEvent->eType == eMalloc )
+        {
+            ullStart = prvNanoseconds();
+            ppvBlocks[ pxEvent->ulId ] = pvPortMalloc( pxEvent->ulSize );
+            ulElapsed = ( uint32_t ) ( prvNanoseconds() - ullStart );
+
+            /* Failed calls are timed too, as a heap that is slow to give up
+             * costs the application as much as one that is slow to succeed. */
+            pulMallocTimes[ xMallocs++ ] = ulElapsed;
+
+            if( ppvBlocks[ pxEvent->ulId ] != NULL )
+            {
+                /* Touch the memory so the allocator cannot get away with not
+                 * handing it out. */
+                ( void ) memset( ppvBlocks[ pxEvent->ulId ], 0xa5, pxEvent->ulSize );
+                pulSizes[ pxEvent->ulId ] = pxEvent->ulSize;
+                xLiveBytes += pxEvent->ulSize;
+
+                if( xLiveBytes > xPeakLiveBytes )
+                {
+                    xPeakLiveBytes = xLiveBytes;
+                }
+            }
+            else if( pxEvent->ulSize > 0U )
+            {
+                if( ( xFreedSinceFailure != pdFALSE ) && ( xFailurePointCount < benchMAX_FAILURE_POINTS ) )
+                {
+                    xFailurePoints[ xFailurePointCount ].xEvent = xEvent;
+                    xFailurePoints[ xFailurePointCount ].xSize = pxEvent->ulSize;
+                    xFailurePoints[ xFailurePointCount ].xLiveBytes = xLiveBytes;
+                    prvGetFreeSpace( &( xFailurePoints[ xFailurePointCount ].xFreeBytes ), &( xFailurePoints[ xFailurePointCount ].xLargestFreeBlock ) );
+                    xFailurePointCount++;
+                }
+
+                xFreedSinceFailure = pdFALSE;
+                xFailures++;
+            }
+        }
+        else if( ppvBlocks[ pxEvent->ulId ] != NULL )
+        {
+            #if ( benchHEAP_CAN_FREE == 1 )
+            {
+                ullStart = prvNanoseconds();
+                vPortFree( ppvBlocks[ pxEvent->ulId ] );
+                ulElapsed = ( uint32_t ) ( prvNanoseconds() - ullStart );
+
+                pulFreeTimes[ xFrees++ ] = ulElapsed;
+                xLiveBytes -= pulSizes[ pxEvent->ulId ];
+                xFreedSinceFailure = pdTRUE;
+            }
+            #else
+            {
+                /* Nothing is given back to the heap, so this does not start
+                 * a new failure point. */
+                xFreesNotMade++;
+            }
+            #endif
+
+            ppvBlocks[ pxEvent->ulId ] = NULL;
+        }
+
+        /* Sample the heap outside the timed calls. */
+        if( ( ( xEvent % benchSAMPLE_INTERVAL ) == 0U ) || ( ( pxEvent->eType == eMalloc ) && ( ppvBlocks[ pxEvent->ulId ] == NULL ) ) )
+        {
+            prvGetFreeSpace( &xFreeBytes, &xLargestFreeBlock );
+
+            if( xFreeBytes < xMinFreeBytes )
+            {
+                xMinFreeBytes = xFreeBytes;
+            }
+
+            if( xFreeBytes > 0U )
+            {
+                dFragmentation = 1.0 - ( ( double ) xLargestFreeBlock / ( double ) xFreeBytes );
+
+                if( dFragmentation > dPeakFragmentation )
+                {
+                    dPeakFragmentation = dFragmentation;
+                }
+            }
+        }
+    }
+
+    printf( "{\n" );
+    printf( "  \"heap\": \"heap_%d.c\",\n", BENCH_HEAP );
+    prvPrintString( "trace", pcTraceName );
+    printf( "  " );
+    prvPrintSize( "heap_size", configTOTAL_HEAP_SIZE, ( BENCH_HEAP != 3 ), ",\n" );
+    printf( "  \"events\": %lu,\n", ( unsigned long ) xTrace.xEvents );
+    prvPrintTimes( "malloc", pulMallocTimes, xMallocs );
+    printf( ", \"failures\": %lu },\n", ( unsigned long ) xFailures );
+    prvPrintTimes( "free", pulFreeTimes, xFrees );
+    printf( ", \"not_made\": %lu },\n", ( unsigned long ) xFreesNotMade );
+    printf( "  \"peak_live_bytes\": %lu,\n", ( unsigned long ) xPeakLiveBytes );
+    printf( "  " );
+    prvPrintSize( "free_bytes_at_start", xStartFreeBytes, benchHEAP_REPORTS_FREE_BYTES, ",\n" );
+    printf( "  " );
+    prvPrintSize( "min_free_bytes", xMinFreeBytes, benchHEAP_REPORTS_FREE_BYTES, ",\n" );
+
+    #if ( benchHEAP_REPORTS_LARGEST_BLOCK == 1 )
+        printf( "  \"peak_fragmentation\": %.4f,\n", dPeakFragmentation );
+    #else
+        printf( "  \"peak_fragmentation\": null,\n" );
+    #endif
+
+    printf( "  \"failure_points\": [" );
+
+    for( xFailurePoint = 0; xFailurePoint < xFailurePointCount; xFailurePoint++ )
+    {
+        printf( "%s\n    { \"event\": %lu, \"size\": %lu, \"live_bytes\": %lu, ",
+                ( xFailurePoint == 0U ) ? "" : ",",
+                ( unsigned long ) xFailurePoints[ xFailurePoint ].xEvent,
+                ( unsigned long ) xFailurePoints[ xFailurePoint ].xSize,
+                ( unsigned long ) xFailurePoints[ xFailurePoint ].xLiveBytes );
+        prvPrintSize( "free_bytes", xFailurePoints[ xFailurePoint ].xFreeBytes, benchHEAP_REPORTS_FREE_BYTES, ", " );
+        prvPrintSize( "largest_free_block", xFailurePoints[ xFailurePoint ].xLargestFreeBlock, benchHEAP_REPORTS_LARGEST_BLOCK, " }" );
+    }
+
+    printf( "%s]\n", ( xFailurePointCount == 0U ) ? "" : "\n  " );
+
+    printf( "}\n" );
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    size_t x;
+
+    if( ( argc == 2 ) && ( strcmp( argv[ 1 ], "--list" ) == 0 ) )
+    {
+        for( x = 0; x < ( sizeof( xSyntheticTraces ) / sizeof( xSyntheticTraces[ 0 ] ) ); x++ )
+        {
+            printf( "%-8s %s\n", xSyntheticTraces[ x ].pcName, xSyntheticTraces[ x ].pcDescription );
+        }
+
+        return 0;
+    }
+
+    if( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s <synthetic trace name | recorded trace file>\n"
+                         "       %s --list\n", argv[ 0 ], argv[ 0 ] );
+        return 2;
+    }
+
+    pcTraceName = argv[ 1 ];
+
+    for( x = 0; x < ( sizeof( xSyntheticTraces ) / sizeof( xSyntheticTraces[ 0 ] ) ); x++ )
+    {
+        if( strcmp( pcTraceName, xSyntheticTraces[ x ].pcName ) == 0 )
+        {
+            xSyntheticTraces[ x ].pxGenerate( &xTrace );
+            break;
+        }
+    }
+
+    if( ( x == ( sizeof( xSyntheticTraces ) / sizeof( xSyntheticTraces[ 0 ] ) ) ) && ( prvLoadTrace( &xTrace, pcTraceName ) != 0 ) )
+    {
+        fprintf( stderr, "%s: not a synthetic trace and cannot be opened: %s\n", pcTraceName, strerror( errno ) );
+        return 2;
+    }
+
+    #if ( BENCH_HEAP == 5 )
+    {
+        static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+        const HeapRegion_t xHeapRegions[] =
+        {
+            { ucHeap, sizeof( ucHeap ) },
+            { NULL,   0                }
+        };
+
+        vPortDefineHeapRegions( xHeapRegions );
+    }
+    #endif
+
+    ( void ) xTaskCreate( prvReplayTask, "Replay", configMINIMAL_STACK_SIZE * 4U, NULL, benchMAIN_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""Run every heap against every allocation trace and collect the results.
+
+The build produces one executable per heap, heap_bench_1 to heap_bench_6.
+Each replays one trace and writes its results as a JSON object.  This script
+runs each executable against each trace, prints a summary table, and can write
+all the results to one JSON file:
+
+    heap_bench.py --build build --output results.json
+
+Given --baseline, the results are compared with an earlier results file and
+the script exits with status 1 if any heap regressed on any trace: a 99th
+percentile time grew by more than --threshold percent, more allocations
+failed, or the peak fragmentation grew by more than 0.05.  Host timings are
+noisy, so compare runs made on the same machine.
+
+The traces are the synthetic traces listed by "heap_bench_<n> --list" and the
+recorded traces in the traces directory, unless traces are named on the
+command line.
+"""
+
+import argparse
+import datetime
+import glob
+import json
+import os
+import platform
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def find_executables(build, heaps):
+    """Returns the heap_bench executables in the build directory."""
+    executables = {}
+    for heap in heaps:
+        path = os.path.join(build, "heap_bench_%d" % heap)
+        if os.access(path, os.X_OK):
+            executables[heap] = path
+    return executables
+
+
+def default_traces(executable):
+    """Returns the synthetic trace names and the recorded trace files."""
+    output = subprocess.run([executable, "--list"], check=True,
+                            capture_output=True, text=True).stdout
+    names = [line.split()[0] for line in output.splitlines() if line.strip()]
+    return names + sorted(glob.glob(os.path.join(HERE, "traces", "*.trace")))
+
+
+def run(executable, trace):
+    """Replays one trace and returns its results."""
+    output = subprocess.run([executable, trace], check=True,
+                            capture_output=True, text=True).stdout
+    result = json.loads(output)
+    # Name recorded traces by their file name, so results made from different
+    # directories can be compared.
+    result["trace"] = os.path.basename(trace)
+    return result
+
+
+def git_commit():
+    """Returns the commit the kernel was built from, if it is known."""
+    try:
+        return subprocess.run(["git", "-C", HERE, "rev-parse", "HEAD"],
+                              check=True, capture_output=True,
+                              text=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def value(result, *keys):
+    """Returns the value at keys, or None if any level is missing or null."""
+    for key in keys:
+        if result is None:
+            return None
+        result = result.get(key)
+    return result
+
+
+def text(number):
+    if number is None:
+        return "-"
+    if isinstance(number, float):
+        return "%.3f" % number
+    return str(number)
+
+
+def print_table(results):
+    columns = ("heap", "trace", "malloc p50", "malloc p99", "free p50",
+               "free p99", "peak frag", "failures", "first fail live")
+    rows = [columns]
+    for result in results:
+        points = result["failure_points"]
+        rows.append((result["heap"], result["trace"],
+                     text(value(result, "malloc", "p50_ns")),
+                     text(value(result, "malloc", "p99_ns")),
+                     text(value(result, "free", "p50_ns")),
+                     text(value(result, "free", "p99_ns")),
+                     text(result["peak_fragmentation"]),
+                     text(value(result, "malloc", "failures")),
+                     text(points[0]["live_bytes"] if points else None)))
+    widths = [max(len(row[i]) for row in rows) for i in range(len(columns))]
+    for row in rows:
+        print("  ".join(cell.ljust(width) for cell, width in zip(row, widths)).rstrip())
+    print("Times are in nanoseconds.")
+
+
+def regressions(results, baseline, threshold):
+    """Returns a description of each way results are worse than baseline."""
+    earlier = {(r["heap"], r["trace"]): r for r in baseline["results"]}
+    found = []
+    for result in results:
+        old = earlier.get((result["heap"], result["trace"]))
+        if old is None:
+            continue
+        name = "%s %s" % (result["heap"], result["trace"])
+        for function in ("malloc", "free"):
+            new_time = value(result, function, "p99_ns")
+            old_time = value(old, function, "p99_ns")
+            if new_time is not None and old_time:
+                growth = 100.0 * (new_time - old_time) / old_time
+                if growth > threshold:
+                    found.append("%s: %s p99 %d ns, was %d ns (+%.0f%%)" %
+                                 (name, function, new_time, old_time, growth))
+        new_failures = value(result, "malloc", "failures")
+        old_failures = value(old, "malloc", "failures")
+        if old_failures is not None and new_failures > old_failures:
+            found.append("%s: %d failed allocations, was %d" %
+                         (name, new_failures, old_failures))
+        new_frag = result["peak_fragmentation"]
+        old_frag = old["peak_fragmentation"]
+        if new_frag is not None and old_frag is not None and new_frag > old_frag + 0.05:
+            found.append("%s: peak fragmentation %.3f, was %.3f" %
+                         (name, new_frag, old_frag))
+    return found
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("traces", nargs="*",
+                        help="synthetic trace names or recorded trace files")
+    parser.add_argument("--build", default=os.path.join(HERE, "build"),
+                        help="the build directory holding the executables")
+    parser.add_argument("--heaps", default="1,2,3,4,5,6",
+                        help="comma separated heap numbers to run")
+    parser.add_argument("--output", help="write all the results to this file")
+    parser.add_argument("--baseline",
+                        help="results file to check for regressions against")
+    parser.add_argument("--threshold", type=float, default=20.0,
+                        help="percentage a p99 time may grow before it is a regression")
+    args = parser.parse_args()
+
+    executables = find_executables(
+        args.build, [int(heap) for heap in args.heaps.split(",")])
+    if not executables:
+        sys.exit("no heap_bench executables in %s" % args.build)
+
+    traces = args.traces or default_traces(next(iter(executables.values())))
+    results = []
+    for heap, executable in sorted(executables.items()):
+        for trace in traces:
+            results.append(run(executable, trace))
+
+    print_table(results)
+
+    if args.output:
+        document = {
+            "date": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+            "host": platform.node(),
+            "commit": git_commit(),
+            "results": results,
+        }
+        with open(args.output, "w") as output:
+            json.dump(document, output, indent=2)
+            output.write("\n")
+
+    if args.baseline:
+        with open(args.baseline) as baseline:
+            found = regressions(results, json.load(baseline), args.threshold)
+        for line in found:
+            print("regression: " + line)
+        if found:
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,78 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Configuration for the heap trace demo.  The demo runs on the GCC_POSIX port
+ * so the dump can be turned into a flame graph on the development host.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <assert.h>
+
+#define configUSE_PREEMPTION                       1
+#define configUSE_TIME_SLICING                     0
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#define configUSE_TICKLESS_IDLE                    0
+#define configTICK_RATE_HZ                         ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                       8
+#define configMINIMAL_STACK_SIZE                   ( ( configSTACK_DEPTH_TYPE ) 512 )
+#define configMAX_TASK_NAME_LEN                    16
+#define configTICK_TYPE_WIDTH_IN_BITS              TICK_TYPE_WIDTH_32_BITS
+#define configIDLE_SHOULD_YIELD                    1
+#define configSTACK_DEPTH_TYPE                     uint32_t
+
+#define configSUPPORT_STATIC_ALLOCATION            0
+#define configSUPPORT_DYNAMIC_ALLOCATION           1
+#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 256 * 1024 ) )
+
+#define configUSE_IDLE_HOOK                        0
+#define configUSE_TICK_HOOK                        0
+#define configUSE_MALLOC_FAILED_HOOK               0
+#define configCHECK_FOR_STACK_OVERFLOW             0
+
+#define configUSE_TIMERS                           1
+#define configTIMER_TASK_PRIORITY                  ( tskIDLE_PRIORITY + 2 )
+#define configTIMER_QUEUE_LENGTH                   16
+#define configTIMER_TASK_STACK_DEPTH               configMINIMAL_STACK_SIZE
+
+#define configUSE_MUTEXES                          1
+
+#define configUSE_HEAP_TRACE                       1
+#define configHEAP_TRACE_TABLE_SIZE                256
+#define configHEAP_TRACE_SIZE_CLASSES              16
+
+#define configASSERT( x )    assert( x )
+
+#define INCLUDE_vTaskDelete                        1
+#define INCLUDE_vTaskDelay                         1
+#define INCLUDE_xTaskGetSchedulerState             1
+#define INCLUDE_xTaskGetCurrentTaskHandle          1
+
+#endif /* FREERTOS_CONFIG_H */
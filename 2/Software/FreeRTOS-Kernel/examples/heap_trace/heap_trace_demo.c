@@ -0,0 +1,160 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Demonstrates heap tracing.
+ *
+ * A few tasks allocate buffers of different sizes.
+ * One task deletes itself while still holding memory, and one leaks a block on
+ * every pass through its loop.  The demo then prints the full heap trace, and
+ * the allocations made since a checkpoint taken once the tasks had settled,
+ * which holds only the leaked blocks.
+ *
+ * Pipe the output through heap_trace_fold.py, and the result through
+ * flamegraph.pl, to get a flame graph of live heap bytes by task and function.
+ * See README.md.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "heap_trace.h"
+
+#define demoPASSES           20
+#define demoDUMP_LENGTH      ( 32 * 1024 )
+
+#define demoMAIN_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#define demoTASK_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+
+static char cDumpBuffer[ demoDUMP_LENGTH ];
+static void * pvConfiguration;
+
+/*-----------------------------------------------------------*/
+
+/* Holds a few network frames, and frees and reallocates them as it goes. */
+static void prvNetworkTask( void * pvParameters )
+{
+    void * pvFrames[ 4 ] = { NULL };
+    uint32_t ulPass;
+
+    ( void ) pvParameters;
+
+    for( ulPass = 0; ; ulPass++ )
+    {
+        vPortFree( pvFrames[ ulPass % 4U ] );
+        pvFrames[ ulPass % 4U ] = pvPortMalloc( 1500 );
+        vTaskDelay( 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Leaks one record on every pass. */
+static void prvLoggerTask( void * pvParameters )
+{
+    void * pvRecord;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        pvRecord = pvPortMalloc( 96 );
+
+        /* The record should be freed once it has been written out, but it is
+         * not. */
+        ( void ) pvRecord;
+
+        vTaskDelay( 2 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Allocates a workspace and deletes itself without freeing it. */
+static void prvSetupTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    ( void ) pvPortMalloc( 8192 );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintDump( const char * pcTitle,
+                          uint32_t ulSinceSequence )
+{
+    #if ( DEMO_HEAP >= 4 )
+        HeapStats_t xHeapStats;
+        HeapStats_t * pxHeapStats = &xHeapStats;
+
+        vPortGetHeapStats( &xHeapStats );
+    #else
+        HeapStats_t * pxHeapStats = NULL;
+    #endif
+
+    vHeapTraceDump( cDumpBuffer, sizeof( cDumpBuffer ), ulSinceSequence, pxHeapStats );
+    printf( "# %s\n%s", pcTitle, cDumpBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMainTask( void * pvParameters )
+{
+    uint32_t ulCheckpoint;
+
+    ( void ) pvParameters;
+
+    xTaskCreate( prvSetupTask, "setup", configMINIMAL_STACK_SIZE, NULL, demoTASK_PRIORITY, NULL );
+    xTaskCreate( prvNetworkTask, "network", configMINIMAL_STACK_SIZE, NULL, demoTASK_PRIORITY, NULL );
+    xTaskCreate( prvLoggerTask, "logger", configMINIMAL_STACK_SIZE, NULL, demoTASK_PRIORITY, NULL );
+
+    /* Let the tasks allocate their long lived buffers, then take a
+     * checkpoint.  Anything allocated after the checkpoint that is still live
+     * at the end is a leak, or a buffer that has been replaced. */
+    vTaskDelay( 10 );
+    ulCheckpoint = ulHeapTraceGetSequence();
+    vTaskDelay( demoPASSES * 2 );
+
+    prvPrintDump( "all live allocations", 0 );
+    prvPrintDump( "allocations since checkpoint", ulCheckpoint );
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    /* Allocated before the scheduler starts, so it has no owner. */
+    pvConfiguration = pvPortMalloc( 3000 );
+
+    xTaskCreate( prvMainTask, "main", configMINIMAL_STACK_SIZE * 4, NULL, demoMAIN_PRIORITY, NULL );
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Resolve the call sites in a heap trace dump and fold it for flamegraph.pl.
+
+vHeapTraceDump() writes one line per live allocation:
+
+    <task name>;0x<call site address> <bytes>
+
+This script maps each call site address to the function it lies in, using
+addr2line and the executable that produced the dump, merges lines that resolve
+to the same task and function, and writes the result in the folded stack
+format read by flamegraph.pl:
+
+    heap_trace_fold.py build/heap_trace_demo < dump.txt | flamegraph.pl > heap.svg
+
+Lines starting with '#' are comments, apart from the "# image base" line, which
+gives the address the executable was loaded at.  It is needed to resolve the
+call sites of a position independent executable.  Only the first dump in the
+input is used unless --all is given.
+"""
+
+import argparse
+import collections
+import subprocess
+import sys
+
+
+def link_time_image_base(executable):
+    """Returns the address __executable_start was linked at."""
+    output = subprocess.run(["nm", executable], check=True,
+                            capture_output=True, text=True).stdout
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[2] == "__executable_start":
+            return int(fields[0], 16)
+    return 0
+
+
+def resolve(executable, addresses, with_lines):
+    """Maps each address in addresses to a function name."""
+    if not addresses:
+        return {}
+    # Each address is a return address, so look up the byte before it, which
+    # lies in the call instruction.
+    output = subprocess.run(
+        ["addr2line", "-f", "-C", "-e", executable] +
+        ["0x%x" % (address - 1) for address in addresses],
+        check=True, capture_output=True, text=True).stdout.splitlines()
+    names = {}
+    for index, address in enumerate(addresses):
+        function = output[2 * index]
+        location = output[2 * index + 1]
+        if function == "??":
+            function = "0x%x" % address
+        if with_lines and not location.startswith("??"):
+            function += ";" + location.rsplit("/", 1)[-1].split(" ")[0]
+        names[address] = function
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("executable", help="the executable that wrote the dump")
+    parser.add_argument("dump", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="the dump, read from standard input if omitted")
+    parser.add_argument("--lines", action="store_true",
+                        help="add the source file and line as a frame below the function")
+    parser.add_argument("--all", action="store_true",
+                        help="fold every dump in the input, not only the first")
+    args = parser.parse_args()
+
+    runtime_base = None
+    samples = []
+    dumps = 0
+
+    for line in args.dump:
+        line = line.rstrip("\n")
+        if line.startswith("# heap trace:"):
+            dumps += 1
+            if dumps > 1 and not args.all:
+                break
+        if line.startswith("# image base "):
+            runtime_base = int(line.split()[-1], 16)
+        if not line or line.startswith("#"):
+            continue
+        stack, _, size = line.rpartition(" ")
+        task, _, caller = stack.rpartition(";")
+        samples.append((task, int(caller, 16), int(size)))
+
+    # A position independent executable is loaded at a different address to
+    # the one it was linked at, so move the call sites back to link time
+    # addresses before resolving them.
+    offset = 0
+    if runtime_base is not None:
+        offset = link_time_image_base(args.executable) - runtime_base
+
+    addresses = sorted({caller + offset for _, caller, _ in samples})
+    names = resolve(args.executable, addresses, args.lines)
+
+    folded = collections.OrderedDict()
+    for task, caller, size in samples:
+        key = task + ";" + names[caller + offset]
+        folded[key] = folded.get(key, 0) + size
+
+    for key, size in folded.items():
+        print("%s %d" % (key, size))
+
+
+if __name__ == "__main__":
+    main()
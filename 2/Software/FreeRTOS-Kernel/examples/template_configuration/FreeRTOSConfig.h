@@ -155,6 +155,14 @@
  * kernel aware debugger.  Defaults to 0 if left undefined. */
 #define configQUEUE_REGISTRY_SIZE                  0
 
+/* Set configUSE_QUEUE_PERF_COUNTERS to 1 to count the sends, receives and
+ * waits of each queue, semaphore and mutex, readable with
+ * vQueueGetPerfCounters().  configQUEUE_PERF_HISTOGRAM_BUCKETS sets the number
+ * of buckets in the histogram of the time items spend in timestamped queues.
+ * Default to 0 and 8 respectively if left undefined. */
+#define configUSE_QUEUE_PERF_COUNTERS              0
+#define configQUEUE_PERF_HISTOGRAM_BUCKETS         8
+
 /* Set configENABLE_BACKWARD_COMPATIBILITY to 1 to map function names and
  * datatypes from old version of FreeRTOS to their latest equivalent.  Defaults
  * to 1 if left undefined. */
@@ -242,6 +250,54 @@
  * used if configUSE_TIMERS is set to 1. */
 #define configTIMER_QUEUE_LENGTH        10
 
+/* By default active timers are held in lists sorted by expiry time, so the
+ * cost of starting or resetting a timer grows with the number of active timers.
+ * Set configUSE_TIMER_WHEEL to 1 to hold them in a hierarchical timing wheel
+ * instead, which makes starting, stopping and resetting a timer take constant
+ * time and expires all the timers due on a tick as one batch.  The wheel has
+ * configTIMER_WHEEL_LEVELS levels of 2 ^ configTIMER_WHEEL_SLOT_BITS slots, each
+ * slot being a list, so it costs RAM even when few timers are used.  Timers that
+ * expire further away than 2 ^ ( configTIMER_WHEEL_SLOT_BITS *
+ * configTIMER_WHEEL_LEVELS ) ticks are placed again when they come into range.
+ * configUSE_TIMER_WHEEL defaults to 0, configTIMER_WHEEL_SLOT_BITS to 5, and
+ * configTIMER_WHEEL_LEVELS to 4 (3 when TickType_t is 16 bits). */
+#define configUSE_TIMER_WHEEL          0
+#define configTIMER_WHEEL_SLOT_BITS    5
+#define configTIMER_WHEEL_LEVELS       4
+
+/* By default every timer command is a separate message on the timer queue.
+ * Set configUSE_TIMER_COMMAND_COALESCING to 1 to instead record the net effect
+ * of the commands sent to a timer in the timer itself, so the timer service
+ * task processes a burst of commands to the same timer (for example repeated
+ * resets of a debounce timer) as one.  A message is only queued when the timer
+ * service task has no commands pending, so sending a command never blocks and
+ * the xTicksToWait parameter of the timer API functions is not used.  Adds a
+ * pointer, two TickType_t values and a byte to each timer.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_TIMER_COMMAND_COALESCING    0
+
+/* Set configUSE_TIMER_SLACK to 1 to include vTimerSetSlack(), which allows a
+ * timer to be processed up to a given number of ticks after its expiry time.
+ * The timer service task then groups timers with nearby expiry times into a
+ * single wake up, which reduces context switches and, with tickless idle,
+ * lengthens sleep periods.  Adds a TickType_t to each timer.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_TIMER_SLACK                 0
+
+/* configTIMER_SERVICE_TASKS sets the number of timer service tasks.  Each has
+ * its own command queue and active timers, and runs the callbacks of only the
+ * timers assigned to it by xTimerCreateOnService() or
+ * xTimerCreateStaticOnService(), so slow callbacks can be kept out of the way of
+ * time critical ones.  Timer service task 0 runs at configTIMER_TASK_PRIORITY
+ * and is used by xTimerCreate() and xTimerPendFunctionCall().  Timer service
+ * task n runs at configTIMER_SERVICE_TASK_PRIORITY( n ), which defaults to
+ * ( configTIMER_TASK_PRIORITY - n ).  Each task has a stack of
+ * configTIMER_TASK_STACK_DEPTH, a queue of configTIMER_QUEUE_LENGTH and, when
+ * configUSE_TIMER_WHEEL is 1, its own timer wheel.  Task n, for n greater than
+ * 0, is named configTIMER_SERVICE_TASK_NAME followed by n, for example
+ * "Tmr Svc1".  Defaults to 1 if left undefined. */
+#define configTIMER_SERVICE_TASKS             1
+
 /******************************************************************************/
 /* Event Group related definitions. *******************************************/
 /******************************************************************************/
@@ -253,6 +309,23 @@
 
 #define configUSE_EVENT_GROUPS    1
 
+/* By default xEventGroupSetBits() tests the wait condition of every task
+ * blocked on the event group.  Set configEVENT_GROUP_INDEXED_BITS to N to give
+ * each of the event group's N least significant bits its own list of waiting
+ * tasks.  A task that waits for just one of those bits is then unblocked
+ * without being tested, and the other waiting tasks are only tested when a bit
+ * they wait for is set.  Each indexed bit costs one list (20 bytes on a 32-bit
+ * architecture) per event group.  Defaults to 0 if left undefined. */
+#define configEVENT_GROUP_INDEXED_BITS    0
+
+/* By default xEventGroupSetBitsFromISR() defers setting the bits to the timer
+ * task, so requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be
+ * set to 1.  Set configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR to 1 to instead set
+ * the bits, and unblock the waiting tasks, from within the interrupt.  This
+ * removes the timer task from the interrupt to task latency, at the cost of a
+ * longer critical section in the interrupt.  Defaults to 0 if left undefined. */
+#define configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR    0
+
 /******************************************************************************/
 /* Stream Buffer related definitions. *****************************************/
 /******************************************************************************/
@@ -264,6 +337,95 @@
 
 #define configUSE_STREAM_BUFFERS    1
 
+/******************************************************************************/
+/* Mailbox related definitions. ***********************************************/
+/******************************************************************************/
+
+/* Set configUSE_MAILBOXES to 1 to include mailbox (latest value register)
+ * functionality in the build.  Set to 0 to exclude mailbox functionality from
+ * the build.  The FreeRTOS/source/mailbox.c source file must be included in the
+ * build if configUSE_MAILBOXES is set to 1.  Defaults to 0 if left undefined. */
+
+#define configUSE_MAILBOXES                 0
+
+/* Tasks that block in xMailboxWaitForChange() wait on the direct to task
+ * notification at index configMAILBOX_NOTIFICATION_INDEX, which must be less
+ * than configTASK_NOTIFICATION_ARRAY_ENTRIES.  Defaults to 0 if left
+ * undefined. */
+
+#define configMAILBOX_NOTIFICATION_INDEX    0
+
+/******************************************************************************/
+/* Topic related definitions. *************************************************/
+/******************************************************************************/
+
+/* Set configUSE_TOPICS to 1 to include publish/subscribe topic functionality
+ * in the build.  Set to 0 to exclude topic functionality from the build.  The
+ * FreeRTOS/source/topic.c source file must be included in the build if
+ * configUSE_TOPICS is set to 1.  Defaults to 0 if left undefined. */
+
+#define configUSE_TOPICS                  0
+
+/* Subscribers that block in xTopicReceive() wait on the direct to task
+ * notification at index configTOPIC_NOTIFICATION_INDEX, which must be less
+ * than configTASK_NOTIFICATION_ARRAY_ENTRIES.  Defaults to 0 if left
+ * undefined. */
+
+#define configTOPIC_NOTIFICATION_INDEX    0
+
+/******************************************************************************/
+/* Core channel related definitions. ******************************************/
+/******************************************************************************/
+
+/* Set configUSE_CORE_CHANNELS to 1 to include core channel (lock free byte
+ * stream between two cores) functionality in the build.  Set to 0 to exclude
+ * core channel functionality from the build.  The FreeRTOS/source/core_channel.c
+ * source file must be included in the build, and the port must define
+ * portCORE_CHANNEL_SIGNAL(), if configUSE_CORE_CHANNELS is set to 1.  Defaults
+ * to 0 if left undefined. */
+
+#define configUSE_CORE_CHANNELS                  0
+
+/* Tasks that block in xCoreChannelSend() or xCoreChannelReceive() wait on the
+ * direct to task notification at index configCORE_CHANNEL_NOTIFICATION_INDEX,
+ * which must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  Defaults to 0
+ * if left undefined. */
+
+#define configCORE_CHANNEL_NOTIFICATION_INDEX    0
+
+/******************************************************************************/
+/* ISR timer related definitions. *********************************************/
+/******************************************************************************/
+
+/* Set configUSE_ISR_TIMERS to 1 to include ISR timer (microsecond resolution
+ * timers whose callbacks execute in the interrupt raised by a hardware alarm)
+ * functionality in the build.  Set to 0 to exclude ISR timer functionality from
+ * the build.  The FreeRTOS/source/isr_timer.c source file must be included in
+ * the build, and the port must define portISR_TIMER_GET_TIME_US(),
+ * portISR_TIMER_SET_ALARM() and portISR_TIMER_CANCEL_ALARM(), if
+ * configUSE_ISR_TIMERS is set to 1.  Defaults to 0 if left undefined. */
+
+#define configUSE_ISR_TIMERS          0
+
+/* configISR_TIMER_MAX_ACTIVE sets the maximum number of ISR timers that can be
+ * running at once.  Running timers are held in a statically allocated array of
+ * this many pointers, so starting a timer never allocates memory.  Defaults to
+ * 16 if left undefined. */
+
+#define configISR_TIMER_MAX_ACTIVE    16
+
+/* Set configUSE_HIGH_RES_TIMEOUTS to 1 to include xTaskDelayUntilUs(), and
+ * versions of the queue, semaphore and task notification receive and send
+ * functions that take their block time in microseconds, in the build.  Each
+ * task is given an ISR timer that unblocks it at its microsecond wake time, so
+ * periods and timeouts are not rounded to the tick period.  A task blocked with
+ * a microsecond timeout uses one of the configISR_TIMER_MAX_ACTIVE running ISR
+ * timers; if none is free the task is unblocked by the tick instead, up to two
+ * tick periods late.  Requires configUSE_ISR_TIMERS and INCLUDE_xTaskAbortDelay
+ * to be set to 1.  Defaults to 0 if left undefined. */
+
+#define configUSE_HIGH_RES_TIMEOUTS    0
+
 /******************************************************************************/
 /* Memory allocation related definitions. *************************************/
 /******************************************************************************/
@@ -283,9 +445,11 @@
  * https://www.freertos.org/Static_Vs_Dynamic_Memory_Allocation.html. */
 #define configSUPPORT_DYNAMIC_ALLOCATION             1
 
-/* Sets the total size of the FreeRTOS heap, in bytes, when heap_1.c, heap_2.c
- * or heap_4.c are included in the build.  This value is defaulted to 4096 bytes
- * but it must be tailored to each application.  Note the heap will appear in
+/* Sets the total size of the FreeRTOS heap, in bytes, when heap_1.c, heap_2.c,
+ * heap_4.c or heap_6.c are included in the build.  This value is defaulted to
+ * 4096 bytes but it must be tailored to each application.  heap_6.c can be
+ * used without this value defined, in which case all the heap memory comes
+ * from vPortDefineHeapRegions().  Note the heap will appear in
  * the .bss section.  See https://www.freertos.org/a00111.html. */
 #define configTOTAL_HEAP_SIZE                        4096
 
@@ -303,10 +467,119 @@
 #define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP    0
 
 /* Set configENABLE_HEAP_PROTECTOR to 1 to enable bounds checking and
- * obfuscation to internal heap block pointers in heap_4.c and heap_5.c to help
- * catch pointer corruptions. Defaults to 0 if left undefined. */
+ * obfuscation to internal heap block pointers in heap_4.c, heap_5.c and heap_6.c
+ * to help catch pointer corruptions. Defaults to 0 if left undefined. */
 #define configENABLE_HEAP_PROTECTOR                  0
 
+/* heap_6.c splits each power of two range of block sizes into
+ * 2 ^ configHEAP_TLSF_SL_INDEX_COUNT_LOG2 size classes, each with its own free
+ * list.  Larger values waste less memory when a request is rounded up to its
+ * size class, but take more RAM for the list heads.  Must be between 1 and 5.
+ * Defaults to 4 if left undefined. */
+#define configHEAP_TLSF_SL_INDEX_COUNT_LOG2          4
+
+/* heap_6.c blocks, and so heap_6.c regions, must be smaller than
+ * 2 ^ configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2 bytes.  Must not be greater than 31.
+ * Defaults to 24 (16 MiB) if left undefined. */
+#define configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2          24
+
+/* Set configHEAP_USE_BULK_REGIONS to 1 to have heap_6.c keep a second heap for
+ * large memory that is slower to access, such as external PSRAM.  Regions are
+ * added to it with vPortDefineBulkHeapRegions(), and pvPortMallocBulk()
+ * allocates from it.  pvPortMalloc() never does, so the kernel's own objects
+ * stay in internal RAM.  Defaults to 0 if left undefined. */
+#define configHEAP_USE_BULK_REGIONS                  0
+
+/* Set configHEAP_BULK_FALLBACK_TO_FAST to 1 to have pvPortMallocBulk() allocate
+ * from the normal heap when the bulk heap cannot satisfy the request.  Leave it
+ * at 0 to have pvPortMallocBulk() return NULL instead, so large buffers never
+ * take internal RAM needed by task stacks.  Only used when
+ * configHEAP_USE_BULK_REGIONS is 1.  Defaults to 0 if left undefined. */
+#define configHEAP_BULK_FALLBACK_TO_FAST             0
+
+/* Set configHEAP_USE_CORE_CACHES to 1 to have heap_4.c give each core a cache
+ * of small free blocks, so most small allocations and frees only mask the
+ * calling core's interrupts rather than suspending the scheduler, which in SMP
+ * builds serialises the cores.  Caches are refilled from, and returned to, the
+ * heap in batches.  Cannot be used with configUSE_HEAP_TRACE.  Defaults to 0
+ * if left undefined. */
+#define configHEAP_USE_CORE_CACHES                   0
+
+/* configHEAP_CORE_CACHE_CLASSES sets the number of size classes each core
+ * caches.  Size class n holds blocks of ( n + 1 ) times the minimum block size,
+ * which is 16 bytes on 32-bit ports, including the block header.  Defaults to 8
+ * if left undefined. */
+#define configHEAP_CORE_CACHE_CLASSES                8
+
+/* configHEAP_CORE_CACHE_BATCH sets the number of blocks moved between a core
+ * cache and the heap at a time, and configHEAP_CORE_CACHE_DEPTH the number of
+ * blocks of each size class a core cache holds before a batch is returned to
+ * the heap.  Default to 8 and twice configHEAP_CORE_CACHE_BATCH if left
+ * undefined. */
+#define configHEAP_CORE_CACHE_BATCH                  8
+#define configHEAP_CORE_CACHE_DEPTH                  16
+
+/* Set configUSE_OBJECT_POOLS to 1 to have dynamically created task control
+ * blocks, queues (including semaphores and mutexes), software timers and task
+ * stacks allocated from fixed size pools of statically allocated blocks, rather
+ * than from the heap.  Taking a block from a pool and returning it take constant
+ * time, and cannot fragment the heap.  An object is allocated from the heap as
+ * normal if its pool is empty, or too small for it.  The lengths below set the
+ * number of blocks in each pool - a length of 0 disables that pool.
+ * vObjectPoolGetStats() reports how full each pool has been.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_OBJECT_POOLS                       0
+
+/* The number of blocks in the task control block, queue and software timer
+ * pools.  Each defaults to 0 if left undefined. */
+#define configTASK_POOL_LENGTH                       0
+#define configQUEUE_POOL_LENGTH                      0
+#define configTIMER_POOL_LENGTH                      0
+
+/* The number of bytes of item storage each block in the queue pool can hold in
+ * addition to the queue structure itself.  Queues that need more storage are
+ * allocated from the heap.  The default of 0 pools only semaphores and
+ * mutexes.  Defaults to 0 if left undefined. */
+#define configQUEUE_POOL_STORAGE_SIZE                0
+
+/* The depth, in words, and number of blocks of up to three stack pools.  A
+ * task's stack is taken from the smallest pool its depth fits in, or from a
+ * larger pool if that one is empty.  The depths must be in ascending order.
+ * Each defaults to 0 if left undefined. */
+#define configSTACK_POOL_SMALL_DEPTH                 0
+#define configSTACK_POOL_SMALL_LENGTH                0
+#define configSTACK_POOL_MEDIUM_DEPTH                0
+#define configSTACK_POOL_MEDIUM_LENGTH               0
+#define configSTACK_POOL_LARGE_DEPTH                 0
+#define configSTACK_POOL_LARGE_LENGTH                0
+
+/* Set configUSE_ARENAS to 1 to include arenas in the build.  A task allocates
+ * buffers from its arena by advancing an offset, without locking, and frees
+ * them all at once with vArenaReset().  Arenas attached to a task with
+ * xArenaAttachToTask() are deleted when the task is deleted.  arena.c must be
+ * included in the build if configUSE_ARENAS is set to 1.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_ARENAS                             0
+
+/* Set configUSE_HEAP_TRACE to 1 to record every live heap allocation with its
+ * size, owning task and call site, and to keep per size class counters.  The
+ * records can be read with uxHeapTraceGetAllocations() or written out as
+ * folded stacks for a flame graph with vHeapTraceDump().  heap_trace.c must be
+ * included in the build if configUSE_HEAP_TRACE is set to 1.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_HEAP_TRACE                         0
+
+/* configHEAP_TRACE_TABLE_SIZE sets the number of live allocations the heap
+ * trace can record.  Must be a power of two.  Allocations made while the table
+ * is full are counted but not recorded.  Defaults to 128 if left undefined. */
+#define configHEAP_TRACE_TABLE_SIZE                  128
+
+/* configHEAP_TRACE_SIZE_CLASSES sets the number of power of two size classes
+ * the heap trace keeps counters for.  Class N counts blocks of 2^N bytes up to
+ * 2^(N+1) - 1 bytes, and the last class also counts all larger blocks.
+ * Defaults to 16 if left undefined. */
+#define configHEAP_TRACE_SIZE_CLASSES                16
+
 /******************************************************************************/
 /* Interrupt nesting behaviour configuration. *********************************/
 /******************************************************************************/
@@ -637,6 +910,9 @@
 #define configUSE_RECURSIVE_MUTEXES            1
 #define configUSE_COUNTING_SEMAPHORES          1
 #define configUSE_QUEUE_SETS                   0
+#define configUSE_PRIORITY_QUEUES              0
+#define configUSE_TIMESTAMPED_MESSAGES         0
+#define configUSE_STREAM_BUFFER_OVERWRITE      0
 #define configUSE_APPLICATION_TASK_TAG         0
 
 /* USE_POSIX_ERRNO enables the task global FreeRTOS_errno variable which will
@@ -0,0 +1,583 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_trace.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include heap tracing.  This #if is closed at the very bottom of this file.
+ * If you want to include heap tracing then ensure configUSE_HEAP_TRACE is set to
+ * 1 in FreeRTOSConfig.h. */
+#if ( configUSE_HEAP_TRACE == 1 )
+
+    #define htMASK               ( ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE - ( UBaseType_t ) 1 )
+
+/* The longest line vHeapTraceDump() writes. */
+    #define htMAX_LINE_LENGTH    ( configMAX_TASK_NAME_LEN + 64 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the slot of the table at which the search for pvAddress starts.
+ */
+    static UBaseType_t prvHomeSlot( const void * pvAddress ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the slot of the table that holds the record of pvAddress, or
+ * configHEAP_TRACE_TABLE_SIZE if pvAddress is not recorded.
+ */
+    static UBaseType_t prvFindSlot( const void * pvAddress ) PRIVILEGED_FUNCTION;
+
+/*
+ * Empties the slot uxSlot, moving later records of the same probe sequence
+ * back so every record can still be found from its home slot.
+ */
+    static void prvRemoveSlot( UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the histogram size class of a block of xSize bytes.
+ */
+    static UBaseType_t prvSizeClass( size_t xSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Appends pcLine to the buffer at *ppcWriteBuffer if all of it fits in the
+ * *pxBufferLength bytes left, leaving room for the terminator.  Returns pdFALSE
+ * if it does not fit.
+ */
+    static BaseType_t prvAppendLine( char ** ppcWriteBuffer,
+                                     size_t * pxBufferLength,
+                                     const char * pcLine,
+                                     int iLineLength ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The live allocation table.  A slot is empty if its pvAddress is NULL. */
+    PRIVILEGED_DATA static HeapTraceRecord_t xTable[ configHEAP_TRACE_TABLE_SIZE ];
+
+/* The totals and histogram reported by vHeapTraceGetStats(). */
+    PRIVILEGED_DATA static HeapTraceStats_t xStats;
+
+/* The sequence number the next allocation is given.  Starts at 1 so passing 0
+ * as ulSinceSequence selects every allocation. */
+    PRIVILEGED_DATA static uint32_t ulNextSequence = 1U;
+
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvHomeSlot( const void * pvAddress )
+    {
+        uint32_t ulHash;
+
+        /* The low bits of a block address are the same for every block, so
+         * are shifted out before the address is hashed. */
+        ulHash = ( uint32_t ) ( ( ( portPOINTER_SIZE_TYPE ) pvAddress ) >> 3 );
+        ulHash *= 0x9E3779B1UL;
+        ulHash ^= ulHash >> 16;
+
+        return ( UBaseType_t ) ulHash & htMASK;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvFindSlot( const void * pvAddress )
+    {
+        UBaseType_t uxSlot = prvHomeSlot( pvAddress );
+        UBaseType_t uxProbes;
+        UBaseType_t uxReturn = ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE;
+
+        for( uxProbes = 0; uxProbes < ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE; uxProbes++ )
+        {
+            if( xTable[ uxSlot ].pvAddress == pvAddress )
+            {
+                uxReturn = uxSlot;
+                break;
+            }
+            else if( xTable[ uxSlot ].pvAddress == NULL )
+            {
+                /* The end of the probe sequence was reached. */
+                break;
+            }
+            else
+            {
+                uxSlot = ( uxSlot + ( UBaseType_t ) 1 ) & htMASK;
+            }
+        }
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRemoveSlot( UBaseType_t uxSlot )
+    {
+        UBaseType_t uxNext = uxSlot;
+        UBaseType_t uxHome;
+        BaseType_t xStays;
+
+        for( ; ; )
+        {
+            uxNext = ( uxNext + ( UBaseType_t ) 1 ) & htMASK;
+
+            if( ( xTable[ uxNext ].pvAddress == NULL ) || ( uxNext == uxSlot ) )
+            {
+                break;
+            }
+
+            /* The record in uxNext can stay where it is if its home slot lies
+             * cyclically after the empty slot, otherwise it is moved into the
+             * empty slot so it can still be reached from its home slot. */
+            uxHome = prvHomeSlot( xTable[ uxNext ].pvAddress );
+
+            if( uxSlot <= uxNext )
+            {
+                xStays = ( ( uxSlot < uxHome ) && ( uxHome <= uxNext ) ) ? pdTRUE : pdFALSE;
+            }
+            else
+            {
+                xStays = ( ( uxSlot < uxHome ) || ( uxHome <= uxNext ) ) ? pdTRUE : pdFALSE;
+            }
+
+            if( xStays == pdFALSE )
+            {
+                xTable[ uxSlot ] = xTable[ uxNext ];
+                uxSlot = uxNext;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        ( void ) memset( &( xTable[ uxSlot ] ), 0x00, sizeof( HeapTraceRecord_t ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvSizeClass( size_t xSize )
+    {
+        UBaseType_t uxClass = 0;
+
+        while( ( xSize > ( size_t ) 1 ) && ( uxClass < ( ( UBaseType_t ) configHEAP_TRACE_SIZE_CLASSES - ( UBaseType_t ) 1 ) ) )
+        {
+            xSize >>= 1;
+            uxClass++;
+        }
+
+        return uxClass;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvAppendLine( char ** ppcWriteBuffer,
+                                     size_t * pxBufferLength,
+                                     const char * pcLine,
+                                     int iLineLength )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( iLineLength > 0 ) && ( ( size_t ) iLineLength < *pxBufferLength ) )
+        {
+            ( void ) memcpy( *ppcWriteBuffer, pcLine, ( size_t ) iLineLength );
+            *ppcWriteBuffer += iLineLength;
+            *pxBufferLength -= ( size_t ) iLineLength;
+            **ppcWriteBuffer = '\0';
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceMalloc( void * pvAddress,
+                           size_t xSize,
+                           void * pvCaller )
+    {
+        UBaseType_t uxSlot, uxClass;
+
+        /* Called from inside pvPortMalloc() with the scheduler suspended, so
+         * no other task can access the table. */
+        if( pvAddress == NULL )
+        {
+            xStats.xFailedAllocations++;
+        }
+        else if( xStats.uxLiveAllocations >= ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE )
+        {
+            xStats.xUntrackedAllocations++;
+        }
+        else
+        {
+            uxSlot = prvHomeSlot( pvAddress );
+
+            while( xTable[ uxSlot ].pvAddress != NULL )
+            {
+                uxSlot = ( uxSlot + ( UBaseType_t ) 1 ) & htMASK;
+            }
+
+            xTable[ uxSlot ].pvAddress = pvAddress;
+            xTable[ uxSlot ].xSize = xSize;
+            xTable[ uxSlot ].pvCaller = pvCaller;
+            xTable[ uxSlot ].ulSequence = ulNextSequence;
+            xTable[ uxSlot ].xOwnerDeleted = pdFALSE;
+
+            if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+            {
+                xTable[ uxSlot ].xOwner = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                xTable[ uxSlot ].xOwner = NULL;
+            }
+
+            ulNextSequence++;
+
+            uxClass = prvSizeClass( xSize );
+            xStats.uxLiveAllocations++;
+            xStats.xLiveBytes += xSize;
+            xStats.uxLiveAllocationsInClass[ uxClass ]++;
+            xStats.xLiveBytesInClass[ uxClass ] += xSize;
+            xStats.xAllocationsInClass[ uxClass ]++;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceFree( void * pvAddress )
+    {
+        UBaseType_t uxSlot, uxClass;
+        size_t xSize;
+
+        /* Called from inside vPortFree() with the scheduler suspended, so no
+         * other task can access the table.  Blocks that were not recorded
+         * because the table was full are not found, and are ignored.  NULL
+         * would match an empty slot, so is ignored too. */
+        if( pvAddress != NULL )
+        {
+            uxSlot = prvFindSlot( pvAddress );
+        }
+        else
+        {
+            uxSlot = ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE;
+        }
+
+        if( uxSlot < ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE )
+        {
+            xSize = xTable[ uxSlot ].xSize;
+            uxClass = prvSizeClass( xSize );
+            xStats.uxLiveAllocations--;
+            xStats.xLiveBytes -= xSize;
+            xStats.uxLiveAllocationsInClass[ uxClass ]--;
+            xStats.xLiveBytesInClass[ uxClass ] -= xSize;
+
+            prvRemoveSlot( uxSlot );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceTaskDeleted( TaskHandle_t xTask )
+    {
+        UBaseType_t uxSlot;
+
+        traceENTER_vHeapTraceTaskDeleted( xTask );
+
+        vTaskSuspendAll();
+        {
+            for( uxSlot = 0; uxSlot < ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE; uxSlot++ )
+            {
+                if( ( xTable[ uxSlot ].pvAddress != NULL ) && ( xTable[ uxSlot ].xOwner == xTask ) )
+                {
+                    xTable[ uxSlot ].xOwner = NULL;
+                    xTable[ uxSlot ].xOwnerDeleted = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_vHeapTraceTaskDeleted();
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceGetStats( HeapTraceStats_t * pxStats )
+    {
+        traceENTER_vHeapTraceGetStats( pxStats );
+
+        configASSERT( pxStats );
+
+        vTaskSuspendAll();
+        {
+            *pxStats = xStats;
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_vHeapTraceGetStats();
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulHeapTraceGetSequence( void )
+    {
+        traceENTER_ulHeapTraceGetSequence();
+
+        traceRETURN_ulHeapTraceGetSequence( ulNextSequence );
+
+        return ulNextSequence;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxHeapTraceGetAllocations( HeapTraceRecord_t * pxRecords,
+                                           UBaseType_t uxMaxRecords,
+                                           uint32_t ulSinceSequence )
+    {
+        UBaseType_t uxSlot, uxCount = 0;
+
+        traceENTER_uxHeapTraceGetAllocations( pxRecords, uxMaxRecords, ulSinceSequence );
+
+        configASSERT( ( pxRecords != NULL ) || ( uxMaxRecords == 0 ) );
+
+        vTaskSuspendAll();
+        {
+            for( uxSlot = 0; ( uxSlot < ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE ) && ( uxCount < uxMaxRecords ); uxSlot++ )
+            {
+                if( ( xTable[ uxSlot ].pvAddress != NULL ) && ( xTable[ uxSlot ].ulSequence >= ulSinceSequence ) )
+                {
+                    pxRecords[ uxCount ] = xTable[ uxSlot ];
+                    uxCount++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_uxHeapTraceGetAllocations( uxCount );
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxHeapTraceGetFragmentationIndex( const HeapStats_t * pxHeapStats )
+    {
+        UBaseType_t uxReturn = ( UBaseType_t ) 100;
+
+        traceENTER_uxHeapTraceGetFragmentationIndex( pxHeapStats );
+
+        configASSERT( pxHeapStats );
+
+        if( pxHeapStats->xAvailableHeapSpaceInBytes > ( size_t ) 0 )
+        {
+            if( pxHeapStats->xSizeOfLargestFreeBlockInBytes <= ( SIZE_MAX / ( size_t ) 100 ) )
+            {
+                uxReturn = ( UBaseType_t ) ( ( pxHeapStats->xSizeOfLargestFreeBlockInBytes * ( size_t ) 100 ) / pxHeapStats->xAvailableHeapSpaceInBytes );
+            }
+            else
+            {
+                /* Divide first so the multiplication cannot overflow. */
+                uxReturn = ( UBaseType_t ) ( pxHeapStats->xSizeOfLargestFreeBlockInBytes / ( pxHeapStats->xAvailableHeapSpaceInBytes / ( size_t ) 100 ) );
+            }
+
+            if( uxReturn > ( UBaseType_t ) 100 )
+            {
+                uxReturn = ( UBaseType_t ) 100;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_uxHeapTraceGetFragmentationIndex( uxReturn );
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceDump( char * pcWriteBuffer,
+                         size_t xBufferLength,
+                         uint32_t ulSinceSequence,
+                         const HeapStats_t * pxHeapStats )
+    {
+        char cLine[ htMAX_LINE_LENGTH ];
+        char cName[ configMAX_TASK_NAME_LEN ];
+        int iLength;
+        UBaseType_t uxSlot, uxClass, uxChar;
+        BaseType_t xFits = pdTRUE;
+        const char * pcName;
+        size_t xLowest;
+
+        traceENTER_vHeapTraceDump( pcWriteBuffer, xBufferLength, ulSinceSequence, pxHeapStats );
+
+        configASSERT( pcWriteBuffer );
+        configASSERT( xBufferLength > ( size_t ) 0 );
+
+        pcWriteBuffer[ 0 ] = '\0';
+
+        vTaskSuspendAll();
+        {
+            iLength = snprintf( cLine, sizeof( cLine ), "# heap trace: %lu live allocations, %lu bytes, %lu untracked, %lu failed\n",
+                                ( unsigned long ) xStats.uxLiveAllocations,
+                                ( unsigned long ) xStats.xLiveBytes,
+                                ( unsigned long ) xStats.xUntrackedAllocations,
+                                ( unsigned long ) xStats.xFailedAllocations );
+            xFits = prvAppendLine( &pcWriteBuffer, &xBufferLength, cLine, iLength );
+
+            #ifdef portHEAP_TRACE_IMAGE_BASE
+            {
+                /* Call sites are absolute addresses, so a host tool needs to
+                 * know where the executable was loaded to resolve them. */
+                if( xFits != pdFALSE )
+                {
+                    iLength = snprintf( cLine, sizeof( cLine ), "# image base 0x%lx\n",
+                                        ( unsigned long ) ( portPOINTER_SIZE_TYPE ) portHEAP_TRACE_IMAGE_BASE() );
+                    xFits = prvAppendLine( &pcWriteBuffer, &xBufferLength, cLine, iLength );
+                }
+            }
+            #endif /* portHEAP_TRACE_IMAGE_BASE */
+
+            if( ( xFits != pdFALSE ) && ( pxHeapStats != NULL ) )
+            {
+                iLength = snprintf( cLine, sizeof( cLine ), "# fragmentation index %lu (largest free block %lu of %lu free bytes)\n",
+                                    ( unsigned long ) uxHeapTraceGetFragmentationIndex( pxHeapStats ),
+                                    ( unsigned long ) pxHeapStats->xSizeOfLargestFreeBlockInBytes,
+                                    ( unsigned long ) pxHeapStats->xAvailableHeapSpaceInBytes );
+                xFits = prvAppendLine( &pcWriteBuffer, &xBufferLength, cLine, iLength );
+            }
+
+            for( uxClass = 0; ( uxClass < ( UBaseType_t ) configHEAP_TRACE_SIZE_CLASSES ) && ( xFits != pdFALSE ); uxClass++ )
+            {
+                if( xStats.xAllocationsInClass[ uxClass ] > ( size_t ) 0 )
+                {
+                    xLowest = ( uxClass == 0 ) ? ( size_t ) 0 : ( ( size_t ) 1 << uxClass );
+                    iLength = snprintf( cLine, sizeof( cLine ), "# size class %lu+: %lu live, %lu bytes, %lu allocated\n",
+                                        ( unsigned long ) xLowest,
+                                        ( unsigned long ) xStats.uxLiveAllocationsInClass[ uxClass ],
+                                        ( unsigned long ) xStats.xLiveBytesInClass[ uxClass ],
+                                        ( unsigned long ) xStats.xAllocationsInClass[ uxClass ] );
+                    xFits = prvAppendLine( &pcWriteBuffer, &xBufferLength, cLine, iLength );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            for( uxSlot = 0; ( uxSlot < ( UBaseType_t ) configHEAP_TRACE_TABLE_SIZE ) && ( xFits != pdFALSE ); uxSlot++ )
+            {
+                if( ( xTable[ uxSlot ].pvAddress != NULL ) && ( xTable[ uxSlot ].ulSequence >= ulSinceSequence ) )
+                {
+                    if( xTable[ uxSlot ].xOwner != NULL )
+                    {
+                        pcName = pcTaskGetName( xTable[ uxSlot ].xOwner );
+
+                        /* Spaces and semicolons separate the fields of a
+                         * folded stack, so must not appear in the task
+                         * name. */
+                        for( uxChar = 0; ( uxChar < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 1 ) ) && ( pcName[ uxChar ] != '\0' ); uxChar++ )
+                        {
+                            if( ( pcName[ uxChar ] == ' ' ) || ( pcName[ uxChar ] == ';' ) )
+                            {
+                                cName[ uxChar ] = '_';
+                            }
+                            else
+                            {
+                                cName[ uxChar ] = pcName[ uxChar ];
+                            }
+                        }
+
+                        cName[ uxChar ] = '\0';
+                        pcName = cName;
+                    }
+                    else if( xTable[ uxSlot ].xOwnerDeleted != pdFALSE )
+                    {
+                        pcName = "[deleted_task]";
+                    }
+                    else
+                    {
+                        pcName = "[no_task]";
+                    }
+
+                    iLength = snprintf( cLine, sizeof( cLine ), "%s;0x%lx %lu\n",
+                                        pcName,
+                                        ( unsigned long ) ( portPOINTER_SIZE_TYPE ) xTable[ uxSlot ].pvCaller,
+                                        ( unsigned long ) xTable[ uxSlot ].xSize );
+
+                    xFits = prvAppendLine( &pcWriteBuffer, &xBufferLength, cLine, iLength );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_vHeapTraceDump();
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceResetState( void )
+    {
+        traceENTER_vHeapTraceResetState();
+
+        ( void ) memset( xTable, 0x00, sizeof( xTable ) );
+        ( void ) memset( &xStats, 0x00, sizeof( xStats ) );
+        ulNextSequence = 1U;
+
+        traceRETURN_vHeapTraceResetState();
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include heap tracing.  If you want to include heap tracing then ensure
+ * configUSE_HEAP_TRACE is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_HEAP_TRACE == 1 */
@@ -402,6 +402,15 @@
     #define portSOFTWARE_BARRIER()
 #endif
 
+/* portDATA_MEMORY_BARRIER() orders memory accesses as seen by other cores and
+ * bus masters.  It is used by objects that are accessed without a critical
+ * section, such as mailboxes.  Ports that can run on more than one core must
+ * define it to be a hardware barrier - portMEMORY_BARRIER() is only required to
+ * stop the compiler re-ordering accesses. */
+#ifndef portDATA_MEMORY_BARRIER
+    #define portDATA_MEMORY_BARRIER()    portMEMORY_BARRIER()
+#endif
+
 #ifndef configRUN_MULTIPLE_PRIORITIES
     #define configRUN_MULTIPLE_PRIORITIES    0
 #endif
@@ -589,6 +598,19 @@
     #define vQueueAddToRegistry( xQueue, pcName )
     #define vQueueUnregisterQueue( xQueue )
     #define pcQueueGetName( xQueue )
+    #define xQueueGetNextRegistryEntry( puxIndex, pxQueue, ppcQueueName )    ( pdFALSE )
+#endif
+
+#ifndef configUSE_QUEUE_PERF_COUNTERS
+    #define configUSE_QUEUE_PERF_COUNTERS    0
+#endif
+
+#ifndef configQUEUE_PERF_HISTOGRAM_BUCKETS
+    #define configQUEUE_PERF_HISTOGRAM_BUCKETS    8
+#endif
+
+#if ( configQUEUE_PERF_HISTOGRAM_BUCKETS < 1 )
+    #error configQUEUE_PERF_HISTOGRAM_BUCKETS must be at least 1
 #endif
 
 #ifndef configUSE_MINI_LIST_ITEM
@@ -736,6 +758,10 @@
     #define traceQUEUE_CREATE_FAILED( ucQueueType )
 #endif
 
+#ifndef traceQUEUE_ITEM_EXPIRED
+    #define traceQUEUE_ITEM_EXPIRED( pxQueue )
+#endif
+
 #ifndef traceCREATE_MUTEX
     #define traceCREATE_MUTEX( pxNewQueue )
 #endif
@@ -884,6 +910,29 @@
     #define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#if ( configUSE_HEAP_TRACE == 1 )
+
+/* Heap tracing records every allocation and free made through the heap in the
+ * live allocation table kept by heap_trace.c.  The macros are expanded inside
+ * pvPortMalloc(), so portHEAP_TRACE_CALLER() returns the address pvPortMalloc()
+ * was called from. */
+    #ifndef portHEAP_TRACE_CALLER
+        #if defined( __GNUC__ )
+            #define portHEAP_TRACE_CALLER()    __builtin_return_address( 0 )
+        #else
+            #define portHEAP_TRACE_CALLER()    NULL
+        #endif
+    #endif
+
+    #ifndef traceMALLOC
+        #define traceMALLOC( pvAddress, uiSize )    vHeapTraceMalloc( ( pvAddress ), ( size_t ) ( uiSize ), portHEAP_TRACE_CALLER() )
+    #endif
+
+    #ifndef traceFREE
+        #define traceFREE( pvAddress, uiSize )    vHeapTraceFree( pvAddress )
+    #endif
+#endif /* configUSE_HEAP_TRACE */
+
 #ifndef traceMALLOC
     #define traceMALLOC( pvAddress, uiSize )
 #endif
@@ -1028,6 +1077,106 @@
     #define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )
 #endif
 
+#ifndef traceMAILBOX_CREATE
+    #define traceMAILBOX_CREATE( pxMailbox )
+#endif
+
+#ifndef traceMAILBOX_CREATE_FAILED
+    #define traceMAILBOX_CREATE_FAILED()
+#endif
+
+#ifndef traceMAILBOX_DELETE
+    #define traceMAILBOX_DELETE( xMailbox )
+#endif
+
+#ifndef traceMAILBOX_WRITE
+    #define traceMAILBOX_WRITE( xMailbox, ulVersion )
+#endif
+
+#ifndef traceMAILBOX_WRITE_FROM_ISR
+    #define traceMAILBOX_WRITE_FROM_ISR( xMailbox, ulVersion )
+#endif
+
+#ifndef traceBLOCKING_ON_MAILBOX_WAIT
+    #define traceBLOCKING_ON_MAILBOX_WAIT( xMailbox )
+#endif
+
+#ifndef traceTOPIC_CREATE
+    #define traceTOPIC_CREATE( pxTopic )
+#endif
+
+#ifndef traceTOPIC_CREATE_FAILED
+    #define traceTOPIC_CREATE_FAILED()
+#endif
+
+#ifndef traceTOPIC_DELETE
+    #define traceTOPIC_DELETE( xTopic )
+#endif
+
+#ifndef traceTOPIC_PUBLISH
+    #define traceTOPIC_PUBLISH( xTopic )
+#endif
+
+#ifndef traceTOPIC_PUBLISH_FROM_ISR
+    #define traceTOPIC_PUBLISH_FROM_ISR( xTopic )
+#endif
+
+#ifndef traceTOPIC_RECEIVE
+    #define traceTOPIC_RECEIVE( xSubscriber )
+#endif
+
+#ifndef traceTOPIC_RECEIVE_FAILED
+    #define traceTOPIC_RECEIVE_FAILED( xSubscriber )
+#endif
+
+#ifndef traceBLOCKING_ON_TOPIC_RECEIVE
+    #define traceBLOCKING_ON_TOPIC_RECEIVE( xSubscriber )
+#endif
+
+#ifndef traceCORE_CHANNEL_CREATE
+    #define traceCORE_CHANNEL_CREATE( pxCoreChannel )
+#endif
+
+#ifndef traceCORE_CHANNEL_CREATE_FAILED
+    #define traceCORE_CHANNEL_CREATE_FAILED()
+#endif
+
+#ifndef traceCORE_CHANNEL_DELETE
+    #define traceCORE_CHANNEL_DELETE( xCoreChannel )
+#endif
+
+#ifndef traceCORE_CHANNEL_SEND
+    #define traceCORE_CHANNEL_SEND( xCoreChannel, xBytesSent )
+#endif
+
+#ifndef traceCORE_CHANNEL_RECEIVE
+    #define traceCORE_CHANNEL_RECEIVE( xCoreChannel, xReceivedLength )
+#endif
+
+#ifndef traceBLOCKING_ON_CORE_CHANNEL_SEND
+    #define traceBLOCKING_ON_CORE_CHANNEL_SEND( xCoreChannel )
+#endif
+
+#ifndef traceBLOCKING_ON_CORE_CHANNEL_RECEIVE
+    #define traceBLOCKING_ON_CORE_CHANNEL_RECEIVE( xCoreChannel )
+#endif
+
+#ifndef traceISR_TIMER_CREATE
+    #define traceISR_TIMER_CREATE( pxNewTimer )
+#endif
+
+#ifndef traceISR_TIMER_CREATE_FAILED
+    #define traceISR_TIMER_CREATE_FAILED()
+#endif
+
+#ifndef traceISR_TIMER_DELETE
+    #define traceISR_TIMER_DELETE( xTimer )
+#endif
+
+#ifndef traceISR_TIMER_EXPIRED
+    #define traceISR_TIMER_EXPIRED( xTimer )
+#endif
+
 #ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
     #define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )
 #endif
@@ -1040,6 +1189,14 @@
     #define traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer )
 #endif
 
+#ifndef traceSTREAM_BUFFER_MESSAGE_EXPIRED
+    #define traceSTREAM_BUFFER_MESSAGE_EXPIRED( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_DROPPED_OLDEST
+    #define traceSTREAM_BUFFER_DROPPED_OLDEST( xStreamBuffer, xBytesDropped )
+#endif
+
 #ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
     #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
@@ -1196,6 +1353,54 @@
     #define traceRETURN_xQueueGenericCreate( pxNewQueue )
 #endif
 
+#ifndef traceENTER_xQueueCreatePriority
+    #define traceENTER_xQueueCreatePriority( uxQueueLength, uxItemSize, uxPriorityLevels )
+#endif
+
+#ifndef traceRETURN_xQueueCreatePriority
+    #define traceRETURN_xQueueCreatePriority( pxNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreatePriorityStatic
+    #define traceENTER_xQueueCreatePriorityStatic( uxQueueLength, uxItemSize, uxPriorityLevels, pucQueueStorage, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreatePriorityStatic
+    #define traceRETURN_xQueueCreatePriorityStatic( pxNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateTimestamped
+    #define traceENTER_xQueueCreateTimestamped( uxQueueLength, uxItemSize, xMaxItemAge )
+#endif
+
+#ifndef traceRETURN_xQueueCreateTimestamped
+    #define traceRETURN_xQueueCreateTimestamped( pxNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateTimestampedStatic
+    #define traceENTER_xQueueCreateTimestampedStatic( uxQueueLength, uxItemSize, xMaxItemAge, pucQueueStorage, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateTimestampedStatic
+    #define traceRETURN_xQueueCreateTimestampedStatic( pxNewQueue )
+#endif
+
+#ifndef traceENTER_vQueueSetMaxItemAge
+    #define traceENTER_vQueueSetMaxItemAge( xQueue, xMaxItemAge )
+#endif
+
+#ifndef traceRETURN_vQueueSetMaxItemAge
+    #define traceRETURN_vQueueSetMaxItemAge()
+#endif
+
+#ifndef traceENTER_vQueueGetAgeStats
+    #define traceENTER_vQueueGetAgeStats( xQueue, pxAgeStats, xReset )
+#endif
+
+#ifndef traceRETURN_vQueueGetAgeStats
+    #define traceRETURN_vQueueGetAgeStats()
+#endif
+
 #ifndef traceENTER_xQueueCreateMutex
     #define traceENTER_xQueueCreateMutex( ucQueueType )
 #endif
@@ -1468,6 +1673,22 @@
     #define traceRETURN_vQueueUnregisterQueue()
 #endif
 
+#ifndef traceENTER_xQueueGetNextRegistryEntry
+    #define traceENTER_xQueueGetNextRegistryEntry( puxIndex, pxQueue, ppcQueueName )
+#endif
+
+#ifndef traceRETURN_xQueueGetNextRegistryEntry
+    #define traceRETURN_xQueueGetNextRegistryEntry( xReturn )
+#endif
+
+#ifndef traceENTER_vQueueGetPerfCounters
+    #define traceENTER_vQueueGetPerfCounters( xQueue, pxCounters, xReset )
+#endif
+
+#ifndef traceRETURN_vQueueGetPerfCounters
+    #define traceRETURN_vQueueGetPerfCounters()
+#endif
+
 #ifndef traceENTER_vQueueWaitForMessageRestricted
     #define traceENTER_vQueueWaitForMessageRestricted( xQueue, xTicksToWait, xWaitIndefinitely )
 #endif
@@ -1564,6 +1785,38 @@
     #define traceRETURN_xTimerGetTimerDaemonTaskHandle( xTimerTaskHandle )
 #endif
 
+#ifndef traceENTER_xTimerCreateOnService
+    #define traceENTER_xTimerCreateOnService( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, uxTimerService )
+#endif
+
+#ifndef traceRETURN_xTimerCreateOnService
+    #define traceRETURN_xTimerCreateOnService( pxNewTimer )
+#endif
+
+#ifndef traceENTER_xTimerCreateStaticOnService
+    #define traceENTER_xTimerCreateStaticOnService( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer, uxTimerService )
+#endif
+
+#ifndef traceRETURN_xTimerCreateStaticOnService
+    #define traceRETURN_xTimerCreateStaticOnService( pxNewTimer )
+#endif
+
+#ifndef traceENTER_xTimerGetTimerServiceTaskHandle
+    #define traceENTER_xTimerGetTimerServiceTaskHandle( uxTimerService )
+#endif
+
+#ifndef traceRETURN_xTimerGetTimerServiceTaskHandle
+    #define traceRETURN_xTimerGetTimerServiceTaskHandle( xTimerTaskHandle )
+#endif
+
+#ifndef traceENTER_uxTimerGetTimerService
+    #define traceENTER_uxTimerGetTimerService( xTimer )
+#endif
+
+#ifndef traceRETURN_uxTimerGetTimerService
+    #define traceRETURN_uxTimerGetTimerService( uxTimerService )
+#endif
+
 #ifndef traceENTER_xTimerGetPeriod
     #define traceENTER_xTimerGetPeriod( xTimer )
 #endif
@@ -1604,6 +1857,22 @@
     #define traceRETURN_xTimerGetExpiryTime( xReturn )
 #endif
 
+#ifndef traceENTER_vTimerSetSlack
+    #define traceENTER_vTimerSetSlack( xTimer, xSlack )
+#endif
+
+#ifndef traceRETURN_vTimerSetSlack
+    #define traceRETURN_vTimerSetSlack()
+#endif
+
+#ifndef traceENTER_xTimerGetSlack
+    #define traceENTER_xTimerGetSlack( xTimer )
+#endif
+
+#ifndef traceRETURN_xTimerGetSlack
+    #define traceRETURN_xTimerGetSlack( xReturn )
+#endif
+
 #ifndef traceENTER_xTimerGetStaticBuffer
     #define traceENTER_xTimerGetStaticBuffer( xTimer, ppxTimerBuffer )
 #endif
@@ -2088,6 +2357,14 @@
     #define traceRETURN_vTaskRemoveFromUnorderedEventList()
 #endif
 
+#ifndef traceENTER_xTaskRemoveFromUnorderedEventListFromISR
+    #define traceENTER_xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, xItemValue )
+#endif
+
+#ifndef traceRETURN_xTaskRemoveFromUnorderedEventListFromISR
+    #define traceRETURN_xTaskRemoveFromUnorderedEventListFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskSetTimeOutState
     #define traceENTER_vTaskSetTimeOutState( pxTimeOut )
 #endif
@@ -2496,6 +2773,14 @@
     #define traceRETURN_xStreamBufferSendFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_xStreamBufferSendV
+    #define traceENTER_xStreamBufferSendV( xStreamBuffer, pxVectors, xVectorCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSendV
+    #define traceRETURN_xStreamBufferSendV( xReturn )
+#endif
+
 #ifndef traceENTER_xStreamBufferReceive
     #define traceENTER_xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait )
 #endif
@@ -2504,6 +2789,14 @@
     #define traceRETURN_xStreamBufferReceive( xReceivedLength )
 #endif
 
+#ifndef traceENTER_xStreamBufferReceiveV
+    #define traceENTER_xStreamBufferReceiveV( xStreamBuffer, pxVectors, xVectorCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceiveV
+    #define traceRETURN_xStreamBufferReceiveV( xReceivedLength )
+#endif
+
 #ifndef traceENTER_xStreamBufferNextMessageLengthBytes
     #define traceENTER_xStreamBufferNextMessageLengthBytes( xStreamBuffer )
 #endif
@@ -2552,6 +2845,54 @@
     #define traceRETURN_xStreamBufferReceiveCompletedFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_xStreamBufferReserveWrite
+    #define traceENTER_xStreamBufferReserveWrite( xStreamBuffer, xLengthBytes, ppvData, pxContiguousLengthBytes )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReserveWrite
+    #define traceRETURN_xStreamBufferReserveWrite( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferCommitWrite
+    #define traceENTER_xStreamBufferCommitWrite( xStreamBuffer, xLengthBytes )
+#endif
+
+#ifndef traceRETURN_xStreamBufferCommitWrite
+    #define traceRETURN_xStreamBufferCommitWrite( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferCommitWriteFromISR
+    #define traceENTER_xStreamBufferCommitWriteFromISR( xStreamBuffer, xLengthBytes, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferCommitWriteFromISR
+    #define traceRETURN_xStreamBufferCommitWriteFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferPeekRead
+    #define traceENTER_xStreamBufferPeekRead( xStreamBuffer, ppvData )
+#endif
+
+#ifndef traceRETURN_xStreamBufferPeekRead
+    #define traceRETURN_xStreamBufferPeekRead( xContiguousLength )
+#endif
+
+#ifndef traceENTER_xStreamBufferConsume
+    #define traceENTER_xStreamBufferConsume( xStreamBuffer, xLengthBytes )
+#endif
+
+#ifndef traceRETURN_xStreamBufferConsume
+    #define traceRETURN_xStreamBufferConsume( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferConsumeFromISR
+    #define traceENTER_xStreamBufferConsumeFromISR( xStreamBuffer, xLengthBytes, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferConsumeFromISR
+    #define traceRETURN_xStreamBufferConsumeFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_uxStreamBufferGetStreamBufferNotificationIndex
     #define traceENTER_uxStreamBufferGetStreamBufferNotificationIndex( xStreamBuffer )
 #endif
@@ -2592,6 +2933,38 @@
     #define traceRETURN_ucStreamBufferGetStreamBufferType( ucStreamBufferType )
 #endif
 
+#ifndef traceENTER_xStreamBufferSetMaxMessageAge
+    #define traceENTER_xStreamBufferSetMaxMessageAge( xStreamBuffer, xMaxMessageAge )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSetMaxMessageAge
+    #define traceRETURN_xStreamBufferSetMaxMessageAge( xReturn )
+#endif
+
+#ifndef traceENTER_vStreamBufferGetAgeStats
+    #define traceENTER_vStreamBufferGetAgeStats( xStreamBuffer, pxAgeStats, xReset )
+#endif
+
+#ifndef traceRETURN_vStreamBufferGetAgeStats
+    #define traceRETURN_vStreamBufferGetAgeStats()
+#endif
+
+#ifndef traceENTER_xStreamBufferSetOverwrite
+    #define traceENTER_xStreamBufferSetOverwrite( xStreamBuffer, xOverwrite )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSetOverwrite
+    #define traceRETURN_xStreamBufferSetOverwrite( xReturn )
+#endif
+
+#ifndef traceENTER_vStreamBufferGetDroppedCounts
+    #define traceENTER_vStreamBufferGetDroppedCounts( xStreamBuffer, pxBytesDropped, puxMessagesDropped, xReset )
+#endif
+
+#ifndef traceRETURN_vStreamBufferGetDroppedCounts
+    #define traceRETURN_vStreamBufferGetDroppedCounts()
+#endif
+
 #ifndef traceENTER_vListInitialise
     #define traceENTER_vListInitialise( pxList )
 #endif
@@ -2664,141 +3037,981 @@
     #define traceRETURN_xCoRoutineRemoveFromEventList( xReturn )
 #endif
 
-#ifndef configGENERATE_RUN_TIME_STATS
-    #define configGENERATE_RUN_TIME_STATS    0
+#ifndef traceENTER_xMailboxCreate
+    #define traceENTER_xMailboxCreate( xItemSize )
 #endif
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#ifndef traceRETURN_xMailboxCreate
+    #define traceRETURN_xMailboxCreate( xReturn )
+#endif
 
-    #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
-        #error If configGENERATE_RUN_TIME_STATS is defined then portCONFIGURE_TIMER_FOR_RUN_TIME_STATS must also be defined.  portCONFIGURE_TIMER_FOR_RUN_TIME_STATS should call a port layer function to setup a peripheral timer/counter that can then be used as the run time counter time base.
-    #endif /* portCONFIGURE_TIMER_FOR_RUN_TIME_STATS */
+#ifndef traceENTER_xMailboxCreateStatic
+    #define traceENTER_xMailboxCreateStatic( xItemSize, pucMailboxStorage, pxStaticMailbox )
+#endif
 
-    #ifndef portGET_RUN_TIME_COUNTER_VALUE
-        #ifndef portALT_GET_RUN_TIME_COUNTER_VALUE
-            #error If configGENERATE_RUN_TIME_STATS is defined then either portGET_RUN_TIME_COUNTER_VALUE or portALT_GET_RUN_TIME_COUNTER_VALUE must also be defined.  See the examples provided and the FreeRTOS web site for more information.
-        #endif /* portALT_GET_RUN_TIME_COUNTER_VALUE */
-    #endif /* portGET_RUN_TIME_COUNTER_VALUE */
+#ifndef traceRETURN_xMailboxCreateStatic
+    #define traceRETURN_xMailboxCreateStatic( xReturn )
+#endif
 
-#endif /* configGENERATE_RUN_TIME_STATS */
+#ifndef traceENTER_vMailboxDelete
+    #define traceENTER_vMailboxDelete( xMailbox )
+#endif
 
-#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
-    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#ifndef traceRETURN_vMailboxDelete
+    #define traceRETURN_vMailboxDelete()
 #endif
 
-#ifndef portPRIVILEGE_BIT
-    #define portPRIVILEGE_BIT    ( ( UBaseType_t ) 0x00 )
+#ifndef traceENTER_ulMailboxWrite
+    #define traceENTER_ulMailboxWrite( xMailbox, pvItem )
 #endif
 
-#ifndef portYIELD_WITHIN_API
-    #define portYIELD_WITHIN_API    portYIELD
+#ifndef traceRETURN_ulMailboxWrite
+    #define traceRETURN_ulMailboxWrite( ulReturn )
 #endif
 
-#ifndef portSUPPRESS_TICKS_AND_SLEEP
-    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
+#ifndef traceENTER_ulMailboxWriteFromISR
+    #define traceENTER_ulMailboxWriteFromISR( xMailbox, pvItem, pxHigherPriorityTaskWoken )
 #endif
 
-#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
-    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#ifndef traceRETURN_ulMailboxWriteFromISR
+    #define traceRETURN_ulMailboxWriteFromISR( ulReturn )
 #endif
 
-#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
-    #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#ifndef traceENTER_xMailboxRead
+    #define traceENTER_xMailboxRead( xMailbox, pvBuffer, pulVersion )
 #endif
 
-#ifndef configUSE_TICKLESS_IDLE
-    #define configUSE_TICKLESS_IDLE    0
+#ifndef traceRETURN_xMailboxRead
+    #define traceRETURN_xMailboxRead( xReturn )
 #endif
 
-#ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
-    #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
+#ifndef traceENTER_xMailboxReadIfChanged
+    #define traceENTER_xMailboxReadIfChanged( xMailbox, pvBuffer, pulVersion )
 #endif
 
-#ifndef configPRE_SLEEP_PROCESSING
-    #define configPRE_SLEEP_PROCESSING( x )
+#ifndef traceRETURN_xMailboxReadIfChanged
+    #define traceRETURN_xMailboxReadIfChanged( xReturn )
 #endif
 
-#ifndef configPOST_SLEEP_PROCESSING
-    #define configPOST_SLEEP_PROCESSING( x )
+#ifndef traceENTER_ulMailboxGetVersion
+    #define traceENTER_ulMailboxGetVersion( xMailbox )
 #endif
 
-#ifndef configUSE_QUEUE_SETS
-    #define configUSE_QUEUE_SETS    0
+#ifndef traceRETURN_ulMailboxGetVersion
+    #define traceRETURN_ulMailboxGetVersion( ulReturn )
 #endif
 
-#ifndef portTASK_USES_FLOATING_POINT
-    #define portTASK_USES_FLOATING_POINT()
+#ifndef traceENTER_xMailboxWaitForChange
+    #define traceENTER_xMailboxWaitForChange( xMailbox, pvBuffer, pulVersion, xTicksToWait )
 #endif
 
-#ifndef portALLOCATE_SECURE_CONTEXT
-    #define portALLOCATE_SECURE_CONTEXT( ulSecureStackSize )
+#ifndef traceRETURN_xMailboxWaitForChange
+    #define traceRETURN_xMailboxWaitForChange( xReturn )
 #endif
 
-#ifndef portDONT_DISCARD
-    #define portDONT_DISCARD
+#ifndef traceENTER_xTopicCreate
+    #define traceENTER_xTopicCreate( uxLength, uxItemSize )
 #endif
 
-#ifndef configUSE_TIME_SLICING
-    #define configUSE_TIME_SLICING    1
+#ifndef traceRETURN_xTopicCreate
+    #define traceRETURN_xTopicCreate( xReturn )
 #endif
 
-#ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
-    #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
+#ifndef traceENTER_xTopicCreateStatic
+    #define traceENTER_xTopicCreateStatic( uxLength, uxItemSize, pucTopicStorage, pxStaticTopic )
 #endif
 
-#ifndef configUSE_STATS_FORMATTING_FUNCTIONS
-    #define configUSE_STATS_FORMATTING_FUNCTIONS    0
+#ifndef traceRETURN_xTopicCreateStatic
+    #define traceRETURN_xTopicCreateStatic( xReturn )
 #endif
 
-#ifndef portASSERT_IF_INTERRUPT_PRIORITY_INVALID
-    #define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()
+#ifndef traceENTER_vTopicDelete
+    #define traceENTER_vTopicDelete( xTopic )
 #endif
 
-#ifndef configUSE_TRACE_FACILITY
-    #define configUSE_TRACE_FACILITY    0
+#ifndef traceRETURN_vTopicDelete
+    #define traceRETURN_vTopicDelete()
 #endif
 
-#ifndef mtCOVERAGE_TEST_MARKER
-    #define mtCOVERAGE_TEST_MARKER()
+#ifndef traceENTER_xTopicSubscribe
+    #define traceENTER_xTopicSubscribe( xTopic )
 #endif
 
-#ifndef mtCOVERAGE_TEST_DELAY
-    #define mtCOVERAGE_TEST_DELAY()
+#ifndef traceRETURN_xTopicSubscribe
+    #define traceRETURN_xTopicSubscribe( xReturn )
 #endif
 
-#ifndef portASSERT_IF_IN_ISR
-    #define portASSERT_IF_IN_ISR()
+#ifndef traceENTER_xTopicSubscribeStatic
+    #define traceENTER_xTopicSubscribeStatic( xTopic, pxStaticSubscriber )
 #endif
 
-#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
-    #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#ifndef traceRETURN_xTopicSubscribeStatic
+    #define traceRETURN_xTopicSubscribeStatic( xReturn )
 #endif
 
-#ifndef configAPPLICATION_ALLOCATED_HEAP
-    #define configAPPLICATION_ALLOCATED_HEAP    0
+#ifndef traceENTER_vTopicUnsubscribe
+    #define traceENTER_vTopicUnsubscribe( xSubscriber )
 #endif
 
-#ifndef configENABLE_HEAP_PROTECTOR
-    #define configENABLE_HEAP_PROTECTOR    0
+#ifndef traceRETURN_vTopicUnsubscribe
+    #define traceRETURN_vTopicUnsubscribe()
 #endif
 
-#ifndef configUSE_TASK_NOTIFICATIONS
-    #define configUSE_TASK_NOTIFICATIONS    1
+#ifndef traceENTER_vTopicPublish
+    #define traceENTER_vTopicPublish( xTopic, pvItem )
 #endif
 
-#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
-    #define configTASK_NOTIFICATION_ARRAY_ENTRIES    1
+#ifndef traceRETURN_vTopicPublish
+    #define traceRETURN_vTopicPublish()
 #endif
 
-#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
-    #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#ifndef traceENTER_vTopicPublishFromISR
+    #define traceENTER_vTopicPublishFromISR( xTopic, pvItem, pxHigherPriorityTaskWoken )
 #endif
 
-#ifndef configUSE_POSIX_ERRNO
-    #define configUSE_POSIX_ERRNO    0
+#ifndef traceRETURN_vTopicPublishFromISR
+    #define traceRETURN_vTopicPublishFromISR()
 #endif
 
-#ifndef configUSE_SB_COMPLETED_CALLBACK
+#ifndef traceENTER_xTopicReceive
+    #define traceENTER_xTopicReceive( xSubscriber, pvBuffer, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xTopicReceive
+    #define traceRETURN_xTopicReceive( xReturn )
+#endif
+
+#ifndef traceENTER_uxTopicMessagesWaiting
+    #define traceENTER_uxTopicMessagesWaiting( xSubscriber )
+#endif
+
+#ifndef traceRETURN_uxTopicMessagesWaiting
+    #define traceRETURN_uxTopicMessagesWaiting( uxReturn )
+#endif
+
+#ifndef traceENTER_ulTopicGetOverrunCount
+    #define traceENTER_ulTopicGetOverrunCount( xSubscriber )
+#endif
+
+#ifndef traceRETURN_ulTopicGetOverrunCount
+    #define traceRETURN_ulTopicGetOverrunCount( ulReturn )
+#endif
+
+#ifndef traceENTER_xCoreChannelCreate
+    #define traceENTER_xCoreChannelCreate( xBufferSizeBytes )
+#endif
+
+#ifndef traceRETURN_xCoreChannelCreate
+    #define traceRETURN_xCoreChannelCreate( xReturn )
+#endif
+
+#ifndef traceENTER_xCoreChannelCreateStatic
+    #define traceENTER_xCoreChannelCreateStatic( xBufferSizeBytes, pucChannelStorage, pxStaticChannel )
+#endif
+
+#ifndef traceRETURN_xCoreChannelCreateStatic
+    #define traceRETURN_xCoreChannelCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_vCoreChannelDelete
+    #define traceENTER_vCoreChannelDelete( xCoreChannel )
+#endif
+
+#ifndef traceRETURN_vCoreChannelDelete
+    #define traceRETURN_vCoreChannelDelete()
+#endif
+
+#ifndef traceENTER_xCoreChannelSend
+    #define traceENTER_xCoreChannelSend( xCoreChannel, pvTxData, xDataLengthBytes, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xCoreChannelSend
+    #define traceRETURN_xCoreChannelSend( xReturn )
+#endif
+
+#ifndef traceENTER_xCoreChannelReceive
+    #define traceENTER_xCoreChannelReceive( xCoreChannel, pvRxData, xBufferLengthBytes, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xCoreChannelReceive
+    #define traceRETURN_xCoreChannelReceive( xReturn )
+#endif
+
+#ifndef traceENTER_xCoreChannelBytesAvailable
+    #define traceENTER_xCoreChannelBytesAvailable( xCoreChannel )
+#endif
+
+#ifndef traceRETURN_xCoreChannelBytesAvailable
+    #define traceRETURN_xCoreChannelBytesAvailable( xReturn )
+#endif
+
+#ifndef traceENTER_xCoreChannelSpacesAvailable
+    #define traceENTER_xCoreChannelSpacesAvailable( xCoreChannel )
+#endif
+
+#ifndef traceRETURN_xCoreChannelSpacesAvailable
+    #define traceRETURN_xCoreChannelSpacesAvailable( xReturn )
+#endif
+
+#ifndef traceENTER_vCoreChannelHandleSignalFromISR
+    #define traceENTER_vCoreChannelHandleSignalFromISR( pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_vCoreChannelHandleSignalFromISR
+    #define traceRETURN_vCoreChannelHandleSignalFromISR()
+#endif
+
+#ifndef traceENTER_xISRTimerCreate
+    #define traceENTER_xISRTimerCreate( pxCallbackFunction, pvTimerID )
+#endif
+
+#ifndef traceRETURN_xISRTimerCreate
+    #define traceRETURN_xISRTimerCreate( xReturn )
+#endif
+
+#ifndef traceENTER_xISRTimerCreateStatic
+    #define traceENTER_xISRTimerCreateStatic( pxCallbackFunction, pvTimerID, pxTimerBuffer )
+#endif
+
+#ifndef traceRETURN_xISRTimerCreateStatic
+    #define traceRETURN_xISRTimerCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_vISRTimerDelete
+    #define traceENTER_vISRTimerDelete( xTimer )
+#endif
+
+#ifndef traceRETURN_vISRTimerDelete
+    #define traceRETURN_vISRTimerDelete()
+#endif
+
+#ifndef traceENTER_xISRTimerStart
+    #define traceENTER_xISRTimerStart( xTimer, ullExpiryTimeUs, ulPeriodUs )
+#endif
+
+#ifndef traceRETURN_xISRTimerStart
+    #define traceRETURN_xISRTimerStart( xReturn )
+#endif
+
+#ifndef traceENTER_xISRTimerStartFromISR
+    #define traceENTER_xISRTimerStartFromISR( xTimer, ullExpiryTimeUs, ulPeriodUs )
+#endif
+
+#ifndef traceRETURN_xISRTimerStartFromISR
+    #define traceRETURN_xISRTimerStartFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xISRTimerStop
+    #define traceENTER_xISRTimerStop( xTimer )
+#endif
+
+#ifndef traceRETURN_xISRTimerStop
+    #define traceRETURN_xISRTimerStop( xReturn )
+#endif
+
+#ifndef traceENTER_xISRTimerStopFromISR
+    #define traceENTER_xISRTimerStopFromISR( xTimer )
+#endif
+
+#ifndef traceRETURN_xISRTimerStopFromISR
+    #define traceRETURN_xISRTimerStopFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xISRTimerIsActive
+    #define traceENTER_xISRTimerIsActive( xTimer )
+#endif
+
+#ifndef traceRETURN_xISRTimerIsActive
+    #define traceRETURN_xISRTimerIsActive( xReturn )
+#endif
+
+#ifndef traceENTER_pvISRTimerGetTimerID
+    #define traceENTER_pvISRTimerGetTimerID( xTimer )
+#endif
+
+#ifndef traceRETURN_pvISRTimerGetTimerID
+    #define traceRETURN_pvISRTimerGetTimerID( pvReturn )
+#endif
+
+#ifndef traceENTER_ullISRTimerGetExpiryTime
+    #define traceENTER_ullISRTimerGetExpiryTime( xTimer )
+#endif
+
+#ifndef traceRETURN_ullISRTimerGetExpiryTime
+    #define traceRETURN_ullISRTimerGetExpiryTime( ullReturn )
+#endif
+
+#ifndef traceENTER_ulISRTimerGetOverrunCount
+    #define traceENTER_ulISRTimerGetOverrunCount( xTimer )
+#endif
+
+#ifndef traceRETURN_ulISRTimerGetOverrunCount
+    #define traceRETURN_ulISRTimerGetOverrunCount( ulReturn )
+#endif
+
+#ifndef traceENTER_ullISRTimerGetTimeUs
+    #define traceENTER_ullISRTimerGetTimeUs()
+#endif
+
+#ifndef traceRETURN_ullISRTimerGetTimeUs
+    #define traceRETURN_ullISRTimerGetTimeUs( ullReturn )
+#endif
+
+#ifndef traceENTER_vISRTimerHandleAlarmFromISR
+    #define traceENTER_vISRTimerHandleAlarmFromISR( pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_vISRTimerHandleAlarmFromISR
+    #define traceRETURN_vISRTimerHandleAlarmFromISR()
+#endif
+
+#ifndef traceENTER_xTaskDelayUntilUs
+    #define traceENTER_xTaskDelayUntilUs( pullPreviousWakeTimeUs, ulTimeIncrementUs )
+#endif
+
+#ifndef traceRETURN_xTaskDelayUntilUs
+    #define traceRETURN_xTaskDelayUntilUs( xShouldDelay )
+#endif
+
+#ifndef traceENTER_xTaskGenericNotifyWaitUs
+    #define traceENTER_xTaskGenericNotifyWaitUs( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, ulTimeoutUs )
+#endif
+
+#ifndef traceRETURN_xTaskGenericNotifyWaitUs
+    #define traceRETURN_xTaskGenericNotifyWaitUs( xReturn )
+#endif
+
+#ifndef traceENTER_ulTaskGenericNotifyTakeUs
+    #define traceENTER_ulTaskGenericNotifyTakeUs( uxIndexToWaitOn, xClearCountOnExit, ulTimeoutUs )
+#endif
+
+#ifndef traceRETURN_ulTaskGenericNotifyTakeUs
+    #define traceRETURN_ulTaskGenericNotifyTakeUs( ulReturn )
+#endif
+
+#ifndef traceENTER_xTaskBeginTimeoutUs
+    #define traceENTER_xTaskBeginTimeoutUs( ullWakeTimeUs )
+#endif
+
+#ifndef traceRETURN_xTaskBeginTimeoutUs
+    #define traceRETURN_xTaskBeginTimeoutUs( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskEndTimeoutUs
+    #define traceENTER_vTaskEndTimeoutUs()
+#endif
+
+#ifndef traceRETURN_vTaskEndTimeoutUs
+    #define traceRETURN_vTaskEndTimeoutUs()
+#endif
+
+#ifndef traceENTER_xQueueGenericSendUs
+    #define traceENTER_xQueueGenericSendUs( xQueue, pvItemToQueue, ulTimeoutUs, xCopyPosition )
+#endif
+
+#ifndef traceRETURN_xQueueGenericSendUs
+    #define traceRETURN_xQueueGenericSendUs( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveUs
+    #define traceENTER_xQueueReceiveUs( xQueue, pvBuffer, ulTimeoutUs )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveUs
+    #define traceRETURN_xQueueReceiveUs( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSemaphoreTakeUs
+    #define traceENTER_xQueueSemaphoreTakeUs( xQueue, ulTimeoutUs )
+#endif
+
+#ifndef traceRETURN_xQueueSemaphoreTakeUs
+    #define traceRETURN_xQueueSemaphoreTakeUs( xReturn )
+#endif
+
+#ifndef traceENTER_pvObjectPoolMalloc
+    #define traceENTER_pvObjectPoolMalloc( ePool, xWantedSize )
+#endif
+
+#ifndef traceRETURN_pvObjectPoolMalloc
+    #define traceRETURN_pvObjectPoolMalloc( pvReturn )
+#endif
+
+#ifndef traceENTER_vObjectPoolFree
+    #define traceENTER_vObjectPoolFree( pv )
+#endif
+
+#ifndef traceRETURN_vObjectPoolFree
+    #define traceRETURN_vObjectPoolFree()
+#endif
+
+#ifndef traceENTER_pvObjectPoolMallocStack
+    #define traceENTER_pvObjectPoolMallocStack( xWantedSize )
+#endif
+
+#ifndef traceRETURN_pvObjectPoolMallocStack
+    #define traceRETURN_pvObjectPoolMallocStack( pvReturn )
+#endif
+
+#ifndef traceENTER_vObjectPoolFreeStack
+    #define traceENTER_vObjectPoolFreeStack( pv )
+#endif
+
+#ifndef traceRETURN_vObjectPoolFreeStack
+    #define traceRETURN_vObjectPoolFreeStack()
+#endif
+
+#ifndef traceENTER_vObjectPoolGetStats
+    #define traceENTER_vObjectPoolGetStats( ePool, pxPoolStats )
+#endif
+
+#ifndef traceRETURN_vObjectPoolGetStats
+    #define traceRETURN_vObjectPoolGetStats()
+#endif
+
+#ifndef traceENTER_xArenaCreate
+    #define traceENTER_xArenaCreate( xSizeInBytes )
+#endif
+
+#ifndef traceRETURN_xArenaCreate
+    #define traceRETURN_xArenaCreate( xReturn )
+#endif
+
+#ifndef traceENTER_xArenaCreateStatic
+    #define traceENTER_xArenaCreateStatic( xSizeInBytes, pucArenaStorage, pxStaticArena )
+#endif
+
+#ifndef traceRETURN_xArenaCreateStatic
+    #define traceRETURN_xArenaCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_vArenaDelete
+    #define traceENTER_vArenaDelete( xArena )
+#endif
+
+#ifndef traceRETURN_vArenaDelete
+    #define traceRETURN_vArenaDelete()
+#endif
+
+#ifndef traceENTER_pvArenaMalloc
+    #define traceENTER_pvArenaMalloc( xArena, xWantedSize )
+#endif
+
+#ifndef traceRETURN_pvArenaMalloc
+    #define traceRETURN_pvArenaMalloc( pvReturn )
+#endif
+
+#ifndef traceENTER_vArenaReset
+    #define traceENTER_vArenaReset( xArena )
+#endif
+
+#ifndef traceRETURN_vArenaReset
+    #define traceRETURN_vArenaReset()
+#endif
+
+#ifndef traceENTER_xArenaGetFreeSize
+    #define traceENTER_xArenaGetFreeSize( xArena )
+#endif
+
+#ifndef traceRETURN_xArenaGetFreeSize
+    #define traceRETURN_xArenaGetFreeSize( xReturn )
+#endif
+
+#ifndef traceENTER_xArenaGetMinimumEverFreeSize
+    #define traceENTER_xArenaGetMinimumEverFreeSize( xArena )
+#endif
+
+#ifndef traceRETURN_xArenaGetMinimumEverFreeSize
+    #define traceRETURN_xArenaGetMinimumEverFreeSize( xReturn )
+#endif
+
+#ifndef traceENTER_xArenaAttachToTask
+    #define traceENTER_xArenaAttachToTask( xArena, xTask )
+#endif
+
+#ifndef traceRETURN_xArenaAttachToTask
+    #define traceRETURN_xArenaAttachToTask( xReturn )
+#endif
+
+#ifndef traceENTER_vArenaDetachFromTask
+    #define traceENTER_vArenaDetachFromTask( xArena )
+#endif
+
+#ifndef traceRETURN_vArenaDetachFromTask
+    #define traceRETURN_vArenaDetachFromTask()
+#endif
+
+#ifndef traceENTER_vHeapTraceTaskDeleted
+    #define traceENTER_vHeapTraceTaskDeleted( xTask )
+#endif
+
+#ifndef traceRETURN_vHeapTraceTaskDeleted
+    #define traceRETURN_vHeapTraceTaskDeleted()
+#endif
+
+#ifndef traceENTER_vHeapTraceGetStats
+    #define traceENTER_vHeapTraceGetStats( pxStats )
+#endif
+
+#ifndef traceRETURN_vHeapTraceGetStats
+    #define traceRETURN_vHeapTraceGetStats()
+#endif
+
+#ifndef traceENTER_ulHeapTraceGetSequence
+    #define traceENTER_ulHeapTraceGetSequence()
+#endif
+
+#ifndef traceRETURN_ulHeapTraceGetSequence
+    #define traceRETURN_ulHeapTraceGetSequence( ulReturn )
+#endif
+
+#ifndef traceENTER_uxHeapTraceGetAllocations
+    #define traceENTER_uxHeapTraceGetAllocations( pxRecords, uxMaxRecords, ulSinceSequence )
+#endif
+
+#ifndef traceRETURN_uxHeapTraceGetAllocations
+    #define traceRETURN_uxHeapTraceGetAllocations( uxReturn )
+#endif
+
+#ifndef traceENTER_uxHeapTraceGetFragmentationIndex
+    #define traceENTER_uxHeapTraceGetFragmentationIndex( pxHeapStats )
+#endif
+
+#ifndef traceRETURN_uxHeapTraceGetFragmentationIndex
+    #define traceRETURN_uxHeapTraceGetFragmentationIndex( uxReturn )
+#endif
+
+#ifndef traceENTER_vHeapTraceDump
+    #define traceENTER_vHeapTraceDump( pcWriteBuffer, xBufferLength, ulSinceSequence, pxHeapStats )
+#endif
+
+#ifndef traceRETURN_vHeapTraceDump
+    #define traceRETURN_vHeapTraceDump()
+#endif
+
+#ifndef traceENTER_vHeapTraceResetState
+    #define traceENTER_vHeapTraceResetState()
+#endif
+
+#ifndef traceRETURN_vHeapTraceResetState
+    #define traceRETURN_vHeapTraceResetState()
+#endif
+
+#ifndef configGENERATE_RUN_TIME_STATS
+    #define configGENERATE_RUN_TIME_STATS    0
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+        #error If configGENERATE_RUN_TIME_STATS is defined then portCONFIGURE_TIMER_FOR_RUN_TIME_STATS must also be defined.  portCONFIGURE_TIMER_FOR_RUN_TIME_STATS should call a port layer function to setup a peripheral timer/counter that can then be used as the run time counter time base.
+    #endif /* portCONFIGURE_TIMER_FOR_RUN_TIME_STATS */
+
+    #ifndef portGET_RUN_TIME_COUNTER_VALUE
+        #ifndef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #error If configGENERATE_RUN_TIME_STATS is defined then either portGET_RUN_TIME_COUNTER_VALUE or portALT_GET_RUN_TIME_COUNTER_VALUE must also be defined.  See the examples provided and the FreeRTOS web site for more information.
+        #endif /* portALT_GET_RUN_TIME_COUNTER_VALUE */
+    #endif /* portGET_RUN_TIME_COUNTER_VALUE */
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#endif
+
+#ifndef portPRIVILEGE_BIT
+    #define portPRIVILEGE_BIT    ( ( UBaseType_t ) 0x00 )
+#endif
+
+#ifndef portYIELD_WITHIN_API
+    #define portYIELD_WITHIN_API    portYIELD
+#endif
+
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
+#endif
+
+#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#endif
+
+#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
+    #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#endif
+
+#ifndef configUSE_TICKLESS_IDLE
+    #define configUSE_TICKLESS_IDLE    0
+#endif
+
+#ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
+    #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configPRE_SLEEP_PROCESSING
+    #define configPRE_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configPOST_SLEEP_PROCESSING
+    #define configPOST_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configUSE_QUEUE_SETS
+    #define configUSE_QUEUE_SETS    0
+#endif
+
+#ifndef configUSE_PRIORITY_QUEUES
+    #define configUSE_PRIORITY_QUEUES    0
+#endif
+
+#ifndef configUSE_TIMESTAMPED_MESSAGES
+    #define configUSE_TIMESTAMPED_MESSAGES    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_OVERWRITE
+    #define configUSE_STREAM_BUFFER_OVERWRITE    0
+#endif
+
+#ifndef configEVENT_GROUP_INDEXED_BITS
+    #define configEVENT_GROUP_INDEXED_BITS    0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR
+    #define configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR    0
+#endif
+
+#if ( configEVENT_GROUP_INDEXED_BITS < 0 )
+    #error configEVENT_GROUP_INDEXED_BITS must not be negative.
+#elif ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS ) && ( configEVENT_GROUP_INDEXED_BITS > 8 ) )
+    #error configEVENT_GROUP_INDEXED_BITS must not exceed the 8 event bits available when TickType_t is 16 bits.
+#elif ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS ) && ( configEVENT_GROUP_INDEXED_BITS > 24 ) )
+    #error configEVENT_GROUP_INDEXED_BITS must not exceed the 24 event bits available when TickType_t is 32 bits.
+#elif ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_64_BITS ) && ( configEVENT_GROUP_INDEXED_BITS > 56 ) )
+    #error configEVENT_GROUP_INDEXED_BITS must not exceed the 56 event bits available when TickType_t is 64 bits.
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+    #define configTIMER_WHEEL_SLOT_BITS    5
+#endif
+
+#ifndef configTIMER_WHEEL_LEVELS
+    #if ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS )
+        #define configTIMER_WHEEL_LEVELS    3
+    #else
+        #define configTIMER_WHEEL_LEVELS    4
+    #endif
+#endif
+
+#ifndef configUSE_TIMER_COMMAND_COALESCING
+    #define configUSE_TIMER_COMMAND_COALESCING    0
+#endif
+
+#ifndef configUSE_TIMER_SLACK
+    #define configUSE_TIMER_SLACK    0
+#endif
+
+#ifndef configTIMER_SERVICE_TASKS
+    #define configTIMER_SERVICE_TASKS    1
+#endif
+
+#ifndef configTIMER_SERVICE_TASK_PRIORITY
+    #define configTIMER_SERVICE_TASK_PRIORITY( uxTimerService )    ( ( UBaseType_t ) configTIMER_TASK_PRIORITY - ( UBaseType_t ) ( uxTimerService ) )
+#endif
+
+#if ( ( configTIMER_SERVICE_TASKS < 1 ) || ( configTIMER_SERVICE_TASKS > 255 ) )
+    #error configTIMER_SERVICE_TASKS must be between 1 and 255.
+#endif
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+    #if ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 8 ) )
+        #error configTIMER_WHEEL_SLOT_BITS must be between 1 and 8.
+    #endif
+
+    #if ( configTIMER_WHEEL_LEVELS < 1 )
+        #error configTIMER_WHEEL_LEVELS must be at least 1.
+    #endif
+
+    #if ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS ) && ( ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) >= 16 ) )
+        #error configTIMER_WHEEL_SLOT_BITS multiplied by configTIMER_WHEEL_LEVELS must be less than the 16 bits of TickType_t.
+    #elif ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS ) && ( ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) >= 32 ) )
+        #error configTIMER_WHEEL_SLOT_BITS multiplied by configTIMER_WHEEL_LEVELS must be less than the 32 bits of TickType_t.
+    #elif ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_64_BITS ) && ( ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) >= 64 ) )
+        #error configTIMER_WHEEL_SLOT_BITS multiplied by configTIMER_WHEEL_LEVELS must be less than the 64 bits of TickType_t.
+    #endif
+#endif /* configUSE_TIMER_WHEEL */
+
+#ifndef portTASK_USES_FLOATING_POINT
+    #define portTASK_USES_FLOATING_POINT()
+#endif
+
+#ifndef portALLOCATE_SECURE_CONTEXT
+    #define portALLOCATE_SECURE_CONTEXT( ulSecureStackSize )
+#endif
+
+#ifndef portDONT_DISCARD
+    #define portDONT_DISCARD
+#endif
+
+#ifndef configUSE_TIME_SLICING
+    #define configUSE_TIME_SLICING    1
+#endif
+
+#ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
+    #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
+#endif
+
+#ifndef configUSE_STATS_FORMATTING_FUNCTIONS
+    #define configUSE_STATS_FORMATTING_FUNCTIONS    0
+#endif
+
+#ifndef portASSERT_IF_INTERRUPT_PRIORITY_INVALID
+    #define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()
+#endif
+
+#ifndef configUSE_TRACE_FACILITY
+    #define configUSE_TRACE_FACILITY    0
+#endif
+
+#ifndef mtCOVERAGE_TEST_MARKER
+    #define mtCOVERAGE_TEST_MARKER()
+#endif
+
+#ifndef mtCOVERAGE_TEST_DELAY
+    #define mtCOVERAGE_TEST_DELAY()
+#endif
+
+#ifndef portASSERT_IF_IN_ISR
+    #define portASSERT_IF_IN_ISR()
+#endif
+
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+    #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#endif
+
+#ifndef configAPPLICATION_ALLOCATED_HEAP
+    #define configAPPLICATION_ALLOCATED_HEAP    0
+#endif
+
+#ifndef configENABLE_HEAP_PROTECTOR
+    #define configENABLE_HEAP_PROTECTOR    0
+#endif
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+    #define configUSE_TASK_NOTIFICATIONS    1
+#endif
+
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #define configTASK_NOTIFICATION_ARRAY_ENTRIES    1
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+    #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
+#ifndef configUSE_MAILBOXES
+    #define configUSE_MAILBOXES    0
+#endif
+
+#ifndef configMAILBOX_NOTIFICATION_INDEX
+    #define configMAILBOX_NOTIFICATION_INDEX    0
+#endif
+
+#if ( configUSE_MAILBOXES == 1 )
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use mailboxes.
+    #endif
+
+    #if ( configMAILBOX_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+        #error configMAILBOX_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #endif
+#endif
+
+#ifndef configUSE_TOPICS
+    #define configUSE_TOPICS    0
+#endif
+
+#ifndef configTOPIC_NOTIFICATION_INDEX
+    #define configTOPIC_NOTIFICATION_INDEX    0
+#endif
+
+#if ( configUSE_TOPICS == 1 )
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use topics.
+    #endif
+
+    #if ( configTOPIC_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+        #error configTOPIC_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #endif
+#endif
+
+#ifndef configUSE_CORE_CHANNELS
+    #define configUSE_CORE_CHANNELS    0
+#endif
+
+#ifndef configCORE_CHANNEL_NOTIFICATION_INDEX
+    #define configCORE_CHANNEL_NOTIFICATION_INDEX    0
+#endif
+
+#if ( configUSE_CORE_CHANNELS == 1 )
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use core channels.
+    #endif
+
+    #if ( configCORE_CHANNEL_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+        #error configCORE_CHANNEL_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #endif
+
+    #ifndef portCORE_CHANNEL_SIGNAL
+        #error configUSE_CORE_CHANNELS is set to 1 but the port does not define portCORE_CHANNEL_SIGNAL(), which raises the interrupt used to wake tasks blocked on a core channel.
+    #endif
+#endif
+
+#ifndef configUSE_ISR_TIMERS
+    #define configUSE_ISR_TIMERS    0
+#endif
+
+#ifndef configISR_TIMER_MAX_ACTIVE
+    #define configISR_TIMER_MAX_ACTIVE    16
+#endif
+
+#if ( configUSE_ISR_TIMERS == 1 )
+    #if ( configISR_TIMER_MAX_ACTIVE < 1 )
+        #error configISR_TIMER_MAX_ACTIVE must be at least 1.
+    #endif
+
+    #if !defined( portISR_TIMER_GET_TIME_US ) || !defined( portISR_TIMER_SET_ALARM ) || !defined( portISR_TIMER_CANCEL_ALARM )
+        #error configUSE_ISR_TIMERS is set to 1 but the port does not define portISR_TIMER_GET_TIME_US(), portISR_TIMER_SET_ALARM() and portISR_TIMER_CANCEL_ALARM(), which provide the microsecond time base and the hardware alarm that drive ISR timers.
+    #endif
+#endif
+
+#ifndef configUSE_HIGH_RES_TIMEOUTS
+    #define configUSE_HIGH_RES_TIMEOUTS    0
+#endif
+
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    #if ( configUSE_ISR_TIMERS != 1 )
+        #error configUSE_HIGH_RES_TIMEOUTS is set to 1 but configUSE_ISR_TIMERS is not.  Each task is woken from its microsecond timeout by an ISR timer.
+    #endif
+
+    #if ( INCLUDE_xTaskAbortDelay != 1 )
+        #error configUSE_HIGH_RES_TIMEOUTS is set to 1 but INCLUDE_xTaskAbortDelay is not.  A task woken by its microsecond timeout is removed from the Blocked state in the same way as by xTaskAbortDelay().
+    #endif
+#endif
+
+#ifndef configHEAP_USE_BULK_REGIONS
+    #define configHEAP_USE_BULK_REGIONS    0
+#endif
+
+#ifndef configHEAP_BULK_FALLBACK_TO_FAST
+    #define configHEAP_BULK_FALLBACK_TO_FAST    0
+#endif
+
+#ifndef configHEAP_USE_CORE_CACHES
+    #define configHEAP_USE_CORE_CACHES    0
+#endif
+
+#ifndef configUSE_OBJECT_POOLS
+    #define configUSE_OBJECT_POOLS    0
+#endif
+
+#ifndef configTASK_POOL_LENGTH
+    #define configTASK_POOL_LENGTH    0
+#endif
+
+#ifndef configQUEUE_POOL_LENGTH
+    #define configQUEUE_POOL_LENGTH    0
+#endif
+
+#ifndef configQUEUE_POOL_STORAGE_SIZE
+    #define configQUEUE_POOL_STORAGE_SIZE    0
+#endif
+
+#ifndef configTIMER_POOL_LENGTH
+    #define configTIMER_POOL_LENGTH    0
+#endif
+
+#ifndef configSTACK_POOL_SMALL_DEPTH
+    #define configSTACK_POOL_SMALL_DEPTH    0
+#endif
+
+#ifndef configSTACK_POOL_SMALL_LENGTH
+    #define configSTACK_POOL_SMALL_LENGTH    0
+#endif
+
+#ifndef configSTACK_POOL_MEDIUM_DEPTH
+    #define configSTACK_POOL_MEDIUM_DEPTH    0
+#endif
+
+#ifndef configSTACK_POOL_MEDIUM_LENGTH
+    #define configSTACK_POOL_MEDIUM_LENGTH    0
+#endif
+
+#ifndef configSTACK_POOL_LARGE_DEPTH
+    #define configSTACK_POOL_LARGE_DEPTH    0
+#endif
+
+#ifndef configSTACK_POOL_LARGE_LENGTH
+    #define configSTACK_POOL_LARGE_LENGTH    0
+#endif
+
+#if ( configUSE_OBJECT_POOLS == 1 )
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configUSE_OBJECT_POOLS is set to 1 but configSUPPORT_DYNAMIC_ALLOCATION is not.  Object pools only serve objects that would otherwise be allocated from the heap.
+    #endif
+
+    #if ( ( configSTACK_POOL_SMALL_DEPTH > configSTACK_POOL_MEDIUM_DEPTH ) && ( configSTACK_POOL_MEDIUM_LENGTH > 0 ) ) || \
+    ( ( configSTACK_POOL_MEDIUM_DEPTH > configSTACK_POOL_LARGE_DEPTH ) && ( configSTACK_POOL_LARGE_LENGTH > 0 ) ) ||         \
+    ( ( configSTACK_POOL_SMALL_DEPTH > configSTACK_POOL_LARGE_DEPTH ) && ( configSTACK_POOL_LARGE_LENGTH > 0 ) )
+        #error configSTACK_POOL_SMALL_DEPTH, configSTACK_POOL_MEDIUM_DEPTH and configSTACK_POOL_LARGE_DEPTH must be in ascending order.
+    #endif
+#endif
+
+#ifndef configUSE_ARENAS
+    #define configUSE_ARENAS    0
+#endif
+
+#ifndef configUSE_HEAP_TRACE
+    #define configUSE_HEAP_TRACE    0
+#endif
+
+#ifndef configHEAP_TRACE_TABLE_SIZE
+    #define configHEAP_TRACE_TABLE_SIZE    128
+#endif
+
+#ifndef configHEAP_TRACE_SIZE_CLASSES
+    #define configHEAP_TRACE_SIZE_CLASSES    16
+#endif
+
+#if ( configUSE_HEAP_TRACE == 1 )
+    #if ( ( configHEAP_TRACE_TABLE_SIZE & ( configHEAP_TRACE_TABLE_SIZE - 1 ) ) != 0 ) || ( configHEAP_TRACE_TABLE_SIZE < 2 )
+        #error configHEAP_TRACE_TABLE_SIZE must be a power of two.
+    #endif
+
+    #if ( configHEAP_TRACE_SIZE_CLASSES < 1 ) || ( configHEAP_TRACE_SIZE_CLASSES > 32 )
+        #error configHEAP_TRACE_SIZE_CLASSES must be between 1 and 32.
+    #endif
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+        #error configUSE_HEAP_TRACE is set to 1 but INCLUDE_xTaskGetCurrentTaskHandle is not.  Each allocation is recorded against the task that made it.
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+        #error configUSE_HEAP_TRACE is set to 1 but INCLUDE_xTaskGetSchedulerState is not.  Allocations made before the scheduler starts are not recorded against a task.
+    #endif
+
+    #if ( configHEAP_USE_CORE_CACHES == 1 )
+        #error configUSE_HEAP_TRACE and configHEAP_USE_CORE_CACHES cannot both be set to 1.  The heap trace relies on the scheduler being suspended around every allocation and free, which the core caches avoid.
+    #endif
+#endif
+
+#ifndef configUSE_POSIX_ERRNO
+    #define configUSE_POSIX_ERRNO    0
+#endif
+
+#ifndef configUSE_SB_COMPLETED_CALLBACK
 
 /* By default per-instance callbacks are not enabled for stream buffer or message buffer. */
     #define configUSE_SB_COMPLETED_CALLBACK    0
@@ -3130,6 +4343,30 @@ typedef struct xSTATIC_LIST
     #endif
 } StaticList_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the ISR timer structure used
+ * internally by FreeRTOS is not accessible to application code.  However, if
+ * the application writer wants to statically allocate the memory required to
+ * create an ISR timer then the size of the timer object needs to be known.
+ * The StaticISRTimer_t structure below is provided for this purpose.  Its size
+ * and alignment requirements are guaranteed to match those of the genuine
+ * structure, no matter which architecture is being used, and no matter how the
+ * values in FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in
+ * the hope users will recognise that it would be unwise to make direct use of
+ * the structure members.
+ */
+typedef struct xSTATIC_ISR_TIMER
+{
+    uint64_t ullDummy1;
+    uint32_t ulDummy2[ 2 ];
+    TaskFunction_t pvDummy3;
+    void * pvDummy4;
+    UBaseType_t uxDummy5;
+    uint8_t ucDummy6;
+} StaticISRTimer_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -3191,6 +4428,14 @@ typedef struct xSTATIC_TCB
         uint32_t ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
         uint8_t ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
     #endif
+    #if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+        void * pvDummy27;
+        StaticISRTimer_t xDummy28;
+        uint64_t ullDummy29;
+    #endif
+    #if ( ( configUSE_ARENAS == 1 ) && ( INCLUDE_vTaskDelete == 1 ) )
+        void * pvDummy30;
+    #endif
     #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
         uint8_t uxDummy20;
     #endif
@@ -3235,8 +4480,30 @@ typedef struct xSTATIC_QUEUE
         uint8_t ucDummy6;
     #endif
 
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        uint8_t ucDummy11;
+    #endif
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        void * pvDummy12;
+        TickType_t xDummy13;
+        UBaseType_t uxDummy14[ 2 ];
+        TickType_t xDummy15[ 2 ];
+    #endif
+
+    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+        struct
+        {
+            UBaseType_t uxDummy1;
+            uint32_t ulDummy2[ 4 ];
+            TickType_t xDummy3[ 2 ];
+            uint32_t ulDummy4[ configQUEUE_PERF_HISTOGRAM_BUCKETS ];
+        } xDummy16;
+    #endif
+
     #if ( configUSE_QUEUE_SETS == 1 )
         void * pvDummy7;
+        uint8_t ucDummy10;
     #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -3265,6 +4532,16 @@ typedef struct xSTATIC_EVENT_GROUP
     TickType_t xDummy1;
     StaticList_t xDummy2;
 
+    #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        TickType_t xDummy5;
+        StaticList_t xDummy6[ configEVENT_GROUP_INDEXED_BITS ];
+    #endif
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+        UBaseType_t uxDummy7;
+        TickType_t xDummy8;
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
     #endif
@@ -3298,6 +4575,17 @@ typedef struct xSTATIC_TIMER
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy7;
     #endif
+    #if ( configUSE_TIMER_SLACK == 1 )
+        TickType_t xDummy12;
+    #endif
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+        void * pvDummy9;
+        TickType_t xDummy10[ 2 ];
+        uint8_t ucDummy11;
+    #endif
+    #if ( configTIMER_SERVICE_TASKS > 1 )
+        uint8_t ucDummy13;
+    #endif
     uint8_t ucDummy8;
 } StaticTimer_t;
 
@@ -3327,11 +4615,120 @@ typedef struct xSTATIC_STREAM_BUFFER
         void * pvDummy5[ 2 ];
     #endif
     UBaseType_t uxDummy6;
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        TickType_t xDummy7;
+        UBaseType_t uxDummy8[ 2 ];
+        TickType_t xDummy9[ 2 ];
+    #endif
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+        size_t xDummy10;
+        UBaseType_t uxDummy11;
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the mailbox structure used internally
+ * by FreeRTOS is not accessible to application code.  However, if the
+ * application writer wants to statically allocate the memory required to
+ * create a mailbox then the size of the mailbox object needs to be known.  The
+ * StaticMailbox_t structure below is provided for this purpose.  Its size and
+ * alignment requirements are guaranteed to match those of the genuine
+ * structure, no matter which architecture is being used, and no matter how the
+ * values in FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in
+ * the hope users will recognise that it would be unwise to make direct use of
+ * the structure members.
+ */
+typedef struct xSTATIC_MAILBOX
+{
+    uint32_t ulDummy1;
+    size_t uxDummy2;
+    void * pvDummy3;
+    StaticList_t xDummy4;
+    uint8_t ucDummy5;
+} StaticMailbox_t;
+
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the topic and topic subscriber
+ * structures used internally by FreeRTOS are not accessible to application
+ * code.  However, if the application writer wants to statically allocate the
+ * memory required to create a topic or a subscription then the size of the
+ * objects needs to be known.  The StaticTopic_t and StaticTopicSubscriber_t
+ * structures below are provided for this purpose.  Their sizes and alignment
+ * requirements are guaranteed to match those of the genuine structures, no
+ * matter which architecture is being used, and no matter how the values in
+ * FreeRTOSConfig.h are set.  Their contents are somewhat obfuscated in the hope
+ * users will recognise that it would be unwise to make direct use of the
+ * structure members.
+ */
+typedef struct xSTATIC_TOPIC
+{
+    uint32_t ulDummy1[ 2 ];
+    UBaseType_t uxDummy2[ 2 ];
+    void * pvDummy3;
+    StaticList_t xDummy4;
+    uint8_t ucDummy5;
+} StaticTopic_t;
+
+typedef struct xSTATIC_TOPIC_SUBSCRIBER
+{
+    void * pvDummy1;
+    uint32_t ulDummy2[ 2 ];
+    uint8_t ucDummy3;
+} StaticTopicSubscriber_t;
+
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the core channel structure used
+ * internally by FreeRTOS is not accessible to application code.  However, if
+ * the application writer wants to statically allocate the memory required to
+ * create a core channel then the size of the channel object needs to be known.
+ * The StaticCoreChannel_t structure below is provided for this purpose.  Its
+ * size and alignment requirements are guaranteed to match those of the genuine
+ * structure, no matter which architecture is being used, and no matter how the
+ * values in FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in
+ * the hope users will recognise that it would be unwise to make direct use of
+ * the structure members.
+ */
+typedef struct xSTATIC_CORE_CHANNEL
+{
+    size_t uxDummy1[ 3 ];
+    void * pvDummy2[ 3 ];
+    size_t uxDummy3;
+    BaseType_t xDummy4[ 2 ];
+    void * pvDummy5;
+    uint8_t ucDummy6;
+} StaticCoreChannel_t;
+
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the arena structure used internally
+ * by FreeRTOS is not accessible to application code.  However, if the
+ * application writer wants to statically allocate the memory required to
+ * create an arena then the size of the arena object needs to be known.  The
+ * StaticArena_t structure below is provided for this purpose.  Its size and
+ * alignment requirements are guaranteed to match those of the genuine
+ * structure, no matter which architecture is being used, and no matter how the
+ * values in FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in
+ * the hope users will recognise that it would be unwise to make direct use of
+ * the structure members.
+ */
+typedef struct xSTATIC_ARENA
+{
+    void * pvDummy1;
+    size_t xDummy2[ 3 ];
+    void * pvDummy3[ 2 ];
+    uint8_t ucDummy4;
+} StaticArena_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
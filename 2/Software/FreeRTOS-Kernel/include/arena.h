@@ -0,0 +1,284 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * An arena is a block of memory, taken from the heap once when the arena is
+ * created, from which a task allocates buffers by simply advancing an offset.
+ * Nothing allocated from an arena is freed individually - instead
+ * vArenaReset() frees everything allocated from it at once, typically at the
+ * end of each processing cycle.  pvArenaMalloc() takes constant time, does not
+ * suspend the scheduler or enter a critical section, and cannot fragment the
+ * heap, so it can replace pvPortMalloc() and vPortFree() in a task's hot loop.
+ *
+ * Because no lock is taken an arena must only be used by one task at a time.
+ *
+ * An arena can be attached to a task with xArenaAttachToTask().  The kernel
+ * then deletes the arena when the task is deleted, so memory allocated by the
+ * task is reclaimed even if the task never reaches its own clean up code.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for the arena API to
+ * be available.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include arena.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which arenas are referenced.  For example, a call to xArenaCreate()
+ * returns an ArenaHandle_t variable that can then be used as a parameter to
+ * pvArenaMalloc(), vArenaReset(), etc.
+ */
+struct ArenaDef_t;
+typedef struct ArenaDef_t * ArenaHandle_t;
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * ArenaHandle_t xArenaCreate( size_t xSizeInBytes );
+ * @endcode
+ *
+ * Creates a new arena that can hold xSizeInBytes bytes of allocations.  The
+ * arena's data structure and storage are allocated together with one call to
+ * pvPortMalloc().
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xArenaCreate() to be available.
+ *
+ * @param xSizeInBytes The number of bytes of storage in the arena.  Each
+ * allocation is rounded up to a multiple of portBYTE_ALIGNMENT bytes.
+ *
+ * @return The handle of the created arena, or NULL if there was not enough
+ * heap memory available to create it.
+ *
+ * \defgroup xArenaCreate xArenaCreate
+ * \ingroup Arenas
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    ArenaHandle_t xArenaCreate( size_t xSizeInBytes ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * ArenaHandle_t xArenaCreateStatic( size_t xSizeInBytes,
+ *                                   uint8_t * pucArenaStorage,
+ *                                   StaticArena_t * pxStaticArena );
+ * @endcode
+ *
+ * Creates a new arena using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xArenaCreateStatic() to be available.
+ *
+ * @param xSizeInBytes The size, in bytes, of the buffer pointed to by
+ * pucArenaStorage.
+ *
+ * @param pucArenaStorage Must point to a buffer of xSizeInBytes bytes from
+ * which allocations are made.  If the buffer is not aligned to
+ * portBYTE_ALIGNMENT the bytes before the first aligned address are not used.
+ *
+ * @param pxStaticArena Must point to a variable of type StaticArena_t, which
+ * will be used to hold the arena's data structure.
+ *
+ * @return The handle of the created arena, or NULL if either buffer was NULL.
+ *
+ * \defgroup xArenaCreateStatic xArenaCreateStatic
+ * \ingroup Arenas
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    ArenaHandle_t xArenaCreateStatic( size_t xSizeInBytes,
+                                      uint8_t * pucArenaStorage,
+                                      StaticArena_t * pxStaticArena ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * void vArenaDelete( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * Deletes an arena that was created using xArenaCreate() or
+ * xArenaCreateStatic(), detaching it from its task first if it is attached to
+ * one.  Everything allocated from the arena is freed with it.
+ *
+ * \defgroup vArenaDelete vArenaDelete
+ * \ingroup Arenas
+ */
+void vArenaDelete( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * void * pvArenaMalloc( ArenaHandle_t xArena, size_t xWantedSize );
+ * @endcode
+ *
+ * Allocates xWantedSize bytes from the arena.  The memory remains allocated
+ * until vArenaReset() or vArenaDelete() is called on the arena - there is no
+ * way to free it individually.
+ *
+ * @param xArena The handle of the arena to allocate from.
+ *
+ * @param xWantedSize The number of bytes to allocate.
+ *
+ * @return A pointer, aligned to portBYTE_ALIGNMENT, to the allocated memory,
+ * or NULL if xWantedSize is 0 or the arena does not have xWantedSize bytes
+ * left.
+ *
+ * \defgroup pvArenaMalloc pvArenaMalloc
+ * \ingroup Arenas
+ */
+void * pvArenaMalloc( ArenaHandle_t xArena,
+                      size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * void vArenaReset( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * Frees everything allocated from the arena, in constant time.  Pointers
+ * previously returned by pvArenaMalloc() must not be used afterwards.
+ *
+ * \defgroup vArenaReset vArenaReset
+ * \ingroup Arenas
+ */
+void vArenaReset( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * size_t xArenaGetFreeSize( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * @return The number of bytes that can still be allocated from the arena.
+ *
+ * \defgroup xArenaGetFreeSize xArenaGetFreeSize
+ * \ingroup Arenas
+ */
+size_t xArenaGetFreeSize( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * size_t xArenaGetMinimumEverFreeSize( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * @return The lowest value xArenaGetFreeSize() has returned since the arena
+ * was created, which shows how large the arena needs to be.
+ *
+ * \defgroup xArenaGetMinimumEverFreeSize xArenaGetMinimumEverFreeSize
+ * \ingroup Arenas
+ */
+size_t xArenaGetMinimumEverFreeSize( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * BaseType_t xArenaAttachToTask( ArenaHandle_t xArena, TaskHandle_t xTask );
+ * @endcode
+ *
+ * Attaches an arena to a task, so the arena is deleted when the task is
+ * deleted.  A task can have any number of arenas attached to it, but an arena
+ * can only be attached to one task.
+ *
+ * INCLUDE_vTaskDelete must be set to 1 in FreeRTOSConfig.h for
+ * xArenaAttachToTask() to be available.
+ *
+ * @param xArena The handle of the arena to attach.
+ *
+ * @param xTask The handle of the task to attach the arena to.  Passing NULL
+ * attaches the arena to the calling task.
+ *
+ * @return pdPASS if the arena was attached, or pdFAIL if it is already
+ * attached to a task.
+ *
+ * \defgroup xArenaAttachToTask xArenaAttachToTask
+ * \ingroup Arenas
+ */
+#if ( INCLUDE_vTaskDelete == 1 )
+    BaseType_t xArenaAttachToTask( ArenaHandle_t xArena,
+                                   TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * arena.h
+ *
+ * @code{c}
+ * void vArenaDetachFromTask( ArenaHandle_t xArena );
+ * @endcode
+ *
+ * Detaches an arena from the task it was attached to with
+ * xArenaAttachToTask(), so it is no longer deleted with the task.  Does
+ * nothing if the arena is not attached to a task.  Must not be called once
+ * the task has been deleted.
+ *
+ * \defgroup vArenaDetachFromTask vArenaDetachFromTask
+ * \ingroup Arenas
+ */
+#if ( INCLUDE_vTaskDelete == 1 )
+    void vArenaDetachFromTask( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+#endif
+
+/*-----------------------------------------------------------
+* SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
+*----------------------------------------------------------*/
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  It is called by the
+ * kernel when a task is deleted to delete the arenas attached to the task,
+ * pxFirstArena being the first of them.
+ */
+#if ( INCLUDE_vTaskDelete == 1 )
+    void vArenaDeleteTaskArenas( struct ArenaDef_t * pxFirstArena ) PRIVILEGED_FUNCTION;
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* ARENA_H */
@@ -0,0 +1,276 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A core channel is a byte stream between exactly one sender and exactly one
+ * receiver that are expected to run on different cores - for example a sensor
+ * acquisition loop on one core feeding a control task on the other.
+ *
+ * The data is held in a ring buffer in shared memory.  The sender only ever
+ * writes the head index and the receiver only ever writes the tail index, so
+ * sending and receiving need neither a critical section nor the scheduler,
+ * and the two cores never contend for the kernel lock while data is flowing.
+ * The only cross-core signal is raised by the port (a doorbell interrupt on
+ * the RP2350) and only when the other end is blocked waiting for data or
+ * space.  The interrupt handler calls vCoreChannelHandleSignalFromISR(),
+ * which wakes the waiting task using a direct to task notification (using
+ * index configCORE_CHANNEL_NOTIFICATION_INDEX).
+ *
+ * A send or receive with a block time of zero does not call any kernel
+ * function, so can be used from interrupts and from a core that is not
+ * running the FreeRTOS scheduler.
+ *
+ * configUSE_CORE_CHANNELS must be set to 1 in FreeRTOSConfig.h, and the port
+ * must define portCORE_CHANNEL_SIGNAL(), for the core channel API to be
+ * available.
+ */
+
+#ifndef CORE_CHANNEL_H
+#define CORE_CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include core_channel.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which core channels are referenced.  For example, a call to
+ * xCoreChannelCreate() returns a CoreChannelHandle_t variable that can then be
+ * used as a parameter to xCoreChannelSend(), xCoreChannelReceive(), etc.
+ */
+struct CoreChannelDef_t;
+typedef struct CoreChannelDef_t * CoreChannelHandle_t;
+
+/**
+ * core_channel.h
+ *
+ * @code{c}
+ * CoreChannelHandle_t xCoreChannelCreate( size_t xBufferSizeBytes );
+ * @endcode
+ *
+ * Creates a new core channel using dynamically allocated memory.  The channel
+ * structure and its ring buffer are allocated in a single call to
+ * pvPortMalloc().  Channels should be created before either end starts using
+ * them, normally before the other core is started.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xCoreChannelCreate() to be available.
+ *
+ * @param xBufferSizeBytes The total number of bytes the channel can hold.
+ *
+ * @return The handle of the created channel, or NULL if there was not enough
+ * heap memory available to create it.
+ *
+ * \defgroup xCoreChannelCreate xCoreChannelCreate
+ * \ingroup CoreChannels
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    CoreChannelHandle_t xCoreChannelCreate( size_t xBufferSizeBytes ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * core_channel.h
+ *
+ * @code{c}
+ * CoreChannelHandle_t xCoreChannelCreateStatic( size_t xBufferSizeBytes,
+ *                                               uint8_t * pucChannelStorage,
+ *                                               StaticCoreChannel_t * pxStaticChannel );
+ * @endcode
+ *
+ * Creates a new core channel using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xCoreChannelCreateStatic() to be available.
+ *
+ * @param xBufferSizeBytes The total number of bytes the channel can hold.
+ *
+ * @param pucChannelStorage Must point to a buffer of at least xBufferSizeBytes
+ * bytes.  The buffer must be in memory that both cores can access.
+ *
+ * @param pxStaticChannel Must point to a variable of type StaticCoreChannel_t,
+ * which will be used to hold the channel's data structure.
+ *
+ * @return The handle of the created channel, or NULL if either buffer was NULL.
+ *
+ * \defgroup xCoreChannelCreateStatic xCoreChannelCreateStatic
+ * \ingroup CoreChannels
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    CoreChannelHandle_t xCoreChannelCreateStatic( size_t xBufferSizeBytes,
+                                                  uint8_t * pucChannelStorage,
+                                                  StaticCoreChannel_t * pxStaticChannel ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * core_channel.h
+ *
+ * @code{c}
+ * void vCoreChannelDelete( CoreChannelHandle_t xCoreChannel );
+ * @endcode
+ *
+ * Deletes a core channel that was created using xCoreChannelCreate() or
+ * xCoreChannelCreateStatic().  Neither end may be using the channel when it is
+ * deleted.
+ *
+ * \defgroup vCoreChannelDelete vCoreChannelDelete
+ * \ingroup CoreChannels
+ */
+void vCoreChannelDelete( CoreChannelHandle_t xCoreChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * core_channel.h
+ *
+ * @code{c}
+ * size_t xCoreChannelSend( CoreChannelHandle_t xCoreChannel,
+ *                          const void * pvTxData,
+ *                          size_t xDataLengthBytes,
+ *                          TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies bytes into a core channel.  Only one task, interrupt or core may send
+ * to a given channel.
+ *
+ * If there is not enough space for all xDataLengthBytes bytes (or, when
+ * xDataLengthBytes is larger than the channel, for a completely empty channel)
+ * the calling task blocks for up to xTicksToWait ticks waiting for the
+ * receiver to make space, then sends as many bytes as fit.  The task waits on
+ * its direct to task notification at index
+ * configCORE_CHANNEL_NOTIFICATION_INDEX.
+ *
+ * With xTicksToWait set to 0 the function never calls into the kernel, so it
+ * can be used from an interrupt service routine or from a core that is not
+ * running the scheduler.
+ *
+ * @param xCoreChannel The handle of the channel to send to.
+ *
+ * @param pvTxData A pointer to the bytes to copy into the channel.
+ *
+ * @param xDataLengthBytes The number of bytes to copy.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state waiting for space.  Must be 0 when not called from a
+ * task.
+ *
+ * @return The number of bytes copied into the channel.
+ *
+ * \defgroup xCoreChannelSend xCoreChannelSend
+ * \ingroup CoreChannels
+ */
+size_t xCoreChannelSend( CoreChannelHandle_t xCoreChannel,
+                         const void * pvTxData,
+                         size_t xDataLengthBytes,
+                         TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * core_channel.h
+ *
+ * @code{c}
+ * size_t xCoreChannelReceive( CoreChannelHandle_t xCoreChannel,
+ *                             void * pvRxData,
+ *                             size_t xBufferLengthBytes,
+ *                             TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies up to xBufferLengthBytes bytes out of a core channel.  Only one task,
+ * interrupt or core may receive from a given channel.
+ *
+ * If the channel is empty the calling task blocks for up to xTicksToWait ticks
+ * waiting for data to arrive.  As with xCoreChannelSend(), a block time of 0
+ * means the function never calls into the kernel.
+ *
+ * @param xCoreChannel The handle of the channel to receive from.
+ *
+ * @param pvRxData A pointer to the buffer into which the bytes are copied.
+ *
+ * @param xBufferLengthBytes The size of the buffer pointed to by pvRxData.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state waiting for data.  Must be 0 when not called from a
+ * task.
+ *
+ * @return The number of bytes copied out of the channel.
+ *
+ * \defgroup xCoreChannelReceive xCoreChannelReceive
+ * \ingroup CoreChannels
+ */
+size_t xCoreChannelReceive( CoreChannelHandle_t xCoreChannel,
+                            void * pvRxData,
+                            size_t xBufferLengthBytes,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * core_channel.h
+ *
+ * @code{c}
+ * size_t xCoreChannelBytesAvailable( CoreChannelHandle_t xCoreChannel );
+ * @endcode
+ *
+ * @return The number of bytes that can be received from the channel.  If the
+ * sender is running on another core the true number may already be larger.
+ *
+ * \defgroup xCoreChannelBytesAvailable xCoreChannelBytesAvailable
+ * \ingroup CoreChannels
+ */
+size_t xCoreChannelBytesAvailable( CoreChannelHandle_t xCoreChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * core_channel.h
+ *
+ * @code{c}
+ * size_t xCoreChannelSpacesAvailable( CoreChannelHandle_t xCoreChannel );
+ * @endcode
+ *
+ * @return The number of bytes that can be sent to the channel.  If the
+ * receiver is running on another core the true number may already be larger.
+ *
+ * \defgroup xCoreChannelSpacesAvailable xCoreChannelSpacesAvailable
+ * \ingroup CoreChannels
+ */
+size_t xCoreChannelSpacesAvailable( CoreChannelHandle_t xCoreChannel ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY INTENDED
+ * FOR USE BY THE PORT LAYER.
+ *
+ * Called from the interrupt raised by portCORE_CHANNEL_SIGNAL() to wake any
+ * task that is blocked on a core channel and can now make progress.
+ */
+void vCoreChannelHandleSignalFromISR( BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( CORE_CHANNEL_H ) */
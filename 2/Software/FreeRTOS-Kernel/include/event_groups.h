@@ -554,6 +554,15 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR is set to 1 in FreeRTOSConfig.h
+ * the timer task is not used.  Instead the bits are set, and the tasks waiting
+ * for them unblocked, directly from the interrupt - unless a task is accessing
+ * the event group at the time, in which case that task sets the bits as soon
+ * as it has finished.  The time spent in the interrupt grows with the number
+ * of tasks unblocked, and with the number of tasks that have to be tested
+ * because they wait for more than one bit.  Set configEVENT_GROUP_INDEXED_BITS
+ * so tasks waiting for a single bit are not tested.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -572,7 +581,8 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  *
  * @return If the request to execute the function was posted successfully then
  * pdPASS is returned, otherwise pdFALSE is returned.  pdFALSE will be returned
- * if the timer service queue was full.
+ * if the timer service queue was full.  pdPASS is always returned if
+ * configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR is set to 1.
  *
  * Example usage:
  * @code{c}
@@ -610,7 +620,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 ) )
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
@@ -0,0 +1,244 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Heap tracing records each block allocated from the heap, together with the
+ * task that allocated it and the address pvPortMalloc() was called from, in a
+ * table of live allocations.  Records are removed again when the block is
+ * freed, so the table shows who holds the heap memory in use at any time, and
+ * allocations made after a checkpoint that are still live are candidates for
+ * leaks.  A histogram of block sizes, by power of two size class, is kept
+ * alongside.
+ *
+ * Records are made from the traceMALLOC() and traceFREE() macros, so heap
+ * tracing works with any of the heap implementations.  The table is a hash
+ * table with configHEAP_TRACE_TABLE_SIZE entries, so recording an allocation or
+ * a free takes constant time on average.  If the table is full an allocation
+ * is counted but not recorded.
+ *
+ * vHeapTraceDump() writes the table as text with one line per allocation, in
+ * the "folded stack" format used by flamegraph tools - the task name and the
+ * call site separated by a semicolon, then the number of bytes.  On the
+ * GCC_POSIX port the dump also records where the executable was loaded, so
+ * examples/heap_trace/heap_trace_fold.py can resolve the call sites to
+ * function names before the dump is passed to flamegraph.pl.
+ *
+ * configUSE_HEAP_TRACE must be set to 1 in FreeRTOSConfig.h for the heap trace
+ * API to be available.
+ */
+
+#ifndef HEAP_TRACE_H
+#define HEAP_TRACE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include heap_trace.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Used to pass information about a live allocation out of
+ * uxHeapTraceGetAllocations(). */
+typedef struct xHEAP_TRACE_RECORD
+{
+    void * pvAddress;         /* The address returned by pvPortMalloc(). */
+    size_t xSize;             /* The size of the block, as reported by the heap implementation. */
+    TaskHandle_t xOwner;      /* The task that allocated the block, or NULL if it was allocated before the scheduler started or the task has been deleted. */
+    void * pvCaller;          /* The address pvPortMalloc() was called from. */
+    uint32_t ulSequence;      /* The value ulHeapTraceGetSequence() returned when the block was allocated. */
+    BaseType_t xOwnerDeleted; /* pdTRUE if the task that allocated the block has been deleted. */
+} HeapTraceRecord_t;
+
+/* Used to pass information about the heap out of vHeapTraceGetStats(). */
+typedef struct xHEAP_TRACE_STATS
+{
+    UBaseType_t uxLiveAllocations;                                        /* The number of blocks recorded in the table. */
+    size_t xLiveBytes;                                                    /* The total size of the blocks recorded in the table. */
+    size_t xUntrackedAllocations;                                         /* The number of allocations not recorded because the table was full. */
+    size_t xFailedAllocations;                                            /* The number of calls to pvPortMalloc() that returned NULL. */
+    UBaseType_t uxLiveAllocationsInClass[ configHEAP_TRACE_SIZE_CLASSES ]; /* The number of live blocks of each size class. */
+    size_t xLiveBytesInClass[ configHEAP_TRACE_SIZE_CLASSES ];            /* The total size of the live blocks of each size class. */
+    size_t xAllocationsInClass[ configHEAP_TRACE_SIZE_CLASSES ];          /* The number of blocks of each size class ever allocated. */
+} HeapTraceStats_t;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * void vHeapTraceGetStats( HeapTraceStats_t * pxStats );
+ * @endcode
+ *
+ * Returns the totals and size class histogram of the heap trace.  Size class
+ * 0 holds blocks of 0 or 1 byte, and size class n holds blocks of 2 ^ n to
+ * ( 2 ^ ( n + 1 ) ) - 1 bytes, except the last class, which also holds every
+ * larger block.
+ *
+ * @param pxStats Pointer to the structure into which the information is
+ * written.
+ *
+ * \defgroup vHeapTraceGetStats vHeapTraceGetStats
+ * \ingroup HeapTrace
+ */
+void vHeapTraceGetStats( HeapTraceStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * uint32_t ulHeapTraceGetSequence( void );
+ * @endcode
+ *
+ * Every recorded allocation is given the next number in a sequence.  Passing
+ * the value returned by this function to uxHeapTraceGetAllocations() or
+ * vHeapTraceDump() later reports only the allocations made since, which is
+ * how to find blocks leaked by a piece of code that should return the heap to
+ * the state it found it in.
+ *
+ * @return The sequence number the next allocation will be given.
+ *
+ * \defgroup ulHeapTraceGetSequence ulHeapTraceGetSequence
+ * \ingroup HeapTrace
+ */
+uint32_t ulHeapTraceGetSequence( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * UBaseType_t uxHeapTraceGetAllocations( HeapTraceRecord_t * pxRecords,
+ *                                        UBaseType_t uxMaxRecords,
+ *                                        uint32_t ulSinceSequence );
+ * @endcode
+ *
+ * Copies records of the live allocations into an array.  The scheduler is
+ * suspended while the table is read.
+ *
+ * @param pxRecords The array into which the records are copied.
+ *
+ * @param uxMaxRecords The number of records pxRecords can hold.
+ *
+ * @param ulSinceSequence Only allocations given a sequence number of at least
+ * ulSinceSequence are copied.  Pass 0 to copy every live allocation.
+ *
+ * @return The number of records copied into pxRecords.
+ *
+ * \defgroup uxHeapTraceGetAllocations uxHeapTraceGetAllocations
+ * \ingroup HeapTrace
+ */
+UBaseType_t uxHeapTraceGetAllocations( HeapTraceRecord_t * pxRecords,
+                                       UBaseType_t uxMaxRecords,
+                                       uint32_t ulSinceSequence ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * UBaseType_t uxHeapTraceGetFragmentationIndex( const HeapStats_t * pxHeapStats );
+ * @endcode
+ *
+ * Returns the size of the largest free block as a percentage of the total free
+ * space in the heap.  100 means the free space is in one block, and lower
+ * values mean the free space is split into ever smaller blocks.
+ *
+ * @param pxHeapStats Heap statistics returned by vPortGetHeapStats(), which is
+ * provided by heap_4.c, heap_5.c and heap_6.c.
+ *
+ * @return The fragmentation index, or 100 if the heap has no free space.
+ *
+ * \defgroup uxHeapTraceGetFragmentationIndex uxHeapTraceGetFragmentationIndex
+ * \ingroup HeapTrace
+ */
+UBaseType_t uxHeapTraceGetFragmentationIndex( const HeapStats_t * pxHeapStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * @code{c}
+ * void vHeapTraceDump( char * pcWriteBuffer,
+ *                      size_t xBufferLength,
+ *                      uint32_t ulSinceSequence,
+ *                      const HeapStats_t * pxHeapStats );
+ * @endcode
+ *
+ * Writes the heap trace into a buffer as text.  Lines that start with '#'
+ * hold the totals, the fragmentation index and the size class histogram.
+ * Every other line describes one live allocation as:
+ *
+ * <task name>;<call site address> <bytes>
+ *
+ * which is the folded stack format read by flamegraph tools.  Blocks allocated
+ * before the scheduler started are attributed to "[no_task]", and blocks
+ * allocated by a task that has since been deleted to "[deleted_task]".  The
+ * output is truncated, at the end of a line, if the buffer is too small.
+ *
+ * @param pcWriteBuffer The buffer into which the text is written.
+ *
+ * @param xBufferLength The length of pcWriteBuffer.
+ *
+ * @param ulSinceSequence Only allocations given a sequence number of at least
+ * ulSinceSequence are written.  Pass 0 to write every live allocation.
+ *
+ * @param pxHeapStats Heap statistics returned by vPortGetHeapStats(), from
+ * which the fragmentation index is written, or NULL if the heap
+ * implementation does not provide vPortGetHeapStats().
+ *
+ * \defgroup vHeapTraceDump vHeapTraceDump
+ * \ingroup HeapTrace
+ */
+void vHeapTraceDump( char * pcWriteBuffer,
+                     size_t xBufferLength,
+                     uint32_t ulSinceSequence,
+                     const HeapStats_t * pxHeapStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * This function resets the internal state of the heap trace.  It must be
+ * called by the application before restarting the scheduler.
+ */
+void vHeapTraceResetState( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+* SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
+*----------------------------------------------------------*/
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  It is called by the
+ * kernel when a task is deleted, before its TCB is freed, to stop the records
+ * of the blocks the task allocated referring to it.
+ */
+void vHeapTraceTaskDeleted( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* HEAP_TRACE_H */
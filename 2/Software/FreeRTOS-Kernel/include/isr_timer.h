@@ -0,0 +1,379 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * ISR timers are software timers whose callback functions execute directly in
+ * the interrupt raised by a hardware alarm, rather than in the timer service
+ * task.  They are intended for hard real-time jobs such as generating pulses
+ * or sampling at a fixed rate, where the latency and jitter of the timer
+ * service task, and the resolution of the RTOS tick, are not acceptable.
+ *
+ * Expiry times are absolute times in microseconds, measured against the 64-bit
+ * time base returned by ullISRTimerGetTimeUs(), so they never wrap in
+ * practice.  Running timers are held in a binary min-heap ordered by expiry
+ * time, so starting and stopping a timer are O(log n) operations and finding
+ * the next timer to expire is O(1).  Only the timer at the root of the heap
+ * is ever programmed into the hardware alarm.  When the alarm fires the port
+ * calls vISRTimerHandleAlarmFromISR(), which calls the callback of every timer
+ * that has expired then programs the alarm for the next one.
+ *
+ * Because the callbacks execute in an interrupt they must be short, must not
+ * block, and may only call interrupt safe API functions (those that end in
+ * "FromISR").
+ *
+ * configUSE_ISR_TIMERS must be set to 1 in FreeRTOSConfig.h, and the port
+ * must define portISR_TIMER_GET_TIME_US(), portISR_TIMER_SET_ALARM() and
+ * portISR_TIMER_CANCEL_ALARM(), for the ISR timer API to be available.
+ */
+
+#ifndef ISR_TIMER_H
+#define ISR_TIMER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include isr_timer.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which ISR timers are referenced.  For example, a call to
+ * xISRTimerCreate() returns an ISRTimerHandle_t variable that can then be used
+ * to reference the subject timer in calls to other ISR timer API functions
+ * (for example, xISRTimerStart(), xISRTimerStop(), etc.).
+ */
+struct ISRTimerDef_t;
+typedef struct ISRTimerDef_t * ISRTimerHandle_t;
+
+/*
+ * Defines the prototype to which ISR timer callback functions must conform.
+ * The callback executes in interrupt context.  pxHigherPriorityTaskWoken can
+ * be passed directly to any "FromISR" API function the callback calls - the
+ * port performs the context switch, if one is required, when the interrupt
+ * exits.
+ */
+typedef void (* ISRTimerCallbackFunction_t)( ISRTimerHandle_t xTimer,
+                                             BaseType_t * pxHigherPriorityTaskWoken );
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * ISRTimerHandle_t xISRTimerCreate( ISRTimerCallbackFunction_t pxCallbackFunction,
+ *                                   void * pvTimerID );
+ * @endcode
+ *
+ * Creates a new ISR timer using dynamically allocated memory.  The timer is
+ * created in the dormant state - xISRTimerStart() must be called to start it.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xISRTimerCreate() to be available.
+ *
+ * @param pxCallbackFunction The function to call, from the alarm interrupt,
+ * when the timer expires.
+ *
+ * @param pvTimerID An identifier that is assigned to the timer being created,
+ * and that can be retrieved from within the callback function using
+ * pvISRTimerGetTimerID().
+ *
+ * @return The handle of the created timer, or NULL if there was not enough
+ * heap memory available to create it.
+ *
+ * \defgroup xISRTimerCreate xISRTimerCreate
+ * \ingroup ISRTimers
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    ISRTimerHandle_t xISRTimerCreate( ISRTimerCallbackFunction_t pxCallbackFunction,
+                                      void * pvTimerID ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * ISRTimerHandle_t xISRTimerCreateStatic( ISRTimerCallbackFunction_t pxCallbackFunction,
+ *                                         void * pvTimerID,
+ *                                         StaticISRTimer_t * pxTimerBuffer );
+ * @endcode
+ *
+ * Creates a new ISR timer using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xISRTimerCreateStatic() to be available.  It is also available when
+ * configUSE_HIGH_RES_TIMEOUTS is set to 1, as the kernel then uses it to create
+ * the timer that wakes each task from a microsecond timeout.
+ *
+ * @param pxCallbackFunction The function to call, from the alarm interrupt,
+ * when the timer expires.
+ *
+ * @param pvTimerID An identifier that is assigned to the timer being created.
+ *
+ * @param pxTimerBuffer Must point to a variable of type StaticISRTimer_t, which
+ * will be used to hold the timer's data structure.
+ *
+ * @return The handle of the created timer, or NULL if pxTimerBuffer was NULL.
+ *
+ * \defgroup xISRTimerCreateStatic xISRTimerCreateStatic
+ * \ingroup ISRTimers
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) || ( configUSE_HIGH_RES_TIMEOUTS == 1 ) )
+    ISRTimerHandle_t xISRTimerCreateStatic( ISRTimerCallbackFunction_t pxCallbackFunction,
+                                            void * pvTimerID,
+                                            StaticISRTimer_t * pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * void vISRTimerDelete( ISRTimerHandle_t xTimer );
+ * @endcode
+ *
+ * Stops the timer, if it is running, then deletes it.  Must not be called
+ * while the timer's callback function may be executing on another core.
+ *
+ * \defgroup vISRTimerDelete vISRTimerDelete
+ * \ingroup ISRTimers
+ */
+void vISRTimerDelete( ISRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * BaseType_t xISRTimerStart( ISRTimerHandle_t xTimer,
+ *                            uint64_t ullExpiryTimeUs,
+ *                            uint32_t ulPeriodUs );
+ * @endcode
+ *
+ * Starts, or restarts, a timer so it expires at the absolute time
+ * ullExpiryTimeUs.  The command takes effect immediately - there is no timer
+ * command queue.  If ullExpiryTimeUs is already in the past the callback
+ * executes as soon as the alarm interrupt can be taken.
+ *
+ * A periodic timer (ulPeriodUs not zero) is re-armed for exactly ulPeriodUs
+ * after its previous expiry time, so its period does not drift however late
+ * the callback executes.  If the interrupt was held off for so long that one
+ * or more whole periods were missed then the missed expiries are skipped
+ * rather than run back to back, and counted - see
+ * ulISRTimerGetOverrunCount().
+ *
+ * Must not be called from an interrupt - use xISRTimerStartFromISR() instead.
+ *
+ * @param xTimer The handle of the timer being started.
+ *
+ * @param ullExpiryTimeUs The time, in the time base returned by
+ * ullISRTimerGetTimeUs(), at which the timer should first expire.
+ *
+ * @param ulPeriodUs The period, in microseconds, of a periodic timer, or 0 for
+ * a one-shot timer.
+ *
+ * @return pdFAIL if configISR_TIMER_MAX_ACTIVE timers were already running,
+ * otherwise pdPASS.
+ *
+ * Example usage:
+ * @code{c}
+ * // Toggle a pin every 250us, starting 1ms from now.
+ * static void vPulseCallback( ISRTimerHandle_t xTimer,
+ *                             BaseType_t * pxHigherPriorityTaskWoken )
+ * {
+ *     vTogglePin();
+ * }
+ *
+ * void vStartPulses( void )
+ * {
+ *     ISRTimerHandle_t xPulseTimer = xISRTimerCreate( vPulseCallback, NULL );
+ *
+ *     xISRTimerStart( xPulseTimer, ullISRTimerGetTimeUs() + 1000, 250 );
+ * }
+ * @endcode
+ *
+ * \defgroup xISRTimerStart xISRTimerStart
+ * \ingroup ISRTimers
+ */
+BaseType_t xISRTimerStart( ISRTimerHandle_t xTimer,
+                           uint64_t ullExpiryTimeUs,
+                           uint32_t ulPeriodUs ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * BaseType_t xISRTimerStartFromISR( ISRTimerHandle_t xTimer,
+ *                                   uint64_t ullExpiryTimeUs,
+ *                                   uint32_t ulPeriodUs );
+ * @endcode
+ *
+ * A version of xISRTimerStart() that can be called from an interrupt service
+ * routine, including from an ISR timer callback function.
+ *
+ * \defgroup xISRTimerStartFromISR xISRTimerStartFromISR
+ * \ingroup ISRTimers
+ */
+BaseType_t xISRTimerStartFromISR( ISRTimerHandle_t xTimer,
+                                  uint64_t ullExpiryTimeUs,
+                                  uint32_t ulPeriodUs ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * BaseType_t xISRTimerStop( ISRTimerHandle_t xTimer );
+ * @endcode
+ *
+ * Stops a running timer.  The command takes effect immediately, but on a
+ * multicore part a callback that has already started executing on another
+ * core runs to completion.
+ *
+ * Must not be called from an interrupt - use xISRTimerStopFromISR() instead.
+ *
+ * @param xTimer The handle of the timer being stopped.
+ *
+ * @return pdPASS if the timer was running, otherwise pdFAIL.
+ *
+ * \defgroup xISRTimerStop xISRTimerStop
+ * \ingroup ISRTimers
+ */
+BaseType_t xISRTimerStop( ISRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * BaseType_t xISRTimerStopFromISR( ISRTimerHandle_t xTimer );
+ * @endcode
+ *
+ * A version of xISRTimerStop() that can be called from an interrupt service
+ * routine, including from an ISR timer callback function.
+ *
+ * \defgroup xISRTimerStopFromISR xISRTimerStopFromISR
+ * \ingroup ISRTimers
+ */
+BaseType_t xISRTimerStopFromISR( ISRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * BaseType_t xISRTimerIsActive( ISRTimerHandle_t xTimer );
+ * @endcode
+ *
+ * @return pdFALSE if the timer is dormant, otherwise pdTRUE.  A one-shot
+ * timer becomes dormant just before its callback function executes.
+ *
+ * \defgroup xISRTimerIsActive xISRTimerIsActive
+ * \ingroup ISRTimers
+ */
+BaseType_t xISRTimerIsActive( ISRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * void * pvISRTimerGetTimerID( ISRTimerHandle_t xTimer );
+ * @endcode
+ *
+ * @return The identifier assigned to the timer when it was created.
+ *
+ * \defgroup pvISRTimerGetTimerID pvISRTimerGetTimerID
+ * \ingroup ISRTimers
+ */
+void * pvISRTimerGetTimerID( ISRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * uint64_t ullISRTimerGetExpiryTime( ISRTimerHandle_t xTimer );
+ * @endcode
+ *
+ * @return The time at which the timer next expires.  Within the callback of a
+ * periodic timer this is already the time of the following expiry, so the
+ * expiry being handled is ullISRTimerGetExpiryTime() minus the period.  The
+ * value is undefined if the timer is dormant.
+ *
+ * \defgroup ullISRTimerGetExpiryTime ullISRTimerGetExpiryTime
+ * \ingroup ISRTimers
+ */
+uint64_t ullISRTimerGetExpiryTime( ISRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * uint32_t ulISRTimerGetOverrunCount( ISRTimerHandle_t xTimer );
+ * @endcode
+ *
+ * @return The number of expiries of a periodic timer that have been skipped
+ * since the timer was last started because the alarm interrupt was serviced
+ * more than a whole period late.
+ *
+ * \defgroup ulISRTimerGetOverrunCount ulISRTimerGetOverrunCount
+ * \ingroup ISRTimers
+ */
+uint32_t ulISRTimerGetOverrunCount( ISRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * isr_timer.h
+ *
+ * @code{c}
+ * uint64_t ullISRTimerGetTimeUs( void );
+ * @endcode
+ *
+ * @return The current time, in microseconds, of the time base against which
+ * ISR timer expiry times are measured.  The time base is provided by the port
+ * and is independent of the RTOS tick count.  Can be called from tasks and
+ * interrupts.
+ *
+ * \defgroup ullISRTimerGetTimeUs ullISRTimerGetTimeUs
+ * \ingroup ISRTimers
+ */
+uint64_t ullISRTimerGetTimeUs( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY INTENDED
+ * FOR USE BY THE PORT LAYER.
+ *
+ * Called from the interrupt raised by the alarm programmed by
+ * portISR_TIMER_SET_ALARM().  Executes the callback of every timer that has
+ * expired, then programs the alarm for the next timer to expire.  The alarm
+ * may fire early or spuriously - expiry times are always checked against
+ * portISR_TIMER_GET_TIME_US().
+ */
+void vISRTimerHandleAlarmFromISR( BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( ISR_TIMER_H ) */
@@ -0,0 +1,335 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A mailbox holds the most recently written value of a fixed size item - it
+ * is the "latest value register" that is otherwise built from a length one
+ * queue written with xQueueOverwrite() and read with xQueuePeek().
+ *
+ * Every write publishes the new value through a sequence counter.  Readers
+ * copy the value out without entering a critical section and retry if a write
+ * completed while they were copying, so reading a mailbox never blocks other
+ * tasks or interrupts.  Each write also increments the mailbox's version
+ * number, which readers can remember to cheaply test whether the value has
+ * changed since they last looked at it.
+ *
+ * Tasks that want to wait for a new value block on a direct to task
+ * notification (using index configMAILBOX_NOTIFICATION_INDEX) rather than on
+ * a kernel event list, so writers only pay for waking tasks that are actually
+ * waiting.
+ *
+ * configUSE_MAILBOXES must be set to 1 in FreeRTOSConfig.h for the mailbox
+ * API to be available.
+ */
+
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include mailbox.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which mailboxes are referenced.  For example, a call to
+ * xMailboxCreate() returns a MailboxHandle_t variable that can then be used
+ * as a parameter to ulMailboxWrite(), xMailboxRead(), etc.
+ */
+struct MailboxDef_t;
+typedef struct MailboxDef_t * MailboxHandle_t;
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * MailboxHandle_t xMailboxCreate( size_t xItemSize );
+ * @endcode
+ *
+ * Creates a new mailbox using dynamically allocated memory.  The mailbox
+ * structure and the storage for one item are allocated in a single call to
+ * pvPortMalloc().
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xMailboxCreate() to be available.
+ *
+ * @param xItemSize The size, in bytes, of the value held by the mailbox.
+ *
+ * @return The handle of the created mailbox, or NULL if there was not enough
+ * heap memory available to create it.  The mailbox holds no value until it is
+ * first written.
+ *
+ * \defgroup xMailboxCreate xMailboxCreate
+ * \ingroup Mailboxes
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    MailboxHandle_t xMailboxCreate( size_t xItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * MailboxHandle_t xMailboxCreateStatic( size_t xItemSize,
+ *                                       uint8_t * pucMailboxStorage,
+ *                                       StaticMailbox_t * pxStaticMailbox );
+ * @endcode
+ *
+ * Creates a new mailbox using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xMailboxCreateStatic() to be available.
+ *
+ * @param xItemSize The size, in bytes, of the value held by the mailbox.
+ *
+ * @param pucMailboxStorage Must point to a buffer of at least xItemSize bytes
+ * that will hold the mailbox's value.
+ *
+ * @param pxStaticMailbox Must point to a variable of type StaticMailbox_t,
+ * which will be used to hold the mailbox's data structure.
+ *
+ * @return The handle of the created mailbox, or NULL if either buffer was NULL.
+ *
+ * \defgroup xMailboxCreateStatic xMailboxCreateStatic
+ * \ingroup Mailboxes
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    MailboxHandle_t xMailboxCreateStatic( size_t xItemSize,
+                                          uint8_t * pucMailboxStorage,
+                                          StaticMailbox_t * pxStaticMailbox ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * void vMailboxDelete( MailboxHandle_t xMailbox );
+ * @endcode
+ *
+ * Deletes a mailbox that was created using xMailboxCreate() or
+ * xMailboxCreateStatic().  No task may be blocked in xMailboxWaitForChange()
+ * on the mailbox when it is deleted.
+ *
+ * \defgroup vMailboxDelete vMailboxDelete
+ * \ingroup Mailboxes
+ */
+void vMailboxDelete( MailboxHandle_t xMailbox ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * uint32_t ulMailboxWrite( MailboxHandle_t xMailbox, const void * pvItem );
+ * @endcode
+ *
+ * Replaces the value held in the mailbox with the item pointed to by pvItem,
+ * then unblocks every task waiting in xMailboxWaitForChange().  Writing never
+ * blocks - the previous value is simply overwritten.
+ *
+ * The item is copied into the mailbox inside a short critical section, which
+ * guarantees readers on the same core never observe a half written value.
+ * Use ulMailboxWriteFromISR() to write from an interrupt.
+ *
+ * @param xMailbox The handle of the mailbox being written.
+ *
+ * @param pvItem A pointer to the item to copy into the mailbox.  xItemSize
+ * bytes (as passed when the mailbox was created) are copied.
+ *
+ * @return The version number of the value just written.  The first write
+ * to a mailbox produces version 1.  Version numbers wrap from 0x7FFFFFFF back
+ * to 1, never to 0.
+ *
+ * \defgroup ulMailboxWrite ulMailboxWrite
+ * \ingroup Mailboxes
+ */
+uint32_t ulMailboxWrite( MailboxHandle_t xMailbox,
+                         const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * uint32_t ulMailboxWriteFromISR( MailboxHandle_t xMailbox,
+ *                                 const void * pvItem,
+ *                                 BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of ulMailboxWrite() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing the mailbox
+ * unblocked a task that has a priority above the currently running task, in
+ * which case a context switch should be requested before the interrupt exits.
+ * Must be initialised to pdFALSE before it is passed in.
+ *
+ * @return The version number of the value just written.
+ *
+ * \defgroup ulMailboxWriteFromISR ulMailboxWriteFromISR
+ * \ingroup Mailboxes
+ */
+uint32_t ulMailboxWriteFromISR( MailboxHandle_t xMailbox,
+                                const void * pvItem,
+                                BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * BaseType_t xMailboxRead( MailboxHandle_t xMailbox,
+ *                          void * pvBuffer,
+ *                          uint32_t * pulVersion );
+ * @endcode
+ *
+ * Copies the latest value out of the mailbox.  The read does not enter a
+ * critical section.  If a writer on another core updates the mailbox while
+ * the value is being copied the copy is retried, so the value returned is
+ * always one that was written as a whole.  xMailboxRead() can be called from
+ * tasks and from interrupts.
+ *
+ * @param xMailbox The handle of the mailbox being read.
+ *
+ * @param pvBuffer Pointer to the buffer into which the value is copied.
+ *
+ * @param pulVersion If not NULL, the version number of the value copied into
+ * pvBuffer is written to *pulVersion.
+ *
+ * @return pdPASS if a value was copied out, or pdFAIL if the mailbox has never
+ * been written.
+ *
+ * \defgroup xMailboxRead xMailboxRead
+ * \ingroup Mailboxes
+ */
+BaseType_t xMailboxRead( MailboxHandle_t xMailbox,
+                         void * pvBuffer,
+                         uint32_t * pulVersion ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * BaseType_t xMailboxReadIfChanged( MailboxHandle_t xMailbox,
+ *                                   void * pvBuffer,
+ *                                   uint32_t * pulVersion );
+ * @endcode
+ *
+ * Copies the latest value out of the mailbox only if its version differs from
+ * *pulVersion.  Periodic tasks can use this to skip work when an input has not
+ * been updated since the last cycle - *pulVersion should be initialised to 0
+ * so the first value written is always returned.
+ *
+ * @param pulVersion On entry, the version of the value the caller already
+ * holds.  Updated to the version of the value copied into pvBuffer when the
+ * function returns pdTRUE.
+ *
+ * @return pdTRUE if a newer value was copied into pvBuffer, otherwise pdFALSE.
+ *
+ * \defgroup xMailboxReadIfChanged xMailboxReadIfChanged
+ * \ingroup Mailboxes
+ */
+BaseType_t xMailboxReadIfChanged( MailboxHandle_t xMailbox,
+                                  void * pvBuffer,
+                                  uint32_t * pulVersion ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * uint32_t ulMailboxGetVersion( MailboxHandle_t xMailbox );
+ * @endcode
+ *
+ * @return The version number of the value currently held in the mailbox, or 0
+ * if the mailbox has never been written.
+ *
+ * \defgroup ulMailboxGetVersion ulMailboxGetVersion
+ * \ingroup Mailboxes
+ */
+uint32_t ulMailboxGetVersion( MailboxHandle_t xMailbox ) PRIVILEGED_FUNCTION;
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * BaseType_t xMailboxHasChanged( MailboxHandle_t xMailbox, uint32_t ulVersion );
+ * @endcode
+ *
+ * @return pdTRUE if the mailbox has been written since the value with version
+ * ulVersion was read, otherwise pdFALSE.
+ *
+ * \defgroup xMailboxHasChanged xMailboxHasChanged
+ * \ingroup Mailboxes
+ */
+#define xMailboxHasChanged( xMailbox, ulVersion ) \
+    ( ( ulMailboxGetVersion( ( xMailbox ) ) != ( ulVersion ) ) ? pdTRUE : pdFALSE )
+
+/**
+ * mailbox.h
+ *
+ * @code{c}
+ * BaseType_t xMailboxWaitForChange( MailboxHandle_t xMailbox,
+ *                                   void * pvBuffer,
+ *                                   uint32_t * pulVersion,
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Blocks the calling task until the mailbox holds a value with a version that
+ * differs from *pulVersion, then copies that value out.  Returns immediately
+ * if the mailbox has already changed.  The calling task waits on its direct to
+ * task notification at index configMAILBOX_NOTIFICATION_INDEX, which must
+ * therefore not be used for any other purpose by tasks that wait on mailboxes.
+ *
+ * @param pvBuffer Pointer to the buffer into which the new value is copied.
+ *
+ * @param pulVersion On entry, the version of the value the caller already
+ * holds.  Updated to the version of the value copied into pvBuffer when the
+ * function returns pdTRUE.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state waiting for the mailbox to change.
+ *
+ * @return pdTRUE if a newer value was copied into pvBuffer, or pdFALSE if the
+ * block time expired before the mailbox was written.
+ *
+ * \defgroup xMailboxWaitForChange xMailboxWaitForChange
+ * \ingroup Mailboxes
+ */
+BaseType_t xMailboxWaitForChange( MailboxHandle_t xMailbox,
+                                  void * pvBuffer,
+                                  uint32_t * pulVersion,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MAILBOX_H ) */
@@ -387,6 +387,27 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferSend( xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait ) \
     xStreamBufferSend( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendV( MessageBufferHandle_t xMessageBuffer,
+ *                             const StreamBufferVector_t *pxVectors,
+ *                             size_t xVectorCount,
+ *                             TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends a discrete message to the message buffer, gathering the message from
+ * xVectorCount separate fragments that are copied straight into the message
+ * buffer.  The fragments together form one message of their total length.
+ * See xStreamBufferSendV() for details.
+ *
+ * \defgroup xMessageBufferSendV xMessageBufferSendV
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendV( xMessageBuffer, pxVectors, xVectorCount, xTicksToWait ) \
+    xStreamBufferSendV( ( xMessageBuffer ), ( pxVectors ), ( xVectorCount ), ( xTicksToWait ) )
+
 /**
  * message_buffer.h
  *
@@ -587,6 +608,27 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) \
     xStreamBufferReceive( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveV( MessageBufferHandle_t xMessageBuffer,
+ *                                const StreamBufferVector_t *pxVectors,
+ *                                size_t xVectorCount,
+ *                                TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives a discrete message from the message buffer, scattering it across
+ * xVectorCount separate fragments that are filled in turn.  The message is
+ * only received if the total length of the fragments is large enough to hold
+ * it.  See xStreamBufferReceiveV() for details.
+ *
+ * \defgroup xMessageBufferReceiveV xMessageBufferReceiveV
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveV( xMessageBuffer, pxVectors, xVectorCount, xTicksToWait ) \
+    xStreamBufferReceiveV( ( xMessageBuffer ), ( pxVectors ), ( xVectorCount ), ( xTicksToWait ) )
+
 
 /**
  * message_buffer.h
@@ -958,6 +1000,80 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveCompletedFromISR( ( xMessageBuffer ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xMessageBufferSetMaxMessageAge( MessageBufferHandle_t xMessageBuffer, TickType_t xMaxMessageAge );
+ * @endcode
+ *
+ * Makes a message buffer timestamped, so messages that have been in the buffer
+ * for more than xMaxMessageAge ticks are discarded rather than received.  Each
+ * message then uses an extra sizeof( TickType_t ) bytes of the buffer.  See
+ * xStreamBufferSetMaxMessageAge() for details.
+ *
+ * configUSE_TIMESTAMPED_MESSAGES must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferSetMaxMessageAge() to be available.
+ *
+ * \defgroup xMessageBufferSetMaxMessageAge xMessageBufferSetMaxMessageAge
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSetMaxMessageAge( xMessageBuffer, xMaxMessageAge ) \
+    xStreamBufferSetMaxMessageAge( ( xMessageBuffer ), ( xMaxMessageAge ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * void vMessageBufferGetAgeStats( MessageBufferHandle_t xMessageBuffer, StreamBufferAgeStats_t *pxAgeStats, BaseType_t xReset );
+ * @endcode
+ *
+ * Retrieves the age statistics of a timestamped message buffer.  See
+ * vStreamBufferGetAgeStats() for details.
+ *
+ * \defgroup vMessageBufferGetAgeStats vMessageBufferGetAgeStats
+ * \ingroup MessageBufferManagement
+ */
+#define vMessageBufferGetAgeStats( xMessageBuffer, pxAgeStats, xReset ) \
+    vStreamBufferGetAgeStats( ( xMessageBuffer ), ( pxAgeStats ), ( xReset ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xMessageBufferSetOverwrite( MessageBufferHandle_t xMessageBuffer, BaseType_t xOverwrite );
+ * @endcode
+ *
+ * Switches a message buffer into or out of overwrite mode, in which sending a
+ * message never blocks and the oldest whole messages are discarded to make
+ * space for it.  See xStreamBufferSetOverwrite() for details.
+ *
+ * configUSE_STREAM_BUFFER_OVERWRITE must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferSetOverwrite() to be available.
+ *
+ * \defgroup xMessageBufferSetOverwrite xMessageBufferSetOverwrite
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSetOverwrite( xMessageBuffer, xOverwrite ) \
+    xStreamBufferSetOverwrite( ( xMessageBuffer ), ( xOverwrite ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * void vMessageBufferGetDroppedCounts( MessageBufferHandle_t xMessageBuffer, size_t *pxBytesDropped, UBaseType_t *puxMessagesDropped, BaseType_t xReset );
+ * @endcode
+ *
+ * Retrieves the number of messages, and the bytes of data they held, discarded
+ * while the message buffer was in overwrite mode.  See
+ * vStreamBufferGetDroppedCounts() for details.
+ *
+ * \defgroup vMessageBufferGetDroppedCounts vMessageBufferGetDroppedCounts
+ * \ingroup MessageBufferManagement
+ */
+#define vMessageBufferGetDroppedCounts( xMessageBuffer, pxBytesDropped, puxMessagesDropped, xReset ) \
+    vStreamBufferGetDroppedCounts( ( xMessageBuffer ), ( pxBytesDropped ), ( puxMessagesDropped ), ( xReset ) )
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     } /* extern "C" */
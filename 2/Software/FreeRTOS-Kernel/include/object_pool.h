@@ -0,0 +1,156 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Object pools hold a fixed number of fixed size blocks for each kind of
+ * kernel object that is created and deleted at run time - task control
+ * blocks, queues (including semaphores and mutexes), software timers, and
+ * task stacks of up to three common sizes.  The storage for each pool is
+ * allocated statically, and the number of blocks in each pool is set in
+ * FreeRTOSConfig.h.
+ *
+ * When configUSE_OBJECT_POOLS is set to 1 the kernel takes the memory for a
+ * dynamically created object from its pool, and returns it there when the
+ * object is deleted.  Taking and returning a block are constant time
+ * operations that only hold a critical section for a few instructions, and,
+ * as every block in a pool has the same size, creating and deleting objects
+ * cannot fragment the pool.  If a pool is empty, or a queue's storage or a
+ * task's stack is too large for any pool, the memory is allocated from the
+ * heap with pvPortMalloc() as normal.  vObjectPoolGetStats() reports how close
+ * each pool has come to running out, so the pool lengths can be tuned until
+ * the heap is never used for kernel objects after initialisation.
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include object_pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Identifies each of the object pools. */
+typedef enum
+{
+    eObjectPoolTask = 0,    /* Task control blocks. */
+    eObjectPoolQueue,       /* Queues, semaphores and mutexes. */
+    eObjectPoolTimer,       /* Software timers. */
+    eObjectPoolStackSmall,  /* Task stacks of up to configSTACK_POOL_SMALL_DEPTH words. */
+    eObjectPoolStackMedium, /* Task stacks of up to configSTACK_POOL_MEDIUM_DEPTH words. */
+    eObjectPoolStackLarge   /* Task stacks of up to configSTACK_POOL_LARGE_DEPTH words. */
+} eObjectPool;
+
+/* Used to pass information about an object pool out of vObjectPoolGetStats(). */
+typedef struct xOBJECT_POOL_STATS
+{
+    size_t xBlockSize;                   /* The size of each block in the pool, in bytes. */
+    UBaseType_t uxLength;                /* The number of blocks in the pool. */
+    UBaseType_t uxFreeBlocks;            /* The number of blocks in the pool that are not in use. */
+    UBaseType_t uxMinimumEverFreeBlocks; /* The lowest value uxFreeBlocks has had since the system booted. */
+    size_t xNumberOfFallbacks;           /* The number of objects allocated from the heap because the pool was empty. */
+} ObjectPoolStats_t;
+
+/**
+ * object_pool.h
+ *
+ * @code{c}
+ * void vObjectPoolGetStats( eObjectPool ePool, ObjectPoolStats_t * pxPoolStats );
+ * @endcode
+ *
+ * Returns information about the use of an object pool.  A pool whose length
+ * is 0 in FreeRTOSConfig.h reports a length of 0 and no fallbacks.
+ *
+ * configUSE_OBJECT_POOLS must be set to 1 in FreeRTOSConfig.h for
+ * vObjectPoolGetStats() to be available.
+ *
+ * @param ePool The pool to query.
+ *
+ * @param pxPoolStats Pointer to the structure into which the information is
+ * written.
+ *
+ * \defgroup vObjectPoolGetStats vObjectPoolGetStats
+ * \ingroup ObjectPools
+ */
+#if ( configUSE_OBJECT_POOLS == 1 )
+    void vObjectPoolGetStats( eObjectPool ePool,
+                              ObjectPoolStats_t * pxPoolStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * This function resets the internal state of the object pool module.  It must
+ * be called by the application before restarting the scheduler.
+ */
+#if ( configUSE_OBJECT_POOLS == 1 )
+    void vObjectPoolResetState( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*-----------------------------------------------------------
+* SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
+*----------------------------------------------------------*/
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  They are used by
+ * the kernel to allocate and free the memory of dynamically created objects.
+ *
+ * pvObjectPoolMalloc() takes a block from ePool if xWantedSize fits in it, and
+ * otherwise calls pvPortMalloc().  pvObjectPoolMallocStack() takes a block from
+ * the smallest stack pool that has a free block large enough, and otherwise
+ * calls pvPortMallocStack().  vObjectPoolFree() and vObjectPoolFreeStack()
+ * return the memory to the pool it came from, or call vPortFree() or
+ * vPortFreeStack() if it did not come from a pool.
+ */
+#if ( configUSE_OBJECT_POOLS == 1 )
+    void * pvObjectPoolMalloc( eObjectPool ePool,
+                               size_t xWantedSize ) PRIVILEGED_FUNCTION;
+    void vObjectPoolFree( void * pv ) PRIVILEGED_FUNCTION;
+    void * pvObjectPoolMallocStack( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+    void vObjectPoolFreeStack( void * pv ) PRIVILEGED_FUNCTION;
+
+    #define poolMALLOC( ePool, xWantedSize )    pvObjectPoolMalloc( ( ePool ), ( xWantedSize ) )
+    #define poolFREE( pv )                      vObjectPoolFree( pv )
+    #define poolMALLOC_STACK( xWantedSize )     pvObjectPoolMallocStack( xWantedSize )
+    #define poolFREE_STACK( pv )                vObjectPoolFreeStack( pv )
+#else
+    #define poolMALLOC( ePool, xWantedSize )    pvPortMalloc( xWantedSize )
+    #define poolFREE( pv )                      vPortFree( pv )
+    #define poolMALLOC_STACK( xWantedSize )     pvPortMallocStack( xWantedSize )
+    #define poolFREE_STACK( pv )                vPortFreeStack( pv )
+#endif /* configUSE_OBJECT_POOLS */
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* OBJECT_POOL_H */
@@ -186,6 +186,46 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * heap_6.c can keep a second heap for large memory that is slower to access,
+ * such as external PSRAM.  pvPortMallocFast() allocates from the normal heap,
+ * and pvPortMallocBulk() allocates from the bulk heap.  pvPortMallocBulk()
+ * returns NULL when the bulk heap cannot satisfy the request, unless
+ * configHEAP_BULK_FALLBACK_TO_FAST is 1, in which case it falls back to the
+ * normal heap.  Memory from either is freed with vPortFree().  When configHEAP_USE_BULK_REGIONS is not
+ * 1 both map to pvPortMalloc().
+ */
+#if ( configHEAP_USE_BULK_REGIONS == 1 )
+    void * pvPortMallocFast( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+    void * pvPortMallocBulk( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+    void vPortDefineBulkHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
+    void vPortGetBulkHeapStats( HeapStats_t * pxHeapStats );
+    size_t xPortGetFreeBulkHeapSize( void ) PRIVILEGED_FUNCTION;
+#else
+    #define pvPortMallocFast    pvPortMalloc
+    #define pvPortMallocBulk    pvPortMalloc
+#endif
+
+/*
+ * heap_4.c can give each core a cache of small free blocks, see
+ * configHEAP_USE_CORE_CACHES.  vPortHeapFlushCoreCache() returns the blocks
+ * cached by the calling core to the heap.
+ */
+#if ( configHEAP_USE_CORE_CACHES == 1 )
+    void vPortHeapFlushCoreCache( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Called by the heap implementations, through traceMALLOC() and traceFREE(),
+ * to record allocations in the heap trace.  See heap_trace.h.
+ */
+#if ( configUSE_HEAP_TRACE == 1 )
+    void vHeapTraceMalloc( void * pvAddress,
+                           size_t xSize,
+                           void * pvCaller ) PRIVILEGED_FUNCTION;
+    void vHeapTraceFree( void * pvAddress ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
     void * pvPortMallocStack( size_t xSize ) PRIVILEGED_FUNCTION;
     void vPortFreeStack( void * pv ) PRIVILEGED_FUNCTION;
@@ -64,10 +64,38 @@ typedef struct QueueDefinition   * QueueSetHandle_t;
  */
 typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 
+/**
+ * Age statistics of a queue created with xQueueCreateTimestamped(), as returned
+ * by vQueueGetAgeStats().
+ */
+typedef struct xQUEUE_AGE_STATS
+{
+    UBaseType_t uxItemsReceived; /**< The number of items received from the queue. */
+    UBaseType_t uxItemsExpired;  /**< The number of items discarded because they expired before they were received. */
+    TickType_t xTotalAge;        /**< The sum of the ages, in ticks, of the items received.  Wraps on overflow. */
+    TickType_t xMaxAge;          /**< The age, in ticks, of the oldest item received. */
+} QueueAgeStats_t;
+
+/**
+ * Performance counters of a queue, as returned by vQueueGetPerfCounters().
+ */
+typedef struct xQUEUE_PERF_COUNTERS
+{
+    UBaseType_t uxHighWaterMark;   /**< The largest number of items the queue has held. */
+    uint32_t ulSends;              /**< The number of items sent to the queue. */
+    uint32_t ulReceives;           /**< The number of items received from the queue. */
+    uint32_t ulBlockedSends;       /**< The number of sends that had to wait for space because the queue was full. */
+    uint32_t ulBlockedReceives;    /**< The number of receives that had to wait for an item because the queue was empty. */
+    TickType_t xTotalBlockedTime;  /**< The sum of the times, in ticks, senders and receivers waited.  Wraps on overflow. */
+    TickType_t xMaxBlockedTime;    /**< The longest time, in ticks, a sender or receiver waited. */
+    uint32_t ulResidenceHistogram[ configQUEUE_PERF_HISTOGRAM_BUCKETS ]; /**< The number of items received after spending 0 ticks in the queue (bucket 0), 1 tick (bucket 1), 2 to 3 ticks (bucket 2), 4 to 7 ticks (bucket 3) and so on, with the last bucket counting all longer times.  Only updated for queues created with xQueueCreateTimestamped(). */
+} QueuePerfCounters_t;
+
 /* For internal use only. */
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
 #define queueOVERWRITE                        ( ( BaseType_t ) 2 )
+#define queueSEND_WITH_PRIORITY( uxPriority )    ( ( BaseType_t ) 3 + ( BaseType_t ) ( uxPriority ) )
 
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE                  ( ( uint8_t ) 0U )
@@ -688,6 +716,41 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                               TickType_t xTicksToWait,
                               const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendUs( QueueHandle_t xQueue, const void * pvItemToQueue, uint32_t ulTimeoutUs );
+ *
+ * BaseType_t xQueueSendToBackUs( QueueHandle_t xQueue, const void * pvItemToQueue, uint32_t ulTimeoutUs );
+ *
+ * BaseType_t xQueueSendToFrontUs( QueueHandle_t xQueue, const void * pvItemToQueue, uint32_t ulTimeoutUs );
+ * @endcode
+ *
+ * configUSE_HIGH_RES_TIMEOUTS must be set to 1 in FreeRTOSConfig.h for these
+ * macros to be available.
+ *
+ * Versions of xQueueSend(), xQueueSendToBack() and xQueueSendToFront() that
+ * take the block time in microseconds rather than ticks.  The block time ends
+ * when the time returned by ullISRTimerGetTimeUs() reaches the time at which
+ * the function was called plus ulTimeoutUs, without waiting for the next tick
+ * interrupt.  See xTaskDelayUntilUs() for how the timeout is implemented.
+ *
+ * \defgroup xQueueSendUs xQueueSendUs
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    BaseType_t xQueueGenericSendUs( QueueHandle_t xQueue,
+                                    const void * const pvItemToQueue,
+                                    uint32_t ulTimeoutUs,
+                                    const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+    #define xQueueSendUs( xQueue, pvItemToQueue, ulTimeoutUs ) \
+    xQueueGenericSendUs( ( xQueue ), ( pvItemToQueue ), ( ulTimeoutUs ), queueSEND_TO_BACK )
+    #define xQueueSendToBackUs( xQueue, pvItemToQueue, ulTimeoutUs ) \
+    xQueueGenericSendUs( ( xQueue ), ( pvItemToQueue ), ( ulTimeoutUs ), queueSEND_TO_BACK )
+    #define xQueueSendToFrontUs( xQueue, pvItemToQueue, ulTimeoutUs ) \
+    xQueueGenericSendUs( ( xQueue ), ( pvItemToQueue ), ( ulTimeoutUs ), queueSEND_TO_FRONT )
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -914,6 +977,27 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveUs( QueueHandle_t xQueue, void * pvBuffer, uint32_t ulTimeoutUs );
+ * @endcode
+ *
+ * configUSE_HIGH_RES_TIMEOUTS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * A version of xQueueReceive() that takes the block time in microseconds rather
+ * than ticks.  See xQueueSendUs().
+ *
+ * \defgroup xQueueReceiveUs xQueueReceiveUs
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    BaseType_t xQueueReceiveUs( QueueHandle_t xQueue,
+                                void * const pvBuffer,
+                                uint32_t ulTimeoutUs ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -1516,6 +1600,11 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    BaseType_t xQueueSemaphoreTakeUs( QueueHandle_t xQueue,
+                                      uint32_t ulTimeoutUs ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
     TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
@@ -1595,6 +1684,56 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
     const char * pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * Iterates over the queues in the queue registry, for example to find the
+ * queue that is the bottleneck of a pipeline using vQueueGetPerfCounters().
+ * Set *puxIndex to 0 before the first call, then call repeatedly until pdFALSE
+ * is returned:
+ *
+ * UBaseType_t uxIndex = 0;
+ * QueueHandle_t xQueue;
+ * const char * pcName;
+ *
+ * while( xQueueGetNextRegistryEntry( &uxIndex, &xQueue, &pcName ) != pdFALSE )
+ * {
+ *     vQueueGetPerfCounters( xQueue, &xCounters, pdFALSE );
+ * }
+ *
+ * As with pcQueueGetName(), there is nothing to protect against another task
+ * adding or removing entries from the registry during the iteration.
+ *
+ * @param puxIndex The position in the registry from which to search.  Updated
+ * to the position after the entry found.
+ * @param pxQueue Set to the handle of the queue found.
+ * @param ppcQueueName Set to the name of the queue found.
+ * @return pdTRUE if an entry was found, otherwise pdFALSE.
+ */
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+    BaseType_t xQueueGetNextRegistryEntry( UBaseType_t * puxIndex,
+                                           QueueHandle_t * pxQueue,
+                                           const char ** ppcQueueName ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Retrieves the performance counters of a queue, semaphore or mutex - the
+ * high water mark, the number of sends and receives, the number of each that
+ * had to wait and for how long, and, for queues created with
+ * xQueueCreateTimestamped(), a histogram of the time items spent in the queue.
+ *
+ * configUSE_QUEUE_PERF_COUNTERS must be set to 1 in FreeRTOSConfig.h for
+ * vQueueGetPerfCounters() to be available.
+ *
+ * @param xQueue The handle of the queue being queried.
+ * @param pxCounters The structure into which the counters are copied.
+ * @param xReset Set to pdTRUE to clear the counters after they are copied.
+ * The high water mark is then set to the number of items in the queue.
+ */
+#if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+    void vQueueGetPerfCounters( QueueHandle_t xQueue,
+                                QueuePerfCounters_t * pxCounters,
+                                BaseType_t xReset ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to create a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -1631,6 +1770,317 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
                                               StaticQueue_t ** ppxStaticQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+/* The maximum number of priority levels a priority queue can have. */
+#define queuePRIORITY_LEVELS_MAX    ( ( UBaseType_t ) 32U )
+
+/* The number of bytes of storage a priority queue requires for each item and
+ * in total.  Each item is stored with a link to the next item of the same
+ * priority, and the storage starts with the head and tail of each level. */
+#define queuePRIORITY_SLOT_SIZE( uxItemSize ) \
+    ( sizeof( UBaseType_t ) + ( ( ( size_t ) ( uxItemSize ) + sizeof( UBaseType_t ) - 1U ) & ~( sizeof( UBaseType_t ) - 1U ) ) )
+
+#define queuePRIORITY_STORAGE_SIZE( uxQueueLength, uxItemSize, uxPriorityLevels )         \
+    ( ( ( 3U + ( 2U * ( size_t ) ( uxPriorityLevels ) ) ) * sizeof( UBaseType_t ) ) + \
+      ( ( size_t ) ( uxQueueLength ) * queuePRIORITY_SLOT_SIZE( uxItemSize ) ) )
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriority(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            UBaseType_t uxPriorityLevels
+ *                        );
+ * @endcode
+ *
+ * Creates a priority queue and returns a handle by which the queue can be
+ * referenced.  configUSE_PRIORITY_QUEUES must be set to 1 in FreeRTOSConfig.h
+ * for this function to be available.
+ *
+ * Each item sent to a priority queue with xQueueSendWithPriority() carries a
+ * priority from 0 (the lowest) to ( uxPriorityLevels - 1 ).  Receiving from
+ * the queue always returns the oldest item of the highest priority present, so
+ * urgent items do not wait behind less urgent items that were sent earlier.
+ * Items of each priority are held in their own list, and a bitmap records
+ * which lists are not empty, so sending and receiving take constant time
+ * regardless of how many items are queued.
+ *
+ * The queue is otherwise used like any other queue: xQueueReceive(),
+ * xQueuePeek(), the ISR versions of those functions, blocking and queue sets
+ * all behave as normal.  xQueueSend() and xQueueSendToBack() send at the lowest
+ * priority, xQueueSendToFront() sends ahead of all items of the highest
+ * priority.  Priority queues cannot be used with co-routines.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold, across
+ * all priorities.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @param uxPriorityLevels The number of priorities, from 1 to
+ * queuePRIORITY_LEVELS_MAX.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  Otherwise NULL is returned.
+ * \defgroup xQueueCreatePriority xQueueCreatePriority
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreatePriority( const UBaseType_t uxQueueLength,
+                                        const UBaseType_t uxItemSize,
+                                        const UBaseType_t uxPriorityLevels ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriorityStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            UBaseType_t uxPriorityLevels,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a priority queue using statically allocated memory.  See
+ * xQueueCreatePriority() for a description of priority queues.
+ *
+ * @param pucQueueStorage Must point to a buffer of at least
+ * queuePRIORITY_STORAGE_SIZE( uxQueueLength, uxItemSize, uxPriorityLevels )
+ * bytes, aligned to the size of a UBaseType_t.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  Otherwise NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ #define QUEUE_LENGTH 10
+ #define LEVELS 4
+ *
+ * StaticQueue_t xQueueBuffer;
+ * UBaseType_t uxQueueStorage[ queuePRIORITY_STORAGE_SIZE( QUEUE_LENGTH, sizeof( uint32_t ), LEVELS ) / sizeof( UBaseType_t ) ];
+ *
+ * void vATask( void *pvParameters )
+ * {
+ *  QueueHandle_t xQueue;
+ *  uint32_t ulCommand = 0;
+ *
+ *  xQueue = xQueueCreatePriorityStatic( QUEUE_LENGTH, sizeof( uint32_t ), LEVELS,
+ *                                       ( uint8_t * ) uxQueueStorage, &xQueueBuffer );
+ *
+ *  // Routine traffic is sent at priority 0, urgent commands at priority 3.
+ *  // A receiver gets the urgent command first.
+ *  xQueueSendWithPriority( xQueue, &ulCommand, 0, 0 );
+ *  xQueueSendWithPriority( xQueue, &ulCommand, 3, 0 );
+ * }
+ * @endcode
+ * \defgroup xQueueCreatePriorityStatic xQueueCreatePriorityStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreatePriorityStatic( const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              const UBaseType_t uxPriorityLevels,
+                                              uint8_t * pucQueueStorage,
+                                              StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithPriority(
+ *                                   QueueHandle_t xQueue,
+ *                                   const void *pvItemToQueue,
+ *                                   UBaseType_t uxPriority,
+ *                                   TickType_t xTicksToWait
+ *                               );
+ * @endcode
+ *
+ * Post an item with the given priority to a queue created with
+ * xQueueCreatePriority() or xQueueCreatePriorityStatic().  The item is placed
+ * behind any items of the same priority and ahead of all items of a lower
+ * priority.  Must not be used with queues that were not created as priority
+ * queues.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param uxPriority The priority of the item, which must be less than the
+ * number of priority levels the queue was created with.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.
+ *
+ * @return pdTRUE if the item was successfully posted, otherwise errQUEUE_FULL.
+ * \defgroup xQueueSendWithPriority xQueueSendWithPriority
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+    #define xQueueSendWithPriority( xQueue, pvItemToQueue, uxPriority, xTicksToWait ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_WITH_PRIORITY( uxPriority ) )
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithPriorityFromISR(
+ *                                   QueueHandle_t xQueue,
+ *                                   const void *pvItemToQueue,
+ *                                   UBaseType_t uxPriority,
+ *                                   BaseType_t *pxHigherPriorityTaskWoken
+ *                               );
+ * @endcode
+ *
+ * A version of xQueueSendWithPriority() that can be called from an interrupt
+ * service routine.  pxHigherPriorityTaskWoken is used as by
+ * xQueueSendFromISR().
+ * \defgroup xQueueSendWithPriorityFromISR xQueueSendWithPriorityFromISR
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+    #define xQueueSendWithPriorityFromISR( xQueue, pvItemToQueue, uxPriority, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_WITH_PRIORITY( uxPriority ) )
+#endif
+
+/* The number of bytes of storage a timestamped queue requires.  The items are
+ * followed by the tick count at which each was sent. */
+#define queueTIMESTAMPED_STORAGE_SIZE( uxQueueLength, uxItemSize )                                                      \
+    ( ( ( ( ( size_t ) ( uxQueueLength ) * ( size_t ) ( uxItemSize ) ) + sizeof( TickType_t ) - 1U ) & ~( sizeof( TickType_t ) - 1U ) ) + \
+      ( ( size_t ) ( uxQueueLength ) * sizeof( TickType_t ) ) )
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateTimestamped(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            TickType_t xMaxItemAge
+ *                        );
+ * @endcode
+ *
+ * Creates a queue that records the tick count at which each item was sent.
+ * configUSE_TIMESTAMPED_MESSAGES must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Items that have been in the queue for more than xMaxItemAge ticks have
+ * expired.  Expired items at the front of the queue are discarded, without
+ * being copied out, when the queue is received from or peeked, and when a
+ * task or interrupt sends to the queue while it is full - so a sender makes
+ * room by evicting stale items rather than blocking behind them.  The number
+ * of items discarded, and the age of the items received, are available from
+ * vQueueGetAgeStats().
+ *
+ * Items are discarded in order from the front of the queue, so an expired item
+ * that is behind an item sent with xQueueSendToFront() is discarded once it
+ * reaches the front.  xQueuePeekFromISR() does not discard expired items, and
+ * a task that is already blocked waiting to send is not unblocked when an item
+ * expires, only when an item is discarded or received.
+ *
+ * @param uxQueueLength The maximum number of items the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @param xMaxItemAge The maximum time, in ticks, an item can wait in the queue
+ * and still be received.  portMAX_DELAY means items never expire, which is
+ * useful to collect age statistics only.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  Otherwise NULL is returned.
+ * \defgroup xQueueCreateTimestamped xQueueCreateTimestamped
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_TIMESTAMPED_MESSAGES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateTimestamped( const UBaseType_t uxQueueLength,
+                                           const UBaseType_t uxItemSize,
+                                           const TickType_t xMaxItemAge ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateTimestampedStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            TickType_t xMaxItemAge,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a timestamped queue using statically allocated memory.  See
+ * xQueueCreateTimestamped() for a description of timestamped queues.
+ *
+ * @param pucQueueStorage Must point to a buffer of at least
+ * queueTIMESTAMPED_STORAGE_SIZE( uxQueueLength, uxItemSize ) bytes, aligned to
+ * the size of a TickType_t.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  Otherwise NULL is returned.
+ * \defgroup xQueueCreateTimestampedStatic xQueueCreateTimestampedStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_TIMESTAMPED_MESSAGES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateTimestampedStatic( const UBaseType_t uxQueueLength,
+                                                 const UBaseType_t uxItemSize,
+                                                 const TickType_t xMaxItemAge,
+                                                 uint8_t * pucQueueStorage,
+                                                 StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueSetMaxItemAge( QueueHandle_t xQueue, TickType_t xMaxItemAge );
+ * @endcode
+ *
+ * Changes the age, in ticks, after which items in a timestamped queue expire.
+ * Only valid for queues created with xQueueCreateTimestamped() or
+ * xQueueCreateTimestampedStatic().
+ * \defgroup vQueueSetMaxItemAge vQueueSetMaxItemAge
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    void vQueueSetMaxItemAge( QueueHandle_t xQueue,
+                              TickType_t xMaxItemAge ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueGetAgeStats( QueueHandle_t xQueue, QueueAgeStats_t *pxAgeStats, BaseType_t xReset );
+ * @endcode
+ *
+ * Reads the age statistics of a timestamped queue - the number of items
+ * received and discarded, and the total and maximum number of ticks the
+ * received items spent in the queue.  Dividing xTotalAge by uxItemsReceived
+ * gives the mean age.
+ *
+ * @param xQueue The queue to query.
+ *
+ * @param pxAgeStats The structure into which the statistics are copied.
+ *
+ * @param xReset Set to pdTRUE to zero the statistics after they are read, so
+ * the next call reports only what happened in between.
+ * \defgroup vQueueGetAgeStats vQueueGetAgeStats
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    void vQueueGetAgeStats( QueueHandle_t xQueue,
+                            QueueAgeStats_t * pxAgeStats,
+                            BaseType_t xReset ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Queue sets provide a mechanism to allow a task to block (pend) on a read
  * operation from multiple queues or semaphores simultaneously.
@@ -1652,9 +2102,13 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * Note 2:  Blocking on a queue set that contains a mutex will not cause the
  * mutex holder to inherit the priority of the blocked task.
  *
- * Note 3:  An additional 4 bytes of RAM is required for each space in a every
- * queue added to a queue set.  Therefore counting semaphores that have a high
- * maximum count value should not be added to a queue set.
+ * Note 3:  A queue set holds at most one event for each of its members.  A
+ * member is posted to the set when it becomes ready, is not posted again while
+ * that event is waiting to be selected, and is posted again when a read or take
+ * leaves it still ready after it has been selected.  Sending to a busy member
+ * therefore costs no more than sending to a queue that is not in a set, and an
+ * additional 4 bytes of RAM is required for each member rather than for each
+ * space in each member.
  *
  * Note 4:  A receive (in the case of a queue) or take (in the case of a
  * semaphore) operation must not be performed on a member of a queue set unless
@@ -1662,19 +2116,14 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  *
  * @param uxEventQueueLength Queue sets store events that occur on
  * the queues and semaphores contained in the set.  uxEventQueueLength specifies
- * the maximum number of events that can be queued at once.  To be absolutely
- * certain that events are not lost uxEventQueueLength should be set to the
- * total sum of the length of the queues added to the set, where binary
- * semaphores and mutexes have a length of 1, and counting semaphores have a
- * length set by their maximum count value.  Examples:
+ * the maximum number of events that can be queued at once.  As each member
+ * holds at most one event in the set, uxEventQueueLength need only be set to
+ * the number of queues and semaphores that will be added to the set.  Examples:
  *  + If a queue set is to hold a queue of length 5, another queue of length 12,
- *    and a binary semaphore, then uxEventQueueLength should be set to
- *    (5 + 12 + 1), or 18.
- *  + If a queue set is to hold three binary semaphores then uxEventQueueLength
- *    should be set to (1 + 1 + 1 ), or 3.
+ *    and a binary semaphore, then uxEventQueueLength should be set to 3.
  *  + If a queue set is to hold a counting semaphore that has a maximum count of
  *    5, and a counting semaphore that has a maximum count of 3, then
- *    uxEventQueueLength should be set to (5 + 3), or 8.
+ *    uxEventQueueLength should be set to 2.
  *
  * @return If the queue set is created successfully then a handle to the created
  * queue set is returned.  Otherwise NULL is returned.
@@ -1752,6 +2201,9 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * Note 3:  A receive (in the case of a queue) or take (in the case of a
  * semaphore) operation must not be performed on a member of a queue set unless
  * a call to xQueueSelectFromSet() has first returned a handle to that set member.
+ * Each handle returned must be followed by at least one read or take on that
+ * member, otherwise data that remains in the member is not reported again until
+ * more data is sent to it.
  *
  * @param xQueueSet The queue set on which the task will (potentially) block.
  *
@@ -297,6 +297,31 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreTake( xSemaphore, xBlockTime )    xQueueSemaphoreTake( ( xSemaphore ), ( xBlockTime ) )
 
+/**
+ * semphr. h
+ * @code{c}
+ * xSemaphoreTakeUs(
+ *                   SemaphoreHandle_t xSemaphore,
+ *                   uint32_t ulTimeoutUs
+ *               );
+ * @endcode
+ *
+ * configUSE_HIGH_RES_TIMEOUTS must be set to 1 in FreeRTOSConfig.h for this
+ * macro to be available.
+ *
+ * A version of xSemaphoreTake() that takes the block time in microseconds
+ * rather than ticks.  The block time ends when the time returned by
+ * ullISRTimerGetTimeUs() reaches the time at which the macro was called plus
+ * ulTimeoutUs, without waiting for the next tick interrupt.  Priority
+ * inheritance behaves as it does for xSemaphoreTake().
+ *
+ * \defgroup xSemaphoreTakeUs xSemaphoreTakeUs
+ * \ingroup Semaphores
+ */
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    #define xSemaphoreTakeUs( xSemaphore, ulTimeoutUs )    xQueueSemaphoreTakeUs( ( xSemaphore ), ( ulTimeoutUs ) )
+#endif
+
 /**
  * semphr. h
  * @code{c}
@@ -85,6 +85,28 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ * Age statistics of a timestamped message buffer, as returned by
+ * vStreamBufferGetAgeStats().
+ */
+typedef struct xSTREAM_BUFFER_AGE_STATS
+{
+    UBaseType_t uxMessagesReceived; /* The number of messages received. */
+    UBaseType_t uxMessagesExpired;  /* The number of messages discarded because they were older than the maximum message age. */
+    TickType_t xTotalAge;           /* The sum of the ages of the received messages, in ticks. */
+    TickType_t xMaxAge;             /* The age of the oldest message received, in ticks. */
+} StreamBufferAgeStats_t;
+
+/**
+ * One fragment of the data passed to xStreamBufferSendV() or
+ * xStreamBufferReceiveV().
+ */
+typedef struct xSTREAM_BUFFER_VECTOR
+{
+    void * pvData;  /* The start of the fragment. */
+    size_t xLength; /* The length of the fragment in bytes, which can be zero. */
+} StreamBufferVector_t;
+
 /**
  * stream_buffer.h
  *
@@ -594,6 +616,50 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           size_t xDataLengthBytes,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+ *                            const StreamBufferVector_t *pxVectors,
+ *                            size_t xVectorCount,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Equivalent to xStreamBufferSend(), but gathers the data to send from
+ * xVectorCount separate fragments rather than one contiguous buffer.  The
+ * fragments are copied straight into the stream buffer one after another, so
+ * data such as a header, a payload and a checksum held in different places
+ * can be sent without first being assembled in a temporary buffer.  When used
+ * with a message buffer, the fragments together form one message.
+ *
+ * Unlike xStreamBufferSend(), xStreamBufferSendV() must not be called from an
+ * interrupt service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which the data is
+ * being sent.
+ *
+ * @param pxVectors An array of xVectorCount structures, each holding the
+ * start and length of one fragment of the data.  A fragment can have zero
+ * length, in which case its pvData member can be NULL.
+ *
+ * @param xVectorCount The number of structures in the pxVectors array.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for enough space to become available in the stream
+ * buffer, exactly as for xStreamBufferSend().
+ *
+ * @return The number of bytes written to the stream buffer, exactly as for
+ * xStreamBufferSend() when passed the total length of the fragments.
+ *
+ * \defgroup xStreamBufferSendV xStreamBufferSendV
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                           const StreamBufferVector_t * pxVectors,
+                           size_t xVectorCount,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -790,6 +856,52 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
                              size_t xBufferLengthBytes,
                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+ *                               const StreamBufferVector_t *pxVectors,
+ *                               size_t xVectorCount,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Equivalent to xStreamBufferReceive(), but scatters the received data across
+ * xVectorCount separate fragments rather than one contiguous buffer.  Each
+ * fragment is filled in turn, straight from the stream buffer, before the
+ * next is used.
+ *
+ * When used with a message buffer the total length of the fragments must be
+ * large enough to hold the next message, otherwise the message is left in the
+ * message buffer and 0 is returned, exactly as for xStreamBufferReceive().
+ *
+ * Unlike xStreamBufferReceive(), xStreamBufferReceiveV() must not be called
+ * from an interrupt service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer from which data is to
+ * be received.
+ *
+ * @param pxVectors An array of xVectorCount structures, each holding the
+ * start and length of one fragment into which data is received.  A fragment
+ * can have zero length, in which case its pvData member can be NULL.
+ *
+ * @param xVectorCount The number of structures in the pxVectors array.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data to become available, exactly as for
+ * xStreamBufferReceive().
+ *
+ * @return The number of bytes received, exactly as for xStreamBufferReceive()
+ * when passed the total length of the fragments.
+ *
+ * \defgroup xStreamBufferReceiveV xStreamBufferReceiveV
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+                              const StreamBufferVector_t * pxVectors,
+                              size_t xVectorCount,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -1188,6 +1300,190 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferReserveWrite( StreamBufferHandle_t xStreamBuffer,
+ *                                       size_t xLengthBytes,
+ *                                       void **ppvData,
+ *                                       size_t *pxContiguousLengthBytes );
+ * @endcode
+ *
+ * Obtains a pointer directly into the storage area of a stream buffer, so the
+ * data can be written in place (for example by a DMA engine) rather than
+ * copied in by xStreamBufferSend().  The data is not visible to the reader
+ * until it is committed using xStreamBufferCommitWrite() or
+ * xStreamBufferCommitWriteFromISR().
+ *
+ * The free space in a stream buffer can wrap around the end of its storage
+ * area, in which case *pxContiguousLengthBytes is set to the length of the
+ * space up to the end of the storage area only.  Commit that span then call
+ * xStreamBufferReserveWrite() again to obtain the space at the start of the
+ * storage area.
+ *
+ * xStreamBufferReserveWrite() does not block, and can be called from a task or
+ * an interrupt service routine (ISR).  It cannot be used with message buffers.
+ * As with the other stream buffer send functions, there must only be one
+ * writer.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param xLengthBytes The minimum amount of free space, in bytes, that must be
+ * available in the stream buffer (not necessarily contiguously) for the call
+ * to pass.  Set to 0 to pass whenever any space is available.
+ *
+ * @param ppvData Set to the start of the free space in the stream buffer, or
+ * NULL if the call fails.
+ *
+ * @param pxContiguousLengthBytes Set to the number of bytes that can be written
+ * from *ppvData onwards, or 0 if the call fails.
+ *
+ * @return pdPASS if the space was reserved, otherwise pdFAIL.
+ *
+ * Example use:
+ * @code{c}
+ * void vStartUARTReceive( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * void *pvData;
+ * size_t xSpan;
+ *
+ *  // Hand the DMA engine the contiguous free space in the stream buffer.
+ *  if( xStreamBufferReserveWrite( xStreamBuffer, 0, &pvData, &xSpan ) == pdPASS )
+ *  {
+ *      vStartDMA( pvData, xSpan );
+ *  }
+ * }
+ *
+ * void vDMACompleteISR( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  // Make the received bytes available to the reading task.
+ *  xStreamBufferCommitWriteFromISR( xStreamBuffer, xDMABytesTransferred(), &xHigherPriorityTaskWoken );
+ *  vStartUARTReceive( xStreamBuffer );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferReserveWrite xStreamBufferReserveWrite
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferReserveWrite( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xLengthBytes,
+                                      void ** ppvData,
+                                      size_t * pxContiguousLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes );
+ * BaseType_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Makes xLengthBytes bytes written in place, starting at the pointer returned
+ * by xStreamBufferReserveWrite(), available to the reader.  Exactly as when
+ * data is sent using xStreamBufferSend(), a task waiting to receive is
+ * unblocked, or the send completed callback is called, if the bytes in the
+ * buffer reach the trigger level.
+ *
+ * xStreamBufferCommitWrite() must be called from a task, and
+ * xStreamBufferCommitWriteFromISR() from an interrupt service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer written to.
+ *
+ * @param xLengthBytes The number of bytes written.  Must be greater than 0 and
+ * no more than the contiguous length returned by xStreamBufferReserveWrite().
+ *
+ * @param pxHigherPriorityTaskWoken (xStreamBufferCommitWriteFromISR() only)
+ * Set to pdTRUE if committing the data unblocked a task with a priority above
+ * that of the currently running task, in which case a context switch should be
+ * requested before the ISR exits.  See xStreamBufferSendFromISR().
+ *
+ * @return pdPASS if the data was committed, otherwise pdFAIL.
+ *
+ * \defgroup xStreamBufferCommitWrite xStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xLengthBytes ) PRIVILEGED_FUNCTION;
+BaseType_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xLengthBytes,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferPeekRead( StreamBufferHandle_t xStreamBuffer, void **ppvData );
+ * @endcode
+ *
+ * Obtains a pointer directly to the oldest data in a stream buffer, so the data
+ * can be read in place (for example by a DMA engine) rather than copied out by
+ * xStreamBufferReceive().  The data remains in the buffer until it is removed
+ * using xStreamBufferConsume() or xStreamBufferConsumeFromISR().
+ *
+ * The data in a stream buffer can wrap around the end of its storage area, in
+ * which case only the length of the data up to the end of the storage area is
+ * returned.  Consume that data then call xStreamBufferPeekRead() again to
+ * obtain the data at the start of the storage area.
+ *
+ * xStreamBufferPeekRead() does not block, and can be called from a task or an
+ * interrupt service routine (ISR).  It cannot be used with message buffers.  As
+ * with the other stream buffer receive functions, there must only be one
+ * reader.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvData Set to the start of the data in the stream buffer, or NULL if
+ * the stream buffer is empty.
+ *
+ * @return The number of bytes that can be read from *ppvData onwards, which is
+ * 0 if the stream buffer is empty.
+ *
+ * \defgroup xStreamBufferPeekRead xStreamBufferPeekRead
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeekRead( StreamBufferHandle_t xStreamBuffer,
+                              void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes );
+ * BaseType_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer, size_t xLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Removes xLengthBytes bytes, previously read in place using
+ * xStreamBufferPeekRead(), from the stream buffer.  Exactly as when data is
+ * received using xStreamBufferReceive(), a task waiting for space is unblocked,
+ * or the receive completed callback is called.
+ *
+ * xStreamBufferConsume() must be called from a task, and
+ * xStreamBufferConsumeFromISR() from an interrupt service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer read from.
+ *
+ * @param xLengthBytes The number of bytes to remove.  Must be greater than 0
+ * and no more than the number of bytes in the stream buffer.
+ *
+ * @param pxHigherPriorityTaskWoken (xStreamBufferConsumeFromISR() only) Set to
+ * pdTRUE if consuming the data unblocked a task with a priority above that of
+ * the currently running task, in which case a context switch should be
+ * requested before the ISR exits.  See xStreamBufferReceiveFromISR().
+ *
+ * @return pdPASS if the data was removed, otherwise pdFAIL.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xLengthBytes ) PRIVILEGED_FUNCTION;
+BaseType_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xLengthBytes,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -1245,6 +1541,153 @@ UBaseType_t uxStreamBufferGetStreamBufferNotificationIndex( StreamBufferHandle_t
 void vStreamBufferSetStreamBufferNotificationIndex( StreamBufferHandle_t xStreamBuffer,
                                                     UBaseType_t uxNotificationIndex ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferSetMaxMessageAge( StreamBufferHandle_t xStreamBuffer, TickType_t xMaxMessageAge );
+ * @endcode
+ *
+ * Makes a message buffer timestamped, or changes the maximum message age of a
+ * message buffer that is already timestamped.  Each message sent to a
+ * timestamped message buffer is stored with the tick count at which it was
+ * sent, which uses an extra sizeof( TickType_t ) bytes of the buffer per
+ * message.  Messages that have been in the buffer for more than xMaxMessageAge
+ * ticks are discarded by the reader instead of being received, so
+ * xStreamBufferReceive() can return 0 if every message in the buffer has
+ * expired.  Expired messages are only discarded by the reader, so a full
+ * buffer does not make room for a new message by dropping the oldest one.
+ *
+ * A message buffer can only be made timestamped while it is empty and no task
+ * is blocked on it.  Only valid for message buffers.
+ *
+ * configUSE_TIMESTAMPED_MESSAGES must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferSetMaxMessageAge() to be available.
+ *
+ * @param xStreamBuffer The handle of the message buffer.
+ *
+ * @param xMaxMessageAge The maximum time, in ticks, a message can wait in the
+ * buffer.  Set to portMAX_DELAY to timestamp messages without discarding them.
+ *
+ * @return pdPASS if the maximum message age was set, otherwise pdFAIL.
+ *
+ * \defgroup xStreamBufferSetMaxMessageAge xStreamBufferSetMaxMessageAge
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    BaseType_t xStreamBufferSetMaxMessageAge( StreamBufferHandle_t xStreamBuffer,
+                                              TickType_t xMaxMessageAge ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferGetAgeStats( StreamBufferHandle_t xStreamBuffer, StreamBufferAgeStats_t *pxAgeStats, BaseType_t xReset );
+ * @endcode
+ *
+ * Retrieves the number of messages received from and expired in a timestamped
+ * message buffer, and the total and maximum age of the received messages.
+ *
+ * configUSE_TIMESTAMPED_MESSAGES must be set to 1 in FreeRTOSConfig.h for
+ * vStreamBufferGetAgeStats() to be available.
+ *
+ * @param xStreamBuffer The handle of the message buffer being queried.
+ *
+ * @param pxAgeStats The structure into which the statistics are copied.
+ *
+ * @param xReset Set to pdTRUE to clear the statistics after they are copied.
+ *
+ * \defgroup vStreamBufferGetAgeStats vStreamBufferGetAgeStats
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    void vStreamBufferGetAgeStats( StreamBufferHandle_t xStreamBuffer,
+                                   StreamBufferAgeStats_t * pxAgeStats,
+                                   BaseType_t xReset ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferSetOverwrite( StreamBufferHandle_t xStreamBuffer, BaseType_t xOverwrite );
+ * @endcode
+ *
+ * Switches a stream buffer or message buffer into or out of overwrite mode.
+ *
+ * When a buffer that is not in overwrite mode is full, writers wait for space
+ * or send less data than requested.  A buffer in overwrite mode instead always
+ * accepts new data, discarding as much of the oldest data as is needed to make
+ * space for it, and writers never block.  A message buffer discards whole
+ * messages, oldest first.  Data sent to a stream buffer that is longer than the
+ * whole buffer is truncated to its newest bytes.  A message that is longer
+ * than the whole message buffer is still rejected.  The buffer therefore always
+ * holds the most recent data, which makes it suitable for capturing a bounded
+ * history of trace or log events for post-mortem analysis.
+ *
+ * The data discarded is counted, and the counts can be read using
+ * vStreamBufferGetDroppedCounts().
+ *
+ * In overwrite mode the writer moves the position from which data is read, so
+ * data is read from a critical section, and the zero copy functions
+ * (xStreamBufferReserveWrite() and xStreamBufferPeekRead()) cannot be used.
+ *
+ * configUSE_STREAM_BUFFER_OVERWRITE must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferSetOverwrite() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param xOverwrite pdTRUE to switch the buffer into overwrite mode, pdFALSE
+ * to switch it out of overwrite mode.
+ *
+ * @return pdPASS if the mode was set.  pdFAIL if a task was waiting for space
+ * in the buffer, in which case the mode was not changed.
+ *
+ * \defgroup xStreamBufferSetOverwrite xStreamBufferSetOverwrite
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+    BaseType_t xStreamBufferSetOverwrite( StreamBufferHandle_t xStreamBuffer,
+                                          BaseType_t xOverwrite ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferGetDroppedCounts( StreamBufferHandle_t xStreamBuffer, size_t *pxBytesDropped, UBaseType_t *puxMessagesDropped, BaseType_t xReset );
+ * @endcode
+ *
+ * Retrieves the number of bytes, and for a message buffer the number of
+ * messages, that were discarded to make space for new data while the buffer
+ * was in overwrite mode.  See xStreamBufferSetOverwrite().  The counts are
+ * cleared when the buffer is reset.
+ *
+ * configUSE_STREAM_BUFFER_OVERWRITE must be set to 1 in FreeRTOSConfig.h for
+ * vStreamBufferGetDroppedCounts() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer being
+ * queried.
+ *
+ * @param pxBytesDropped Set to the number of bytes of data discarded, which
+ * excludes the bytes used to store the length of each message.  Can be NULL.
+ *
+ * @param puxMessagesDropped Set to the number of whole messages discarded,
+ * which is always 0 for a stream buffer.  Can be NULL.
+ *
+ * @param xReset Set to pdTRUE to clear the counts after they are read.
+ *
+ * \defgroup vStreamBufferGetDroppedCounts vStreamBufferGetDroppedCounts
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+    void vStreamBufferGetDroppedCounts( StreamBufferHandle_t xStreamBuffer,
+                                        size_t * pxBytesDropped,
+                                        UBaseType_t * puxMessagesDropped,
+                                        BaseType_t xReset ) PRIVILEGED_FUNCTION;
+#endif
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
@@ -935,6 +935,62 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
         ( void ) xTaskDelayUntil( ( pxPreviousWakeTime ), ( xTimeIncrement ) ); \
     } while( 0 )
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskDelayUntilUs( uint64_t * const pullPreviousWakeTimeUs, const uint32_t ulTimeIncrementUs );
+ * @endcode
+ *
+ * configUSE_HIGH_RES_TIMEOUTS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * A version of xTaskDelayUntil() that specifies the wake time in microseconds
+ * rather than ticks, so periodic tasks can run at periods that are not a whole
+ * number of tick periods without raising configTICK_RATE_HZ.
+ *
+ * The wake time is measured against the time base returned by
+ * ullISRTimerGetTimeUs().  The task is unblocked by an ISR timer programmed for
+ * the wake time, so it does not wait for the next tick interrupt.  The task
+ * also has a tick based block time that ends a tick or two after the wake time,
+ * which unblocks it should the ISR timer not be available because
+ * configISR_TIMER_MAX_ACTIVE timers are already running.
+ *
+ * @param pullPreviousWakeTimeUs Pointer to a variable that holds the time, in
+ * microseconds, at which the task was last unblocked.  The variable must be
+ * initialised with ullISRTimerGetTimeUs() prior to its first use.  Following
+ * this the variable is automatically updated within xTaskDelayUntilUs().
+ *
+ * @param ulTimeIncrementUs The cycle time period in microseconds.  The task
+ * will be unblocked at time *pullPreviousWakeTimeUs + ulTimeIncrementUs.
+ *
+ * @return pdTRUE if the task was delayed, otherwise pdFALSE.  A task will not
+ * be delayed if the next expected wake time is in the past.
+ *
+ * Example usage:
+ * @code{c}
+ * // Run a control loop every 250 microseconds.
+ * void vControlTask( void * pvParameters )
+ * {
+ * uint64_t ullLastWakeTimeUs;
+ *
+ *     ullLastWakeTimeUs = ullISRTimerGetTimeUs();
+ *
+ *     for( ;; )
+ *     {
+ *         ( void ) xTaskDelayUntilUs( &ullLastWakeTimeUs, 250U );
+ *
+ *         // Perform the control action here.
+ *     }
+ * }
+ * @endcode
+ * \defgroup xTaskDelayUntilUs xTaskDelayUntilUs
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    BaseType_t xTaskDelayUntilUs( uint64_t * const pullPreviousWakeTimeUs,
+                                  const uint32_t ulTimeIncrementUs ) PRIVILEGED_FUNCTION;
+#endif
+
 
 /**
  * task. h
@@ -2912,6 +2968,38 @@ BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
 #define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) \
     xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyWaitUs( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, uint32_t ulTimeoutUs );
+ *
+ * BaseType_t xTaskNotifyWaitIndexedUs( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, uint32_t ulTimeoutUs );
+ * @endcode
+ *
+ * configUSE_HIGH_RES_TIMEOUTS must be set to 1 in FreeRTOSConfig.h for these
+ * macros to be available.
+ *
+ * Versions of xTaskNotifyWait() and xTaskNotifyWaitIndexed() that take the
+ * block time in microseconds rather than ticks.  The block time ends when the
+ * time returned by ullISRTimerGetTimeUs() reaches the time at which the
+ * function was called plus ulTimeoutUs, without waiting for the next tick
+ * interrupt.  See xTaskDelayUntilUs() for how the timeout is implemented.
+ *
+ * \defgroup xTaskNotifyWaitIndexedUs xTaskNotifyWaitIndexedUs
+ * \ingroup TaskNotifications
+ */
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    BaseType_t xTaskGenericNotifyWaitUs( UBaseType_t uxIndexToWaitOn,
+                                         uint32_t ulBitsToClearOnEntry,
+                                         uint32_t ulBitsToClearOnExit,
+                                         uint32_t * pulNotificationValue,
+                                         uint32_t ulTimeoutUs ) PRIVILEGED_FUNCTION;
+    #define xTaskNotifyWaitUs( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, ulTimeoutUs ) \
+    xTaskGenericNotifyWaitUs( tskDEFAULT_INDEX_TO_NOTIFY, ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( ulTimeoutUs ) )
+    #define xTaskNotifyWaitIndexedUs( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, ulTimeoutUs ) \
+    xTaskGenericNotifyWaitUs( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( ulTimeoutUs ) )
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3182,6 +3270,33 @@ uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
 #define ulTaskNotifyTakeIndexed( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait ) \
     ulTaskGenericNotifyTake( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
+/**
+ * task. h
+ * @code{c}
+ * uint32_t ulTaskNotifyTakeUs( BaseType_t xClearCountOnExit, uint32_t ulTimeoutUs );
+ *
+ * uint32_t ulTaskNotifyTakeIndexedUs( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, uint32_t ulTimeoutUs );
+ * @endcode
+ *
+ * configUSE_HIGH_RES_TIMEOUTS must be set to 1 in FreeRTOSConfig.h for these
+ * macros to be available.
+ *
+ * Versions of ulTaskNotifyTake() and ulTaskNotifyTakeIndexed() that take the
+ * block time in microseconds rather than ticks.  See xTaskNotifyWaitUs().
+ *
+ * \defgroup ulTaskNotifyTakeIndexedUs ulTaskNotifyTakeIndexedUs
+ * \ingroup TaskNotifications
+ */
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    uint32_t ulTaskGenericNotifyTakeUs( UBaseType_t uxIndexToWaitOn,
+                                        BaseType_t xClearCountOnExit,
+                                        uint32_t ulTimeoutUs ) PRIVILEGED_FUNCTION;
+    #define ulTaskNotifyTakeUs( xClearCountOnExit, ulTimeoutUs ) \
+    ulTaskGenericNotifyTakeUs( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( ulTimeoutUs ) )
+    #define ulTaskNotifyTakeIndexedUs( uxIndexToWaitOn, xClearCountOnExit, ulTimeoutUs ) \
+    ulTaskGenericNotifyTakeUs( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( ulTimeoutUs ) )
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3564,6 +3679,39 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.
+ *
+ * A version of vTaskRemoveFromUnorderedEventList() that can be called from an
+ * interrupt, or from a critical section while the scheduler is running.  It is
+ * used by event groups built with configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR
+ * set to 1.  The caller must guarantee no task is accessing the event list.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                     const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED TO
+ * IMPLEMENT THE MICROSECOND TIMEOUT API FUNCTIONS.
+ *
+ * xTaskBeginTimeoutUs() records that the next block of the calling task must
+ * end at ullWakeTimeUs, measured against ullISRTimerGetTimeUs(), and returns a
+ * tick block time to pass to the blocking function.  The tick block time ends
+ * after ullWakeTimeUs, and only unblocks the task if its ISR timer could not
+ * be started.  vTaskEndTimeoutUs() must be called once the blocking function
+ * returns.
+ */
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    TickType_t xTaskBeginTimeoutUs( uint64_t ullWakeTimeUs ) PRIVILEGED_FUNCTION;
+    void vTaskEndTimeoutUs( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3675,6 +3823,16 @@ void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
     eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * For internal use only.  Returns a pointer to the head of the list of arenas
+ * attached to xTask, or to the calling task if xTask is NULL.  The list is
+ * only modified by the arena module, from within a critical section.
+ */
+#if ( ( configUSE_ARENAS == 1 ) && ( INCLUDE_vTaskDelete == 1 ) )
+    struct ArenaDef_t;
+    struct ArenaDef_t ** ppxTaskGetArenas( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Increment the mutex held count when a mutex is
  * taken and return the handle of the task that has taken the mutex.
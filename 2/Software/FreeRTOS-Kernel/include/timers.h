@@ -67,6 +67,10 @@
 #define tmrCOMMAND_STOP_FROM_ISR                ( ( BaseType_t ) 8 )
 #define tmrCOMMAND_CHANGE_PERIOD_FROM_ISR       ( ( BaseType_t ) 9 )
 
+/* Sent from both tasks and interrupts to wake the timer service task when
+ * configUSE_TIMER_COMMAND_COALESCING is 1. */
+#define tmrCOMMAND_PROCESS_PENDING              ( ( BaseType_t ) 10 )
+
 
 /**
  * Type by which software timers are referenced.  For example, a call to
@@ -365,6 +369,64 @@ typedef void (* PendedFunction_t)( void * arg1,
                                       StaticTimer_t * pxTimerBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * TimerHandle_t xTimerCreateOnService( const char * const pcTimerName,
+ *                                      TickType_t xTimerPeriodInTicks,
+ *                                      BaseType_t xAutoReload,
+ *                                      void * pvTimerID,
+ *                                      TimerCallbackFunction_t pxCallbackFunction,
+ *                                      UBaseType_t uxTimerService );
+ *
+ * TimerHandle_t xTimerCreateStaticOnService( const char * const pcTimerName,
+ *                                            TickType_t xTimerPeriodInTicks,
+ *                                            BaseType_t xAutoReload,
+ *                                            void * pvTimerID,
+ *                                            TimerCallbackFunction_t pxCallbackFunction,
+ *                                            StaticTimer_t * pxTimerBuffer,
+ *                                            UBaseType_t uxTimerService );
+ *
+ * Create a timer as xTimerCreate() and xTimerCreateStatic() do, but assign it to
+ * the given timer service task instead of timer service task 0.
+ *
+ * When configTIMER_SERVICE_TASKS is greater than 1 the kernel creates that
+ * many timer service tasks.  Each has its own command queue and its own active
+ * timers, and runs the callbacks of only the timers assigned to it.  Timer
+ * service task 0 runs at configTIMER_TASK_PRIORITY, and timer service task n
+ * runs at configTIMER_SERVICE_TASK_PRIORITY( n ), which defaults to
+ * ( configTIMER_TASK_PRIORITY - n ).  Assigning time critical timers with short
+ * callbacks to a high priority service, and timers with long callbacks to a
+ * low priority service, stops the long callbacks delaying the time critical
+ * ones, and stops the long callbacks running at a high priority.  Pended
+ * function calls (see xTimerPendFunctionCall()) always run in timer service
+ * task 0.
+ *
+ * A timer stays assigned to the same timer service task for its lifetime.
+ *
+ * @param uxTimerService The timer service task the timer is assigned to, from
+ * 0 to ( configTIMER_SERVICE_TASKS - 1 ).
+ *
+ * All the other parameters, and the return value, are as for xTimerCreate()
+ * and xTimerCreateStatic().
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) )
+    TimerHandle_t xTimerCreateOnService( const char * const pcTimerName,
+                                         const TickType_t xTimerPeriodInTicks,
+                                         const BaseType_t xAutoReload,
+                                         void * const pvTimerID,
+                                         TimerCallbackFunction_t pxCallbackFunction,
+                                         const UBaseType_t uxTimerService ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) )
+    TimerHandle_t xTimerCreateStaticOnService( const char * const pcTimerName,
+                                               const TickType_t xTimerPeriodInTicks,
+                                               const BaseType_t xAutoReload,
+                                               void * const pvTimerID,
+                                               TimerCallbackFunction_t pxCallbackFunction,
+                                               StaticTimer_t * pxTimerBuffer,
+                                               const UBaseType_t uxTimerService ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * void *pvTimerGetTimerID( TimerHandle_t xTimer );
  *
@@ -454,6 +516,33 @@ BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxTimerService );
+ *
+ * Returns the handle of the given timer service task.  Timer service task 0 is
+ * the task returned by xTimerGetTimerDaemonTaskHandle().  It is not valid to
+ * call xTimerGetTimerServiceTaskHandle() before the scheduler has been started.
+ *
+ * configTIMER_SERVICE_TASKS must be greater than 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ */
+#if ( configTIMER_SERVICE_TASKS > 1 )
+    TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxTimerService ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * UBaseType_t uxTimerGetTimerService( TimerHandle_t xTimer );
+ *
+ * Returns the timer service task the timer was assigned to when it was
+ * created.
+ *
+ * configTIMER_SERVICE_TASKS must be greater than 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ */
+#if ( configTIMER_SERVICE_TASKS > 1 )
+    UBaseType_t uxTimerGetTimerService( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * BaseType_t xTimerStart( TimerHandle_t xTimer, TickType_t xTicksToWait );
  *
@@ -1310,6 +1399,48 @@ UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlack );
+ *
+ * Sets how many ticks after its expiry time a timer is allowed to be
+ * processed.  Rather than waking at the exact expiry time of each timer, the
+ * timer service task sleeps until the latest time at which no timer has
+ * exceeded its slack, then processes every timer that has expired by then in
+ * one go.  Timers with nearby expiry times therefore share a single wake up,
+ * which reduces context switches and lengthens the idle periods available to
+ * tickless idle.  The expiry time of an auto-reload timer is still advanced by
+ * exactly its period, so slack does not cause the timer to drift.
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.  A timer has no slack when it is created.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xSlack The maximum number of ticks the timer callback may be called
+ * after the timer's expiry time.  The new slack is taken into account the
+ * next time the timer service task calculates how long to sleep for.
+ */
+#if ( configUSE_TIMER_SLACK == 1 )
+    void vTimerSetSlack( TimerHandle_t xTimer,
+                         const TickType_t xSlack ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+ *
+ * Returns the slack of a timer, as set by vTimerSetSlack().
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The slack of the timer in ticks.
+ */
+#if ( configUSE_TIMER_SLACK == 1 )
+    TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer );
  *
@@ -1398,6 +1529,33 @@ BaseType_t xTimerGenericCommandFromISR( TimerHandle_t xTimer,
                                          StackType_t ** ppxTimerTaskStackBuffer,
                                          configSTACK_DEPTH_TYPE * puxTimerTaskStackSize );
 
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationGetTimerServiceTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer, StackType_t ** ppxTimerTaskStackBuffer, configSTACK_DEPTH_TYPE * puxTimerTaskStackSize, BaseType_t xTimerServiceTaskIndex )
+ * @endcode
+ *
+ * This function is used to provide statically allocated blocks of memory to
+ * FreeRTOS to hold the TCBs of the additional timer service tasks created when
+ * configTIMER_SERVICE_TASKS is greater than 1.  The memory of timer service task
+ * 0 is still provided by vApplicationGetTimerTaskMemory().
+ *
+ * The function vApplicationGetTimerServiceTaskMemory is called with index
+ * 0, 1 ... ( configTIMER_SERVICE_TASKS - 2 ) to get memory for timer service
+ * tasks 1, 2 ... ( configTIMER_SERVICE_TASKS - 1 ).
+ *
+ * @param ppxTimerTaskTCBBuffer   A handle to a statically allocated TCB buffer
+ * @param ppxTimerTaskStackBuffer A handle to a statically allocated Stack buffer for the timer service task
+ * @param puxTimerTaskStackSize   A pointer to the number of elements that will fit in the allocated stack buffer
+ * @param xTimerServiceTaskIndex  The index of the timer service task buffer
+ */
+    #if ( configTIMER_SERVICE_TASKS > 1 )
+        void vApplicationGetTimerServiceTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                                    StackType_t ** ppxTimerTaskStackBuffer,
+                                                    configSTACK_DEPTH_TYPE * puxTimerTaskStackSize,
+                                                    BaseType_t xTimerServiceTaskIndex );
+    #endif
+
 #endif
 
 #if ( configUSE_DAEMON_TASK_STARTUP_HOOK != 0 )
@@ -0,0 +1,324 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A topic broadcasts fixed size items from any number of publishers to any
+ * number of subscribers.  Published items are copied once into a ring buffer
+ * owned by the topic.  Each subscriber has its own read cursor into the ring,
+ * so the cost of publishing does not depend on how many subscribers there are.
+ *
+ * Publishing never blocks.  When the ring is full the oldest item is
+ * overwritten, and a subscriber that had not yet read the overwritten item
+ * skips forward to the oldest item still available and records how many items
+ * it missed (its overrun count).
+ *
+ * A subscriber that wants to wait for a new item blocks on a direct to task
+ * notification (using index configTOPIC_NOTIFICATION_INDEX), and publishers
+ * only notify subscribers that are actually waiting.  A subscriber handle must
+ * only be used by one task at a time.
+ *
+ * configUSE_TOPICS must be set to 1 in FreeRTOSConfig.h for the topic API to be
+ * available.
+ */
+
+#ifndef TOPIC_H
+#define TOPIC_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include topic.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which topics are referenced.  For example, a call to xTopicCreate()
+ * returns a TopicHandle_t variable that can then be used as a parameter to
+ * xTopicPublish(), xTopicSubscribe(), etc.
+ */
+struct TopicDef_t;
+typedef struct TopicDef_t * TopicHandle_t;
+
+/**
+ * Type by which subscriptions to a topic are referenced.  A call to
+ * xTopicSubscribe() returns a TopicSubscriberHandle_t variable that is then
+ * passed to xTopicReceive().
+ */
+struct TopicSubscriberDef_t;
+typedef struct TopicSubscriberDef_t * TopicSubscriberHandle_t;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * TopicHandle_t xTopicCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new topic using dynamically allocated memory.  The topic structure
+ * and its ring buffer are allocated in a single call to pvPortMalloc().
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xTopicCreate() to be available.
+ *
+ * @param uxLength The number of items the ring buffer holds.  This is how far
+ * a subscriber can fall behind the publishers before it starts to miss items.
+ * Must be a power of two.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return The handle of the created topic, or NULL if uxLength is not a power
+ * of two or there was not enough heap memory available to create it.
+ *
+ * \defgroup xTopicCreate xTopicCreate
+ * \ingroup Topics
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    TopicHandle_t xTopicCreate( UBaseType_t uxLength,
+                                UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * TopicHandle_t xTopicCreateStatic( UBaseType_t uxLength,
+ *                                   UBaseType_t uxItemSize,
+ *                                   uint8_t * pucTopicStorage,
+ *                                   StaticTopic_t * pxStaticTopic );
+ * @endcode
+ *
+ * Creates a new topic using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xTopicCreateStatic() to be available.
+ *
+ * @param uxLength The number of items the ring buffer holds.  Must be a power
+ * of two.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param pucTopicStorage Must point to a buffer of at least
+ * ( uxLength * uxItemSize ) bytes, which is used as the topic's ring buffer.
+ *
+ * @param pxStaticTopic Must point to a variable of type StaticTopic_t, which
+ * will be used to hold the topic's data structure.
+ *
+ * @return The handle of the created topic, or NULL if either buffer was NULL
+ * or uxLength is not a power of two.
+ *
+ * \defgroup xTopicCreateStatic xTopicCreateStatic
+ * \ingroup Topics
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    TopicHandle_t xTopicCreateStatic( UBaseType_t uxLength,
+                                      UBaseType_t uxItemSize,
+                                      uint8_t * pucTopicStorage,
+                                      StaticTopic_t * pxStaticTopic ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * void vTopicDelete( TopicHandle_t xTopic );
+ * @endcode
+ *
+ * Deletes a topic.  All subscriptions to the topic must be removed with
+ * vTopicUnsubscribe() first.
+ *
+ * \defgroup vTopicDelete vTopicDelete
+ * \ingroup Topics
+ */
+void vTopicDelete( TopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic );
+ * @endcode
+ *
+ * Creates a new subscription to a topic using dynamically allocated memory.
+ * The subscriber receives items published after it subscribed.
+ *
+ * @return The handle of the new subscription, or NULL if there was not enough
+ * heap memory available to create it.
+ *
+ * \defgroup xTopicSubscribe xTopicSubscribe
+ * \ingroup Topics
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * TopicSubscriberHandle_t xTopicSubscribeStatic( TopicHandle_t xTopic,
+ *                                                StaticTopicSubscriber_t * pxStaticSubscriber );
+ * @endcode
+ *
+ * Creates a new subscription to a topic using statically allocated memory.
+ *
+ * @param pxStaticSubscriber Must point to a variable of type
+ * StaticTopicSubscriber_t, which will be used to hold the subscriber's cursor.
+ *
+ * \defgroup xTopicSubscribeStatic xTopicSubscribeStatic
+ * \ingroup Topics
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    TopicSubscriberHandle_t xTopicSubscribeStatic( TopicHandle_t xTopic,
+                                                   StaticTopicSubscriber_t * pxStaticSubscriber ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * Removes a subscription created by xTopicSubscribe() or
+ * xTopicSubscribeStatic().  The subscriber must not be blocked in
+ * xTopicReceive() when it is removed.
+ *
+ * \defgroup vTopicUnsubscribe vTopicUnsubscribe
+ * \ingroup Topics
+ */
+void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * void vTopicPublish( TopicHandle_t xTopic, const void * pvItem );
+ * @endcode
+ *
+ * Copies the item pointed to by pvItem into the topic's ring buffer, then
+ * unblocks every subscriber waiting in xTopicReceive().  Publishing never
+ * blocks - if the ring buffer is full the oldest item is overwritten.
+ *
+ * \defgroup vTopicPublish vTopicPublish
+ * \ingroup Topics
+ */
+void vTopicPublish( TopicHandle_t xTopic,
+                    const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * void vTopicPublishFromISR( TopicHandle_t xTopic,
+ *                            const void * pvItem,
+ *                            BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vTopicPublish() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if publishing unblocked a
+ * subscriber that has a priority above the currently running task, in which
+ * case a context switch should be requested before the interrupt exits.
+ *
+ * \defgroup vTopicPublishFromISR vTopicPublishFromISR
+ * \ingroup Topics
+ */
+void vTopicPublishFromISR( TopicHandle_t xTopic,
+                           const void * pvItem,
+                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber,
+ *                           void * pvBuffer,
+ *                           TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the next unread item out of the topic and advances the subscriber's
+ * cursor.  If the subscriber has fallen more than the topic's length behind,
+ * the items that were overwritten are skipped and added to the subscriber's
+ * overrun count (see ulTopicGetOverrunCount()).  Items are copied out without
+ * entering a critical section.
+ *
+ * @param pvBuffer Pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state waiting for an item to be published if none is available.
+ *
+ * @return pdPASS if an item was copied into pvBuffer, otherwise pdFAIL.
+ *
+ * \defgroup xTopicReceive xTopicReceive
+ * \ingroup Topics
+ */
+BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber,
+                          void * pvBuffer,
+                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * UBaseType_t uxTopicMessagesWaiting( TopicSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * @return The number of items the subscriber can read before the topic is
+ * empty from its point of view.  Never more than the topic's length.
+ *
+ * \defgroup uxTopicMessagesWaiting uxTopicMessagesWaiting
+ * \ingroup Topics
+ */
+UBaseType_t uxTopicMessagesWaiting( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * topic.h
+ *
+ * @code{c}
+ * uint32_t ulTopicGetOverrunCount( TopicSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * @return The total number of items the subscriber has missed because they
+ * were overwritten before it read them.
+ *
+ * \defgroup ulTopicGetOverrunCount ulTopicGetOverrunCount
+ * \ingroup Topics
+ */
+uint32_t ulTopicGetOverrunCount( TopicSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( TOPIC_H ) */
@@ -0,0 +1,746 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "isr_timer.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include ISR timer functionality.  This #if is closed at the very bottom of
+ * this file.  If you want to include ISR timers then ensure configUSE_ISR_TIMERS
+ * is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_ISR_TIMERS == 1 )
+
+/* Bits set in ucFlags. */
+    #define isrtmrFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/* The heap index held by a timer that is not in the heap, and so is dormant. */
+    #define isrtmrNOT_IN_HEAP                      ( ( UBaseType_t ) configISR_TIMER_MAX_ACTIVE )
+
+/* The positions of a node's parent and first child within the heap array. */
+    #define isrtmrHEAP_PARENT( uxIndex )           ( ( ( uxIndex ) - ( UBaseType_t ) 1 ) / ( UBaseType_t ) 2 )
+    #define isrtmrHEAP_FIRST_CHILD( uxIndex )      ( ( ( uxIndex ) * ( UBaseType_t ) 2 ) + ( UBaseType_t ) 1 )
+
+    typedef struct ISRTimerDef_t
+    {
+        uint64_t ullExpiryTimeUs;                      /**< The absolute time at which the timer next expires. */
+        uint32_t ulPeriodUs;                           /**< The period of a periodic timer, or 0 for a one-shot timer. */
+        uint32_t ulOverrunCount;                       /**< The number of expiries skipped since the timer was started. */
+        ISRTimerCallbackFunction_t pxCallbackFunction; /**< The function that will be called when the timer expires. */
+        void * pvTimerID;                              /**< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
+        UBaseType_t uxHeapIndex;                       /**< The timer's position in pxISRTimerHeap[], or isrtmrNOT_IN_HEAP if the timer is dormant. */
+        uint8_t ucFlags;
+    } ISRTimer_t;
+
+/*-----------------------------------------------------------*/
+
+/* The running timers, as a binary min-heap ordered by expiry time - the
+ * timer at index 0 is always the next to expire and no timer expires before
+ * its parent.  Only accessed from within a critical section. */
+    PRIVILEGED_DATA static ISRTimer_t * pxISRTimerHeap[ configISR_TIMER_MAX_ACTIVE ];
+    PRIVILEGED_DATA static UBaseType_t uxISRTimersRunning = ( UBaseType_t ) 0U;
+
+/* The time the hardware alarm is programmed for, if it is programmed. */
+    PRIVILEGED_DATA static uint64_t ullISRTimerAlarmTimeUs = 0U;
+    PRIVILEGED_DATA static BaseType_t xISRTimerAlarmArmed = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the dynamic and static create functions to initialise a
+ * newly allocated timer structure.
+ */
+    static void prvInitialiseNewISRTimer( ISRTimer_t * const pxNewTimer,
+                                          ISRTimerCallbackFunction_t pxCallbackFunction,
+                                          void * pvTimerID,
+                                          uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes pxTimer into the heap at uxIndex and records the position in the
+ * timer.
+ */
+    static void prvHeapPlace( ISRTimer_t * const pxTimer,
+                              UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves the timer at uxIndex towards the root of the heap until its parent
+ * expires no later than it does.
+ */
+    static void prvHeapSiftUp( UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves the timer at uxIndex away from the root of the heap until neither of
+ * its children expires before it does.
+ */
+    static void prvHeapSiftDown( UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes a running timer from the heap, leaving it dormant.
+ */
+    static void prvHeapRemove( ISRTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * The implementations of xISRTimerStart() and xISRTimerStop(), shared with the
+ * FromISR() versions.  Must be called from within a critical section.
+ */
+    static BaseType_t prvStartTimer( ISRTimer_t * const pxTimer,
+                                     uint64_t ullExpiryTimeUs,
+                                     uint32_t ulPeriodUs ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvStopTimer( ISRTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Programs the hardware alarm for the timer at the root of the heap, or
+ * cancels the alarm if no timers are running.  Nothing is done if the alarm is
+ * already programmed for the right time.  Must be called from within a
+ * critical section.
+ */
+    static void prvUpdateAlarm( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        ISRTimerHandle_t xISRTimerCreate( ISRTimerCallbackFunction_t pxCallbackFunction,
+                                          void * pvTimerID )
+        {
+            ISRTimer_t * pxNewTimer;
+
+            traceENTER_xISRTimerCreate( pxCallbackFunction, pvTimerID );
+
+            configASSERT( pxCallbackFunction );
+
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxNewTimer = ( ISRTimer_t * ) pvPortMalloc( sizeof( ISRTimer_t ) );
+
+            if( pxNewTimer != NULL )
+            {
+                prvInitialiseNewISRTimer( pxNewTimer, pxCallbackFunction, pvTimerID, 0 );
+
+                traceISR_TIMER_CREATE( pxNewTimer );
+            }
+            else
+            {
+                traceISR_TIMER_CREATE_FAILED();
+            }
+
+            traceRETURN_xISRTimerCreate( pxNewTimer );
+
+            return pxNewTimer;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) || ( configUSE_HIGH_RES_TIMEOUTS == 1 ) )
+
+        ISRTimerHandle_t xISRTimerCreateStatic( ISRTimerCallbackFunction_t pxCallbackFunction,
+                                                void * pvTimerID,
+                                                StaticISRTimer_t * pxTimerBuffer )
+        {
+            ISRTimer_t * pxNewTimer;
+
+            traceENTER_xISRTimerCreateStatic( pxCallbackFunction, pvTimerID, pxTimerBuffer );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticISRTimer_t equals the size of the real
+                 * timer structure. */
+                volatile size_t xSize = sizeof( StaticISRTimer_t );
+                configASSERT( xSize == sizeof( ISRTimer_t ) );
+                ( void ) xSize; /* Prevent unused variable warning when configASSERT() is not defined. */
+            }
+            #endif /* configASSERT_DEFINED */
+
+            configASSERT( pxCallbackFunction );
+            configASSERT( pxTimerBuffer );
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNewTimer = ( ISRTimer_t * ) pxTimerBuffer;
+
+            if( pxNewTimer != NULL )
+            {
+                prvInitialiseNewISRTimer( pxNewTimer, pxCallbackFunction, pvTimerID, isrtmrFLAGS_IS_STATICALLY_ALLOCATED );
+
+                traceISR_TIMER_CREATE( pxNewTimer );
+            }
+            else
+            {
+                traceISR_TIMER_CREATE_FAILED();
+            }
+
+            traceRETURN_xISRTimerCreateStatic( pxNewTimer );
+
+            return pxNewTimer;
+        }
+
+    #endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) || ( configUSE_HIGH_RES_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewISRTimer( ISRTimer_t * const pxNewTimer,
+                                          ISRTimerCallbackFunction_t pxCallbackFunction,
+                                          void * pvTimerID,
+                                          uint8_t ucFlags )
+    {
+        pxNewTimer->ullExpiryTimeUs = 0U;
+        pxNewTimer->ulPeriodUs = 0U;
+        pxNewTimer->ulOverrunCount = 0U;
+        pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+        pxNewTimer->pvTimerID = pvTimerID;
+        pxNewTimer->uxHeapIndex = isrtmrNOT_IN_HEAP;
+        pxNewTimer->ucFlags = ucFlags;
+    }
+/*-----------------------------------------------------------*/
+
+    void vISRTimerDelete( ISRTimerHandle_t xTimer )
+    {
+        ISRTimer_t * const pxTimer = xTimer;
+
+        traceENTER_vISRTimerDelete( xTimer );
+
+        configASSERT( pxTimer );
+
+        traceISR_TIMER_DELETE( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) prvStopTimer( pxTimer );
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( pxTimer->ucFlags & isrtmrFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFree( pxTimer );
+            }
+            #else
+            {
+                /* Should not be possible to get here, ucFlags must be corrupt.
+                 * Force an assert. */
+                configASSERT( xTimer == ( ISRTimerHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure was not allocated dynamically and cannot be freed -
+             * just clear the callback so future use will assert. */
+            pxTimer->pxCallbackFunction = NULL;
+        }
+
+        traceRETURN_vISRTimerDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvHeapPlace( ISRTimer_t * const pxTimer,
+                              UBaseType_t uxIndex )
+    {
+        pxISRTimerHeap[ uxIndex ] = pxTimer;
+        pxTimer->uxHeapIndex = uxIndex;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvHeapSiftUp( UBaseType_t uxIndex )
+    {
+        ISRTimer_t * const pxTimer = pxISRTimerHeap[ uxIndex ];
+        UBaseType_t uxParent;
+
+        while( uxIndex > ( UBaseType_t ) 0 )
+        {
+            uxParent = isrtmrHEAP_PARENT( uxIndex );
+
+            if( pxISRTimerHeap[ uxParent ]->ullExpiryTimeUs <= pxTimer->ullExpiryTimeUs )
+            {
+                break;
+            }
+
+            prvHeapPlace( pxISRTimerHeap[ uxParent ], uxIndex );
+            uxIndex = uxParent;
+        }
+
+        prvHeapPlace( pxTimer, uxIndex );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvHeapSiftDown( UBaseType_t uxIndex )
+    {
+        ISRTimer_t * const pxTimer = pxISRTimerHeap[ uxIndex ];
+        UBaseType_t uxChild;
+
+        for( ; ; )
+        {
+            uxChild = isrtmrHEAP_FIRST_CHILD( uxIndex );
+
+            if( uxChild >= uxISRTimersRunning )
+            {
+                break;
+            }
+
+            /* Follow whichever child expires first. */
+            if( ( ( uxChild + ( UBaseType_t ) 1 ) < uxISRTimersRunning ) &&
+                ( pxISRTimerHeap[ uxChild + ( UBaseType_t ) 1 ]->ullExpiryTimeUs < pxISRTimerHeap[ uxChild ]->ullExpiryTimeUs ) )
+            {
+                uxChild++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxTimer->ullExpiryTimeUs <= pxISRTimerHeap[ uxChild ]->ullExpiryTimeUs )
+            {
+                break;
+            }
+
+            prvHeapPlace( pxISRTimerHeap[ uxChild ], uxIndex );
+            uxIndex = uxChild;
+        }
+
+        prvHeapPlace( pxTimer, uxIndex );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvHeapRemove( ISRTimer_t * const pxTimer )
+    {
+        const UBaseType_t uxIndex = pxTimer->uxHeapIndex;
+        ISRTimer_t * pxLastTimer;
+
+        uxISRTimersRunning--;
+        pxTimer->uxHeapIndex = isrtmrNOT_IN_HEAP;
+
+        if( uxIndex < uxISRTimersRunning )
+        {
+            /* Fill the hole with the last timer in the heap, then move that
+             * timer whichever way restores the heap order. */
+            pxLastTimer = pxISRTimerHeap[ uxISRTimersRunning ];
+            prvHeapPlace( pxLastTimer, uxIndex );
+
+            if( ( uxIndex > ( UBaseType_t ) 0 ) &&
+                ( pxLastTimer->ullExpiryTimeUs < pxISRTimerHeap[ isrtmrHEAP_PARENT( uxIndex ) ]->ullExpiryTimeUs ) )
+            {
+                prvHeapSiftUp( uxIndex );
+            }
+            else
+            {
+                prvHeapSiftDown( uxIndex );
+            }
+        }
+        else
+        {
+            /* The timer was the last in the heap, so nothing needs moving. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUpdateAlarm( void )
+    {
+        if( uxISRTimersRunning == ( UBaseType_t ) 0 )
+        {
+            if( xISRTimerAlarmArmed != pdFALSE )
+            {
+                xISRTimerAlarmArmed = pdFALSE;
+                portISR_TIMER_CANCEL_ALARM();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( ( xISRTimerAlarmArmed == pdFALSE ) ||
+                 ( ullISRTimerAlarmTimeUs != pxISRTimerHeap[ 0 ]->ullExpiryTimeUs ) )
+        {
+            ullISRTimerAlarmTimeUs = pxISRTimerHeap[ 0 ]->ullExpiryTimeUs;
+            xISRTimerAlarmArmed = pdTRUE;
+            portISR_TIMER_SET_ALARM( ullISRTimerAlarmTimeUs );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvStartTimer( ISRTimer_t * const pxTimer,
+                                     uint64_t ullExpiryTimeUs,
+                                     uint32_t ulPeriodUs )
+    {
+        BaseType_t xReturn = pdPASS;
+
+        configASSERT( pxTimer->pxCallbackFunction );
+
+        if( pxTimer->uxHeapIndex != isrtmrNOT_IN_HEAP )
+        {
+            /* Restarting a running timer - the timer can be moved to its new
+             * position without leaving the heap. */
+            pxTimer->ullExpiryTimeUs = ullExpiryTimeUs;
+            pxTimer->ulPeriodUs = ulPeriodUs;
+            pxTimer->ulOverrunCount = 0U;
+
+            if( ( pxTimer->uxHeapIndex > ( UBaseType_t ) 0 ) &&
+                ( ullExpiryTimeUs < pxISRTimerHeap[ isrtmrHEAP_PARENT( pxTimer->uxHeapIndex ) ]->ullExpiryTimeUs ) )
+            {
+                prvHeapSiftUp( pxTimer->uxHeapIndex );
+            }
+            else
+            {
+                prvHeapSiftDown( pxTimer->uxHeapIndex );
+            }
+        }
+        else if( uxISRTimersRunning < ( UBaseType_t ) configISR_TIMER_MAX_ACTIVE )
+        {
+            pxTimer->ullExpiryTimeUs = ullExpiryTimeUs;
+            pxTimer->ulPeriodUs = ulPeriodUs;
+            pxTimer->ulOverrunCount = 0U;
+
+            prvHeapPlace( pxTimer, uxISRTimersRunning );
+            uxISRTimersRunning++;
+            prvHeapSiftUp( pxTimer->uxHeapIndex );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        if( xReturn == pdPASS )
+        {
+            prvUpdateAlarm();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvStopTimer( ISRTimer_t * const pxTimer )
+    {
+        BaseType_t xReturn;
+
+        if( pxTimer->uxHeapIndex != isrtmrNOT_IN_HEAP )
+        {
+            prvHeapRemove( pxTimer );
+            prvUpdateAlarm();
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xISRTimerStart( ISRTimerHandle_t xTimer,
+                               uint64_t ullExpiryTimeUs,
+                               uint32_t ulPeriodUs )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xISRTimerStart( xTimer, ullExpiryTimeUs, ulPeriodUs );
+
+        configASSERT( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            xReturn = prvStartTimer( xTimer, ullExpiryTimeUs, ulPeriodUs );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xISRTimerStart( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xISRTimerStartFromISR( ISRTimerHandle_t xTimer,
+                                      uint64_t ullExpiryTimeUs,
+                                      uint32_t ulPeriodUs )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_xISRTimerStartFromISR( xTimer, ullExpiryTimeUs, ulPeriodUs );
+
+        configASSERT( xTimer );
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            xReturn = prvStartTimer( xTimer, ullExpiryTimeUs, ulPeriodUs );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xISRTimerStartFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xISRTimerStop( ISRTimerHandle_t xTimer )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xISRTimerStop( xTimer );
+
+        configASSERT( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            xReturn = prvStopTimer( xTimer );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xISRTimerStop( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xISRTimerStopFromISR( ISRTimerHandle_t xTimer )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_xISRTimerStopFromISR( xTimer );
+
+        configASSERT( xTimer );
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            xReturn = prvStopTimer( xTimer );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xISRTimerStopFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xISRTimerIsActive( ISRTimerHandle_t xTimer )
+    {
+        BaseType_t xReturn;
+        const ISRTimer_t * const pxTimer = xTimer;
+
+        traceENTER_xISRTimerIsActive( xTimer );
+
+        configASSERT( xTimer );
+
+        if( pxTimer->uxHeapIndex != isrtmrNOT_IN_HEAP )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        traceRETURN_xISRTimerIsActive( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvISRTimerGetTimerID( ISRTimerHandle_t xTimer )
+    {
+        const ISRTimer_t * const pxTimer = xTimer;
+
+        traceENTER_pvISRTimerGetTimerID( xTimer );
+
+        configASSERT( xTimer );
+
+        traceRETURN_pvISRTimerGetTimerID( pxTimer->pvTimerID );
+
+        return pxTimer->pvTimerID;
+    }
+/*-----------------------------------------------------------*/
+
+    uint64_t ullISRTimerGetExpiryTime( ISRTimerHandle_t xTimer )
+    {
+        const ISRTimer_t * const pxTimer = xTimer;
+        uint64_t ullReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_ullISRTimerGetExpiryTime( xTimer );
+
+        configASSERT( xTimer );
+
+        /* The expiry time may be updated by the alarm interrupt, and cannot be
+         * read in one access on a 32-bit architecture. */
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            ullReturn = pxTimer->ullExpiryTimeUs;
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_ullISRTimerGetExpiryTime( ullReturn );
+
+        return ullReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulISRTimerGetOverrunCount( ISRTimerHandle_t xTimer )
+    {
+        const ISRTimer_t * const pxTimer = xTimer;
+
+        traceENTER_ulISRTimerGetOverrunCount( xTimer );
+
+        configASSERT( xTimer );
+
+        traceRETURN_ulISRTimerGetOverrunCount( pxTimer->ulOverrunCount );
+
+        return pxTimer->ulOverrunCount;
+    }
+/*-----------------------------------------------------------*/
+
+    uint64_t ullISRTimerGetTimeUs( void )
+    {
+        uint64_t ullReturn;
+
+        traceENTER_ullISRTimerGetTimeUs();
+
+        ullReturn = portISR_TIMER_GET_TIME_US();
+
+        traceRETURN_ullISRTimerGetTimeUs( ullReturn );
+
+        return ullReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vISRTimerHandleAlarmFromISR( BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ISRTimer_t * pxTimer;
+        ISRTimerCallbackFunction_t pxCallbackFunction;
+        UBaseType_t uxSavedInterruptStatus;
+        uint64_t ullTimeNow;
+        uint64_t ullMissedPeriods;
+
+        traceENTER_vISRTimerHandleAlarmFromISR( pxHigherPriorityTaskWoken );
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+
+        /* The alarm has fired, or was raised spuriously - either way it must be
+         * programmed again below. */
+        xISRTimerAlarmArmed = pdFALSE;
+
+        while( uxISRTimersRunning > ( UBaseType_t ) 0 )
+        {
+            pxTimer = pxISRTimerHeap[ 0 ];
+            ullTimeNow = portISR_TIMER_GET_TIME_US();
+
+            if( pxTimer->ullExpiryTimeUs > ullTimeNow )
+            {
+                break;
+            }
+
+            if( pxTimer->ulPeriodUs != 0U )
+            {
+                /* Re-arm relative to the expiry time, not the current time,
+                 * so the period does not drift.  Whole periods that have
+                 * already passed are skipped rather than run back to back,
+                 * which could otherwise hold the processor in this interrupt
+                 * indefinitely. */
+                pxTimer->ullExpiryTimeUs += pxTimer->ulPeriodUs;
+
+                if( pxTimer->ullExpiryTimeUs <= ullTimeNow )
+                {
+                    ullMissedPeriods = ( ( ullTimeNow - pxTimer->ullExpiryTimeUs ) / pxTimer->ulPeriodUs ) + 1U;
+                    pxTimer->ullExpiryTimeUs += ullMissedPeriods * pxTimer->ulPeriodUs;
+                    pxTimer->ulOverrunCount += ( uint32_t ) ullMissedPeriods;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvHeapSiftDown( 0 );
+            }
+            else
+            {
+                prvHeapRemove( pxTimer );
+            }
+
+            pxCallbackFunction = pxTimer->pxCallbackFunction;
+
+            /* Call the callback outside of the critical section so it can use
+             * the interrupt safe API, including to start and stop ISR timers,
+             * and so other interrupts are not held off while it executes. */
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            {
+                traceISR_TIMER_EXPIRED( pxTimer );
+                pxCallbackFunction( pxTimer, pxHigherPriorityTaskWoken );
+            }
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        }
+
+        prvUpdateAlarm();
+
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_vISRTimerHandleAlarmFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include ISR timer functionality.  If you want to include ISR timers then
+ * ensure configUSE_ISR_TIMERS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_ISR_TIMERS == 1 */
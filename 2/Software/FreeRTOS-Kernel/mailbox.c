@@ -0,0 +1,585 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mailbox.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include mailbox functionality.  This #if is closed at the very bottom of
+ * this file.  If you want to include mailboxes then ensure configUSE_MAILBOXES
+ * is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_MAILBOXES == 1 )
+
+/* The sequence counter is odd while a write is in progress and even
+ * otherwise.  The version number visible to the application is the number of
+ * completed writes, which is the sequence counter divided by two.  A sequence
+ * of 0 means the mailbox has never been written, so when the counter wraps it
+ * skips from 0xFFFFFFFE to 2 rather than returning to 0. */
+    #define mbWRITE_IN_PROGRESS( ulSequence )    ( ( ( ulSequence ) & 1UL ) != 0UL )
+    #define mbSEQUENCE_TO_VERSION( ulSequence )  ( ( ulSequence ) >> 1UL )
+
+/* Bits set in ucFlags. */
+    #define mbFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+    typedef struct MailboxDef_t
+    {
+        volatile uint32_t ulSequence; /**< Incremented before and after every write, see mbWRITE_IN_PROGRESS(). */
+        size_t xItemSize;             /**< The size, in bytes, of the value held by the mailbox. */
+        uint8_t * pucStorage;         /**< Points to the xItemSize bytes that hold the value. */
+        List_t xWaitingReaders;       /**< Tasks blocked in xMailboxWaitForChange().  The list items live on the waiting tasks' stacks and are removed by the task that notifies them. */
+        uint8_t ucFlags;
+    } Mailbox_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the dynamic and static create functions to initialise a
+ * newly allocated mailbox structure.
+ */
+    static void prvInitialiseNewMailbox( Mailbox_t * const pxMailbox,
+                                         size_t xItemSize,
+                                         uint8_t * const pucStorage,
+                                         uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies pvItem into the mailbox, bracketing the copy with increments of the
+ * sequence counter.  Must be called from within a critical section.  Returns
+ * the version of the value written.
+ */
+    static uint32_t prvPublish( Mailbox_t * const pxMailbox,
+                                const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the value out of the mailbox without entering a critical section,
+ * retrying if a write completed on another core while the value was being
+ * copied.  Returns the version of the value copied out, which is 0 (and
+ * nothing is copied) if the mailbox has never been written.
+ */
+    static uint32_t prvReadLockFree( const Mailbox_t * const pxMailbox,
+                                     void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewMailbox( Mailbox_t * const pxMailbox,
+                                         size_t xItemSize,
+                                         uint8_t * const pucStorage,
+                                         uint8_t ucFlags )
+    {
+        ( void ) memset( ( void * ) pxMailbox, 0x00, sizeof( Mailbox_t ) );
+        pxMailbox->xItemSize = xItemSize;
+        pxMailbox->pucStorage = pucStorage;
+        pxMailbox->ucFlags = ucFlags;
+        vListInitialise( &( pxMailbox->xWaitingReaders ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvPublish( Mailbox_t * const pxMailbox,
+                                const void * pvItem )
+    {
+        uint32_t ulSequence = pxMailbox->ulSequence;
+
+        /* Mark the write as in progress before touching the storage so a
+         * reader on another core that overlaps the copy will retry. */
+        pxMailbox->ulSequence = ulSequence + 1UL;
+        portDATA_MEMORY_BARRIER();
+
+        ( void ) memcpy( ( void * ) pxMailbox->pucStorage, pvItem, pxMailbox->xItemSize );
+
+        portDATA_MEMORY_BARRIER();
+        ulSequence += 2UL;
+
+        if( ulSequence == 0UL )
+        {
+            ulSequence = 2UL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxMailbox->ulSequence = ulSequence;
+
+        return mbSEQUENCE_TO_VERSION( ulSequence );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvReadLockFree( const Mailbox_t * const pxMailbox,
+                                     void * pvBuffer )
+    {
+        uint32_t ulStart;
+
+        for( ; ; )
+        {
+            ulStart = pxMailbox->ulSequence;
+            portDATA_MEMORY_BARRIER();
+
+            if( ulStart == 0UL )
+            {
+                /* Never written, nothing to copy. */
+                break;
+            }
+
+            if( mbWRITE_IN_PROGRESS( ulStart ) == pdFALSE )
+            {
+                ( void ) memcpy( pvBuffer, ( const void * ) pxMailbox->pucStorage, pxMailbox->xItemSize );
+                portDATA_MEMORY_BARRIER();
+
+                if( pxMailbox->ulSequence == ulStart )
+                {
+                    /* No write overlapped the copy. */
+                    break;
+                }
+            }
+
+            /* A write is executing on another core.  Writes hold a critical
+             * section for only the duration of one memcpy(), so the retry is
+             * bounded. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return mbSEQUENCE_TO_VERSION( ulStart );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        MailboxHandle_t xMailboxCreate( size_t xItemSize )
+        {
+            Mailbox_t * pxMailbox = NULL;
+            uint8_t * pucAllocatedMemory;
+
+            traceENTER_xMailboxCreate( xItemSize );
+
+            configASSERT( xItemSize > ( size_t ) 0 );
+
+            /* Check for addition overflow before allocating the structure and
+             * the storage in one block, as is done for queues. */
+            if( xItemSize <= ( SIZE_MAX - sizeof( Mailbox_t ) ) )
+            {
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( Mailbox_t ) + xItemSize );
+
+                if( pucAllocatedMemory != NULL )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxMailbox = ( Mailbox_t * ) pucAllocatedMemory;
+
+                    prvInitialiseNewMailbox( pxMailbox,
+                                             xItemSize,
+                                             pucAllocatedMemory + sizeof( Mailbox_t ),
+                                             0 );
+
+                    traceMAILBOX_CREATE( pxMailbox );
+                }
+                else
+                {
+                    traceMAILBOX_CREATE_FAILED();
+                }
+            }
+            else
+            {
+                traceMAILBOX_CREATE_FAILED();
+            }
+
+            traceRETURN_xMailboxCreate( pxMailbox );
+
+            return pxMailbox;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        MailboxHandle_t xMailboxCreateStatic( size_t xItemSize,
+                                              uint8_t * pucMailboxStorage,
+                                              StaticMailbox_t * pxStaticMailbox )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            Mailbox_t * const pxMailbox = ( Mailbox_t * ) pxStaticMailbox;
+            MailboxHandle_t xReturn;
+
+            traceENTER_xMailboxCreateStatic( xItemSize, pucMailboxStorage, pxStaticMailbox );
+
+            configASSERT( pucMailboxStorage );
+            configASSERT( pxStaticMailbox );
+            configASSERT( xItemSize > ( size_t ) 0 );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticMailbox_t equals the size of the real
+                 * mailbox structure. */
+                volatile size_t xSize = sizeof( StaticMailbox_t );
+                configASSERT( xSize == sizeof( Mailbox_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucMailboxStorage != NULL ) && ( pxStaticMailbox != NULL ) )
+            {
+                prvInitialiseNewMailbox( pxMailbox,
+                                         xItemSize,
+                                         pucMailboxStorage,
+                                         mbFLAGS_IS_STATICALLY_ALLOCATED );
+
+                traceMAILBOX_CREATE( pxMailbox );
+
+                xReturn = ( MailboxHandle_t ) pxStaticMailbox;
+            }
+            else
+            {
+                xReturn = NULL;
+                traceMAILBOX_CREATE_FAILED();
+            }
+
+            traceRETURN_xMailboxCreateStatic( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vMailboxDelete( MailboxHandle_t xMailbox )
+    {
+        Mailbox_t * const pxMailbox = xMailbox;
+
+        traceENTER_vMailboxDelete( xMailbox );
+
+        configASSERT( pxMailbox );
+
+        /* A task blocked on the mailbox holds a list item on its own stack that
+         * is linked into xWaitingReaders. */
+        configASSERT( listLIST_IS_EMPTY( &( pxMailbox->xWaitingReaders ) ) != pdFALSE );
+
+        traceMAILBOX_DELETE( xMailbox );
+
+        if( ( pxMailbox->ucFlags & mbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* The structure and the storage were allocated using a single
+                 * call to pvPortMalloc(). */
+                vPortFree( ( void * ) pxMailbox );
+            }
+            #else
+            {
+                /* Should not be possible to get here, ucFlags must be corrupt.
+                 * Force an assert. */
+                configASSERT( xMailbox == ( MailboxHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure was not allocated dynamically and cannot be freed -
+             * just scrub it so future use will assert. */
+            ( void ) memset( pxMailbox, 0x00, sizeof( Mailbox_t ) );
+        }
+
+        traceRETURN_vMailboxDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulMailboxWrite( MailboxHandle_t xMailbox,
+                             const void * pvItem )
+    {
+        Mailbox_t * const pxMailbox = xMailbox;
+        ListItem_t * pxListItem;
+        TaskHandle_t xTaskToNotify;
+        UBaseType_t uxWaiters;
+        uint32_t ulVersion;
+
+        traceENTER_ulMailboxWrite( xMailbox, pvItem );
+
+        configASSERT( pxMailbox );
+        configASSERT( pvItem );
+
+        taskENTER_CRITICAL();
+        {
+            ulVersion = prvPublish( pxMailbox, pvItem );
+
+            traceMAILBOX_WRITE( xMailbox, ulVersion );
+
+            /* Unlink each waiting task before notifying it.  Some ports switch
+             * to the notified task immediately, even from within a critical
+             * section, and the list item lives on that task's stack.  Only the
+             * tasks that were waiting on entry are notified - a notified task
+             * that runs and waits again is appended behind them. */
+            for( uxWaiters = listCURRENT_LIST_LENGTH( &( pxMailbox->xWaitingReaders ) ); uxWaiters > ( UBaseType_t ) 0; uxWaiters-- )
+            {
+                pxListItem = listGET_HEAD_ENTRY( &( pxMailbox->xWaitingReaders ) );
+                xTaskToNotify = ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxListItem );
+                ( void ) uxListRemove( pxListItem );
+                ( void ) xTaskNotifyGiveIndexed( xTaskToNotify, configMAILBOX_NOTIFICATION_INDEX );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_ulMailboxWrite( ulVersion );
+
+        return ulVersion;
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulMailboxWriteFromISR( MailboxHandle_t xMailbox,
+                                    const void * pvItem,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        Mailbox_t * const pxMailbox = xMailbox;
+        ListItem_t * pxListItem;
+        TaskHandle_t xTaskToNotify;
+        UBaseType_t uxWaiters;
+        uint32_t ulVersion;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_ulMailboxWriteFromISR( xMailbox, pvItem, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxMailbox );
+        configASSERT( pvItem );
+
+        /* See the comments in xQueueGenericSendFromISR() regarding interrupt
+         * priorities. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            ulVersion = prvPublish( pxMailbox, pvItem );
+
+            traceMAILBOX_WRITE_FROM_ISR( xMailbox, ulVersion );
+
+            for( uxWaiters = listCURRENT_LIST_LENGTH( &( pxMailbox->xWaitingReaders ) ); uxWaiters > ( UBaseType_t ) 0; uxWaiters-- )
+            {
+                pxListItem = listGET_HEAD_ENTRY( &( pxMailbox->xWaitingReaders ) );
+                xTaskToNotify = ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxListItem );
+                ( void ) uxListRemove( pxListItem );
+                vTaskNotifyGiveIndexedFromISR( xTaskToNotify, configMAILBOX_NOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_ulMailboxWriteFromISR( ulVersion );
+
+        return ulVersion;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xMailboxRead( MailboxHandle_t xMailbox,
+                             void * pvBuffer,
+                             uint32_t * pulVersion )
+    {
+        const Mailbox_t * const pxMailbox = xMailbox;
+        uint32_t ulVersion;
+        BaseType_t xReturn;
+
+        traceENTER_xMailboxRead( xMailbox, pvBuffer, pulVersion );
+
+        configASSERT( pxMailbox );
+        configASSERT( pvBuffer );
+
+        ulVersion = prvReadLockFree( pxMailbox, pvBuffer );
+
+        if( pulVersion != NULL )
+        {
+            *pulVersion = ulVersion;
+        }
+
+        xReturn = ( ulVersion != 0UL ) ? pdPASS : pdFAIL;
+
+        traceRETURN_xMailboxRead( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xMailboxReadIfChanged( MailboxHandle_t xMailbox,
+                                      void * pvBuffer,
+                                      uint32_t * pulVersion )
+    {
+        const Mailbox_t * const pxMailbox = xMailbox;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xMailboxReadIfChanged( xMailbox, pvBuffer, pulVersion );
+
+        configASSERT( pxMailbox );
+        configASSERT( pvBuffer );
+        configASSERT( pulVersion );
+
+        /* Compare against the version of the last completed write without
+         * copying anything - this is the common case for a periodic task
+         * polling an input that has not changed. */
+        if( mbSEQUENCE_TO_VERSION( pxMailbox->ulSequence ) != *pulVersion )
+        {
+            *pulVersion = prvReadLockFree( pxMailbox, pvBuffer );
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xMailboxReadIfChanged( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulMailboxGetVersion( MailboxHandle_t xMailbox )
+    {
+        const Mailbox_t * const pxMailbox = xMailbox;
+        uint32_t ulVersion;
+
+        traceENTER_ulMailboxGetVersion( xMailbox );
+
+        configASSERT( pxMailbox );
+
+        /* While a write is in progress on another core this still returns the
+         * version of the last completed write. */
+        ulVersion = mbSEQUENCE_TO_VERSION( pxMailbox->ulSequence );
+
+        traceRETURN_ulMailboxGetVersion( ulVersion );
+
+        return ulVersion;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xMailboxWaitForChange( MailboxHandle_t xMailbox,
+                                      void * pvBuffer,
+                                      uint32_t * pulVersion,
+                                      TickType_t xTicksToWait )
+    {
+        Mailbox_t * const pxMailbox = xMailbox;
+        ListItem_t xWaitItem;
+        TimeOut_t xTimeOut;
+        BaseType_t xReturn = pdFALSE;
+        BaseType_t xRegistered;
+
+        traceENTER_xMailboxWaitForChange( xMailbox, pvBuffer, pulVersion, xTicksToWait );
+
+        configASSERT( pxMailbox );
+        configASSERT( pvBuffer );
+        configASSERT( pulVersion );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        vListInitialiseItem( &xWaitItem );
+        listSET_LIST_ITEM_OWNER( &xWaitItem, xTaskGetCurrentTaskHandle() );
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            if( xMailboxReadIfChanged( xMailbox, pvBuffer, pulVersion ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                break;
+            }
+
+            xRegistered = pdFALSE;
+
+            taskENTER_CRITICAL();
+            {
+                /* Writers publish inside a critical section, so if the version
+                 * still matches here then no write can be missed between
+                 * clearing any stale notification and joining the list. */
+                if( ulMailboxGetVersion( xMailbox ) == *pulVersion )
+                {
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, configMAILBOX_NOTIFICATION_INDEX );
+                    ( void ) ulTaskNotifyValueClearIndexed( NULL, configMAILBOX_NOTIFICATION_INDEX, ( uint32_t ) ~0UL );
+                    vListInsertEnd( &( pxMailbox->xWaitingReaders ), &xWaitItem );
+                    xRegistered = pdTRUE;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xRegistered != pdFALSE )
+            {
+                traceBLOCKING_ON_MAILBOX_WAIT( xMailbox );
+
+                ( void ) ulTaskNotifyTakeIndexed( configMAILBOX_NOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+
+                taskENTER_CRITICAL();
+                {
+                    /* The item has already been removed if the task was
+                     * notified, rather than timing out. */
+                    if( listLIST_ITEM_CONTAINER( &xWaitItem ) != NULL )
+                    {
+                        ( void ) uxListRemove( &xWaitItem );
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        traceRETURN_xMailboxWaitForChange( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include mailbox functionality.  If you want to include mailboxes then
+ * ensure configUSE_MAILBOXES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_MAILBOXES == 1 */
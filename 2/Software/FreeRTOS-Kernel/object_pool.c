@@ -0,0 +1,505 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "object_pool.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include object pool functionality.  This #if is closed at the very bottom
+ * of this file.  If you want to include object pools then ensure
+ * configUSE_OBJECT_POOLS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_OBJECT_POOLS == 1 )
+
+    #if ( ( configSTACK_POOL_SMALL_LENGTH > 0 ) && ( configSTACK_POOL_SMALL_DEPTH == 0 ) ) || \
+    ( ( configSTACK_POOL_MEDIUM_LENGTH > 0 ) && ( configSTACK_POOL_MEDIUM_DEPTH == 0 ) ) ||     \
+    ( ( configSTACK_POOL_LARGE_LENGTH > 0 ) && ( configSTACK_POOL_LARGE_DEPTH == 0 ) )
+        #error A stack pool with a non-zero length must also have a non-zero depth.
+    #endif
+
+    #define poolNUMBER_OF_POOLS    ( ( UBaseType_t ) eObjectPoolStackLarge + ( UBaseType_t ) 1U )
+
+/* Every block is a multiple of portBYTE_ALIGNMENT bytes, so every block in a
+ * pool is aligned if the first one is. */
+    #define poolALIGN_UP( xSize )    ( ( ( size_t ) ( xSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The size of the blocks in each pool.  The kernel's private structures are
+ * the same size as their public static counterparts, which are visible here. */
+    #define poolTASK_BLOCK_SIZE            poolALIGN_UP( sizeof( StaticTask_t ) )
+    #define poolQUEUE_BLOCK_SIZE           poolALIGN_UP( sizeof( StaticQueue_t ) + ( size_t ) configQUEUE_POOL_STORAGE_SIZE )
+    #define poolTIMER_BLOCK_SIZE           poolALIGN_UP( sizeof( StaticTimer_t ) )
+    #define poolSTACK_SMALL_BLOCK_SIZE     poolALIGN_UP( ( size_t ) configSTACK_POOL_SMALL_DEPTH * sizeof( StackType_t ) )
+    #define poolSTACK_MEDIUM_BLOCK_SIZE    poolALIGN_UP( ( size_t ) configSTACK_POOL_MEDIUM_DEPTH * sizeof( StackType_t ) )
+    #define poolSTACK_LARGE_BLOCK_SIZE     poolALIGN_UP( ( size_t ) configSTACK_POOL_LARGE_DEPTH * sizeof( StackType_t ) )
+
+/* The storage for each pool.  The extra portBYTE_ALIGNMENT bytes allow the
+ * first block to be aligned wherever the linker places the array. */
+    #define poolSTORAGE_SIZE( uxLength, xBlockSize )    ( ( ( size_t ) ( uxLength ) * ( xBlockSize ) ) + ( size_t ) portBYTE_ALIGNMENT )
+
+    #if ( configTASK_POOL_LENGTH > 0 )
+        PRIVILEGED_DATA static uint8_t ucTaskPoolStorage[ poolSTORAGE_SIZE( configTASK_POOL_LENGTH, poolTASK_BLOCK_SIZE ) ];
+        #define poolTASK_STORAGE    ucTaskPoolStorage
+    #else
+        #define poolTASK_STORAGE    NULL
+    #endif
+
+    #if ( configQUEUE_POOL_LENGTH > 0 )
+        PRIVILEGED_DATA static uint8_t ucQueuePoolStorage[ poolSTORAGE_SIZE( configQUEUE_POOL_LENGTH, poolQUEUE_BLOCK_SIZE ) ];
+        #define poolQUEUE_STORAGE    ucQueuePoolStorage
+    #else
+        #define poolQUEUE_STORAGE    NULL
+    #endif
+
+    #if ( configTIMER_POOL_LENGTH > 0 )
+        PRIVILEGED_DATA static uint8_t ucTimerPoolStorage[ poolSTORAGE_SIZE( configTIMER_POOL_LENGTH, poolTIMER_BLOCK_SIZE ) ];
+        #define poolTIMER_STORAGE    ucTimerPoolStorage
+    #else
+        #define poolTIMER_STORAGE    NULL
+    #endif
+
+    #if ( configSTACK_POOL_SMALL_LENGTH > 0 )
+        PRIVILEGED_DATA static uint8_t ucStackSmallPoolStorage[ poolSTORAGE_SIZE( configSTACK_POOL_SMALL_LENGTH, poolSTACK_SMALL_BLOCK_SIZE ) ];
+        #define poolSTACK_SMALL_STORAGE    ucStackSmallPoolStorage
+    #else
+        #define poolSTACK_SMALL_STORAGE    NULL
+    #endif
+
+    #if ( configSTACK_POOL_MEDIUM_LENGTH > 0 )
+        PRIVILEGED_DATA static uint8_t ucStackMediumPoolStorage[ poolSTORAGE_SIZE( configSTACK_POOL_MEDIUM_LENGTH, poolSTACK_MEDIUM_BLOCK_SIZE ) ];
+        #define poolSTACK_MEDIUM_STORAGE    ucStackMediumPoolStorage
+    #else
+        #define poolSTACK_MEDIUM_STORAGE    NULL
+    #endif
+
+    #if ( configSTACK_POOL_LARGE_LENGTH > 0 )
+        PRIVILEGED_DATA static uint8_t ucStackLargePoolStorage[ poolSTORAGE_SIZE( configSTACK_POOL_LARGE_LENGTH, poolSTACK_LARGE_BLOCK_SIZE ) ];
+        #define poolSTACK_LARGE_STORAGE    ucStackLargePoolStorage
+    #else
+        #define poolSTACK_LARGE_STORAGE    NULL
+    #endif
+
+/*
+ * The state of one pool.  Blocks are handed out from the free list if it is
+ * not empty, otherwise from the part of the storage that has never been used,
+ * so a pool needs no initialisation other than its static initialiser.  A free
+ * block holds the pointer to the next free block in its first bytes.
+ */
+    typedef struct xOBJECT_POOL
+    {
+        uint8_t * pucStorage;                /**< The storage for the blocks, or NULL if the pool has no blocks.  Not necessarily aligned. */
+        size_t xBlockSize;                   /**< The size of each block, a multiple of portBYTE_ALIGNMENT. */
+        UBaseType_t uxLength;                /**< The number of blocks in the pool. */
+        UBaseType_t uxNextUnused;            /**< The index of the first block that has never been handed out. */
+        void * pvFreeList;                   /**< The most recently freed block, or NULL if no block is on the free list. */
+        UBaseType_t uxFreeBlocks;            /**< The number of blocks not in use. */
+        UBaseType_t uxMinimumEverFreeBlocks; /**< The lowest value of uxFreeBlocks. */
+        size_t xNumberOfFallbacks;           /**< The number of allocations that fell back to the heap because the pool was empty. */
+    } ObjectPool_t;
+
+/*-----------------------------------------------------------*/
+
+/* The pools, indexed by eObjectPool.  Only accessed from within a critical
+ * section once the scheduler has started. */
+    PRIVILEGED_DATA static ObjectPool_t xPools[ poolNUMBER_OF_POOLS ] =
+    {
+        { poolTASK_STORAGE,         poolTASK_BLOCK_SIZE,         configTASK_POOL_LENGTH,         0U, NULL, configTASK_POOL_LENGTH,         configTASK_POOL_LENGTH,         0U },
+        { poolQUEUE_STORAGE,        poolQUEUE_BLOCK_SIZE,        configQUEUE_POOL_LENGTH,        0U, NULL, configQUEUE_POOL_LENGTH,        configQUEUE_POOL_LENGTH,        0U },
+        { poolTIMER_STORAGE,        poolTIMER_BLOCK_SIZE,        configTIMER_POOL_LENGTH,        0U, NULL, configTIMER_POOL_LENGTH,        configTIMER_POOL_LENGTH,        0U },
+        { poolSTACK_SMALL_STORAGE,  poolSTACK_SMALL_BLOCK_SIZE,  configSTACK_POOL_SMALL_LENGTH,  0U, NULL, configSTACK_POOL_SMALL_LENGTH,  configSTACK_POOL_SMALL_LENGTH,  0U },
+        { poolSTACK_MEDIUM_STORAGE, poolSTACK_MEDIUM_BLOCK_SIZE, configSTACK_POOL_MEDIUM_LENGTH, 0U, NULL, configSTACK_POOL_MEDIUM_LENGTH, configSTACK_POOL_MEDIUM_LENGTH, 0U },
+        { poolSTACK_LARGE_STORAGE,  poolSTACK_LARGE_BLOCK_SIZE,  configSTACK_POOL_LARGE_LENGTH,  0U, NULL, configSTACK_POOL_LARGE_LENGTH,  configSTACK_POOL_LARGE_LENGTH,  0U }
+    };
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the address of the first block in the pool.
+ */
+    static portPOINTER_SIZE_TYPE prvPoolStart( const ObjectPool_t * pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes a block from the pool, or returns NULL if the pool is empty.
+ */
+    static void * prvPoolTake( ObjectPool_t * pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records that an allocation that would have fitted in the pool had to be
+ * made from the heap instead.
+ */
+    static void prvPoolFallback( ObjectPool_t * pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the pool that holds pv, or NULL if pv was not allocated from a pool.
+ */
+    static ObjectPool_t * prvFindPool( const void * pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns a block to the pool it was taken from.
+ */
+    static void prvPoolGive( ObjectPool_t * pxPool,
+                             void * pv ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static portPOINTER_SIZE_TYPE prvPoolStart( const ObjectPool_t * pxPool )
+    {
+        portPOINTER_SIZE_TYPE uxStart = ( portPOINTER_SIZE_TYPE ) pxPool->pucStorage;
+
+        uxStart += ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK;
+        uxStart &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+        return uxStart;
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvPoolTake( ObjectPool_t * pxPool )
+    {
+        void * pvReturn = NULL;
+
+        taskENTER_CRITICAL();
+        {
+            if( pxPool->pvFreeList != NULL )
+            {
+                /* Reuse the most recently freed block. */
+                pvReturn = pxPool->pvFreeList;
+                pxPool->pvFreeList = *( ( void ** ) pvReturn );
+            }
+            else if( pxPool->uxNextUnused < pxPool->uxLength )
+            {
+                /* Hand out a block that has never been used. */
+                pvReturn = ( void * ) ( prvPoolStart( pxPool ) + ( ( portPOINTER_SIZE_TYPE ) pxPool->uxNextUnused * ( portPOINTER_SIZE_TYPE ) pxPool->xBlockSize ) );
+                pxPool->uxNextUnused++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pvReturn != NULL )
+            {
+                pxPool->uxFreeBlocks--;
+
+                if( pxPool->uxFreeBlocks < pxPool->uxMinimumEverFreeBlocks )
+                {
+                    pxPool->uxMinimumEverFreeBlocks = pxPool->uxFreeBlocks;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPoolFallback( ObjectPool_t * pxPool )
+    {
+        taskENTER_CRITICAL();
+        {
+            pxPool->xNumberOfFallbacks++;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static ObjectPool_t * prvFindPool( const void * pv )
+    {
+        ObjectPool_t * pxPool = NULL;
+        portPOINTER_SIZE_TYPE uxAddress = ( portPOINTER_SIZE_TYPE ) pv;
+        portPOINTER_SIZE_TYPE uxStart;
+        UBaseType_t uxPool;
+
+        for( uxPool = 0U; ( uxPool < poolNUMBER_OF_POOLS ) && ( pxPool == NULL ); uxPool++ )
+        {
+            if( xPools[ uxPool ].uxLength > 0U )
+            {
+                uxStart = prvPoolStart( &( xPools[ uxPool ] ) );
+
+                if( ( uxAddress >= uxStart ) &&
+                    ( uxAddress < ( uxStart + ( ( portPOINTER_SIZE_TYPE ) xPools[ uxPool ].uxLength * ( portPOINTER_SIZE_TYPE ) xPools[ uxPool ].xBlockSize ) ) ) )
+                {
+                    /* Only the start of a block can be freed. */
+                    configASSERT( ( ( uxAddress - uxStart ) % ( portPOINTER_SIZE_TYPE ) xPools[ uxPool ].xBlockSize ) == 0U );
+                    pxPool = &( xPools[ uxPool ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pxPool;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPoolGive( ObjectPool_t * pxPool,
+                             void * pv )
+    {
+        taskENTER_CRITICAL();
+        {
+            configASSERT( pxPool->uxFreeBlocks < pxPool->uxLength );
+
+            *( ( void ** ) pv ) = pxPool->pvFreeList;
+            pxPool->pvFreeList = pv;
+            pxPool->uxFreeBlocks++;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvObjectPoolMalloc( eObjectPool ePool,
+                               size_t xWantedSize )
+    {
+        ObjectPool_t * pxPool;
+        void * pvReturn = NULL;
+
+        traceENTER_pvObjectPoolMalloc( ePool, xWantedSize );
+
+        configASSERT( ( UBaseType_t ) ePool < poolNUMBER_OF_POOLS );
+
+        pxPool = &( xPools[ ePool ] );
+
+        /* Queues whose storage does not fit in a pool block always come from
+         * the heap. */
+        if( ( pxPool->uxLength > 0U ) && ( xWantedSize <= pxPool->xBlockSize ) )
+        {
+            pvReturn = prvPoolTake( pxPool );
+
+            if( pvReturn == NULL )
+            {
+                prvPoolFallback( pxPool );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pvReturn == NULL )
+        {
+            pvReturn = pvPortMalloc( xWantedSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_pvObjectPoolMalloc( pvReturn );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vObjectPoolFree( void * pv )
+    {
+        ObjectPool_t * pxPool;
+
+        traceENTER_vObjectPoolFree( pv );
+
+        if( pv != NULL )
+        {
+            pxPool = prvFindPool( pv );
+
+            if( pxPool != NULL )
+            {
+                prvPoolGive( pxPool, pv );
+            }
+            else
+            {
+                vPortFree( pv );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vObjectPoolFree();
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvObjectPoolMallocStack( size_t xWantedSize )
+    {
+        ObjectPool_t * pxFirstFit = NULL;
+        void * pvReturn = NULL;
+        UBaseType_t uxPool;
+
+        traceENTER_pvObjectPoolMallocStack( xWantedSize );
+
+        /* Use the smallest stack pool the stack fits in, or the next larger
+         * pool if that one is empty. */
+        for( uxPool = ( UBaseType_t ) eObjectPoolStackSmall; ( uxPool <= ( UBaseType_t ) eObjectPoolStackLarge ) && ( pvReturn == NULL ); uxPool++ )
+        {
+            if( ( xPools[ uxPool ].uxLength > 0U ) && ( xWantedSize <= xPools[ uxPool ].xBlockSize ) )
+            {
+                if( pxFirstFit == NULL )
+                {
+                    pxFirstFit = &( xPools[ uxPool ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pvReturn = prvPoolTake( &( xPools[ uxPool ] ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( pvReturn == NULL )
+        {
+            if( pxFirstFit != NULL )
+            {
+                prvPoolFallback( pxFirstFit );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pvReturn = pvPortMallocStack( xWantedSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_pvObjectPoolMallocStack( pvReturn );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vObjectPoolFreeStack( void * pv )
+    {
+        ObjectPool_t * pxPool;
+
+        traceENTER_vObjectPoolFreeStack( pv );
+
+        if( pv != NULL )
+        {
+            pxPool = prvFindPool( pv );
+
+            if( pxPool != NULL )
+            {
+                prvPoolGive( pxPool, pv );
+            }
+            else
+            {
+                vPortFreeStack( pv );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vObjectPoolFreeStack();
+    }
+/*-----------------------------------------------------------*/
+
+    void vObjectPoolGetStats( eObjectPool ePool,
+                              ObjectPoolStats_t * pxPoolStats )
+    {
+        const ObjectPool_t * pxPool;
+
+        traceENTER_vObjectPoolGetStats( ePool, pxPoolStats );
+
+        configASSERT( ( UBaseType_t ) ePool < poolNUMBER_OF_POOLS );
+        configASSERT( pxPoolStats );
+
+        pxPool = &( xPools[ ePool ] );
+
+        taskENTER_CRITICAL();
+        {
+            pxPoolStats->xBlockSize = pxPool->xBlockSize;
+            pxPoolStats->uxLength = pxPool->uxLength;
+            pxPoolStats->uxFreeBlocks = pxPool->uxFreeBlocks;
+            pxPoolStats->uxMinimumEverFreeBlocks = pxPool->uxMinimumEverFreeBlocks;
+            pxPoolStats->xNumberOfFallbacks = pxPool->xNumberOfFallbacks;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vObjectPoolGetStats();
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+    void vObjectPoolResetState( void )
+    {
+        UBaseType_t uxPool;
+
+        for( uxPool = 0U; uxPool < poolNUMBER_OF_POOLS; uxPool++ )
+        {
+            xPools[ uxPool ].uxNextUnused = 0U;
+            xPools[ uxPool ].pvFreeList = NULL;
+            xPools[ uxPool ].uxFreeBlocks = xPools[ uxPool ].uxLength;
+            xPools[ uxPool ].uxMinimumEverFreeBlocks = xPools[ uxPool ].uxLength;
+            xPools[ uxPool ].xNumberOfFallbacks = 0U;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include object pool functionality.  If you want to include object pools
+ * then ensure configUSE_OBJECT_POOLS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_OBJECT_POOLS == 1 */
@@ -33,6 +33,23 @@
  *
  * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
  * memory management pages of https://www.FreeRTOS.org for more information.
+ *
+ * Set configHEAP_USE_CORE_CACHES to 1 to give each core a cache of free small
+ * blocks.  In SMP builds every call to the heap otherwise suspends the
+ * scheduler, which serialises all the cores on one lock.  Blocks of up to
+ * configHEAP_CORE_CACHE_CLASSES size classes are instead allocated from, and
+ * freed to, the cache of the calling core with only that core's interrupts
+ * masked.  An empty cache is refilled with configHEAP_CORE_CACHE_BATCH blocks
+ * taken from the heap in one go, and once a cache holds more than
+ * configHEAP_CORE_CACHE_DEPTH blocks of a size class a batch of them is
+ * returned to the heap, so the scheduler is only suspended once per batch.
+ * Blocks held in a cache are counted as allocated by xPortGetFreeHeapSize().
+ * vPortHeapFlushCoreCache() returns the blocks cached by the calling core to
+ * the heap.  Cached blocks cannot be merged with their neighbours, so before an
+ * allocation fails the calling core's cache is flushed and the allocation
+ * retried.  Blocks cached by other cores are not reclaimed, so up to
+ * configHEAP_CORE_CACHE_CLASSES * configHEAP_CORE_CACHE_DEPTH blocks per other
+ * core can still be unavailable to a large allocation.
  */
 #include <stdlib.h>
 #include <string.h>
@@ -55,6 +72,33 @@
     #define configHEAP_CLEAR_MEMORY_ON_FREE    0
 #endif
 
+/* The number of size classes each core caches.  Size class n holds blocks of
+ * ( n + 1 ) * heapCACHE_GRANULE bytes, including the block header. */
+#ifndef configHEAP_CORE_CACHE_CLASSES
+    #define configHEAP_CORE_CACHE_CLASSES    8
+#endif
+
+/* The number of blocks moved between a core cache and the heap at a time. */
+#ifndef configHEAP_CORE_CACHE_BATCH
+    #define configHEAP_CORE_CACHE_BATCH    8
+#endif
+
+/* The number of blocks of each size class a core cache can hold before a
+ * batch is returned to the heap. */
+#ifndef configHEAP_CORE_CACHE_DEPTH
+    #define configHEAP_CORE_CACHE_DEPTH    ( 2 * configHEAP_CORE_CACHE_BATCH )
+#endif
+
+#if ( configHEAP_USE_CORE_CACHES == 1 )
+    #if ( configHEAP_CORE_CACHE_CLASSES < 1 )
+        #error configHEAP_CORE_CACHE_CLASSES must be at least 1.
+    #endif
+
+    #if ( ( configHEAP_CORE_CACHE_BATCH < 1 ) || ( configHEAP_CORE_CACHE_DEPTH < configHEAP_CORE_CACHE_BATCH ) )
+        #error configHEAP_CORE_CACHE_BATCH must be at least 1 and not more than configHEAP_CORE_CACHE_DEPTH.
+    #endif
+#endif
+
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
 
@@ -83,6 +127,22 @@
 #define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
 #define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
 
+#if ( configHEAP_USE_CORE_CACHES == 1 )
+
+/* Core cache size classes are multiples of the smallest block size. */
+    #define heapCACHE_GRANULE                ( heapMINIMUM_BLOCK_SIZE )
+    #define heapCACHE_MAX_BLOCK_SIZE         ( heapCACHE_GRANULE * ( size_t ) configHEAP_CORE_CACHE_CLASSES )
+
+/* The size class a request for xBlockSize bytes is served from, and the size
+ * class a free block of xBlockSize bytes is cached in.  A request is rounded
+ * up and a free block rounded down, so every block in a class is large enough
+ * for every request served from it. */
+    #define heapCACHE_CLASS_TO_ALLOCATE( xBlockSize )    ( ( UBaseType_t ) ( ( ( xBlockSize ) - ( size_t ) 1 ) / heapCACHE_GRANULE ) )
+    #define heapCACHE_CLASS_TO_FREE( xBlockSize )        ( ( UBaseType_t ) ( ( ( xBlockSize ) / heapCACHE_GRANULE ) - ( size_t ) 1 ) )
+    #define heapCACHE_CLASS_SIZE( uxClass )              ( ( ( size_t ) ( uxClass ) + ( size_t ) 1 ) * heapCACHE_GRANULE )
+
+#endif /* configHEAP_USE_CORE_CACHES */
+
 /*-----------------------------------------------------------*/
 
 /* Allocate the memory for the heap. */
@@ -151,6 +211,55 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEG
  */
 static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Takes a block of at least xWantedSize bytes, including the BlockLink_t
+ * header, out of the list of free blocks and marks it as allocated.  Returns
+ * NULL if there is no block large enough.  Must be called with the scheduler
+ * suspended.
+ */
+static BlockLink_t * prvAllocateBlock( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+#if ( configHEAP_USE_CORE_CACHES == 1 )
+
+/*
+ * Takes a block of size class uxClass from the cache of the calling core,
+ * first refilling the cache with a batch of blocks from the heap if it is
+ * empty.  Returns NULL if the heap has no block large enough.
+ */
+    static BlockLink_t * prvCacheMalloc( UBaseType_t uxClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * A core's cache is only accessed between prvEnterCoreCache() and
+ * prvExitCoreCache(), which mask the calling core's interrupts, or with the
+ * scheduler suspended, so the task accessing it can neither be switched out
+ * nor moved to another core part way through.  No other core ever accesses
+ * it, so no lock is needed.
+ */
+    static UBaseType_t prvEnterCoreCache( void ) PRIVILEGED_FUNCTION;
+    static void prvExitCoreCache( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds the free block pxBlock to the cache of the calling core, then returns a
+ * batch of blocks to the heap if the cache holds too many of that size class.
+ */
+    static void prvCacheFree( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Inserts a list of cached blocks, linked through their pxNextFreeBlock
+ * members, into the list of free blocks.  Must be called with the scheduler
+ * suspended.
+ */
+    static void prvReturnBlocksToHeap( BlockLink_t * pxBlocks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns every block cached by the calling core to the list of free blocks.
+ * Returns pdTRUE if the cache held any blocks.  Must be called with the
+ * scheduler suspended.
+ */
+    static BaseType_t prvFlushCoreCache( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configHEAP_USE_CORE_CACHES */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -168,13 +277,28 @@ PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
 
+#if ( configHEAP_USE_CORE_CACHES == 1 )
+
+/* The free blocks cached by one core, one list per size class.  Cached blocks
+ * are linked through their pxNextFreeBlock members and are marked as free, so
+ * freeing a cached block again is caught by vPortFree(). */
+    typedef struct xCORE_CACHE
+    {
+        BlockLink_t * pxBlocks[ configHEAP_CORE_CACHE_CLASSES ];
+        UBaseType_t uxBlocks[ configHEAP_CORE_CACHE_CLASSES ];
+        size_t xNumberOfAllocations; /* Allocations served from this cache, which are not counted in xNumberOfSuccessfulAllocations. */
+        size_t xNumberOfFrees;       /* Frees made to this cache, which are not counted in xNumberOfSuccessfulFrees. */
+    } CoreCache_t;
+
+    PRIVILEGED_DATA static CoreCache_t xCoreCaches[ configNUMBER_OF_CORES ];
+
+#endif /* configHEAP_USE_CORE_CACHES */
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
 {
-    BlockLink_t * pxBlock;
-    BlockLink_t * pxPreviousBlock;
-    BlockLink_t * pxNewBlockLink;
+    BlockLink_t * pxBlock = NULL;
     void * pvReturn = NULL;
     size_t xAdditionalRequiredSize;
     size_t xAllocatedBlockSize = 0;
@@ -218,97 +342,76 @@ void * pvPortMalloc( size_t xWantedSize )
         mtCOVERAGE_TEST_MARKER();
     }
 
-    vTaskSuspendAll();
+    #if ( configHEAP_USE_CORE_CACHES == 1 )
     {
-        /* If this is the first call to malloc then the heap will require
-         * initialisation to setup the list of free blocks. */
-        if( pxEnd == NULL )
+        /* Small blocks come from the calling core's cache, without suspending
+         * the scheduler unless the cache has to be refilled. */
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= heapCACHE_MAX_BLOCK_SIZE ) )
         {
-            prvHeapInit();
+            pxBlock = prvCacheMalloc( heapCACHE_CLASS_TO_ALLOCATE( xWantedSize ) );
+
+            if( pxBlock != NULL )
+            {
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                traceMALLOC( pvReturn, ( pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+    }
+    #endif /* configHEAP_USE_CORE_CACHES */
 
-        /* Check the block size we are trying to allocate is not so large that the
-         * top bit is set.  The top bit of the block size member of the BlockLink_t
-         * structure is used to determine who owns the block - the application or
-         * the kernel, so it must be free. */
-        if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+    if( pvReturn == NULL )
+    {
+        vTaskSuspendAll();
         {
-            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            /* If this is the first call to malloc then the heap will require
+             * initialisation to setup the list of free blocks. */
+            if( pxEnd == NULL )
+            {
+                prvHeapInit();
+            }
+            else
             {
-                /* Traverse the list from the start (lowest address) block until
-                 * one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
-                heapVALIDATE_BLOCK_POINTER( pxBlock );
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
-                {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
-                    heapVALIDATE_BLOCK_POINTER( pxBlock );
-                }
+            /* Check the block size we are trying to allocate is not so large that the
+             * top bit is set.  The top bit of the block size member of the BlockLink_t
+             * structure is used to determine who owns the block - the application or
+             * the kernel, so it must be free. */
+            if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+            {
+                pxBlock = prvAllocateBlock( xWantedSize );
 
-                /* If the end marker was reached then a block of adequate size
-                 * was not found. */
-                if( pxBlock != pxEnd )
+                #if ( configHEAP_USE_CORE_CACHES == 1 )
                 {
-                    /* Return the memory space pointed to - jumping over the
-                     * BlockLink_t structure at its start. */
-                    pvReturn = ( void * ) ( ( ( uint8_t * ) heapPROTECT_BLOCK_POINTER( pxPreviousBlock->pxNextFreeBlock ) ) + xHeapStructSize );
-                    heapVALIDATE_BLOCK_POINTER( pvReturn );
-
-                    /* This block is being returned for use so must be taken out
-                     * of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                     * two. */
-                    configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
-
-                    if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
-                    {
-                        /* This block is to be split into two.  Create a new
-                         * block following the number of bytes requested. The void
-                         * cast is used to prevent byte alignment warnings from the
-                         * compiler. */
-                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
-                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
-
-                        /* Calculate the sizes of two blocks split from the
-                         * single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
-                        pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
-                    }
-                    else
+                    /* Cached blocks are held out of the list of free blocks, so
+                     * cannot be merged with their neighbours.  Return this core's
+                     * cached blocks to the list and try again before failing. */
+                    if( ( pxBlock == NULL ) && ( prvFlushCoreCache() != pdFALSE ) )
                     {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
-
-                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
-                    {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                        pxBlock = prvAllocateBlock( xWantedSize );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+                }
+                #endif /* configHEAP_USE_CORE_CACHES */
 
-                    xAllocatedBlockSize = pxBlock->xBlockSize;
-
-                    /* The block is being returned - it is allocated and owned
-                     * by the application and has no "next" block. */
-                    heapALLOCATE_BLOCK( pxBlock );
-                    pxBlock->pxNextFreeBlock = NULL;
+                if( pxBlock != NULL )
+                {
+                    /* Return the memory space pointed to - jumping over the
+                     * BlockLink_t structure at its start. */
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
                     xNumberOfSuccessfulAllocations++;
                 }
                 else
@@ -320,18 +423,18 @@ void * pvPortMalloc( size_t xWantedSize )
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
 
-        traceMALLOC( pvReturn, xAllocatedBlockSize );
+            traceMALLOC( pvReturn, xAllocatedBlockSize );
 
-        /* Prevent compiler warnings when trace macros are not used. */
-        ( void ) xAllocatedBlockSize;
+            /* Prevent compiler warnings when trace macros are not used. */
+            ( void ) xAllocatedBlockSize;
+        }
+        ( void ) xTaskResumeAll();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
     }
-    ( void ) xTaskResumeAll();
 
     #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
     {
@@ -355,6 +458,7 @@ void vPortFree( void * pv )
 {
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
+    BaseType_t xCached = pdFALSE;
 
     if( pv != NULL )
     {
@@ -387,15 +491,39 @@ void vPortFree( void * pv )
                 }
                 #endif
 
-                vTaskSuspendAll();
+                #if ( configHEAP_USE_CORE_CACHES == 1 )
                 {
-                    /* Add this block to the list of free blocks. */
-                    xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE( pv, pxLink->xBlockSize );
-                    prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
-                    xNumberOfSuccessfulFrees++;
+                    if( ( pxLink->xBlockSize >= heapCACHE_GRANULE ) && ( pxLink->xBlockSize <= heapCACHE_MAX_BLOCK_SIZE ) )
+                    {
+                        /* Small blocks go back to the calling core's cache
+                         * rather than to the list of free blocks. */
+                        traceFREE( pv, pxLink->xBlockSize );
+                        prvCacheFree( pxLink );
+                        xCached = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configHEAP_USE_CORE_CACHES */
+
+                if( xCached == pdFALSE )
+                {
+                    vTaskSuspendAll();
+                    {
+                        /* Add this block to the list of free blocks. */
+                        xFreeBytesRemaining += pxLink->xBlockSize;
+                        traceFREE( pv, pxLink->xBlockSize );
+                        prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+                        xNumberOfSuccessfulFrees++;
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                ( void ) xTaskResumeAll();
             }
             else
             {
@@ -495,6 +623,329 @@ static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
 }
 /*-----------------------------------------------------------*/
 
+static BlockLink_t * prvAllocateBlock( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxNewBlockLink;
+    BlockLink_t * pxReturn = NULL;
+
+    if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+    {
+        /* Traverse the list from the start (lowest address) block until
+         * one of adequate size is found. */
+        pxPreviousBlock = &xStart;
+        pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+        heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+        while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
+        {
+            pxPreviousBlock = pxBlock;
+            pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+            heapVALIDATE_BLOCK_POINTER( pxBlock );
+        }
+
+        /* If the end marker was reached then a block of adequate size
+         * was not found. */
+        if( pxBlock != pxEnd )
+        {
+            /* This block is being returned for use so must be taken out
+             * of the list of free blocks. */
+            pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+            /* If the block is larger than required it can be split into
+             * two. */
+            configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
+
+            if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+            {
+                /* This block is to be split into two.  Create a new
+                 * block following the number of bytes requested. The void
+                 * cast is used to prevent byte alignment warnings from the
+                 * compiler. */
+                pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                /* Calculate the sizes of two blocks split from the
+                 * single block. */
+                pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                pxBlock->xBlockSize = xWantedSize;
+
+                /* Insert the new block into the list of free blocks. */
+                pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+                pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+            if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+            {
+                xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The block is being returned - it is allocated and owned
+             * by the application and has no "next" block. */
+            heapALLOCATE_BLOCK( pxBlock );
+            pxBlock->pxNextFreeBlock = NULL;
+            pxReturn = pxBlock;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configHEAP_USE_CORE_CACHES == 1 )
+
+    static UBaseType_t prvEnterCoreCache( void ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            /* With a single core a critical section only masks interrupts. */
+            taskENTER_CRITICAL();
+            uxSavedInterruptStatus = 0;
+        }
+        #else
+        {
+            /* A critical section would take the locks shared by all the
+             * cores, so only mask this core's interrupts. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+        }
+        #endif
+
+        return uxSavedInterruptStatus;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvExitCoreCache( UBaseType_t uxSavedInterruptStatus ) /* PRIVILEGED_FUNCTION */
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            ( void ) uxSavedInterruptStatus;
+            taskEXIT_CRITICAL();
+        }
+        #else
+        {
+            portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static BlockLink_t * prvCacheMalloc( UBaseType_t uxClass ) /* PRIVILEGED_FUNCTION */
+    {
+        CoreCache_t * pxCache;
+        BlockLink_t * pxBlock;
+        BlockLink_t * pxCachedBlock;
+        UBaseType_t uxSavedInterruptStatus;
+        UBaseType_t uxBlock;
+
+        uxSavedInterruptStatus = prvEnterCoreCache();
+        {
+            pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+            pxBlock = pxCache->pxBlocks[ uxClass ];
+
+            if( pxBlock != NULL )
+            {
+                pxCache->pxBlocks[ uxClass ] = pxBlock->pxNextFreeBlock;
+                pxCache->uxBlocks[ uxClass ]--;
+                pxCache->xNumberOfAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        prvExitCoreCache( uxSavedInterruptStatus );
+
+        if( pxBlock != NULL )
+        {
+            /* The block is being returned - it is allocated and owned by the
+             * application and has no "next" block. */
+            heapALLOCATE_BLOCK( pxBlock );
+            pxBlock->pxNextFreeBlock = NULL;
+        }
+        else
+        {
+            /* The cache is empty, so take a batch of blocks from the heap, one
+             * for the caller and the rest for the cache.  While the scheduler
+             * is suspended this task cannot move to another core and no other
+             * task can run on this one, so the cache can be refilled without
+             * masking interrupts. */
+            vTaskSuspendAll();
+            {
+                if( pxEnd == NULL )
+                {
+                    prvHeapInit();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+                pxBlock = prvAllocateBlock( heapCACHE_CLASS_SIZE( uxClass ) );
+
+                if( pxBlock != NULL )
+                {
+                    pxCache->xNumberOfAllocations++;
+
+                    for( uxBlock = ( UBaseType_t ) 1; uxBlock < ( UBaseType_t ) configHEAP_CORE_CACHE_BATCH; uxBlock++ )
+                    {
+                        pxCachedBlock = prvAllocateBlock( heapCACHE_CLASS_SIZE( uxClass ) );
+
+                        if( pxCachedBlock == NULL )
+                        {
+                            break;
+                        }
+
+                        heapFREE_BLOCK( pxCachedBlock );
+                        pxCachedBlock->pxNextFreeBlock = pxCache->pxBlocks[ uxClass ];
+                        pxCache->pxBlocks[ uxClass ] = pxCachedBlock;
+                        pxCache->uxBlocks[ uxClass ]++;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+        return pxBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCacheFree( BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        CoreCache_t * pxCache;
+        BlockLink_t * pxBatch = NULL;
+        BlockLink_t * pxLastInBatch;
+        UBaseType_t uxClass = heapCACHE_CLASS_TO_FREE( pxBlock->xBlockSize );
+        UBaseType_t uxSavedInterruptStatus;
+        UBaseType_t uxBlock;
+
+        uxSavedInterruptStatus = prvEnterCoreCache();
+        {
+            pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+            pxBlock->pxNextFreeBlock = pxCache->pxBlocks[ uxClass ];
+            pxCache->pxBlocks[ uxClass ] = pxBlock;
+            pxCache->uxBlocks[ uxClass ]++;
+            pxCache->xNumberOfFrees++;
+
+            if( pxCache->uxBlocks[ uxClass ] > ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH )
+            {
+                /* Detach a batch of blocks from the front of the list, to be
+                 * returned to the heap once interrupts are unmasked. */
+                pxBatch = pxBlock;
+                pxLastInBatch = pxBatch;
+
+                for( uxBlock = ( UBaseType_t ) 1; uxBlock < ( UBaseType_t ) configHEAP_CORE_CACHE_BATCH; uxBlock++ )
+                {
+                    pxLastInBatch = pxLastInBatch->pxNextFreeBlock;
+                }
+
+                pxCache->pxBlocks[ uxClass ] = pxLastInBatch->pxNextFreeBlock;
+                pxCache->uxBlocks[ uxClass ] -= ( UBaseType_t ) configHEAP_CORE_CACHE_BATCH;
+                pxLastInBatch->pxNextFreeBlock = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        prvExitCoreCache( uxSavedInterruptStatus );
+
+        if( pxBatch != NULL )
+        {
+            vTaskSuspendAll();
+            {
+                prvReturnBlocksToHeap( pxBatch );
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReturnBlocksToHeap( BlockLink_t * pxBlocks ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxNextBlock;
+
+        while( pxBlocks != NULL )
+        {
+            pxNextBlock = pxBlocks->pxNextFreeBlock;
+            xFreeBytesRemaining += pxBlocks->xBlockSize;
+            prvInsertBlockIntoFreeList( pxBlocks );
+            pxBlocks = pxNextBlock;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvFlushCoreCache( void ) /* PRIVILEGED_FUNCTION */
+    {
+        CoreCache_t * pxCache;
+        UBaseType_t uxClass;
+        BaseType_t xReturn = pdFALSE;
+
+        /* While the scheduler is suspended this task cannot move to another
+         * core and no other task can run on this one, so the cache can be
+         * emptied without masking interrupts. */
+        pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+
+        for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_CORE_CACHE_CLASSES; uxClass++ )
+        {
+            if( pxCache->pxBlocks[ uxClass ] != NULL )
+            {
+                prvReturnBlocksToHeap( pxCache->pxBlocks[ uxClass ] );
+                pxCache->pxBlocks[ uxClass ] = NULL;
+                pxCache->uxBlocks[ uxClass ] = 0;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortHeapFlushCoreCache( void )
+    {
+        vTaskSuspendAll();
+        {
+            ( void ) prvFlushCoreCache();
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_USE_CORE_CACHES */
+
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t * pxIterator;
@@ -610,6 +1061,20 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
         pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
         pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
         pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+
+        #if ( configHEAP_USE_CORE_CACHES == 1 )
+        {
+            BaseType_t xCore;
+
+            /* The other cores can update their cache counts while they are
+             * summed, so the totals may be a few calls out of date. */
+            for( xCore = 0; xCore < ( BaseType_t ) configNUMBER_OF_CORES; xCore++ )
+            {
+                pxHeapStats->xNumberOfSuccessfulAllocations += xCoreCaches[ xCore ].xNumberOfAllocations;
+                pxHeapStats->xNumberOfSuccessfulFrees += xCoreCaches[ xCore ].xNumberOfFrees;
+            }
+        }
+        #endif
     }
     taskEXIT_CRITICAL();
 }
@@ -628,5 +1093,11 @@ void vPortHeapResetState( void )
     xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
     xNumberOfSuccessfulAllocations = ( size_t ) 0U;
     xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+    #if ( configHEAP_USE_CORE_CACHES == 1 )
+    {
+        ( void ) memset( xCoreCaches, 0x00, sizeof( xCoreCaches ) );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
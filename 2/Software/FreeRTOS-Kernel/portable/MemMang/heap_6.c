@@ -0,0 +1,1333 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses the Two
+ * Level Segregated Fit (TLSF) algorithm, so both functions execute in constant
+ * time no matter how many blocks are free, and combines (coalescences)
+ * adjacent memory blocks as they are freed.
+ *
+ * heap_4.c and heap_5.c keep a single address ordered list of free blocks, so
+ * pvPortMalloc() and vPortFree() both walk a number of blocks that grows with
+ * fragmentation.  heap_6.c instead keeps one free list per size class.  The
+ * size classes are split first into powers of two, then each power of two is
+ * split into 2 ^ configHEAP_TLSF_SL_INDEX_COUNT_LOG2 linear steps.  A bitmap
+ * records which lists are not empty, so finding a free block that is large
+ * enough takes a couple of bit scans.  Each block records the block
+ * immediately before it in memory, so a block being freed is merged with its
+ * neighbours without searching.
+ *
+ * pvPortMalloc() rounds the requested size up to the next size class before
+ * searching, so any block it finds is large enough - it never walks a list.
+ * The cost is that a request may fail, or take a block from a larger class,
+ * while a block of adequate size but in the same size class remains free.  The
+ * worst case waste from this is 1 / ( 2 ^ configHEAP_TLSF_SL_INDEX_COUNT_LOG2 )
+ * of the request size.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Usage notes:
+ *
+ * If configTOTAL_HEAP_SIZE is defined then the heap starts with a single region
+ * that is a configTOTAL_HEAP_SIZE byte array, as with heap_4.c.  Set
+ * configAPPLICATION_ALLOCATED_HEAP to 1 to have the application define the
+ * array.  Leave configTOTAL_HEAP_SIZE undefined if all the heap memory is to be
+ * provided by vPortDefineHeapRegions().
+ *
+ * vPortDefineHeapRegions() adds further regions to the heap, using the same
+ * NULL terminated array of HeapRegion_t structures as heap_5.c.  Unlike
+ * heap_5.c the regions can be in any order, and vPortDefineHeapRegions() can
+ * be called more than once, and after pvPortMalloc() has been called.  Each
+ * region must be smaller than 2 ^ configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2 bytes.
+ *
+ * Set configHEAP_USE_BULK_REGIONS to 1 to keep a second, separate, heap for
+ * large memory that is slower to access, such as external PSRAM.  Regions are
+ * added to it with vPortDefineBulkHeapRegions().  pvPortMallocBulk() only
+ * allocates from the bulk heap, and returns NULL if the bulk heap cannot
+ * satisfy the request, so large buffers never compete with task stacks for
+ * fast memory.  Set configHEAP_BULK_FALLBACK_TO_FAST to 1 to have
+ * pvPortMallocBulk() try the normal heap instead of failing.  pvPortMalloc()
+ * and pvPortMallocFast() only allocate from the normal heap, so the kernel's
+ * task stacks and control blocks always stay in fast memory.  vPortFree() frees memory from either heap.
+ * xPortGetFreeHeapSize(), xPortGetMinimumEverFreeHeapSize() and
+ * vPortGetHeapStats() report the normal heap; xPortGetFreeBulkHeapSize() and
+ * vPortGetBulkHeapStats() report the bulk heap.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Each power of two size range is split into 2 ^ configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+ * size classes.  Larger values waste less memory when a request is rounded up
+ * to a size class, at the cost of more free list heads. */
+#ifndef configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+    #define configHEAP_TLSF_SL_INDEX_COUNT_LOG2    4
+#endif
+
+/* Blocks, and so heap regions, must be smaller than
+ * 2 ^ configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2 bytes.  The default allows regions of
+ * up to 16 MiB. */
+#ifndef configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2
+    #define configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2    24
+#endif
+
+#if ( ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 < 1 ) || ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 > 5 ) )
+    #error configHEAP_TLSF_SL_INDEX_COUNT_LOG2 must be between 1 and 5.
+#endif
+
+#if ( configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2 > 31 )
+    #error configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2 must not be greater than 31.
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )     ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )          ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* Check if the subtraction operation ( a - b ) will result in underflow. */
+#define heapSUBTRACT_WILL_UNDERFLOW( a, b )    ( ( a ) < ( b ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_SIZE( pxBlock )                ( ( pxBlock->xBlockSize ) & ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* log2( portBYTE_ALIGNMENT ).  Block sizes are always a multiple of
+ * portBYTE_ALIGNMENT, so the low bits carry no size class information. */
+#if ( portBYTE_ALIGNMENT == 32 )
+    #define heapALIGNMENT_LOG2    5U
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define heapALIGNMENT_LOG2    4U
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapALIGNMENT_LOG2    3U
+#elif ( portBYTE_ALIGNMENT == 4 )
+    #define heapALIGNMENT_LOG2    2U
+#elif ( portBYTE_ALIGNMENT == 2 )
+    #define heapALIGNMENT_LOG2    1U
+#else
+    #define heapALIGNMENT_LOG2    0U
+#endif
+
+/* The number of second level lists for each first level list. */
+#define heapSL_INDEX_COUNT_LOG2    ( ( UBaseType_t ) configHEAP_TLSF_SL_INDEX_COUNT_LOG2 )
+#define heapSL_INDEX_COUNT         ( ( UBaseType_t ) 1U << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE are all held in the first first
+ * level list, split linearly into portBYTE_ALIGNMENT sized steps.  Larger
+ * blocks are held in the first level list for their most significant bit. */
+#define heapFL_INDEX_SHIFT         ( heapSL_INDEX_COUNT_LOG2 + ( UBaseType_t ) heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE       ( ( size_t ) 1U << heapFL_INDEX_SHIFT )
+#define heapFL_INDEX_COUNT         ( ( UBaseType_t ) configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2 - heapFL_INDEX_SHIFT + ( UBaseType_t ) 1U )
+#define heapMAX_BLOCK_SIZE         ( ( size_t ) 1U << configHEAP_TLSF_MAX_BLOCK_SIZE_LOG2 )
+
+/* Setting configENABLE_HEAP_PROTECTOR to 1 enables heap block pointers
+ * protection using an application supplied canary value to catch heap
+ * corruption should a heap buffer overflow occur.
+ */
+#if ( configENABLE_HEAP_PROTECTOR == 1 )
+
+/* Macro to load/store BlockLink_t pointers to memory. By XORing the
+ * pointers with a random canary value, heap overflows will result
+ * in randomly unpredictable pointer values which will be caught by
+ * heapVALIDATE_BLOCK_POINTER assert. */
+    #define heapPROTECT_BLOCK_POINTER( pxBlock )    ( ( BlockLink_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxBlock ) ) ^ xHeapCanary ) )
+
+/* Assert that a heap block pointer is within the heap bounds. */
+    #define heapVALIDATE_BLOCK_POINTER( pxBlock )                       \
+    configASSERT( ( pucHeapHighAddress != NULL ) &&                     \
+                  ( pucHeapLowAddress != NULL ) &&                      \
+                  ( ( uint8_t * ) ( pxBlock ) >= pucHeapLowAddress ) && \
+                  ( ( uint8_t * ) ( pxBlock ) < pucHeapHighAddress ) )
+
+#else /* if ( configENABLE_HEAP_PROTECTOR == 1 ) */
+
+    #define heapPROTECT_BLOCK_POINTER( pxBlock )    ( pxBlock )
+
+    #define heapVALIDATE_BLOCK_POINTER( pxBlock )
+
+#endif /* configENABLE_HEAP_PROTECTOR */
+
+/* traceMALLOC() is called from prvHeapMalloc().  When heap tracing is enabled
+ * prvHeapMalloc() is forced inline so the return address the trace records is
+ * the application's call site rather than pvPortMalloc() itself. */
+#if ( ( configUSE_HEAP_TRACE == 1 ) && defined( __GNUC__ ) )
+    #define heapINLINE    inline __attribute__( ( always_inline ) )
+#else
+    #define heapINLINE
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the default heap region. */
+#ifdef configTOTAL_HEAP_SIZE
+    #if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+        extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+    #else
+        PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+    #endif /* configAPPLICATION_ALLOCATED_HEAP */
+#endif /* configTOTAL_HEAP_SIZE */
+
+/* The header placed at the start of every block.  Only the first two members
+ * are kept while a block is allocated - the free list links occupy the start
+ * of the memory returned to the application, so are only valid while the
+ * block is free. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPrevPhysBlock; /**< The block immediately below this one in memory, or NULL if this is the first block in its region. */
+    size_t xBlockSize;                     /**< The size of the block, including the header.  The MSB is set while the block is allocated. */
+    struct A_BLOCK_LINK * pxNextFreeBlock; /**< The next block in the same free list. */
+    struct A_BLOCK_LINK * pxPrevFreeBlock; /**< The previous block in the same free list. */
+} BlockLink_t;
+
+/* The state of one heap - the normal heap, or the bulk heap. */
+typedef struct xHEAP_CONTROL
+{
+    /* The heads of the free lists, and bitmaps that record which lists are not
+     * empty.  Bit n of ulFLBitmap is set if any bit of ulSLBitmap[ n ] is set,
+     * and bit m of ulSLBitmap[ n ] is set if pxFreeLists[ n ][ m ] is not
+     * empty. */
+    BlockLink_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+    uint32_t ulFLBitmap;
+    uint32_t ulSLBitmap[ heapFL_INDEX_COUNT ];
+
+    /* The lowest and highest addresses of the regions in this heap. */
+    uint8_t * pucLowAddress;
+    uint8_t * pucHighAddress;
+
+    /* Keeps track of the number of calls to allocate and free memory as well
+     * as the number of free bytes remaining, but says nothing about
+     * fragmentation. */
+    size_t xFreeBytesRemaining;
+    size_t xMinimumEverFreeBytesRemaining;
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+    size_t xNumberOfFreeBlocks;
+} HeapControl_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to set up the default heap region the first time
+ * pvPortMalloc() or vPortDefineHeapRegions() is called.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds the memory between pucStartAddress and pucStartAddress + xSizeInBytes
+ * to pxHeap as a single free block.
+ */
+static void prvAddRegion( HeapControl_t * pxHeap,
+                          uint8_t * pucStartAddress,
+                          size_t xSizeInBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocates xWantedSize bytes from pxHeap, or if that fails and pxFallbackHeap
+ * is not NULL, from pxFallbackHeap.
+ */
+static heapINLINE void * prvHeapMalloc( HeapControl_t * pxHeap,
+                                        HeapControl_t * pxFallbackHeap,
+                                        size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocates a block of exactly xBlockSize bytes, including the header, from
+ * pxHeap.  Must be called with the scheduler suspended.
+ */
+static void * prvAllocateBlock( HeapControl_t * pxHeap,
+                                size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the heap that pxBlock belongs to.
+ */
+static HeapControl_t * prvHeapOfBlock( const BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills pxHeapStats with information about pxHeap.
+ */
+static void prvGetHeapStats( HeapControl_t * pxHeap,
+                             HeapStats_t * pxHeapStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the index of the least and most significant set bits in ulBits.
+ * ulBits must not be zero.
+ */
+static UBaseType_t prvFindFirstSet( uint32_t ulBits );
+static UBaseType_t prvFindLastSet( uint32_t ulBits );
+
+/*
+ * Calculate the first and second level list indexes of the free list that
+ * holds blocks of xBlockSize bytes.
+ */
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find a free block of at least xWantedSize bytes, without searching any free
+ * list, and return it with the indexes of the free list that holds it.
+ * Returns NULL if there is no such block.
+ */
+static BlockLink_t * prvFindSuitableBlock( const HeapControl_t * pxHeap,
+                                           size_t xWantedSize,
+                                           UBaseType_t * puxFLIndex,
+                                           UBaseType_t * puxSLIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert a free block into, or remove a free block from, the free list for its
+ * size.
+ */
+static void prvInsertBlockIntoFreeList( HeapControl_t * pxHeap,
+                                        BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
+static void prvRemoveBlockFromFreeList( HeapControl_t * pxHeap,
+                                        BlockLink_t * pxBlockToRemove,
+                                        UBaseType_t uxFLIndex,
+                                        UBaseType_t uxSLIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Merge a block that is being freed with the blocks either side of it in
+ * memory, if they are free too, then insert the result into the free lists.
+ */
+static void prvMergeAndInsertBlock( HeapControl_t * pxHeap,
+                                    BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
+
+#if ( configENABLE_HEAP_PROTECTOR == 1 )
+
+/**
+ * @brief Application provided function to get a random value to be used as canary.
+ *
+ * @param pxHeapCanary [out] Output parameter to return the canary value.
+ */
+    extern void vApplicationGetRandomHeapCanary( portPOINTER_SIZE_TYPE * pxHeapCanary );
+#endif /* configENABLE_HEAP_PROTECTOR */
+
+/*-----------------------------------------------------------*/
+
+/* The size of the header kept at the beginning of each allocated memory block
+ * must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Block sizes must not get too small - a free block must hold the whole
+ * BlockLink_t structure. */
+static const size_t xMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The normal heap, which holds the default region and the regions passed to
+ * vPortDefineHeapRegions(). */
+PRIVILEGED_DATA static HeapControl_t xHeap;
+
+#if ( configHEAP_USE_BULK_REGIONS == 1 )
+
+/* The bulk heap, which holds the regions passed to
+ * vPortDefineBulkHeapRegions(). */
+    PRIVILEGED_DATA static HeapControl_t xBulkHeap;
+#endif
+
+/* Set once prvHeapInit() has run. */
+PRIVILEGED_DATA static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+#if ( configENABLE_HEAP_PROTECTOR == 1 )
+
+/* Canary value for protecting internal heap pointers. */
+    PRIVILEGED_DATA static portPOINTER_SIZE_TYPE xHeapCanary;
+
+/* Highest and lowest heap addresses used for heap block bounds checking. */
+    PRIVILEGED_DATA static uint8_t * pucHeapHighAddress = NULL;
+    PRIVILEGED_DATA static uint8_t * pucHeapLowAddress = NULL;
+
+#endif /* configENABLE_HEAP_PROTECTOR */
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    return prvHeapMalloc( &xHeap, NULL, xWantedSize );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configHEAP_USE_BULK_REGIONS == 1 )
+
+    void * pvPortMallocFast( size_t xWantedSize )
+    {
+        return prvHeapMalloc( &xHeap, NULL, xWantedSize );
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPortMallocBulk( size_t xWantedSize )
+    {
+        #if ( configHEAP_BULK_FALLBACK_TO_FAST == 1 )
+        {
+            return prvHeapMalloc( &xBulkHeap, &xHeap, xWantedSize );
+        }
+        #else
+        {
+            return prvHeapMalloc( &xBulkHeap, NULL, xWantedSize );
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_USE_BULK_REGIONS */
+
+static heapINLINE void * prvHeapMalloc( HeapControl_t * pxHeap,
+                                        HeapControl_t * pxFallbackHeap,
+                                        size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    size_t xAllocatedBlockSize = 0;
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain the block header
+         * in addition to the requested amount of bytes. */
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned to the required number
+             * of bytes. */
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                /* Byte alignment required. */
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The block must be able to hold the free list links once it is
+             * freed. */
+            if( ( xWantedSize > 0 ) && ( xWantedSize < xMinimumBlockSize ) )
+            {
+                xWantedSize = xMinimumBlockSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the list of free blocks. */
+        if( xHeapHasBeenInitialised == pdFALSE )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* No block can be larger than heapMAX_BLOCK_SIZE, which also ensures
+         * the top bit of the size, which records who owns the block, is
+         * clear. */
+        if( ( xWantedSize > 0 ) && ( xWantedSize < heapMAX_BLOCK_SIZE ) )
+        {
+            pvReturn = prvAllocateBlock( pxHeap, xWantedSize );
+
+            if( ( pvReturn == NULL ) && ( pxFallbackHeap != NULL ) )
+            {
+                pvReturn = prvAllocateBlock( pxFallbackHeap, xWantedSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pvReturn != NULL )
+            {
+                xAllocatedBlockSize = heapBLOCK_SIZE( ( ( BlockLink_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+        /* Prevent compiler warnings when trace macros are not used. */
+        ( void ) xAllocatedBlockSize;
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvAllocateBlock( HeapControl_t * pxHeap,
+                                size_t xBlockSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    BlockLink_t * pxNextBlock;
+    UBaseType_t uxFLIndex, uxSLIndex;
+    void * pvReturn = NULL;
+
+    if( xBlockSize <= pxHeap->xFreeBytesRemaining )
+    {
+        pxBlock = prvFindSuitableBlock( pxHeap, xBlockSize, &uxFLIndex, &uxSLIndex );
+
+        if( pxBlock != NULL )
+        {
+            heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+            /* This block is being returned for use so must be taken out of the
+             * free lists. */
+            prvRemoveBlockFromFreeList( pxHeap, pxBlock, uxFLIndex, uxSLIndex );
+
+            /* If the block is larger than required it can be split into
+             * two. */
+            configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xBlockSize ) == 0 );
+
+            if( ( pxBlock->xBlockSize - xBlockSize ) >= xMinimumBlockSize )
+            {
+                /* This block is to be split into two.  Create a new block
+                 * following the number of bytes requested. The void cast is
+                 * used to prevent byte alignment warnings from the compiler. */
+                pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+                configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                /* Calculate the sizes of two blocks split from the single
+                 * block. */
+                pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xBlockSize;
+                pxBlock->xBlockSize = xBlockSize;
+
+                /* Link the new block into the chain of blocks in memory
+                 * order. */
+                pxNewBlockLink->pxPrevPhysBlock = heapPROTECT_BLOCK_POINTER( pxBlock );
+                pxNextBlock = ( void * ) ( ( ( uint8_t * ) pxNewBlockLink ) + pxNewBlockLink->xBlockSize );
+                pxNextBlock->pxPrevPhysBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
+
+                /* Insert the new block into the free lists. */
+                prvInsertBlockIntoFreeList( pxHeap, pxNewBlockLink );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxHeap->xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+            if( pxHeap->xFreeBytesRemaining < pxHeap->xMinimumEverFreeBytesRemaining )
+            {
+                pxHeap->xMinimumEverFreeBytesRemaining = pxHeap->xFreeBytesRemaining;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The block is being returned - it is allocated and owned by the
+             * application.  Return the memory space pointed to - jumping over
+             * the block header at its start. */
+            heapALLOCATE_BLOCK( pxBlock );
+            pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+            pxHeap->xNumberOfSuccessfulAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    HeapControl_t * pxHeap;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a block header immediately before
+         * it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        heapVALIDATE_BLOCK_POINTER( pxLink );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            heapFREE_BLOCK( pxLink );
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                /* Check for underflow as this can occur if xBlockSize is
+                 * overwritten in a heap block. */
+                if( heapSUBTRACT_WILL_UNDERFLOW( pxLink->xBlockSize, xHeapStructSize ) == 0 )
+                {
+                    ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+                }
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                /* Add this block to the free lists of the heap it came
+                 * from. */
+                pxHeap = prvHeapOfBlock( pxLink );
+                pxHeap->xFreeBytesRemaining += pxLink->xBlockSize;
+                traceFREE( pv, pxLink->xBlockSize );
+                prvMergeAndInsertBlock( pxHeap, pxLink );
+                pxHeap->xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xHeap.xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xHeap.xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configHEAP_USE_BULK_REGIONS == 1 )
+
+    size_t xPortGetFreeBulkHeapSize( void )
+    {
+        return xBulkHeap.xFreeBytesRemaining;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_USE_BULK_REGIONS */
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    #if ( configENABLE_HEAP_PROTECTOR == 1 )
+    {
+        vApplicationGetRandomHeapCanary( &( xHeapCanary ) );
+    }
+    #endif
+
+    xHeapHasBeenInitialised = pdTRUE;
+
+    #ifdef configTOTAL_HEAP_SIZE
+    {
+        prvAddRegion( &xHeap, ucHeap, ( size_t ) configTOTAL_HEAP_SIZE );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddRegion( HeapControl_t * pxHeap,
+                          uint8_t * pucStartAddress,
+                          size_t xSizeInBytes ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlock;
+    BlockLink_t * pxEnd;
+    portPOINTER_SIZE_TYPE uxStartAddress, uxEndAddress;
+    size_t xTotalRegionSize = xSizeInBytes;
+
+    /* Ensure the region starts on a correctly aligned boundary. */
+    uxStartAddress = ( portPOINTER_SIZE_TYPE ) pucStartAddress;
+
+    if( ( uxStartAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxStartAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxStartAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+        /* Adjust the size for the bytes lost to alignment. */
+        xTotalRegionSize -= ( size_t ) ( uxStartAddress - ( portPOINTER_SIZE_TYPE ) pucStartAddress );
+    }
+
+    /* pxEnd marks the end of the region.  It is a zero sized block that is
+     * always marked as allocated, so the last real block in the region is
+     * never merged with whatever follows the region in memory. */
+    uxEndAddress = uxStartAddress + ( portPOINTER_SIZE_TYPE ) xTotalRegionSize;
+    uxEndAddress -= ( portPOINTER_SIZE_TYPE ) xHeapStructSize;
+    uxEndAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+    /* The region must hold at least one block, and cannot be larger than the
+     * largest block. */
+    configASSERT( uxEndAddress > uxStartAddress );
+    configASSERT( ( size_t ) ( uxEndAddress - uxStartAddress ) >= xMinimumBlockSize );
+    configASSERT( ( size_t ) ( uxEndAddress - uxStartAddress ) < heapMAX_BLOCK_SIZE );
+
+    /* To start with there is a single free block in the region that is sized
+     * to take up the entire region, minus the space taken by pxEnd.  It is the
+     * first block in the region, so has no block before it. */
+    pxFirstFreeBlock = ( BlockLink_t * ) uxStartAddress;
+    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxEndAddress - uxStartAddress );
+    pxFirstFreeBlock->pxPrevPhysBlock = heapPROTECT_BLOCK_POINTER( NULL );
+
+    pxEnd = ( BlockLink_t * ) uxEndAddress;
+    pxEnd->xBlockSize = 0;
+    heapALLOCATE_BLOCK( pxEnd );
+    pxEnd->pxPrevPhysBlock = heapPROTECT_BLOCK_POINTER( pxFirstFreeBlock );
+
+    #if ( configENABLE_HEAP_PROTECTOR == 1 )
+    {
+        if( ( pucHeapLowAddress == NULL ) ||
+            ( ( uint8_t * ) pxFirstFreeBlock < pucHeapLowAddress ) )
+        {
+            pucHeapLowAddress = ( uint8_t * ) pxFirstFreeBlock;
+        }
+
+        if( ( pucHeapHighAddress == NULL ) ||
+            ( ( ( uint8_t * ) pxEnd ) + xHeapStructSize > pucHeapHighAddress ) )
+        {
+            pucHeapHighAddress = ( ( uint8_t * ) pxEnd ) + xHeapStructSize;
+        }
+    }
+    #endif /* configENABLE_HEAP_PROTECTOR */
+
+    if( ( pxHeap->pucLowAddress == NULL ) ||
+        ( ( uint8_t * ) pxFirstFreeBlock < pxHeap->pucLowAddress ) )
+    {
+        pxHeap->pucLowAddress = ( uint8_t * ) pxFirstFreeBlock;
+    }
+
+    if( ( pxHeap->pucHighAddress == NULL ) ||
+        ( ( ( uint8_t * ) pxEnd ) + xHeapStructSize > pxHeap->pucHighAddress ) )
+    {
+        pxHeap->pucHighAddress = ( ( uint8_t * ) pxEnd ) + xHeapStructSize;
+    }
+
+    #if ( configHEAP_USE_BULK_REGIONS == 1 )
+    {
+        /* vPortFree() tells which heap a block belongs to from the range of
+         * addresses the bulk heap spans, so no normal heap region may lie
+         * within that range. */
+        configASSERT( ( xHeap.pucHighAddress == NULL ) ||
+                      ( xBulkHeap.pucHighAddress == NULL ) ||
+                      ( xHeap.pucHighAddress <= xBulkHeap.pucLowAddress ) ||
+                      ( xHeap.pucLowAddress >= xBulkHeap.pucHighAddress ) );
+    }
+    #endif
+
+    prvInsertBlockIntoFreeList( pxHeap, pxFirstFreeBlock );
+
+    pxHeap->xFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+    pxHeap->xMinimumEverFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static HeapControl_t * prvHeapOfBlock( const BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    HeapControl_t * pxHeap = &xHeap;
+
+    #if ( configHEAP_USE_BULK_REGIONS == 1 )
+    {
+        if( ( xBulkHeap.pucLowAddress != NULL ) &&
+            ( ( const uint8_t * ) pxBlock >= xBulkHeap.pucLowAddress ) &&
+            ( ( const uint8_t * ) pxBlock < xBulkHeap.pucHighAddress ) )
+        {
+            pxHeap = &xBulkHeap;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else
+    {
+        ( void ) pxBlock;
+    }
+    #endif /* configHEAP_USE_BULK_REGIONS */
+
+    return pxHeap;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindFirstSet( uint32_t ulBits )
+{
+    /* Isolate the least significant set bit, then find its index. */
+    return prvFindLastSet( ulBits & ( ~ulBits + 1U ) );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulBits )
+{
+    UBaseType_t uxIndex;
+
+    configASSERT( ulBits != 0U );
+
+    #if defined( __GNUC__ ) && ( __SIZEOF_INT__ == 4 )
+    {
+        uxIndex = ( UBaseType_t ) 31U - ( UBaseType_t ) __builtin_clz( ( unsigned int ) ulBits );
+    }
+    #else
+    {
+        /* A binary search, so the time taken does not depend on the value. */
+        uxIndex = 0U;
+
+        if( ( ulBits & 0xffff0000UL ) != 0U )
+        {
+            ulBits >>= 16;
+            uxIndex += 16U;
+        }
+
+        if( ( ulBits & 0xff00UL ) != 0U )
+        {
+            ulBits >>= 8;
+            uxIndex += 8U;
+        }
+
+        if( ( ulBits & 0xf0UL ) != 0U )
+        {
+            ulBits >>= 4;
+            uxIndex += 4U;
+        }
+
+        if( ( ulBits & 0xcUL ) != 0U )
+        {
+            ulBits >>= 2;
+            uxIndex += 2U;
+        }
+
+        if( ( ulBits & 0x2UL ) != 0U )
+        {
+            uxIndex += 1U;
+        }
+    }
+    #endif /* if defined( __GNUC__ ) && ( __SIZEOF_INT__ == 4 ) */
+
+    return uxIndex;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxMostSignificantBit;
+
+    if( xBlockSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* Small blocks are all in the first list, split linearly. */
+        *puxFLIndex = 0U;
+        *puxSLIndex = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+    }
+    else
+    {
+        /* The first level index is the most significant bit, the second level
+         * index is the bits immediately below it. */
+        uxMostSignificantBit = prvFindLastSet( ( uint32_t ) xBlockSize );
+        *puxSLIndex = ( UBaseType_t ) ( xBlockSize >> ( uxMostSignificantBit - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT;
+        *puxFLIndex = uxMostSignificantBit - ( heapFL_INDEX_SHIFT - ( UBaseType_t ) 1U );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindSuitableBlock( const HeapControl_t * pxHeap,
+                                           size_t xWantedSize,
+                                           UBaseType_t * puxFLIndex,
+                                           UBaseType_t * puxSLIndex ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock = NULL;
+    UBaseType_t uxFLIndex, uxSLIndex;
+    uint32_t ulFLMap, ulSLMap;
+    size_t xRoundedSize = xWantedSize;
+
+    /* Round the size up to the start of the next size class, so every block in
+     * the list found is large enough and the list does not need searching. */
+    if( xRoundedSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xRoundedSize += ( ( size_t ) 1U << ( prvFindLastSet( ( uint32_t ) xRoundedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1U;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xRoundedSize < heapMAX_BLOCK_SIZE )
+    {
+        prvMappingInsert( xRoundedSize, &uxFLIndex, &uxSLIndex );
+
+        /* Look for a non-empty list in the same power of two range first. */
+        ulSLMap = pxHeap->ulSLBitmap[ uxFLIndex ] & ( ~( uint32_t ) 0U << uxSLIndex );
+
+        if( ulSLMap == 0U )
+        {
+            /* No block in this range is large enough, so look in the next
+             * non-empty range up.  uxFLIndex + 1 is never more than 31. */
+            ulFLMap = pxHeap->ulFLBitmap & ( ~( uint32_t ) 0U << ( uxFLIndex + ( UBaseType_t ) 1U ) );
+
+            if( ulFLMap != 0U )
+            {
+                uxFLIndex = prvFindFirstSet( ulFLMap );
+                ulSLMap = pxHeap->ulSLBitmap[ uxFLIndex ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulSLMap != 0U )
+        {
+            uxSLIndex = prvFindFirstSet( ulSLMap );
+            pxBlock = pxHeap->pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+            *puxFLIndex = uxFLIndex;
+            *puxSLIndex = uxSLIndex;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( HeapControl_t * pxHeap,
+                                        BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+    BlockLink_t * pxHead;
+
+    prvMappingInsert( pxBlockToInsert->xBlockSize, &uxFLIndex, &uxSLIndex );
+
+    /* Blocks are added at the head of the list. */
+    pxHead = pxHeap->pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+    pxBlockToInsert->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxHead );
+    pxBlockToInsert->pxPrevFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = heapPROTECT_BLOCK_POINTER( pxBlockToInsert );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxHeap->pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxBlockToInsert;
+    pxHeap->ulFLBitmap |= ( uint32_t ) 1U << uxFLIndex;
+    pxHeap->ulSLBitmap[ uxFLIndex ] |= ( uint32_t ) 1U << uxSLIndex;
+    pxHeap->xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlockFromFreeList( HeapControl_t * pxHeap,
+                                        BlockLink_t * pxBlockToRemove,
+                                        UBaseType_t uxFLIndex,
+                                        UBaseType_t uxSLIndex ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxNext = heapPROTECT_BLOCK_POINTER( pxBlockToRemove->pxNextFreeBlock );
+    BlockLink_t * pxPrev = heapPROTECT_BLOCK_POINTER( pxBlockToRemove->pxPrevFreeBlock );
+
+    if( pxNext != NULL )
+    {
+        heapVALIDATE_BLOCK_POINTER( pxNext );
+        pxNext->pxPrevFreeBlock = heapPROTECT_BLOCK_POINTER( pxPrev );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxPrev != NULL )
+    {
+        heapVALIDATE_BLOCK_POINTER( pxPrev );
+        pxPrev->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNext );
+    }
+    else
+    {
+        /* The block was at the head of the list. */
+        configASSERT( pxHeap->pxFreeLists[ uxFLIndex ][ uxSLIndex ] == pxBlockToRemove );
+        pxHeap->pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxNext;
+
+        if( pxNext == NULL )
+        {
+            /* The list is now empty, so clear its bit, and the bit of the
+             * power of two range if that is now empty too. */
+            pxHeap->ulSLBitmap[ uxFLIndex ] &= ~( ( uint32_t ) 1U << uxSLIndex );
+
+            if( pxHeap->ulSLBitmap[ uxFLIndex ] == 0U )
+            {
+                pxHeap->ulFLBitmap &= ~( ( uint32_t ) 1U << uxFLIndex );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    pxHeap->xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMergeAndInsertBlock( HeapControl_t * pxHeap,
+                                    BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxNeighbour;
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    /* Merge with the block before this one in memory if it is free.  The first
+     * block in a region has no block before it. */
+    pxNeighbour = heapPROTECT_BLOCK_POINTER( pxBlock->pxPrevPhysBlock );
+
+    if( pxNeighbour != NULL )
+    {
+        heapVALIDATE_BLOCK_POINTER( pxNeighbour );
+
+        if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 )
+        {
+            prvMappingInsert( pxNeighbour->xBlockSize, &uxFLIndex, &uxSLIndex );
+            prvRemoveBlockFromFreeList( pxHeap, pxNeighbour, uxFLIndex, uxSLIndex );
+            pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+            pxBlock = pxNeighbour;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Merge with the block after this one in memory if it is free.  The end
+     * marker of a region is always marked as allocated. */
+    pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+    heapVALIDATE_BLOCK_POINTER( pxNeighbour );
+
+    if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 )
+    {
+        prvMappingInsert( pxNeighbour->xBlockSize, &uxFLIndex, &uxSLIndex );
+        prvRemoveBlockFromFreeList( pxHeap, pxNeighbour, uxFLIndex, uxSLIndex );
+        pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+        pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* pxNeighbour is now the block following the merged block. */
+    pxNeighbour->pxPrevPhysBlock = heapPROTECT_BLOCK_POINTER( pxBlock );
+
+    prvInsertBlockIntoFreeList( pxHeap, pxBlock );
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+{
+    const HeapRegion_t * pxHeapRegion;
+
+    configASSERT( pxHeapRegions );
+
+    vTaskSuspendAll();
+    {
+        if( xHeapHasBeenInitialised == pdFALSE )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0; pxHeapRegion++ )
+        {
+            prvAddRegion( &xHeap, pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    /* Check something was actually defined. */
+    configASSERT( xHeap.xFreeBytesRemaining );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configHEAP_USE_BULK_REGIONS == 1 )
+
+    void vPortDefineBulkHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+    {
+        const HeapRegion_t * pxHeapRegion;
+
+        configASSERT( pxHeapRegions );
+
+        vTaskSuspendAll();
+        {
+            if( xHeapHasBeenInitialised == pdFALSE )
+            {
+                prvHeapInit();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0; pxHeapRegion++ )
+            {
+                prvAddRegion( &xBulkHeap, pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        /* Check something was actually defined. */
+        configASSERT( xBulkHeap.xFreeBytesRemaining );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_USE_BULK_REGIONS */
+/*-----------------------------------------------------------*/
+
+static void prvGetHeapStats( HeapControl_t * pxHeap,
+                             HeapStats_t * pxHeapStats ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFLIndex, uxSLIndex;
+    size_t xBlocks, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        xBlocks = pxHeap->xNumberOfFreeBlocks;
+
+        if( pxHeap->ulFLBitmap != 0U )
+        {
+            /* The largest free block is in the highest non-empty list, which
+             * holds blocks of a range of sizes, so search just that list. */
+            uxFLIndex = prvFindLastSet( pxHeap->ulFLBitmap );
+            uxSLIndex = prvFindLastSet( pxHeap->ulSLBitmap[ uxFLIndex ] );
+
+            for( pxBlock = pxHeap->pxFreeLists[ uxFLIndex ][ uxSLIndex ]; pxBlock != NULL; pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock ) )
+            {
+                heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+            }
+
+            /* Likewise the smallest is in the lowest non-empty list. */
+            uxFLIndex = prvFindFirstSet( pxHeap->ulFLBitmap );
+            uxSLIndex = prvFindFirstSet( pxHeap->ulSLBitmap[ uxFLIndex ] );
+
+            for( pxBlock = pxHeap->pxFreeLists[ uxFLIndex ][ uxSLIndex ]; pxBlock != NULL; pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock ) )
+            {
+                heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+                if( pxBlock->xBlockSize < xMinSize )
+                {
+                    xMinSize = pxBlock->xBlockSize;
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = pxHeap->xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = pxHeap->xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = pxHeap->xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = pxHeap->xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    prvGetHeapStats( &xHeap, pxHeapStats );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configHEAP_USE_BULK_REGIONS == 1 )
+
+    void vPortGetBulkHeapStats( HeapStats_t * pxHeapStats )
+    {
+        prvGetHeapStats( &xBulkHeap, pxHeapStats );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_USE_BULK_REGIONS */
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapResetState( void )
+{
+    ( void ) memset( &xHeap, 0, sizeof( xHeap ) );
+
+    #if ( configHEAP_USE_BULK_REGIONS == 1 )
+    {
+        ( void ) memset( &xBulkHeap, 0, sizeof( xBulkHeap ) );
+    }
+    #endif
+
+    xHeapHasBeenInitialised = pdFALSE;
+
+    #if ( configENABLE_HEAP_PROTECTOR == 1 )
+        pucHeapHighAddress = NULL;
+        pucHeapLowAddress = NULL;
+    #endif /* #if ( configENABLE_HEAP_PROTECTOR == 1 ) */
+}
+/*-----------------------------------------------------------*/
@@ -74,9 +74,20 @@
 #include "task.h"
 #include "timers.h"
 #include "utils/wait_for_event.h"
+
+#if ( configUSE_CORE_CHANNELS == 1 )
+    #include "core_channel.h"
+#endif
+
+#if ( configUSE_ISR_TIMERS == 1 )
+    #include <sys/timerfd.h>
+    #include "isr_timer.h"
+#endif
 /*-----------------------------------------------------------*/
 
-#define SIG_RESUME    SIGUSR1
+#define SIG_RESUME          SIGUSR1
+#define SIG_CORE_CHANNEL    SIGUSR2
+#define SIG_ISR_TIMER       SIGRTMIN
 
 typedef struct THREAD
 {
@@ -109,6 +120,16 @@ static BaseType_t xSchedulerEnd = pdFALSE;
 static pthread_t hTimerTickThread;
 static bool xTimerTickThreadShouldRun;
 static uint64_t prvStartTimeNs;
+
+#if ( configUSE_CORE_CHANNELS == 1 )
+    static volatile BaseType_t xCoreChannelSignalPending = pdFALSE;
+#endif
+
+#if ( configUSE_ISR_TIMERS == 1 )
+    static int iISRTimerFd = -1;
+    static pthread_t hISRTimerThread;
+    static volatile BaseType_t xISRTimerAlarmPending = pdFALSE;
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
@@ -119,6 +140,15 @@ static void prvSwitchThread( Thread_t * xThreadToResume,
 static void prvSuspendSelf( Thread_t * thread );
 static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
+#if ( configUSE_CORE_CHANNELS == 1 )
+    static BaseType_t prvServiceCoreChannelSignal( void );
+    static void vPortCoreChannelSignalHandler( int sig );
+#endif
+#if ( configUSE_ISR_TIMERS == 1 )
+    static BaseType_t prvServiceISRTimerAlarm( void );
+    static void vPortISRTimerSignalHandler( int sig );
+    static void * prvISRTimerThread( void * pvParams );
+#endif
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
 /*-----------------------------------------------------------*/
@@ -438,6 +468,18 @@ static void vPortSystemTickHandler( int sig )
  * do { */
     xTaskIncrementTick();
 
+    #if ( configUSE_CORE_CHANNELS == 1 )
+
+        /* A signal that arrived while the running thread was being switched
+         * out is left pending, so pick it up here at the latest. */
+        ( void ) prvServiceCoreChannelSignal();
+    #endif
+
+    #if ( configUSE_ISR_TIMERS == 1 )
+        /* As above. */
+        ( void ) prvServiceISRTimerAlarm();
+    #endif
+
 /*        prvTickCount++;
  *    } while (prvTickCount < xExpectedTicks);
  */
@@ -455,6 +497,202 @@ static void vPortSystemTickHandler( int sig )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_CORE_CHANNELS == 1 )
+
+    static BaseType_t prvServiceCoreChannelSignal( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        if( __atomic_exchange_n( &xCoreChannelSignalPending, pdFALSE, __ATOMIC_SEQ_CST ) != pdFALSE )
+        {
+            vCoreChannelHandleSignalFromISR( &xHigherPriorityTaskWoken );
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+/*-----------------------------------------------------------*/
+
+    static void vPortCoreChannelSignalHandler( int sig )
+    {
+        Thread_t * pxThreadToSuspend;
+        Thread_t * pxThreadToResume;
+
+        ( void ) sig;
+
+        uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+
+        pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        if( prvServiceCoreChannelSignal() != pdFALSE )
+        {
+            vTaskSwitchContext();
+
+            pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+            prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+        }
+
+        uxCriticalNesting--;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortCoreChannelSignal( BaseType_t xCoreID )
+    {
+        TaskHandle_t xRunningTask;
+
+        /* There is only one simulated core. */
+        ( void ) xCoreID;
+
+        /* This can be called from a host thread that is not a task, so the
+         * "interrupt" is delivered to whichever task is currently running.  If
+         * that thread is switched out before the signal is taken the tick
+         * handler services the pending flag instead. */
+        __atomic_store_n( &xCoreChannelSignalPending, pdTRUE, __ATOMIC_SEQ_CST );
+
+        xRunningTask = xTaskGetCurrentTaskHandle();
+
+        if( xRunningTask != NULL )
+        {
+            ( void ) pthread_kill( prvGetThreadFromTask( xRunningTask )->pthread, SIG_CORE_CHANNEL );
+        }
+    }
+
+#endif /* configUSE_CORE_CHANNELS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_TIMERS == 1 )
+
+    static BaseType_t prvServiceISRTimerAlarm( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        if( __atomic_exchange_n( &xISRTimerAlarmPending, pdFALSE, __ATOMIC_SEQ_CST ) != pdFALSE )
+        {
+            vISRTimerHandleAlarmFromISR( &xHigherPriorityTaskWoken );
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+/*-----------------------------------------------------------*/
+
+    static void vPortISRTimerSignalHandler( int sig )
+    {
+        Thread_t * pxThreadToSuspend;
+        Thread_t * pxThreadToResume;
+
+        ( void ) sig;
+
+        uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+
+        pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        if( prvServiceISRTimerAlarm() != pdFALSE )
+        {
+            vTaskSwitchContext();
+
+            pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+            prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+        }
+
+        uxCriticalNesting--;
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvISRTimerThread( void * pvParams )
+    {
+        uint64_t ullExpirations;
+        TaskHandle_t xRunningTask;
+        sigset_t xSignals;
+
+        ( void ) pvParams;
+
+        /* The alarm must only ever be handled by the thread of the running
+         * task, never by this one. */
+        sigfillset( &xSignals );
+        ( void ) pthread_sigmask( SIG_SETMASK, &xSignals, NULL );
+
+        prvPortSetCurrentThreadName( "ISR timer alarm" );
+
+        for( ; ; )
+        {
+            if( read( iISRTimerFd, &ullExpirations, sizeof( ullExpirations ) ) == ( ssize_t ) sizeof( ullExpirations ) )
+            {
+                /* Deliver the "interrupt" to whichever task is running.  If
+                 * that thread is switched out before the signal is taken the
+                 * tick handler services the pending flag instead. */
+                __atomic_store_n( &xISRTimerAlarmPending, pdTRUE, __ATOMIC_SEQ_CST );
+
+                xRunningTask = xTaskGetCurrentTaskHandle();
+
+                if( xRunningTask != NULL )
+                {
+                    ( void ) pthread_kill( prvGetThreadFromTask( xRunningTask )->pthread, SIG_ISR_TIMER );
+                }
+            }
+        }
+
+        return NULL;
+    }
+/*-----------------------------------------------------------*/
+
+    uint64_t ullPortISRTimerGetTimeUs( void )
+    {
+        return prvGetTimeNs() / ( uint64_t ) 1000U;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortISRTimerSetAlarm( uint64_t ullTimeUs )
+    {
+        struct itimerspec xAlarm;
+
+        if( iISRTimerFd < 0 )
+        {
+            iISRTimerFd = timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC );
+
+            if( iISRTimerFd < 0 )
+            {
+                prvFatalError( "timerfd_create", errno );
+            }
+
+            if( pthread_create( &hISRTimerThread, NULL, prvISRTimerThread, NULL ) != 0 )
+            {
+                prvFatalError( "pthread_create", errno );
+            }
+        }
+
+        /* An absolute time in the past expires immediately, but a time of
+         * zero would disarm the timer instead. */
+        if( ullTimeUs == ( uint64_t ) 0U )
+        {
+            ullTimeUs = ( uint64_t ) 1U;
+        }
+
+        ( void ) memset( &xAlarm, 0, sizeof( xAlarm ) );
+        xAlarm.it_value.tv_sec = ( time_t ) ( ullTimeUs / ( uint64_t ) 1000000U );
+        xAlarm.it_value.tv_nsec = ( long ) ( ( ullTimeUs % ( uint64_t ) 1000000U ) * ( uint64_t ) 1000U );
+
+        if( timerfd_settime( iISRTimerFd, TFD_TIMER_ABSTIME, &xAlarm, NULL ) != 0 )
+        {
+            prvFatalError( "timerfd_settime", errno );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortISRTimerCancelAlarm( void )
+    {
+        struct itimerspec xAlarm;
+
+        if( iISRTimerFd >= 0 )
+        {
+            ( void ) memset( &xAlarm, 0, sizeof( xAlarm ) );
+            ( void ) timerfd_settime( iISRTimerFd, 0, &xAlarm, NULL );
+        }
+    }
+
+#endif /* configUSE_ISR_TIMERS */
+/*-----------------------------------------------------------*/
+
 void vPortThreadDying( void * pxTaskToDelete,
                        volatile BaseType_t * pxPendYield )
 {
@@ -602,6 +840,40 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configUSE_CORE_CHANNELS == 1 )
+    {
+        struct sigaction sigchannel;
+
+        sigchannel.sa_flags = 0;
+        sigchannel.sa_handler = vPortCoreChannelSignalHandler;
+        sigfillset( &sigchannel.sa_mask );
+
+        iRet = sigaction( SIG_CORE_CHANNEL, &sigchannel, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif /* configUSE_CORE_CHANNELS */
+
+    #if ( configUSE_ISR_TIMERS == 1 )
+    {
+        struct sigaction sigisrtimer;
+
+        sigisrtimer.sa_flags = 0;
+        sigisrtimer.sa_handler = vPortISRTimerSignalHandler;
+        sigfillset( &sigisrtimer.sa_mask );
+
+        iRet = sigaction( SIG_ISR_TIMER, &sigisrtimer, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif /* configUSE_ISR_TIMERS */
 }
 /*-----------------------------------------------------------*/
 
@@ -130,6 +130,15 @@ extern void vPortCancelThread( void * pxTaskToDelete );
 #define portTASK_FUNCTION( vFunction, pvParameters )               void vFunction( void * pvParameters )
 /*-----------------------------------------------------------*/
 
+/* The heap trace dump records the address the executable was loaded at, so a
+ * host tool can resolve the recorded call sites in a position independent
+ * executable. */
+#if defined( __linux__ )
+    extern char __executable_start[];
+    #define portHEAP_TRACE_IMAGE_BASE()    ( ( void * ) __executable_start )
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Tasks run in their own pthreads and context switches between them
  * are always a full memory barrier. ISRs are emulated as signals
@@ -140,6 +149,33 @@ extern void vPortCancelThread( void * pxTaskToDelete );
  */
 #define portMEMORY_BARRIER()                        __asm volatile ( "" ::: "memory" )
 
+/*
+ * Objects accessed without a critical section, such as core channels, can
+ * also be used from host threads that are not FreeRTOS tasks, so those need
+ * a real hardware barrier.
+ */
+#define portDATA_MEMORY_BARRIER()                   __sync_synchronize()
+
+/*
+ * The host has no second core to interrupt, so core channels raise a host
+ * signal that is handled like an interrupt by whichever task is running.
+ */
+extern void vPortCoreChannelSignal( BaseType_t xCoreID );
+#define portCORE_CHANNEL_SIGNAL( xCoreID )          vPortCoreChannelSignal( xCoreID )
+
+/*
+ * ISR timers are driven by a timerfd, so are only available on Linux.  The
+ * expiry is delivered as a host signal in the same way as for core channels.
+ */
+#ifdef __linux__
+    extern uint64_t ullPortISRTimerGetTimeUs( void );
+    extern void vPortISRTimerSetAlarm( uint64_t ullTimeUs );
+    extern void vPortISRTimerCancelAlarm( void );
+    #define portISR_TIMER_GET_TIME_US()             ullPortISRTimerGetTimeUs()
+    #define portISR_TIMER_SET_ALARM( ullTimeUs )    vPortISRTimerSetAlarm( ullTimeUs )
+    #define portISR_TIMER_CANCEL_ALARM()            vPortISRTimerCancelAlarm()
+#endif
+
 extern uint32_t ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
 #define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
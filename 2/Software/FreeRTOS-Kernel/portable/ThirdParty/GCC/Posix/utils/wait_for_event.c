@@ -39,6 +39,15 @@ struct event
     bool event_triggered;
 };
 
+/* Unlocks the event mutex if a thread is cancelled while it waits for the
+ * event.  A thread cancelled inside pthread_cond_wait() exits holding the
+ * mutex, so without this the next event_signal() on the event would block
+ * forever. */
+static void prvUnlockMutex( void * pvMutex )
+{
+    pthread_mutex_unlock( ( pthread_mutex_t * ) pvMutex );
+}
+
 struct event * event_create( void )
 {
     struct event * ev = malloc( sizeof( struct event ) );
@@ -63,6 +72,7 @@ void event_delete( struct event * ev )
 bool event_wait( struct event * ev )
 {
     pthread_mutex_lock( &ev->mutex );
+    pthread_cleanup_push( prvUnlockMutex, &ev->mutex );
 
     while( ev->event_triggered == false )
     {
@@ -70,7 +80,7 @@ bool event_wait( struct event * ev )
     }
 
     ev->event_triggered = false;
-    pthread_mutex_unlock( &ev->mutex );
+    pthread_cleanup_pop( 1 );
     return true;
 }
 bool event_wait_timed( struct event * ev,
@@ -276,7 +276,8 @@ static inline void vPortRecursiveLock( uint32_t ulLockNum,
 
 #define portNOP()               __asm volatile ( "nop" )
 
-#define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
+#define portMEMORY_BARRIER()         __asm volatile ( "" ::: "memory" )
+#define portDATA_MEMORY_BARRIER()    __asm volatile ( "dmb" ::: "memory" )
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
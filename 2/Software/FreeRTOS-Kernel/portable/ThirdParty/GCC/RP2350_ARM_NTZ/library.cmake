@@ -6,13 +6,20 @@
 
 add_library(FreeRTOS-Kernel-Core INTERFACE)
 target_sources(FreeRTOS-Kernel-Core INTERFACE
+        ${FREERTOS_KERNEL_PATH}/arena.c
+        ${FREERTOS_KERNEL_PATH}/core_channel.c
         ${FREERTOS_KERNEL_PATH}/croutine.c
         ${FREERTOS_KERNEL_PATH}/event_groups.c
+        ${FREERTOS_KERNEL_PATH}/heap_trace.c
+        ${FREERTOS_KERNEL_PATH}/isr_timer.c
         ${FREERTOS_KERNEL_PATH}/list.c
+        ${FREERTOS_KERNEL_PATH}/mailbox.c
+        ${FREERTOS_KERNEL_PATH}/object_pool.c
         ${FREERTOS_KERNEL_PATH}/queue.c
         ${FREERTOS_KERNEL_PATH}/stream_buffer.c
         ${FREERTOS_KERNEL_PATH}/tasks.c
         ${FREERTOS_KERNEL_PATH}/timers.c
+        ${FREERTOS_KERNEL_PATH}/topic.c
         )
 target_include_directories(FreeRTOS-Kernel-Core INTERFACE ${FREERTOS_KERNEL_PATH}/include)
 
@@ -36,6 +43,7 @@ target_link_libraries(FreeRTOS-Kernel INTERFACE
         pico_base_headers
         hardware_clocks
         hardware_exception
+        hardware_timer
         pico_multicore
 )
 
@@ -71,3 +79,7 @@ target_link_libraries(FreeRTOS-Kernel-Heap4 INTERFACE FreeRTOS-Kernel)
 add_library(FreeRTOS-Kernel-Heap5 INTERFACE)
 target_sources(FreeRTOS-Kernel-Heap5 INTERFACE ${FREERTOS_KERNEL_PATH}/portable/MemMang/heap_5.c)
 target_link_libraries(FreeRTOS-Kernel-Heap5 INTERFACE FreeRTOS-Kernel)
+
+add_library(FreeRTOS-Kernel-Heap6 INTERFACE)
+target_sources(FreeRTOS-Kernel-Heap6 INTERFACE ${FREERTOS_KERNEL_PATH}/portable/MemMang/heap_6.c)
+target_link_libraries(FreeRTOS-Kernel-Heap6 INTERFACE FreeRTOS-Kernel)
@@ -61,6 +61,19 @@
 #include "pico/multicore.h"
 #endif /* LIB_PICO_MULTICORE */
 
+#if ( configUSE_CORE_CHANNELS == 1 )
+    #if ( LIB_PICO_MULTICORE != 1 )
+        #error configUSE_CORE_CHANNELS requires pico_multicore, which provides the doorbells used to signal the other core
+    #endif
+    #include "core_channel.h"
+#endif /* configUSE_CORE_CHANNELS */
+
+#if ( configUSE_ISR_TIMERS == 1 )
+    #include "hardware/irq.h"
+    #include "hardware/timer.h"
+    #include "isr_timer.h"
+#endif /* configUSE_ISR_TIMERS */
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 /**
@@ -388,9 +401,9 @@ typedef void ( * portISR_t )( void );
 #define portNO_SECURE_CONTEXT    0
 /*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configNUMBER_OF_CORES > 1 )
+#if ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configNUMBER_OF_CORES > 1 || configUSE_CORE_CHANNELS == 1 )
     #include "hardware/irq.h"
-#endif /* ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configNUMBER_OF_CORES > 1 ) */
+#endif /* ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configNUMBER_OF_CORES > 1 || configUSE_CORE_CHANNELS == 1 ) */
 #if ( configSUPPORT_PICO_SYNC_INTEROP == 1 )
     #include "pico/lock_core.h"
     #include "event_groups.h"
@@ -822,6 +835,10 @@ PRIVILEGED_DATA volatile uint32_t ulCriticalNestings[ configNUMBER_OF_CORES ] =
 static uint8_t ucPrimaryCoreNum = INVALID_PRIMARY_CORE_NUM;
 /* Initialize to -1 so that when using INTEROP with SDK and running on one core only, we can tell if this is initialized yet */
 static int8_t cDoorbellNum = -1;
+#if ( configUSE_CORE_CHANNELS == 1 )
+/* A second doorbell, raised by core channels to wake a task blocked on the other core */
+static int8_t cCoreChannelDoorbellNum = -1;
+#endif
 
 /* Note: portIS_FREE_RTOS_CORE() also returns false until the scheduler is started */
 #if ( configNUMBER_OF_CORES != 1 )
@@ -1690,7 +1707,7 @@ void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTIO
 #endif /* configENABLE_MPU */
 /*-----------------------------------------------------------*/
 
-#if ( LIB_PICO_MULTICORE == 1 ) && ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configNUMBER_OF_CORES > 1)
+#if ( LIB_PICO_MULTICORE == 1 ) && ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configNUMBER_OF_CORES > 1 || configUSE_CORE_CHANNELS == 1 )
     static void prvDoorbellInterruptHandler()
     {
         if (cDoorbellNum >= 0 && multicore_doorbell_is_set_current_core(cDoorbellNum))
@@ -1709,8 +1726,19 @@ void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTIO
                 portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
             #endif /* configNUMBER_OF_CORES != 1 */
         }
+        #if ( configUSE_CORE_CHANNELS == 1 )
+        /* All doorbells share one interrupt, so the core channel doorbell is handled here too */
+        if (cCoreChannelDoorbellNum >= 0 && multicore_doorbell_is_set_current_core(cCoreChannelDoorbellNum))
+        {
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+            traceISR_ENTER();
+            multicore_doorbell_clear_current_core(cCoreChannelDoorbellNum);
+            vCoreChannelHandleSignalFromISR( &xHigherPriorityTaskWoken );
+            portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+        }
+        #endif /* configUSE_CORE_CHANNELS */
     }
-#endif /* ( LIB_PICO_MULTICORE == 1 ) && ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configNUMBER_OF_CORES > 1) */
+#endif /* ( LIB_PICO_MULTICORE == 1 ) && ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configNUMBER_OF_CORES > 1 || configUSE_CORE_CHANNELS == 1 ) */
 
 #if ( configNUMBER_OF_CORES > 1 )
     static BaseType_t xPortStartSchedulerOnCore( void ) /* PRIVILEGED_FUNCTION */
@@ -1902,6 +1930,12 @@ void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTIO
         cDoorbellNum = (int8_t)multicore_doorbell_claim_unused(0b11, true);
         multicore_doorbell_clear_current_core(cDoorbellNum);
         multicore_doorbell_clear_other_core(cDoorbellNum);
+        #if ( configUSE_CORE_CHANNELS == 1 )
+            /* shares the doorbell interrupt, so no extra handler is needed */
+            cCoreChannelDoorbellNum = (int8_t)multicore_doorbell_claim_unused(0b11, true);
+            multicore_doorbell_clear_current_core(cCoreChannelDoorbellNum);
+            multicore_doorbell_clear_other_core(cCoreChannelDoorbellNum);
+        #endif
 
         ucPrimaryCoreNum = configTICK_CORE;
         configASSERT( get_core_num() == 0 ); /* we must be started on core 0 */
@@ -2065,7 +2099,15 @@ void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTIO
                 cDoorbellNum = (int8_t) multicore_doorbell_claim_unused(0b11, true);
                 multicore_doorbell_clear_current_core(cDoorbellNum);
                 multicore_doorbell_clear_other_core(cDoorbellNum);
-                uint32_t irq_num = multicore_doorbell_irq_num(cDoorbellNum);
+            #endif
+            #if ( configUSE_CORE_CHANNELS == 1 )
+                cCoreChannelDoorbellNum = (int8_t) multicore_doorbell_claim_unused(0b11, true);
+                multicore_doorbell_clear_current_core(cCoreChannelDoorbellNum);
+                multicore_doorbell_clear_other_core(cCoreChannelDoorbellNum);
+            #endif
+            #if ( configSUPPORT_PICO_SYNC_INTEROP == 1 || configUSE_CORE_CHANNELS == 1 )
+                /* all doorbells share the same interrupt */
+                uint32_t irq_num = multicore_doorbell_irq_num( ( cDoorbellNum >= 0 ) ? cDoorbellNum : cCoreChannelDoorbellNum );
                 irq_set_priority( irq_num, portMIN_INTERRUPT_PRIORITY );
                 irq_set_exclusive_handler( irq_num, prvDoorbellInterruptHandler );
                 irq_set_enabled( irq_num, 1 );
@@ -2741,4 +2783,102 @@ BaseType_t xPortIsInsideInterrupt( void )
     }
 #endif // ( configNUMBER_OF_CORES != 1 )
 
+#if ( configUSE_CORE_CHANNELS == 1 )
+    void vPortCoreChannelSignal( BaseType_t xCoreID )
+    {
+        uint uTargetCore;
+
+        /* Note this may be called from a core that is not running FreeRTOS */
+        if( cCoreChannelDoorbellNum >= 0 )
+        {
+        #if ( configNUMBER_OF_CORES != 1 )
+            uTargetCore = ( uint ) xCoreID;
+        #else
+            /* When FreeRTOS runs on one core, tasks can only ever wait on that core */
+            ( void ) xCoreID;
+            uTargetCore = ucPrimaryCoreNum;
+        #endif
+
+            if( uTargetCore == get_core_num() )
+            {
+                multicore_doorbell_set_current_core(cCoreChannelDoorbellNum);
+            }
+            else
+            {
+                multicore_doorbell_set_other_core(cCoreChannelDoorbellNum);
+            }
+        }
+    }
+#endif /* configUSE_CORE_CHANNELS */
+
+#if ( configUSE_ISR_TIMERS == 1 )
+/* The hardware alarm that drives ISR timers, claimed the first time it is programmed */
+static int8_t cISRTimerAlarmNum = -1;
+
+    static void prvISRTimerAlarmHandler( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        uint32_t ulAlarmMask = 1u << ( uint ) cISRTimerAlarmNum;
+
+        traceISR_ENTER();
+        /* Clear both a real alarm match and a forced interrupt */
+        timer_hw->intr = ulAlarmMask;
+        hw_clear_bits( &timer_hw->intf, ulAlarmMask );
+        vISRTimerHandleAlarmFromISR( &xHigherPriorityTaskWoken );
+        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+    }
+
+    uint64_t ullPortISRTimerGetTimeUs( void )
+    {
+        return time_us_64();
+    }
+
+    void vPortISRTimerSetAlarm( uint64_t ullTimeUs )
+    {
+        uint32_t ulAlarmMask;
+        uint64_t ullTimeNow;
+
+        if( cISRTimerAlarmNum < 0 )
+        {
+            /* The interrupt is enabled on the core that starts the first ISR timer, so that is the core the callbacks execute on */
+            cISRTimerAlarmNum = ( int8_t ) hardware_alarm_claim_unused( true );
+            uint irq_num = hardware_alarm_get_irq_num( ( uint ) cISRTimerAlarmNum );
+            irq_set_exclusive_handler( irq_num, prvISRTimerAlarmHandler );
+            /* As high as possible while still being allowed to call the interrupt safe API */
+            irq_set_priority( irq_num, configMAX_SYSCALL_INTERRUPT_PRIORITY );
+            hw_set_bits( &timer_hw->inte, 1u << ( uint ) cISRTimerAlarmNum );
+            irq_set_enabled( irq_num, true );
+        }
+
+        ulAlarmMask = 1u << ( uint ) cISRTimerAlarmNum;
+        ullTimeNow = time_us_64();
+
+        /* The alarm only compares the low 32 bits of the time, so a far away expiry is approached in steps -
+         * the kernel programs the alarm again each time it fires early */
+        if( ( ullTimeUs > ullTimeNow ) && ( ( ullTimeUs - ullTimeNow ) > 0x7fffffffULL ) )
+        {
+            ullTimeUs = ullTimeNow + 0x7fffffffULL;
+        }
+
+        /* Writing the alarm register arms the alarm */
+        timer_hw->alarm[ cISRTimerAlarmNum ] = ( uint32_t ) ullTimeUs;
+
+        /* A time that has already passed will never match, so force the interrupt instead */
+        if( time_us_64() >= ullTimeUs )
+        {
+            hw_set_bits( &timer_hw->intf, ulAlarmMask );
+        }
+    }
+
+    void vPortISRTimerCancelAlarm( void )
+    {
+        if( cISRTimerAlarmNum >= 0 )
+        {
+            /* Writing a one disarms the alarm */
+            timer_hw->armed = 1u << ( uint ) cISRTimerAlarmNum;
+            hw_clear_bits( &timer_hw->intf, 1u << ( uint ) cISRTimerAlarmNum );
+        }
+    }
+#endif /* configUSE_ISR_TIMERS */
+
 /*-----------------------------------------------------------*/
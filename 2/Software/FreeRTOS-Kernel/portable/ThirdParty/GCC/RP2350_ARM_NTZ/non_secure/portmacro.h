@@ -149,6 +149,18 @@
 void vYieldCore( int xCoreID );
 #define portYIELD_CORE( a )                  vYieldCore( a )
 
+/* Core channels ring a doorbell on the core a blocked task is waiting on */
+void vPortCoreChannelSignal( BaseType_t xCoreID );
+#define portCORE_CHANNEL_SIGNAL( xCoreID )   vPortCoreChannelSignal( xCoreID )
+
+/* ISR timers are driven by a hardware alarm of the microsecond timer */
+uint64_t ullPortISRTimerGetTimeUs( void );
+void vPortISRTimerSetAlarm( uint64_t ullTimeUs );
+void vPortISRTimerCancelAlarm( void );
+#define portISR_TIMER_GET_TIME_US()             ullPortISRTimerGetTimeUs()
+#define portISR_TIMER_SET_ALARM( ullTimeUs )    vPortISRTimerSetAlarm( ullTimeUs )
+#define portISR_TIMER_CANCEL_ALARM()            vPortISRTimerCancelAlarm()
+
 /*-----------------------------------------------------------*/
 
 /* Critical nesting count management. */
@@ -121,6 +121,18 @@ typedef portUBASE_TYPE   TickType_t;
 void vYieldCore( int xCoreID );
 #define portYIELD_CORE( a )                  vYieldCore( a )
 
+/* Core channels ring a doorbell on the core a blocked task is waiting on */
+void vPortCoreChannelSignal( BaseType_t xCoreID );
+#define portCORE_CHANNEL_SIGNAL( xCoreID )   vPortCoreChannelSignal( xCoreID )
+
+/* ISR timers are driven by a hardware alarm of the microsecond timer */
+uint64_t ullPortISRTimerGetTimeUs( void );
+void vPortISRTimerSetAlarm( uint64_t ullTimeUs );
+void vPortISRTimerCancelAlarm( void );
+#define portISR_TIMER_GET_TIME_US()             ullPortISRTimerGetTimeUs()
+#define portISR_TIMER_SET_ALARM( ullTimeUs )    vPortISRTimerSetAlarm( ullTimeUs )
+#define portISR_TIMER_CANCEL_ALARM()            vPortISRTimerCancelAlarm()
+
 /*-----------------------------------------------------------*/
 
 /* Scheduler utilities. */
@@ -243,7 +255,8 @@ extern void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
     #define portFORCE_INLINE    inline __attribute__( ( always_inline ) )
 #endif
 
-#define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
+#define portMEMORY_BARRIER()         __asm volatile ( "" ::: "memory" )
+#define portDATA_MEMORY_BARRIER()    __asm volatile ( "fence rw, rw" ::: "memory" )
 /*-----------------------------------------------------------*/
 
 /* Critical section management. */
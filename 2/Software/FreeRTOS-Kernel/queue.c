@@ -37,6 +37,8 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "isr_timer.h"
+#include "object_pool.h"
 
 #if ( configUSE_CO_ROUTINES == 1 )
     #include "croutine.h"
@@ -125,8 +127,23 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
     #endif
 
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        uint8_t ucPriorityLevels; /**< The number of item priorities if the queue was created as a priority queue, otherwise 0. */
+    #endif
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        TickType_t * pxItemTimes;  /**< The tick count at which the item in each slot of the storage area was sent, or NULL if the queue was not created as a timestamped queue. */
+        TickType_t xMaxItemAge;    /**< Items that have been in the queue for more than this number of ticks are discarded rather than received. */
+        QueueAgeStats_t xAgeStats; /**< Statistics on the age of the items that left the queue. */
+    #endif
+
+    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+        QueuePerfCounters_t xPerfCounters; /**< Counts of the sends, receives and waits of the queue, as returned by vQueueGetPerfCounters(). */
+    #endif
+
     #if ( configUSE_QUEUE_SETS == 1 )
         struct QueueDefinition * pxQueueSetContainer;
+        uint8_t ucPostedToQueueSet; /**< Set to pdTRUE while the handle of this queue is held in its queue set, so the handle is posted to the set at most once until it is selected. */
     #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -139,6 +156,53 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
  * name below to enable the use of older kernel aware debuggers. */
 typedef xQUEUE Queue_t;
 
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+
+/* Items are timestamped, and their age measured, using the tick count.  The
+ * ISR safe version is used as items are sent and received from both tasks and
+ * interrupts. */
+    #define queueGET_ITEM_TIME()    xTaskGetTickCountFromISR()
+
+/* The slot of the storage area an item occupies, which is also its index in
+ * the pxItemTimes array. */
+    #define queueITEM_SLOT( pxQueue, pcItem )    ( ( size_t ) ( ( pcItem ) - ( pxQueue )->pcHead ) / ( size_t ) ( pxQueue )->uxItemSize )
+
+#endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+/*
+ * The storage area of a priority queue starts with a PriorityQueueControl_t
+ * structure, followed by a PriorityQueueLevel_t structure for each priority,
+ * followed by the item slots.  Each slot holds the index of the next slot of
+ * the same priority followed by the item itself.  Slots that have been used and
+ * released are linked through the same index into a free list, and slots from
+ * uxUnusedSlot upwards have never been used, so resetting the queue does not
+ * need to visit every slot.
+ */
+    typedef struct PriorityQueueControl
+    {
+        UBaseType_t uxReadyLevels; /**< Bit n is set when priority n holds at least one item. */
+        UBaseType_t uxFreeSlot;    /**< The first released slot, or queuePRIORITY_NO_SLOT. */
+        UBaseType_t uxUnusedSlot;  /**< The first slot that has never been used. */
+    } PriorityQueueControl_t;
+
+    typedef struct PriorityQueueLevel
+    {
+        UBaseType_t uxHead; /**< The oldest item of this priority. */
+        UBaseType_t uxTail; /**< The newest item of this priority. */
+    } PriorityQueueLevel_t;
+
+    #define queuePRIORITY_NO_SLOT    ( ~( UBaseType_t ) 0U )
+
+    #define prvPRIORITY_QUEUE_CONTROL( pxQueue )    ( ( PriorityQueueControl_t * ) ( pxQueue )->pcHead )
+    #define prvPRIORITY_QUEUE_LEVELS( pxQueue )     ( ( PriorityQueueLevel_t * ) &( prvPRIORITY_QUEUE_CONTROL( pxQueue )[ 1 ] ) )
+    #define prvPRIORITY_QUEUE_SLOT( pxQueue, uxSlot )                                                                                        \
+    ( ( UBaseType_t * ) ( ( pxQueue )->pcHead + ( ( 3U + ( 2U * ( size_t ) ( pxQueue )->ucPriorityLevels ) ) * sizeof( UBaseType_t ) ) + \
+                          ( ( size_t ) ( uxSlot ) * queuePRIORITY_SLOT_SIZE( ( pxQueue )->uxItemSize ) ) ) )
+
+#endif /* configUSE_PRIORITY_QUEUES */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -214,9 +278,61 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 
 /*
  * Checks to see if a queue is a member of a queue set, and if so, notifies
- * the queue set that the queue contains data.
+ * the queue set that the queue contains data.  The handle of the queue is only
+ * posted to the set if it is not already held in the set, so a member occupies
+ * at most one space in the set however many items it contains.
+ */
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+/*
+ * Equivalents of prvCopyDataToQueue() and prvCopyDataFromQueue() for queues
+ * created as priority queues.  prvCopyDataFromPriorityQueue() leaves the item
+ * in the queue if xRemove is pdFALSE, which is used to peek the queue.
+ */
+    static void prvCopyDataToPriorityQueue( Queue_t * const pxQueue,
+                                            const void * pvItemToQueue,
+                                            const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+    static void prvCopyDataFromPriorityQueue( Queue_t * const pxQueue,
+                                              void * const pvBuffer,
+                                              const BaseType_t xRemove ) PRIVILEGED_FUNCTION;
+
+/*
+ * Empties a priority queue.  Must be called from a critical section.
+ */
+    static void prvResetPriorityQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+
+/*
+ * Discards items from the front of a timestamped queue that have been in the
+ * queue for longer than its maximum item age, unblocking a task waiting to
+ * send for each item discarded.  Returns pdTRUE if a task that has a priority
+ * above the calling task was unblocked.  Must be called from a critical
+ * section.
+ */
+    static BaseType_t prvDiscardExpiredItems( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Updates the age statistics of a timestamped queue after the item at
+ * pcReadFrom has been received.  Must be called from a critical section.
+ */
+    static void prvRecordItemAge( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+
+/*
+ * Updates the performance counters of a queue after a send (xIsSend is pdTRUE)
+ * or receive that had to wait, starting at tick count xBlockedSince, completes
+ * or times out.  Must be called from a critical section.
  */
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvRecordBlockedTime( Queue_t * const pxQueue,
+                                      const TickType_t xBlockedSince,
+                                      const BaseType_t xIsSend ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
@@ -324,6 +440,19 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_PRIORITY_QUEUES == 1 )
+            {
+                if( pxQueue->ucPriorityLevels != ( uint8_t ) 0U )
+                {
+                    prvResetPriorityQueue( pxQueue );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_PRIORITY_QUEUES */
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -523,7 +652,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+            pxNewQueue = ( Queue_t * ) poolMALLOC( eObjectPoolQueue, sizeof( Queue_t ) + xQueueSizeInBytes );
 
             if( pxNewQueue != NULL )
             {
@@ -563,403 +692,769 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
-                                   const UBaseType_t uxItemSize,
-                                   uint8_t * pucQueueStorage,
-                                   const uint8_t ucQueueType,
-                                   Queue_t * pxNewQueue )
-{
-    /* Remove compiler warnings about unused parameters should
-     * configUSE_TRACE_FACILITY not be set to 1. */
-    ( void ) ucQueueType;
-
-    if( uxItemSize == ( UBaseType_t ) 0 )
-    {
-        /* No RAM was allocated for the queue storage area, but PC head cannot
-         * be set to NULL because NULL is used as a key to say the queue is used as
-         * a mutex.  Therefore just set pcHead to point to the queue as a benign
-         * value that is known to be within the memory map. */
-        pxNewQueue->pcHead = ( int8_t * ) pxNewQueue;
-    }
-    else
-    {
-        /* Set the head to the start of the queue storage area. */
-        pxNewQueue->pcHead = ( int8_t * ) pucQueueStorage;
-    }
-
-    /* Initialise the queue members as described where the queue type is
-     * defined. */
-    pxNewQueue->uxLength = uxQueueLength;
-    pxNewQueue->uxItemSize = uxItemSize;
-    ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
-
-    #if ( configUSE_TRACE_FACILITY == 1 )
-    {
-        pxNewQueue->ucQueueType = ucQueueType;
-    }
-    #endif /* configUSE_TRACE_FACILITY */
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    #if ( configUSE_QUEUE_SETS == 1 )
+    QueueHandle_t xQueueCreatePriority( const UBaseType_t uxQueueLength,
+                                        const UBaseType_t uxItemSize,
+                                        const UBaseType_t uxPriorityLevels )
     {
-        pxNewQueue->pxQueueSetContainer = NULL;
-    }
-    #endif /* configUSE_QUEUE_SETS */
-
-    traceQUEUE_CREATE( pxNewQueue );
-}
-/*-----------------------------------------------------------*/
+        Queue_t * pxNewQueue = NULL;
+        uint8_t * pucQueueStorage;
 
-#if ( configUSE_MUTEXES == 1 )
+        traceENTER_xQueueCreatePriority( uxQueueLength, uxItemSize, uxPriorityLevels );
 
-    static void prvInitialiseMutex( Queue_t * pxNewQueue )
-    {
-        if( pxNewQueue != NULL )
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            ( uxItemSize > ( UBaseType_t ) 0 ) &&
+            ( uxPriorityLevels > ( UBaseType_t ) 0 ) &&
+            ( uxPriorityLevels <= queuePRIORITY_LEVELS_MAX ) &&
+            ( uxPriorityLevels <= ( UBaseType_t ) ( sizeof( UBaseType_t ) * 8U ) ) &&
+            /* Check for overflow when the slot and storage sizes are calculated. */
+            ( queuePRIORITY_SLOT_SIZE( uxItemSize ) > ( size_t ) uxItemSize ) &&
+            ( ( ( SIZE_MAX - sizeof( Queue_t ) - queuePRIORITY_STORAGE_SIZE( 0U, 0U, uxPriorityLevels ) ) / queuePRIORITY_SLOT_SIZE( uxItemSize ) ) >= ( size_t ) uxQueueLength ) )
         {
-            /* The queue create function will set all the queue structure members
-            * correctly for a generic queue, but this function is creating a
-            * mutex.  Overwrite those members that need to be set differently -
-            * in particular the information required for priority inheritance. */
-            pxNewQueue->u.xSemaphore.xMutexHolder = NULL;
-            pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxNewQueue = ( Queue_t * ) poolMALLOC( eObjectPoolQueue, sizeof( Queue_t ) + queuePRIORITY_STORAGE_SIZE( uxQueueLength, uxItemSize, uxPriorityLevels ) );
 
-            /* In case this is a recursive mutex. */
-            pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
+            if( pxNewQueue != NULL )
+            {
+                /* Jump past the queue structure to find the location of the queue
+                 * storage area. */
+                pucQueueStorage = ( uint8_t * ) pxNewQueue;
+                pucQueueStorage += sizeof( Queue_t );
 
-            traceCREATE_MUTEX( pxNewQueue );
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    pxNewQueue->ucStaticallyAllocated = pdFALSE;
+                }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-            /* Start with the semaphore in the expected state. */
-            ( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+                prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage, queueQUEUE_TYPE_BASE, pxNewQueue );
+
+                pxNewQueue->ucPriorityLevels = ( uint8_t ) uxPriorityLevels;
+                prvResetPriorityQueue( pxNewQueue );
+            }
+            else
+            {
+                traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
-            traceCREATE_MUTEX_FAILED();
+            configASSERT( pxNewQueue );
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        traceRETURN_xQueueCreatePriority( pxNewQueue );
+
+        return pxNewQueue;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-    QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
+    QueueHandle_t xQueueCreatePriorityStatic( const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              const UBaseType_t uxPriorityLevels,
+                                              uint8_t * pucQueueStorage,
+                                              StaticQueue_t * pxStaticQueue )
     {
-        QueueHandle_t xNewQueue;
-        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
-
-        traceENTER_xQueueCreateMutex( ucQueueType );
+        Queue_t * pxNewQueue = NULL;
 
-        xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, ucQueueType );
-        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+        traceENTER_xQueueCreatePriorityStatic( uxQueueLength, uxItemSize, uxPriorityLevels, pucQueueStorage, pxStaticQueue );
 
-        traceRETURN_xQueueCreateMutex( xNewQueue );
+        configASSERT( pxStaticQueue );
+        configASSERT( pucQueueStorage );
 
-        return xNewQueue;
-    }
+        /* The storage area holds slot indexes as well as items, so must be
+         * aligned to a UBaseType_t. */
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucQueueStorage ) & ( ( portPOINTER_SIZE_TYPE ) sizeof( UBaseType_t ) - 1U ) ) == 0U );
 
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            ( uxItemSize > ( UBaseType_t ) 0 ) &&
+            ( uxPriorityLevels > ( UBaseType_t ) 0 ) &&
+            ( uxPriorityLevels <= queuePRIORITY_LEVELS_MAX ) &&
+            ( uxPriorityLevels <= ( UBaseType_t ) ( sizeof( UBaseType_t ) * 8U ) ) &&
+            ( pxStaticQueue != NULL ) &&
+            ( pucQueueStorage != NULL ) )
+        {
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticQueue_t equals the size of the real
+                 * queue structure. */
+                volatile size_t xSize = sizeof( StaticQueue_t );
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+                /* This assertion cannot be branch covered in unit tests */
+                configASSERT( xSize == sizeof( Queue_t ) ); /* LCOV_EXCL_BR_LINE */
+                ( void ) xSize;                             /* Prevent unused variable warning when configASSERT() is not defined. */
+            }
+            #endif /* configASSERT_DEFINED */
 
-    QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
-                                           StaticQueue_t * pxStaticQueue )
-    {
-        QueueHandle_t xNewQueue;
-        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNewQueue = ( Queue_t * ) pxStaticQueue;
 
-        traceENTER_xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                pxNewQueue->ucStaticallyAllocated = pdTRUE;
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 
-        /* Prevent compiler warnings about unused parameters if
-         * configUSE_TRACE_FACILITY does not equal 1. */
-        ( void ) ucQueueType;
+            prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage, queueQUEUE_TYPE_BASE, pxNewQueue );
 
-        xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, ucQueueType );
-        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+            pxNewQueue->ucPriorityLevels = ( uint8_t ) uxPriorityLevels;
+            prvResetPriorityQueue( pxNewQueue );
+        }
+        else
+        {
+            configASSERT( pxNewQueue );
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        traceRETURN_xQueueCreateMutexStatic( xNewQueue );
+        traceRETURN_xQueueCreatePriorityStatic( pxNewQueue );
 
-        return xNewQueue;
+        return pxNewQueue;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+#if ( ( configUSE_TIMESTAMPED_MESSAGES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
+    QueueHandle_t xQueueCreateTimestamped( const UBaseType_t uxQueueLength,
+                                           const UBaseType_t uxItemSize,
+                                           const TickType_t xMaxItemAge )
     {
-        TaskHandle_t pxReturn;
-        Queue_t * const pxSemaphore = ( Queue_t * ) xSemaphore;
-
-        traceENTER_xQueueGetMutexHolder( xSemaphore );
+        Queue_t * pxNewQueue = NULL;
+        uint8_t * pucQueueStorage;
 
-        configASSERT( xSemaphore );
+        traceENTER_xQueueCreateTimestamped( uxQueueLength, uxItemSize, xMaxItemAge );
 
-        /* This function is called by xSemaphoreGetMutexHolder(), and should not
-         * be called directly.  Note:  This is a good way of determining if the
-         * calling task is the mutex holder, but not a good way of determining the
-         * identity of the mutex holder, as the holder may change between the
-         * following critical section exiting and the function returning. */
-        taskENTER_CRITICAL();
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            ( uxItemSize > ( UBaseType_t ) 0 ) &&
+            /* Check for overflow when the storage size is calculated. */
+            ( ( ( SIZE_MAX - sizeof( Queue_t ) - sizeof( TickType_t ) ) / ( ( size_t ) uxItemSize + sizeof( TickType_t ) ) ) >= ( size_t ) uxQueueLength ) )
         {
-            if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxNewQueue = ( Queue_t * ) poolMALLOC( eObjectPoolQueue, sizeof( Queue_t ) + queueTIMESTAMPED_STORAGE_SIZE( uxQueueLength, uxItemSize ) );
+
+            if( pxNewQueue != NULL )
             {
-                pxReturn = pxSemaphore->u.xSemaphore.xMutexHolder;
+                /* Jump past the queue structure to find the location of the queue
+                 * storage area. */
+                pucQueueStorage = ( uint8_t * ) pxNewQueue;
+                pucQueueStorage += sizeof( Queue_t );
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    pxNewQueue->ucStaticallyAllocated = pdFALSE;
+                }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage, queueQUEUE_TYPE_BASE, pxNewQueue );
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxNewQueue->pxItemTimes = ( TickType_t * ) &( pucQueueStorage[ queueTIMESTAMPED_STORAGE_SIZE( uxQueueLength, uxItemSize ) - ( ( size_t ) uxQueueLength * sizeof( TickType_t ) ) ] );
+                pxNewQueue->xMaxItemAge = xMaxItemAge;
             }
             else
             {
-                pxReturn = NULL;
+                traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
+        else
+        {
+            configASSERT( pxNewQueue );
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        traceRETURN_xQueueGetMutexHolder( pxReturn );
+        traceRETURN_xQueueCreateTimestamped( pxNewQueue );
 
-        return pxReturn;
+        return pxNewQueue;
     }
 
-#endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+#endif /* ( ( configUSE_TIMESTAMPED_MESSAGES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+#if ( ( configUSE_TIMESTAMPED_MESSAGES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-    TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore )
+    QueueHandle_t xQueueCreateTimestampedStatic( const UBaseType_t uxQueueLength,
+                                                 const UBaseType_t uxItemSize,
+                                                 const TickType_t xMaxItemAge,
+                                                 uint8_t * pucQueueStorage,
+                                                 StaticQueue_t * pxStaticQueue )
     {
-        TaskHandle_t pxReturn;
+        Queue_t * pxNewQueue = NULL;
 
-        traceENTER_xQueueGetMutexHolderFromISR( xSemaphore );
+        traceENTER_xQueueCreateTimestampedStatic( uxQueueLength, uxItemSize, xMaxItemAge, pucQueueStorage, pxStaticQueue );
 
-        configASSERT( xSemaphore );
+        configASSERT( pxStaticQueue );
+        configASSERT( pucQueueStorage );
 
-        /* Mutexes cannot be used in interrupt service routines, so the mutex
-         * holder should not change in an ISR, and therefore a critical section is
-         * not required here. */
-        if( ( ( Queue_t * ) xSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
+        /* The storage area ends with the item timestamps, so must be aligned
+         * to a TickType_t. */
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucQueueStorage ) & ( ( portPOINTER_SIZE_TYPE ) sizeof( TickType_t ) - 1U ) ) == 0U );
+
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            ( uxItemSize > ( UBaseType_t ) 0 ) &&
+            ( pxStaticQueue != NULL ) &&
+            ( pucQueueStorage != NULL ) )
         {
-            pxReturn = ( ( Queue_t * ) xSemaphore )->u.xSemaphore.xMutexHolder;
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticQueue_t equals the size of the real
+                 * queue structure. */
+                volatile size_t xSize = sizeof( StaticQueue_t );
+
+                /* This assertion cannot be branch covered in unit tests */
+                configASSERT( xSize == sizeof( Queue_t ) ); /* LCOV_EXCL_BR_LINE */
+                ( void ) xSize;                             /* Prevent unused variable warning when configASSERT() is not defined. */
+            }
+            #endif /* configASSERT_DEFINED */
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNewQueue = ( Queue_t * ) pxStaticQueue;
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                pxNewQueue->ucStaticallyAllocated = pdTRUE;
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+            prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage, queueQUEUE_TYPE_BASE, pxNewQueue );
+
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNewQueue->pxItemTimes = ( TickType_t * ) &( pucQueueStorage[ queueTIMESTAMPED_STORAGE_SIZE( uxQueueLength, uxItemSize ) - ( ( size_t ) uxQueueLength * sizeof( TickType_t ) ) ] );
+            pxNewQueue->xMaxItemAge = xMaxItemAge;
         }
         else
         {
-            pxReturn = NULL;
+            configASSERT( pxNewQueue );
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xQueueGetMutexHolderFromISR( pxReturn );
+        traceRETURN_xQueueCreateTimestampedStatic( pxNewQueue );
 
-        return pxReturn;
+        return pxNewQueue;
     }
 
-#endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+#endif /* ( ( configUSE_TIMESTAMPED_MESSAGES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
 
-    BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
+    void vQueueSetMaxItemAge( QueueHandle_t xQueue,
+                              TickType_t xMaxItemAge )
     {
-        BaseType_t xReturn;
-        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
-
-        traceENTER_xQueueGiveMutexRecursive( xMutex );
-
-        configASSERT( pxMutex );
-
-        /* If this is the task that holds the mutex then xMutexHolder will not
-         * change outside of this task.  If this task does not hold the mutex then
-         * pxMutexHolder can never coincidentally equal the tasks handle, and as
-         * this is the only condition we are interested in it does not matter if
-         * pxMutexHolder is accessed simultaneously by another task.  Therefore no
-         * mutual exclusion is required to test the pxMutexHolder variable. */
-        if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
-        {
-            traceGIVE_MUTEX_RECURSIVE( pxMutex );
+        Queue_t * const pxQueue = xQueue;
 
-            /* uxRecursiveCallCount cannot be zero if xMutexHolder is equal to
-             * the task handle, therefore no underflow check is required.  Also,
-             * uxRecursiveCallCount is only modified by the mutex holder, and as
-             * there can only be one, no mutual exclusion is required to modify the
-             * uxRecursiveCallCount member. */
-            ( pxMutex->u.xSemaphore.uxRecursiveCallCount )--;
+        traceENTER_vQueueSetMaxItemAge( xQueue, xMaxItemAge );
 
-            /* Has the recursive call count unwound to 0? */
-            if( pxMutex->u.xSemaphore.uxRecursiveCallCount == ( UBaseType_t ) 0 )
-            {
-                /* Return the mutex.  This will automatically unblock any other
-                 * task that might be waiting to access the mutex. */
-                ( void ) xQueueGenericSend( pxMutex, NULL, queueMUTEX_GIVE_BLOCK_TIME, queueSEND_TO_BACK );
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->pxItemTimes != NULL );
 
-            xReturn = pdPASS;
-        }
-        else
+        taskENTER_CRITICAL();
         {
-            /* The mutex cannot be given because the calling task is not the
-             * holder. */
-            xReturn = pdFAIL;
-
-            traceGIVE_MUTEX_RECURSIVE_FAILED( pxMutex );
+            pxQueue->xMaxItemAge = xMaxItemAge;
         }
+        taskEXIT_CRITICAL();
 
-        traceRETURN_xQueueGiveMutexRecursive( xReturn );
-
-        return xReturn;
+        traceRETURN_vQueueSetMaxItemAge();
     }
 
-#endif /* configUSE_RECURSIVE_MUTEXES */
+#endif /* configUSE_TIMESTAMPED_MESSAGES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
 
-    BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
-                                         TickType_t xTicksToWait )
+    void vQueueGetAgeStats( QueueHandle_t xQueue,
+                            QueueAgeStats_t * pxAgeStats,
+                            BaseType_t xReset )
     {
-        BaseType_t xReturn;
-        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
-
-        traceENTER_xQueueTakeMutexRecursive( xMutex, xTicksToWait );
-
-        configASSERT( pxMutex );
+        Queue_t * const pxQueue = xQueue;
 
-        /* Comments regarding mutual exclusion as per those within
-         * xQueueGiveMutexRecursive(). */
+        traceENTER_vQueueGetAgeStats( xQueue, pxAgeStats, xReset );
 
-        traceTAKE_MUTEX_RECURSIVE( pxMutex );
+        configASSERT( pxQueue );
+        configASSERT( pxAgeStats );
 
-        if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
-        {
-            ( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
-            xReturn = pdPASS;
-        }
-        else
+        taskENTER_CRITICAL();
         {
-            xReturn = xQueueSemaphoreTake( pxMutex, xTicksToWait );
+            *pxAgeStats = pxQueue->xAgeStats;
 
-            /* pdPASS will only be returned if the mutex was successfully
-             * obtained.  The calling task may have entered the Blocked state
-             * before reaching here. */
-            if( xReturn != pdFAIL )
+            if( xReset != pdFALSE )
             {
-                ( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
+                ( void ) memset( ( void * ) &( pxQueue->xAgeStats ), 0x00, sizeof( QueueAgeStats_t ) );
             }
             else
             {
-                traceTAKE_MUTEX_RECURSIVE_FAILED( pxMutex );
+                mtCOVERAGE_TEST_MARKER();
             }
         }
+        taskEXIT_CRITICAL();
 
-        traceRETURN_xQueueTakeMutexRecursive( xReturn );
-
-        return xReturn;
+        traceRETURN_vQueueGetAgeStats();
     }
 
-#endif /* configUSE_RECURSIVE_MUTEXES */
+#endif /* configUSE_TIMESTAMPED_MESSAGES */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
+                                   const UBaseType_t uxItemSize,
+                                   uint8_t * pucQueueStorage,
+                                   const uint8_t ucQueueType,
+                                   Queue_t * pxNewQueue )
+{
+    /* Remove compiler warnings about unused parameters should
+     * configUSE_TRACE_FACILITY not be set to 1. */
+    ( void ) ucQueueType;
 
-    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
-                                                       const UBaseType_t uxInitialCount,
-                                                       StaticQueue_t * pxStaticQueue )
+    if( uxItemSize == ( UBaseType_t ) 0 )
     {
-        QueueHandle_t xHandle = NULL;
+        /* No RAM was allocated for the queue storage area, but PC head cannot
+         * be set to NULL because NULL is used as a key to say the queue is used as
+         * a mutex.  Therefore just set pcHead to point to the queue as a benign
+         * value that is known to be within the memory map. */
+        pxNewQueue->pcHead = ( int8_t * ) pxNewQueue;
+    }
+    else
+    {
+        /* Set the head to the start of the queue storage area. */
+        pxNewQueue->pcHead = ( int8_t * ) pucQueueStorage;
+    }
 
-        traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+    /* Initialise the queue members as described where the queue type is
+     * defined. */
+    pxNewQueue->uxLength = uxQueueLength;
+    pxNewQueue->uxItemSize = uxItemSize;
 
-        if( ( uxMaxCount != 0U ) &&
-            ( uxInitialCount <= uxMaxCount ) )
-        {
-            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+    {
+        /* Priority queues set this after the queue is initialised. */
+        pxNewQueue->ucPriorityLevels = ( uint8_t ) 0U;
+    }
+    #endif /* configUSE_PRIORITY_QUEUES */
 
-            if( xHandle != NULL )
-            {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    {
+        /* Timestamped queues set these after the queue is initialised. */
+        pxNewQueue->pxItemTimes = NULL;
+        pxNewQueue->xMaxItemAge = portMAX_DELAY;
+        ( void ) memset( ( void * ) &( pxNewQueue->xAgeStats ), 0x00, sizeof( QueueAgeStats_t ) );
+    }
+    #endif /* configUSE_TIMESTAMPED_MESSAGES */
 
-                traceCREATE_COUNTING_SEMAPHORE();
-            }
-            else
-            {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
-            }
-        }
-        else
-        {
-            configASSERT( xHandle );
-            mtCOVERAGE_TEST_MARKER();
-        }
+    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+    {
+        ( void ) memset( ( void * ) &( pxNewQueue->xPerfCounters ), 0x00, sizeof( QueuePerfCounters_t ) );
+    }
+    #endif /* configUSE_QUEUE_PERF_COUNTERS */
 
-        traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle );
+    ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
-        return xHandle;
+    #if ( configUSE_TRACE_FACILITY == 1 )
+    {
+        pxNewQueue->ucQueueType = ucQueueType;
     }
+    #endif /* configUSE_TRACE_FACILITY */
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+    #if ( configUSE_QUEUE_SETS == 1 )
+    {
+        pxNewQueue->pxQueueSetContainer = NULL;
+        pxNewQueue->ucPostedToQueueSet = pdFALSE;
+    }
+    #endif /* configUSE_QUEUE_SETS */
+
+    traceQUEUE_CREATE( pxNewQueue );
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( configUSE_MUTEXES == 1 )
 
-    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
-                                                 const UBaseType_t uxInitialCount )
+    static void prvInitialiseMutex( Queue_t * pxNewQueue )
     {
-        QueueHandle_t xHandle = NULL;
-
-        traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount );
-
-        if( ( uxMaxCount != 0U ) &&
-            ( uxInitialCount <= uxMaxCount ) )
+        if( pxNewQueue != NULL )
         {
-            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+            /* The queue create function will set all the queue structure members
+            * correctly for a generic queue, but this function is creating a
+            * mutex.  Overwrite those members that need to be set differently -
+            * in particular the information required for priority inheritance. */
+            pxNewQueue->u.xSemaphore.xMutexHolder = NULL;
+            pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
 
-            if( xHandle != NULL )
-            {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+            /* In case this is a recursive mutex. */
+            pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
-                traceCREATE_COUNTING_SEMAPHORE();
-            }
-            else
-            {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
-            }
+            traceCREATE_MUTEX( pxNewQueue );
+
+            /* Start with the semaphore in the expected state. */
+            ( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
         }
         else
         {
-            configASSERT( xHandle );
-            mtCOVERAGE_TEST_MARKER();
+            traceCREATE_MUTEX_FAILED();
         }
-
-        traceRETURN_xQueueCreateCountingSemaphore( xHandle );
-
-        return xHandle;
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
-                              const void * const pvItemToQueue,
-                              TickType_t xTicksToWait,
-                              const BaseType_t xCopyPosition )
-{
-    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
-
-    traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-    }
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateMutex( ucQueueType );
+
+        xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, ucQueueType );
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        traceRETURN_xQueueCreateMutex( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
+                                           StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+
+        /* Prevent compiler warnings about unused parameters if
+         * configUSE_TRACE_FACILITY does not equal 1. */
+        ( void ) ucQueueType;
+
+        xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, ucQueueType );
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        traceRETURN_xQueueCreateMutexStatic( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+
+    TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
+    {
+        TaskHandle_t pxReturn;
+        Queue_t * const pxSemaphore = ( Queue_t * ) xSemaphore;
+
+        traceENTER_xQueueGetMutexHolder( xSemaphore );
+
+        configASSERT( xSemaphore );
+
+        /* This function is called by xSemaphoreGetMutexHolder(), and should not
+         * be called directly.  Note:  This is a good way of determining if the
+         * calling task is the mutex holder, but not a good way of determining the
+         * identity of the mutex holder, as the holder may change between the
+         * following critical section exiting and the function returning. */
+        taskENTER_CRITICAL();
+        {
+            if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
+            {
+                pxReturn = pxSemaphore->u.xSemaphore.xMutexHolder;
+            }
+            else
+            {
+                pxReturn = NULL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xQueueGetMutexHolder( pxReturn );
+
+        return pxReturn;
+    }
+
+#endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+
+    TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore )
+    {
+        TaskHandle_t pxReturn;
+
+        traceENTER_xQueueGetMutexHolderFromISR( xSemaphore );
+
+        configASSERT( xSemaphore );
+
+        /* Mutexes cannot be used in interrupt service routines, so the mutex
+         * holder should not change in an ISR, and therefore a critical section is
+         * not required here. */
+        if( ( ( Queue_t * ) xSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            pxReturn = ( ( Queue_t * ) xSemaphore )->u.xSemaphore.xMutexHolder;
+        }
+        else
+        {
+            pxReturn = NULL;
+        }
+
+        traceRETURN_xQueueGetMutexHolderFromISR( pxReturn );
+
+        return pxReturn;
+    }
+
+#endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+    BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+        traceENTER_xQueueGiveMutexRecursive( xMutex );
+
+        configASSERT( pxMutex );
+
+        /* If this is the task that holds the mutex then xMutexHolder will not
+         * change outside of this task.  If this task does not hold the mutex then
+         * pxMutexHolder can never coincidentally equal the tasks handle, and as
+         * this is the only condition we are interested in it does not matter if
+         * pxMutexHolder is accessed simultaneously by another task.  Therefore no
+         * mutual exclusion is required to test the pxMutexHolder variable. */
+        if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+        {
+            traceGIVE_MUTEX_RECURSIVE( pxMutex );
+
+            /* uxRecursiveCallCount cannot be zero if xMutexHolder is equal to
+             * the task handle, therefore no underflow check is required.  Also,
+             * uxRecursiveCallCount is only modified by the mutex holder, and as
+             * there can only be one, no mutual exclusion is required to modify the
+             * uxRecursiveCallCount member. */
+            ( pxMutex->u.xSemaphore.uxRecursiveCallCount )--;
+
+            /* Has the recursive call count unwound to 0? */
+            if( pxMutex->u.xSemaphore.uxRecursiveCallCount == ( UBaseType_t ) 0 )
+            {
+                /* Return the mutex.  This will automatically unblock any other
+                 * task that might be waiting to access the mutex. */
+                ( void ) xQueueGenericSend( pxMutex, NULL, queueMUTEX_GIVE_BLOCK_TIME, queueSEND_TO_BACK );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            /* The mutex cannot be given because the calling task is not the
+             * holder. */
+            xReturn = pdFAIL;
+
+            traceGIVE_MUTEX_RECURSIVE_FAILED( pxMutex );
+        }
+
+        traceRETURN_xQueueGiveMutexRecursive( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_RECURSIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+    BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
+                                         TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+        traceENTER_xQueueTakeMutexRecursive( xMutex, xTicksToWait );
+
+        configASSERT( pxMutex );
+
+        /* Comments regarding mutual exclusion as per those within
+         * xQueueGiveMutexRecursive(). */
+
+        traceTAKE_MUTEX_RECURSIVE( pxMutex );
+
+        if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+        {
+            ( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = xQueueSemaphoreTake( pxMutex, xTicksToWait );
+
+            /* pdPASS will only be returned if the mutex was successfully
+             * obtained.  The calling task may have entered the Blocked state
+             * before reaching here. */
+            if( xReturn != pdFAIL )
+            {
+                ( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
+            }
+            else
+            {
+                traceTAKE_MUTEX_RECURSIVE_FAILED( pxMutex );
+            }
+        }
+
+        traceRETURN_xQueueTakeMutexRecursive( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_RECURSIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
+                                                       const UBaseType_t uxInitialCount,
+                                                       StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+
+        if( ( uxMaxCount != 0U ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle );
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
+                                                 const UBaseType_t uxInitialCount )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount );
+
+        if( ( uxMaxCount != 0U ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCountingSemaphore( xHandle );
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
+                              const void * const pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition )
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
+    traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
     #endif
 
     for( ; ; )
     {
         taskENTER_CRITICAL();
         {
+            #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+            {
+                /* Make room by discarding expired items rather than waiting
+                 * for the receiver to discard them. */
+                if( ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) && ( prvDiscardExpiredItems( pxQueue ) != pdFALSE ) )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
             /* Is there room on the queue now?  The running task must be the
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
@@ -968,6 +1463,19 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             {
                 traceQUEUE_SEND( pxQueue );
 
+                #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+                {
+                    if( xEntryTimeSet != pdFALSE )
+                    {
+                        prvRecordBlockedTime( pxQueue, xBlockedSince, pdTRUE );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_PERF_COUNTERS */
+
                 #if ( configUSE_QUEUE_SETS == 1 )
                 {
                     const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1091,6 +1599,12 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                      * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+
+                    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+                    {
+                        xBlockedSince = xTimeOut.xTimeOnEntering;
+                    }
+                    #endif /* configUSE_QUEUE_PERF_COUNTERS */
                 }
                 else
                 {
@@ -1145,6 +1659,16 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
+            #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+            {
+                taskENTER_CRITICAL();
+                {
+                    prvRecordBlockedTime( pxQueue, xBlockedSince, pdTRUE );
+                }
+                taskEXIT_CRITICAL();
+            }
+            #endif /* configUSE_QUEUE_PERF_COUNTERS */
+
             traceQUEUE_SEND_FAILED( pxQueue );
             traceRETURN_xQueueGenericSend( errQUEUE_FULL );
 
@@ -1154,6 +1678,37 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+
+    BaseType_t xQueueGenericSendUs( QueueHandle_t xQueue,
+                                    const void * const pvItemToQueue,
+                                    uint32_t ulTimeoutUs,
+                                    const BaseType_t xCopyPosition )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xQueueGenericSendUs( xQueue, pvItemToQueue, ulTimeoutUs, xCopyPosition );
+
+        if( ulTimeoutUs == 0U )
+        {
+            xReturn = xQueueGenericSend( xQueue, pvItemToQueue, ( TickType_t ) 0U, xCopyPosition );
+        }
+        else
+        {
+            /* The task's wake timer ends the block at the microsecond timeout,
+             * xQueueGenericSend() sees it as an aborted delay. */
+            xReturn = xQueueGenericSend( xQueue, pvItemToQueue, xTaskBeginTimeoutUs( ullISRTimerGetTimeUs() + ulTimeoutUs ), xCopyPosition );
+            vTaskEndTimeoutUs();
+        }
+
+        traceRETURN_xQueueGenericSendUs( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_HIGH_RES_TIMEOUTS */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                                      const void * const pvItemToQueue,
                                      BaseType_t * const pxHigherPriorityTaskWoken,
@@ -1195,6 +1750,21 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     /* coverity[misra_c_2012_directive_4_7_violation] */
     uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
+        #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        {
+            if( ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) &&
+                ( prvDiscardExpiredItems( pxQueue ) != pdFALSE ) &&
+                ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
         if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
@@ -1507,6 +2077,10 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
     traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait );
 
     /* Check the pointer is not NULL. */
@@ -1527,7 +2101,23 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
     {
         taskENTER_CRITICAL();
         {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+            UBaseType_t uxMessagesWaiting;
+
+            #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+            {
+                /* Expired items are discarded without being copied out. */
+                if( prvDiscardExpiredItems( pxQueue ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+            uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
             /* Is there data in the queue now?  To be running the calling task
              * must be the highest priority task wanting to access the queue. */
@@ -1538,6 +2128,49 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 traceQUEUE_RECEIVE( pxQueue );
                 pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
 
+                #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+                {
+                    prvRecordItemAge( pxQueue );
+                }
+                #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+                #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+                {
+                    pxQueue->xPerfCounters.ulReceives++;
+
+                    if( xEntryTimeSet != pdFALSE )
+                    {
+                        prvRecordBlockedTime( pxQueue, xBlockedSince, pdFALSE );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_PERF_COUNTERS */
+
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    /* A queue set member is only posted to its set once until
+                     * it is selected, so post it again if data remains. */
+                    if( ( pxQueue->pxQueueSetContainer != NULL ) && ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) )
+                    {
+                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+
                 /* There is now space in the queue, were any tasks waiting to
                  * post to the queue?  If so, unblock the highest priority waiting
                  * task. */
@@ -1582,6 +2215,12 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                      * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+
+                    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+                    {
+                        xBlockedSince = xTimeOut.xTimeOnEntering;
+                    }
+                    #endif /* configUSE_QUEUE_PERF_COUNTERS */
                 }
                 else
                 {
@@ -1635,6 +2274,16 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
+                #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        prvRecordBlockedTime( pxQueue, xBlockedSince, pdFALSE );
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                #endif /* configUSE_QUEUE_PERF_COUNTERS */
+
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
                 traceRETURN_xQueueReceive( errQUEUE_EMPTY );
 
@@ -1649,6 +2298,34 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+
+    BaseType_t xQueueReceiveUs( QueueHandle_t xQueue,
+                                void * const pvBuffer,
+                                uint32_t ulTimeoutUs )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xQueueReceiveUs( xQueue, pvBuffer, ulTimeoutUs );
+
+        if( ulTimeoutUs == 0U )
+        {
+            xReturn = xQueueReceive( xQueue, pvBuffer, ( TickType_t ) 0U );
+        }
+        else
+        {
+            xReturn = xQueueReceive( xQueue, pvBuffer, xTaskBeginTimeoutUs( ullISRTimerGetTimeUs() + ulTimeoutUs ) );
+            vTaskEndTimeoutUs();
+        }
+
+        traceRETURN_xQueueReceiveUs( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_HIGH_RES_TIMEOUTS */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait )
 {
@@ -1656,6 +2333,10 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+        TickType_t xBlockedSince = ( TickType_t ) 0;
+    #endif
+
     #if ( configUSE_MUTEXES == 1 )
         BaseType_t xInheritanceOccurred = pdFALSE;
     #endif
@@ -1694,6 +2375,44 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                  * messages waiting is the semaphore's count.  Reduce the count. */
                 pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - ( UBaseType_t ) 1 );
 
+                #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+                {
+                    pxQueue->xPerfCounters.ulReceives++;
+
+                    if( xEntryTimeSet != pdFALSE )
+                    {
+                        prvRecordBlockedTime( pxQueue, xBlockedSince, pdFALSE );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_PERF_COUNTERS */
+
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    /* A queue set member is only posted to its set once until
+                     * it is selected, so post it again if the semaphore can
+                     * still be taken. */
+                    if( ( pxQueue->pxQueueSetContainer != NULL ) && ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) )
+                    {
+                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+
                 #if ( configUSE_MUTEXES == 1 )
                 {
                     if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
@@ -1752,6 +2471,12 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                      * so configure the timeout structure ready to block. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+
+                    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+                    {
+                        xBlockedSince = xTimeOut.xTimeOnEntering;
+                    }
+                    #endif /* configUSE_QUEUE_PERF_COUNTERS */
                 }
                 else
                 {
@@ -1860,6 +2585,16 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_MUTEXES */
 
+                #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        prvRecordBlockedTime( pxQueue, xBlockedSince, pdFALSE );
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                #endif /* configUSE_QUEUE_PERF_COUNTERS */
+
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
                 traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
 
@@ -1874,6 +2609,36 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+
+    BaseType_t xQueueSemaphoreTakeUs( QueueHandle_t xQueue,
+                                      uint32_t ulTimeoutUs )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xQueueSemaphoreTakeUs( xQueue, ulTimeoutUs );
+
+        if( ulTimeoutUs == 0U )
+        {
+            xReturn = xQueueSemaphoreTake( xQueue, ( TickType_t ) 0U );
+        }
+        else
+        {
+            /* A timeout ended by the wake timer is handled by
+             * xQueueSemaphoreTake() like any other, so priority
+             * disinheritance still takes place. */
+            xReturn = xQueueSemaphoreTake( xQueue, xTaskBeginTimeoutUs( ullISRTimerGetTimeUs() + ulTimeoutUs ) );
+            vTaskEndTimeoutUs();
+        }
+
+        traceRETURN_xQueueSemaphoreTakeUs( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_HIGH_RES_TIMEOUTS */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueuePeek( QueueHandle_t xQueue,
                        void * const pvBuffer,
                        TickType_t xTicksToWait )
@@ -1903,22 +2668,47 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
     {
         taskENTER_CRITICAL();
         {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+            UBaseType_t uxMessagesWaiting;
+
+            #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+            {
+                if( prvDiscardExpiredItems( pxQueue ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+            uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
             /* Is there data in the queue now?  To be running the calling task
              * must be the highest priority task wanting to access the queue. */
             if( uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+                #if ( configUSE_PRIORITY_QUEUES == 1 )
+                    if( pxQueue->ucPriorityLevels != ( uint8_t ) 0U )
+                    {
+                        prvCopyDataFromPriorityQueue( pxQueue, pvBuffer, pdFALSE );
+                        traceQUEUE_PEEK( pxQueue );
+                    }
+                    else
+                #endif /* configUSE_PRIORITY_QUEUES */
+                {
+                    /* Remember the read position so it can be reset after the data
+                     * is read from the queue as this function is only peeking the
+                     * data, not removing it. */
+                    pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
 
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_PEEK( pxQueue );
+                    prvCopyDataFromQueue( pxQueue, pvBuffer );
+                    traceQUEUE_PEEK( pxQueue );
 
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+                    /* The data is not being removed, so reset the read pointer. */
+                    pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+                }
 
                 /* The data is being left in the queue, so see if there are
                  * any other tasks waiting for the data. */
@@ -2032,18 +2822,169 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
-                                 void * const pvBuffer,
-                                 BaseType_t * const pxHigherPriorityTaskWoken )
+BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    {
+        UBaseType_t uxMessagesWaiting;
+
+        #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        {
+            /* Expired items are discarded without being copied out. */
+            if( ( prvDiscardExpiredItems( pxQueue ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+        uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* Cannot block in an ISR, so check there is data available. */
+        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+            #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+            {
+                prvRecordItemAge( pxQueue );
+            }
+            #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+            #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+            {
+                pxQueue->xPerfCounters.ulReceives++;
+            }
+            #endif /* configUSE_QUEUE_PERF_COUNTERS */
+
+            #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                /* A queue set member is only posted to its set once until it
+                 * is selected, so post it again if data remains. */
+                if( ( pxQueue->pxQueueSetContainer != NULL ) && ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) )
+                {
+                    if( ( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_QUEUE_SETS */
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that an ISR has removed data while the queue was
+             * locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority than us so
+                         * force a context switch. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was removed while it was locked. */
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    traceRETURN_xQueueReceiveFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer )
 {
     BaseType_t xReturn;
     UBaseType_t uxSavedInterruptStatus;
+    int8_t * pcOriginalReadPosition;
     Queue_t * const pxQueue = xQueue;
 
-    traceENTER_xQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken );
+    traceENTER_xQueuePeekFromISR( xQueue, pvBuffer );
 
     configASSERT( pxQueue );
     configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
 
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -2066,397 +3007,738 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
     /* coverity[misra_c_2012_directive_4_7_violation] */
     uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
-        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
-
         /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
         {
-            const int8_t cRxLock = pxQueue->cRxLock;
-
-            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
-
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+            traceQUEUE_PEEK_FROM_ISR( pxQueue );
 
-            /* If the queue is locked the event list will not be modified.
-             * Instead update the lock count so the task that unlocks the queue
-             * will know that an ISR has removed data while the queue was
-             * locked. */
-            if( cRxLock == queueUNLOCKED )
-            {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            #if ( configUSE_PRIORITY_QUEUES == 1 )
+                if( pxQueue->ucPriorityLevels != ( uint8_t ) 0U )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority than us so
-                         * force a context switch. */
-                        if( pxHigherPriorityTaskWoken != NULL )
-                        {
-                            *pxHigherPriorityTaskWoken = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    prvCopyDataFromPriorityQueue( pxQueue, pvBuffer, pdFALSE );
                 }
                 else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
+            #endif /* configUSE_PRIORITY_QUEUES */
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was removed while it was locked. */
-                prvIncrementQueueRxLock( pxQueue, cRxLock );
+                /* Remember the read position so it can be reset as nothing is
+                 * actually being removed from the queue. */
+                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
             }
 
             xReturn = pdPASS;
         }
         else
         {
-            xReturn = pdFAIL;
-            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            xReturn = pdFAIL;
+            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    traceRETURN_xQueuePeekFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    traceENTER_uxQueueMessagesWaiting( xQueue );
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    traceRETURN_uxQueueMessagesWaiting( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueSpacesAvailable( xQueue );
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+    }
+    taskEXIT_CRITICAL();
+
+    traceRETURN_uxQueueSpacesAvailable( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueMessagesWaitingFromISR( xQueue );
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    traceRETURN_uxQueueMessagesWaitingFromISR( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_vQueueDelete( xQueue );
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        poolFREE( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            poolFREE( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+    traceRETURN_vQueueDelete();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        traceENTER_uxQueueGetQueueNumber( xQueue );
+
+        traceRETURN_uxQueueGetQueueNumber( ( ( Queue_t * ) xQueue )->uxQueueNumber );
+
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber );
+
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+
+        traceRETURN_vQueueSetQueueNumber();
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        traceENTER_ucQueueGetQueueType( xQueue );
+
+        traceRETURN_ucQueueGetQueueType( ( ( Queue_t * ) xQueue )->ucQueueType );
+
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+{
+    traceENTER_uxQueueGetQueueItemSize( xQueue );
+
+    traceRETURN_uxQueueGetQueueItemSize( ( ( Queue_t * ) xQueue )->uxItemSize );
+
+    return ( ( Queue_t * ) xQueue )->uxItemSize;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+{
+    traceENTER_uxQueueGetQueueLength( xQueue );
+
+    traceRETURN_uxQueueGetQueueLength( ( ( Queue_t * ) xQueue )->uxLength );
+
+    return ( ( Queue_t * ) xQueue )->uxLength;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
         }
-    }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
-    traceRETURN_xQueueReceiveFromISR( xReturn );
+        return uxHighestPriorityOfWaitingTasks;
+    }
 
-    return xReturn;
-}
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
-                              void * const pvBuffer )
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      const BaseType_t xPosition )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
-    Queue_t * const pxQueue = xQueue;
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxMessagesWaiting;
 
-    traceENTER_xQueuePeekFromISR( xQueue, pvBuffer );
+    /* This function is called from a critical section. */
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    {
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            {
+                /* The mutex is no longer being held. */
+                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MUTEXES */
+    }
 
-    /* MISRA Ref 4.7.1 [Return value shall be checked] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
-    /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        else if( pxQueue->ucPriorityLevels != ( uint8_t ) 0U )
+        {
+            prvCopyDataToPriorityQueue( pxQueue, pvItemToQueue, xPosition );
+
+            if( ( xPosition == queueOVERWRITE ) && ( uxMessagesWaiting > ( UBaseType_t ) 0 ) )
+            {
+                /* The existing item was discarded, so the number of items
+                 * does not change. */
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif /* configUSE_PRIORITY_QUEUES */
+    else if( xPosition == queueSEND_TO_BACK )
     {
-        /* Cannot block in an ISR, so check there is data available. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
         {
-            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+            if( pxQueue->pxItemTimes != NULL )
+            {
+                pxQueue->pxItemTimes[ queueITEM_SLOT( pxQueue, pxQueue->pcWriteTo ) ] = queueGET_ITEM_TIME();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMESTAMPED_MESSAGES */
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        pxQueue->pcWriteTo += pxQueue->uxItemSize;
 
-            xReturn = pdPASS;
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
         }
         else
         {
-            xReturn = pdFAIL;
-            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    else
+    {
+        /* Items can only be sent with a priority to a priority queue. */
+        configASSERT( xPosition <= queueOVERWRITE );
 
-    traceRETURN_xQueuePeekFromISR( xReturn );
+        #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        {
+            if( pxQueue->pxItemTimes != NULL )
+            {
+                pxQueue->pxItemTimes[ queueITEM_SLOT( pxQueue, pxQueue->u.xQueue.pcReadFrom ) ] = queueGET_ITEM_TIME();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMESTAMPED_MESSAGES */
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
+        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead )
+        {
+            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    traceENTER_uxQueueMessagesWaiting( xQueue );
+        if( xPosition == queueOVERWRITE )
+        {
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* An item is not being added but overwritten, so subtract
+                 * one from the recorded number of items in the queue so when
+                 * one is added again below the number of recorded items remains
+                 * correct. */
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
 
-    configASSERT( xQueue );
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
 
-    taskENTER_CRITICAL();
+    #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+        pxQueue->xPerfCounters.ulSends++;
 
-    traceRETURN_uxQueueMessagesWaiting( uxReturn );
+        if( pxQueue->uxMessagesWaiting > pxQueue->xPerfCounters.uxHighWaterMark )
+        {
+            pxQueue->xPerfCounters.uxHighWaterMark = pxQueue->uxMessagesWaiting;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_QUEUE_PERF_COUNTERS */
 
-    return uxReturn;
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+static void prvCopyDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
 {
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
-
-    traceENTER_uxQueueSpacesAvailable( xQueue );
-
-    configASSERT( pxQueue );
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        if( pxQueue->ucPriorityLevels != ( uint8_t ) 0U )
+        {
+            prvCopyDataFromPriorityQueue( pxQueue, pvBuffer, pdTRUE );
+        }
+        else
+    #endif /* configUSE_PRIORITY_QUEUES */
 
-    taskENTER_CRITICAL();
+    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
     {
-        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
-    }
-    taskEXIT_CRITICAL();
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
 
-    traceRETURN_uxQueueSpacesAvailable( uxReturn );
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    return uxReturn;
+        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize );
+    }
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
-
-    traceENTER_uxQueueMessagesWaitingFromISR( xQueue );
-
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
-
-    traceRETURN_uxQueueMessagesWaitingFromISR( uxReturn );
+#if ( configUSE_PRIORITY_QUEUES == 1 )
 
-    return uxReturn;
-}
-/*-----------------------------------------------------------*/
+    static void prvCopyDataToPriorityQueue( Queue_t * const pxQueue,
+                                            const void * pvItemToQueue,
+                                            const BaseType_t xPosition )
+    {
+        PriorityQueueControl_t * const pxControl = prvPRIORITY_QUEUE_CONTROL( pxQueue );
+        PriorityQueueLevel_t * pxLevel;
+        UBaseType_t uxPriority;
+        UBaseType_t uxSlot;
+        UBaseType_t * puxSlot;
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
+        /* This function is called from a critical section. */
 
-    traceENTER_vQueueDelete( xQueue );
+        if( xPosition == queueOVERWRITE )
+        {
+            /* Overwriting is only valid for a queue of length 1, so discard
+             * the item (if any) then post the new item at the lowest
+             * priority. */
+            if( pxControl->uxReadyLevels != ( UBaseType_t ) 0U )
+            {
+                prvCopyDataFromPriorityQueue( pxQueue, NULL, pdTRUE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+            uxPriority = ( UBaseType_t ) 0U;
+        }
+        else if( xPosition == queueSEND_TO_FRONT )
+        {
+            uxPriority = ( UBaseType_t ) pxQueue->ucPriorityLevels - ( UBaseType_t ) 1U;
+        }
+        else if( xPosition == queueSEND_TO_BACK )
+        {
+            uxPriority = ( UBaseType_t ) 0U;
+        }
+        else
+        {
+            uxPriority = ( UBaseType_t ) ( xPosition - queueSEND_WITH_PRIORITY( 0 ) );
+        }
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
-    {
-        vQueueUnregisterQueue( pxQueue );
-    }
-    #endif
+        configASSERT( uxPriority < ( UBaseType_t ) pxQueue->ucPriorityLevels );
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-    {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        /* The calling function has already checked there is space in the
+         * queue, so a slot is always available. */
+        if( pxControl->uxFreeSlot != queuePRIORITY_NO_SLOT )
         {
-            vPortFree( pxQueue );
+            uxSlot = pxControl->uxFreeSlot;
+            pxControl->uxFreeSlot = *prvPRIORITY_QUEUE_SLOT( pxQueue, uxSlot );
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            configASSERT( pxControl->uxUnusedSlot < pxQueue->uxLength );
+            uxSlot = pxControl->uxUnusedSlot;
+            pxControl->uxUnusedSlot++;
+        }
+
+        puxSlot = prvPRIORITY_QUEUE_SLOT( pxQueue, uxSlot );
+        ( void ) memcpy( ( void * ) &( puxSlot[ 1 ] ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+
+        pxLevel = &( prvPRIORITY_QUEUE_LEVELS( pxQueue )[ uxPriority ] );
+
+        if( ( pxControl->uxReadyLevels & ( ( UBaseType_t ) 1U << uxPriority ) ) == ( UBaseType_t ) 0U )
+        {
+            /* This is the only item of its priority. */
+            puxSlot[ 0 ] = queuePRIORITY_NO_SLOT;
+            pxLevel->uxHead = uxSlot;
+            pxLevel->uxTail = uxSlot;
+            pxControl->uxReadyLevels |= ( ( UBaseType_t ) 1U << uxPriority );
+        }
+        else if( xPosition == queueSEND_TO_FRONT )
+        {
+            puxSlot[ 0 ] = pxLevel->uxHead;
+            pxLevel->uxHead = uxSlot;
+        }
+        else
+        {
+            puxSlot[ 0 ] = queuePRIORITY_NO_SLOT;
+            *prvPRIORITY_QUEUE_SLOT( pxQueue, pxLevel->uxTail ) = uxSlot;
+            pxLevel->uxTail = uxSlot;
         }
     }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
-    {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
-    }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 
-    traceRETURN_vQueueDelete();
-}
+#endif /* configUSE_PRIORITY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_PRIORITY_QUEUES == 1 )
 
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    static void prvCopyDataFromPriorityQueue( Queue_t * const pxQueue,
+                                              void * const pvBuffer,
+                                              const BaseType_t xRemove )
     {
-        traceENTER_uxQueueGetQueueNumber( xQueue );
+        PriorityQueueControl_t * const pxControl = prvPRIORITY_QUEUE_CONTROL( pxQueue );
+        PriorityQueueLevel_t * pxLevel;
+        UBaseType_t uxTopPriority;
+        UBaseType_t uxSlot;
+        UBaseType_t * puxSlot;
 
-        traceRETURN_uxQueueGetQueueNumber( ( ( Queue_t * ) xQueue )->uxQueueNumber );
+        /* This function is called from a critical section, and only when the
+         * queue contains at least one item. */
+        configASSERT( pxControl->uxReadyLevels != ( UBaseType_t ) 0U );
 
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
+        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+        {
+            portGET_HIGHEST_PRIORITY( uxTopPriority, pxControl->uxReadyLevels );
+        }
+        #else
+        {
+            uxTopPriority = ( UBaseType_t ) pxQueue->ucPriorityLevels - ( UBaseType_t ) 1U;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+            while( ( pxControl->uxReadyLevels & ( ( UBaseType_t ) 1U << uxTopPriority ) ) == ( UBaseType_t ) 0U )
+            {
+                --uxTopPriority;
+            }
+        }
+        #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+        pxLevel = &( prvPRIORITY_QUEUE_LEVELS( pxQueue )[ uxTopPriority ] );
+        uxSlot = pxLevel->uxHead;
+        puxSlot = prvPRIORITY_QUEUE_SLOT( pxQueue, uxSlot );
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
-    {
-        traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber );
+        if( pvBuffer != NULL )
+        {
+            ( void ) memcpy( pvBuffer, ( void * ) &( puxSlot[ 1 ] ), ( size_t ) pxQueue->uxItemSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+        if( xRemove != pdFALSE )
+        {
+            if( uxSlot == pxLevel->uxTail )
+            {
+                /* That was the last item of its priority. */
+                pxControl->uxReadyLevels &= ~( ( UBaseType_t ) 1U << uxTopPriority );
+            }
+            else
+            {
+                pxLevel->uxHead = puxSlot[ 0 ];
+            }
 
-        traceRETURN_vQueueSetQueueNumber();
+            puxSlot[ 0 ] = pxControl->uxFreeSlot;
+            pxControl->uxFreeSlot = uxSlot;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_PRIORITY_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_PRIORITY_QUEUES == 1 )
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    static void prvResetPriorityQueue( Queue_t * const pxQueue )
     {
-        traceENTER_ucQueueGetQueueType( xQueue );
-
-        traceRETURN_ucQueueGetQueueType( ( ( Queue_t * ) xQueue )->ucQueueType );
+        PriorityQueueControl_t * const pxControl = prvPRIORITY_QUEUE_CONTROL( pxQueue );
 
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
+        /* The head and tail of a priority are only read while its bit is set
+         * in uxReadyLevels, so they do not need to be cleared. */
+        pxControl->uxReadyLevels = ( UBaseType_t ) 0U;
+        pxControl->uxFreeSlot = queuePRIORITY_NO_SLOT;
+        pxControl->uxUnusedSlot = ( UBaseType_t ) 0U;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_PRIORITY_QUEUES */
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
-{
-    traceENTER_uxQueueGetQueueItemSize( xQueue );
-
-    traceRETURN_uxQueueGetQueueItemSize( ( ( Queue_t * ) xQueue )->uxItemSize );
-
-    return ( ( Queue_t * ) xQueue )->uxItemSize;
-}
-/*-----------------------------------------------------------*/
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
 
-UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
-{
-    traceENTER_uxQueueGetQueueLength( xQueue );
+    static BaseType_t prvDiscardExpiredItems( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+        BaseType_t xExpired = pdTRUE;
+        TickType_t xTimeNow;
+        int8_t * pcNextReadFrom;
 
-    traceRETURN_uxQueueGetQueueLength( ( ( Queue_t * ) xQueue )->uxLength );
+        /* This function is called from a critical section. */
 
-    return ( ( Queue_t * ) xQueue )->uxLength;
-}
-/*-----------------------------------------------------------*/
+        if( pxQueue->pxItemTimes != NULL )
+        {
+            xTimeNow = queueGET_ITEM_TIME();
 
-#if ( configUSE_MUTEXES == 1 )
+            while( ( xExpired != pdFALSE ) && ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) )
+            {
+                /* The item at the front of the queue is the one after the
+                 * last read position. */
+                pcNextReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
-    {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+                if( pcNextReadFrom >= pxQueue->u.xQueue.pcTail )
+                {
+                    pcNextReadFrom = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
-        {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+                if( ( TickType_t ) ( xTimeNow - pxQueue->pxItemTimes[ queueITEM_SLOT( pxQueue, pcNextReadFrom ) ] ) <= pxQueue->xMaxItemAge )
+                {
+                    /* Items are discarded in order from the front of the
+                     * queue, so stop at the first item that has not expired. */
+                    xExpired = pdFALSE;
+                }
+                else
+                {
+                    const int8_t cRxLock = pxQueue->cRxLock;
+
+                    /* Remove the expired item without copying it out. */
+                    traceQUEUE_ITEM_EXPIRED( pxQueue );
+                    pxQueue->u.xQueue.pcReadFrom = pcNextReadFrom;
+                    pxQueue->uxMessagesWaiting--;
+                    pxQueue->xAgeStats.uxItemsExpired++;
+
+                    /* There is now space in the queue, so unblock a task that
+                     * is waiting to send, or let the task that locked the
+                     * queue know that it must do so. */
+                    if( cRxLock == queueUNLOCKED )
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                            {
+                                xReturn = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    }
+                }
+            }
         }
         else
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return uxHighestPriorityOfWaitingTasks;
+        return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TIMESTAMPED_MESSAGES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
-                                      const void * pvItemToQueue,
-                                      const BaseType_t xPosition )
-{
-    BaseType_t xReturn = pdFALSE;
-    UBaseType_t uxMessagesWaiting;
+#if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
 
-    /* This function is called from a critical section. */
+    static void prvRecordItemAge( Queue_t * const pxQueue )
+    {
+        TickType_t xAge;
 
-    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        /* This function is called from a critical section. */
 
-    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
-    {
-        #if ( configUSE_MUTEXES == 1 )
+        if( pxQueue->pxItemTimes != NULL )
         {
-            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            xAge = ( TickType_t ) ( queueGET_ITEM_TIME() - pxQueue->pxItemTimes[ queueITEM_SLOT( pxQueue, pxQueue->u.xQueue.pcReadFrom ) ] );
+
+            pxQueue->xAgeStats.uxItemsReceived++;
+            pxQueue->xAgeStats.xTotalAge += xAge;
+
+            if( xAge > pxQueue->xAgeStats.xMaxAge )
             {
-                /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                pxQueue->xAgeStats.xMaxAge = xAge;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-        #endif /* configUSE_MUTEXES */
-    }
-    else if( xPosition == queueSEND_TO_BACK )
-    {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
-        pxQueue->pcWriteTo += pxQueue->uxItemSize;
 
-        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
-        {
-            pxQueue->pcWriteTo = pxQueue->pcHead;
+            #if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+            {
+                UBaseType_t uxBucket = ( UBaseType_t ) 0;
+
+                /* Bucket n counts ages of 2^(n-1) to (2^n)-1 ticks. */
+                while( ( xAge != ( TickType_t ) 0 ) && ( uxBucket < ( UBaseType_t ) ( configQUEUE_PERF_HISTOGRAM_BUCKETS - 1 ) ) )
+                {
+                    xAge >>= 1;
+                    uxBucket++;
+                }
+
+                pxQueue->xPerfCounters.ulResidenceHistogram[ uxBucket ]++;
+            }
+            #endif /* configUSE_QUEUE_PERF_COUNTERS */
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
-    else
+
+#endif /* configUSE_TIMESTAMPED_MESSAGES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+
+    static void prvRecordBlockedTime( Queue_t * const pxQueue,
+                                      const TickType_t xBlockedSince,
+                                      const BaseType_t xIsSend )
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
-        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+        const TickType_t xBlockedTime = xTaskGetTickCount() - xBlockedSince;
 
-        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead )
+        /* This function is called from a critical section. */
+
+        if( xIsSend != pdFALSE )
         {
-            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+            pxQueue->xPerfCounters.ulBlockedSends++;
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            pxQueue->xPerfCounters.ulBlockedReceives++;
         }
 
-        if( xPosition == queueOVERWRITE )
+        pxQueue->xPerfCounters.xTotalBlockedTime += xBlockedTime;
+
+        if( xBlockedTime > pxQueue->xPerfCounters.xMaxBlockedTime )
         {
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
-            {
-                /* An item is not being added but overwritten, so subtract
-                 * one from the recorded number of items in the queue so when
-                 * one is added again below the number of recorded items remains
-                 * correct. */
-                --uxMessagesWaiting;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            pxQueue->xPerfCounters.xMaxBlockedTime = xBlockedTime;
         }
         else
         {
@@ -2464,31 +3746,42 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
         }
     }
 
-    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
-
-    return xReturn;
-}
+#endif /* configUSE_QUEUE_PERF_COUNTERS */
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue,
-                                  void * const pvBuffer )
-{
-    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+#if ( configUSE_QUEUE_PERF_COUNTERS == 1 )
+
+    void vQueueGetPerfCounters( QueueHandle_t xQueue,
+                                QueuePerfCounters_t * pxCounters,
+                                BaseType_t xReset )
     {
-        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+        Queue_t * const pxQueue = xQueue;
 
-        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
-        {
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
-        }
-        else
+        traceENTER_vQueueGetPerfCounters( xQueue, pxCounters, xReset );
+
+        configASSERT( pxQueue );
+        configASSERT( pxCounters );
+
+        taskENTER_CRITICAL();
         {
-            mtCOVERAGE_TEST_MARKER();
+            *pxCounters = pxQueue->xPerfCounters;
+
+            if( xReset != pdFALSE )
+            {
+                ( void ) memset( ( void * ) &( pxQueue->xPerfCounters ), 0x00, sizeof( QueuePerfCounters_t ) );
+                pxQueue->xPerfCounters.uxHighWaterMark = pxQueue->uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
+        taskEXIT_CRITICAL();
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize );
+        traceRETURN_vQueueGetPerfCounters();
     }
-}
+
+#endif /* configUSE_QUEUE_PERF_COUNTERS */
 /*-----------------------------------------------------------*/
 
 static void prvUnlockQueue( Queue_t * const pxQueue )
@@ -3090,6 +4383,50 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    BaseType_t xQueueGetNextRegistryEntry( UBaseType_t * puxIndex,
+                                           QueueHandle_t * pxQueue,
+                                           const char ** ppcQueueName )
+    {
+        UBaseType_t ux;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xQueueGetNextRegistryEntry( puxIndex, pxQueue, ppcQueueName );
+
+        configASSERT( puxIndex );
+        configASSERT( pxQueue );
+        configASSERT( ppcQueueName );
+
+        /* Note there is nothing here to protect against another task adding or
+         * removing entries from the registry while it is being searched.  A
+         * NULL name denotes a free slot. */
+        for( ux = *puxIndex; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        {
+            if( xQueueRegistry[ ux ].pcQueueName != NULL )
+            {
+                *pxQueue = xQueueRegistry[ ux ].xHandle;
+                *ppcQueueName = xQueueRegistry[ ux ].pcQueueName;
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        /* Continue from the entry after the one found next time. */
+        *puxIndex = ux + ( UBaseType_t ) 1U;
+
+        traceRETURN_xQueueGetNextRegistryEntry( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
 #if ( configQUEUE_REGISTRY_SIZE > 0 )
 
     void vQueueUnregisterQueue( QueueHandle_t xQueue )
@@ -3255,6 +4592,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             {
                 /* The queue is no longer contained in the set. */
                 pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+                pxQueueOrSemaphore->ucPostedToQueueSet = ( uint8_t ) pdFALSE;
             }
             taskEXIT_CRITICAL();
             xReturn = pdPASS;
@@ -3277,7 +4615,17 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueSelectFromSet( xQueueSet, xTicksToWait );
 
-        ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait );
+        if( xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ) != pdFALSE )
+        {
+            /* The member can be posted to the set again.  If it still holds
+             * data once the caller has read from it then it is re-posted by
+             * the read itself. */
+            taskENTER_CRITICAL();
+            {
+                ( ( Queue_t * ) xReturn )->ucPostedToQueueSet = ( uint8_t ) pdFALSE;
+            }
+            taskEXIT_CRITICAL();
+        }
 
         traceRETURN_xQueueSelectFromSet( xReturn );
 
@@ -3295,7 +4643,16 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueSelectFromSetFromISR( xQueueSet );
 
-        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
+        if( xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL ) != pdFALSE )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+
+            uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+            {
+                ( ( Queue_t * ) xReturn )->ucPostedToQueueSet = ( uint8_t ) pdFALSE;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
 
         traceRETURN_xQueueSelectFromSetFromISR( xReturn );
 
@@ -3307,7 +4664,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
 #if ( configUSE_QUEUE_SETS == 1 )
 
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue )
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue )
     {
         Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
         BaseType_t xReturn = pdFALSE;
@@ -3318,9 +4675,15 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * to prvNotifyQueueSetContainer is preceded by a check that
          * pxQueueSetContainer != NULL */
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
-        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        if( pxQueue->ucPostedToQueueSet != ( uint8_t ) pdFALSE )
+        {
+            /* The handle of the queue is already waiting to be selected from
+             * the set, and a task that selects it will find all the data now
+             * in the queue, so there is nothing to post. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+        else if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
         {
             const int8_t cTxLock = pxQueueSetContainer->cTxLock;
 
@@ -3328,6 +4691,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
             /* The data copied is the handle of the queue that contains data. */
             xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+            pxQueue->ucPostedToQueueSet = ( uint8_t ) pdTRUE;
 
             if( cTxLock == queueUNLOCKED )
             {
@@ -3355,7 +4719,9 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* Each member occupies at most one space in the set, so the set
+             * can only be full if it holds more members than its length. */
+            configASSERT( pdFALSE );
         }
 
         return xReturn;
@@ -221,10 +221,23 @@
 /* The number of bytes used to hold the length of a message in the buffer. */
     #define sbBYTES_TO_STORE_MESSAGE_LENGTH    ( sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) )
 
+/* The number of bytes stored in front of each message - the length of the
+ * message followed, if the message buffer is timestamped, by the tick count at
+ * which the message was sent. */
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        #define sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer )                                   \
+    ( sbBYTES_TO_STORE_MESSAGE_LENGTH +                                                             \
+      ( ( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_TIMESTAMPED ) != ( uint8_t ) 0 ) ? sizeof( TickType_t ) : ( size_t ) 0 ) )
+    #else
+        #define sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer )    sbBYTES_TO_STORE_MESSAGE_LENGTH
+    #endif
+
 /* Bits stored in the ucFlags field of the stream buffer. */
     #define sbFLAGS_IS_MESSAGE_BUFFER          ( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
     #define sbFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
     #define sbFLAGS_IS_BATCHING_BUFFER         ( ( uint8_t ) 4 ) /* Set if the stream buffer was created as a batching buffer, meaning the receiver task will only unblock when the trigger level exceededs. */
+    #define sbFLAGS_IS_TIMESTAMPED             ( ( uint8_t ) 8 ) /* Set if each message in the message buffer is stored with the tick count at which it was sent, so messages older than xMaxMessageAge can be discarded. */
+    #define sbFLAGS_IS_OVERWRITING             ( ( uint8_t ) 16 ) /* Set if the buffer is in overwrite mode, meaning the oldest data is discarded to make space for new data rather than the writer waiting for space. */
 
 /*-----------------------------------------------------------*/
 
@@ -249,6 +262,16 @@ typedef struct StreamBufferDef_t
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
     UBaseType_t uxNotificationIndex;                               /* The index we are using for notification, by default tskDEFAULT_INDEX_TO_NOTIFY. */
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        TickType_t xMaxMessageAge;          /* Messages that have been in a timestamped message buffer for more than this number of ticks are discarded rather than received. */
+        StreamBufferAgeStats_t xAgeStats;   /* Statistics on the age of the messages that left a timestamped message buffer. */
+    #endif
+
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+        size_t xBytesDropped;          /* The number of bytes discarded, in overwrite mode, to make space for new data. */
+        UBaseType_t uxMessagesDropped; /* The number of messages discarded, in overwrite mode, to make space for new messages. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -277,10 +300,14 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
  * message out of the buffer.  If the stream buffer is being used as a stream
  * buffer then read as many bytes as possible from the buffer.
  * prvReadBytesFromBuffer() is called to actually extract the bytes from the
- * buffer's data storage area.
+ * buffer's data storage area.  The bytes are read into pvRxData, or scattered
+ * across the xVectorCount buffers described by pxVectors if pxVectors is not
+ * NULL.
  */
 static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                         void * pvRxData,
+                                        const StreamBufferVector_t * pxVectors,
+                                        size_t xVectorCount,
                                         size_t xBufferLengthBytes,
                                         size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
 
@@ -289,14 +316,67 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
  * message to the buffer.  If the stream buffer is being used as a stream
  * buffer then write as many bytes as possible to the buffer.
  * prvWriteBytestoBuffer() is called to actually send the bytes to the buffer's
- * data storage area.
+ * data storage area.  The bytes are taken from pvTxData, or gathered from the
+ * xVectorCount buffers described by pxVectors if pxVectors is not NULL.
  */
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                        const void * pvTxData,
+                                       const StreamBufferVector_t * pxVectors,
+                                       size_t xVectorCount,
                                        size_t xDataLengthBytes,
                                        size_t xSpace,
                                        size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
 
+/*
+ * The implementation of xStreamBufferSend() and xStreamBufferSendV(), and of
+ * xStreamBufferReceive() and xStreamBufferReceiveV().  The data is sent from,
+ * or received into, pvData if pxVectors is NULL, otherwise the xVectorCount
+ * buffers described by pxVectors, which hold xLengthBytes bytes in total.
+ */
+static size_t prvSendToBuffer( StreamBufferHandle_t xStreamBuffer,
+                               const void * pvTxData,
+                               const StreamBufferVector_t * pxVectors,
+                               size_t xVectorCount,
+                               size_t xDataLengthBytes,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+static size_t prvReceiveFromBuffer( StreamBufferHandle_t xStreamBuffer,
+                                    void * pvRxData,
+                                    const StreamBufferVector_t * pxVectors,
+                                    size_t xVectorCount,
+                                    size_t xBufferLengthBytes,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Equivalents of prvWriteBytesToBuffer() and prvReadBytesFromBuffer() that
+ * copy xCount bytes to or from the xVectorCount buffers described by
+ * pxVectors, in order, rather than from or to one contiguous buffer.
+ */
+static size_t prvWriteVectorsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                       const StreamBufferVector_t * pxVectors,
+                                       size_t xVectorCount,
+                                       size_t xCount,
+                                       size_t xHead ) PRIVILEGED_FUNCTION;
+static size_t prvReadVectorsFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                        const StreamBufferVector_t * pxVectors,
+                                        size_t xVectorCount,
+                                        size_t xCount,
+                                        size_t xTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move xHead or xTail on by xLengthBytes bytes that were written or read in
+ * place, after checking the number of bytes is valid.
+ */
+static BaseType_t prvCommitWrite( StreamBuffer_t * const pxStreamBuffer,
+                                  size_t xLengthBytes ) PRIVILEGED_FUNCTION;
+static BaseType_t prvConsume( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the total number of bytes described by an array of vectors.
+ */
+static size_t prvVectorsLength( const StreamBufferVector_t * pxVectors,
+                                size_t xVectorCount ) PRIVILEGED_FUNCTION;
+
 /*
  * Copies xCount bytes from the pxStreamBuffer's data storage area to pucData.
  * This function does not update the buffer's xTail pointer, so multiple reads
@@ -314,6 +394,33 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+/*
+ * Discards the messages at the front of a timestamped message buffer that have
+ * been in the buffer for longer than the buffer's maximum message age, stopping
+ * at the first message that has not expired.  Returns the number of bytes
+ * freed.  Must only be called by the buffer's reader, as it moves xTail.
+ */
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        static size_t prvDiscardExpiredMessages( StreamBuffer_t * const pxStreamBuffer,
+                                                 size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Writes data to a buffer in overwrite mode, first discarding as much of the
+ * oldest data as is needed to make space for it - whole messages if the buffer
+ * is a message buffer.  Data sent to a stream buffer that is longer than the
+ * whole buffer is truncated to its newest bytes.  Returns the number of bytes
+ * sent, which is 0 if a message is too long to ever fit.  Must be called from
+ * a critical section, as the reader may be reading the data being discarded.
+ */
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+        static size_t prvOverwriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                                   const void * pvTxData,
+                                                   const StreamBufferVector_t * pxVectors,
+                                                   size_t xVectorCount,
+                                                   size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+    #endif
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -601,6 +708,10 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        TickType_t xMaxMessageAge;
+    #endif
+
     traceENTER_xStreamBufferReset( xStreamBuffer );
 
     configASSERT( pxStreamBuffer );
@@ -613,6 +724,14 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
     }
     #endif
 
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    {
+        /* Likewise the maximum message age, which is only set once the
+         * buffer has been created. */
+        xMaxMessageAge = pxStreamBuffer->xMaxMessageAge;
+    }
+    #endif
+
     /* Can only reset a message buffer if there are no tasks blocked on it. */
     taskENTER_CRITICAL();
     {
@@ -639,6 +758,12 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+            {
+                pxStreamBuffer->xMaxMessageAge = xMaxMessageAge;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -663,6 +788,10 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        TickType_t xMaxMessageAge;
+    #endif
+
     traceENTER_xStreamBufferResetFromISR( xStreamBuffer );
 
     configASSERT( pxStreamBuffer );
@@ -675,6 +804,14 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
     }
     #endif
 
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    {
+        /* Likewise the maximum message age, which is only set once the
+         * buffer has been created. */
+        xMaxMessageAge = pxStreamBuffer->xMaxMessageAge;
+    }
+    #endif
+
     /* Can only reset a message buffer if there are no tasks blocked on it. */
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
@@ -704,6 +841,12 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+            {
+                pxStreamBuffer->xMaxMessageAge = xMaxMessageAge;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET_FROM_ISR( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -805,10 +948,12 @@ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer )
 }
 /*-----------------------------------------------------------*/
 
-size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
-                          const void * pvTxData,
-                          size_t xDataLengthBytes,
-                          TickType_t xTicksToWait )
+static size_t prvSendToBuffer( StreamBufferHandle_t xStreamBuffer,
+                               const void * pvTxData,
+                               const StreamBufferVector_t * pxVectors,
+                               size_t xVectorCount,
+                               size_t xDataLengthBytes,
+                               TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReturn, xSpace = 0;
@@ -816,9 +961,6 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
     TimeOut_t xTimeOut;
     size_t xMaxReportedSpace = 0;
 
-    traceENTER_xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
-
-    configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
     /* The maximum amount of space a stream buffer will ever report is its length
@@ -831,7 +973,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
      * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
 
         /* Overflow? */
         configASSERT( xRequiredSpace > xDataLengthBytes );
@@ -864,6 +1006,21 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         }
     }
 
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+    {
+        /* A buffer in overwrite mode makes space for new data by discarding
+         * the oldest, so the writer never waits. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_OVERWRITING ) != ( uint8_t ) 0 )
+        {
+            xTicksToWait = ( TickType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+
     if( xTicksToWait != ( TickType_t ) 0 )
     {
         vTaskSetTimeOutState( &xTimeOut );
@@ -903,16 +1060,31 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         mtCOVERAGE_TEST_MARKER();
     }
 
-    if( xSpace == ( size_t ) 0 )
-    {
-        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    }
-    else
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_OVERWRITING ) != ( uint8_t ) 0 )
+        {
+            /* The reader may be reading the oldest data, so discarding it and
+             * writing the new data must be atomic. */
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvOverwriteMessageToBuffer( pxStreamBuffer, pvTxData, pxVectors, xVectorCount, xDataLengthBytes );
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
     {
-        mtCOVERAGE_TEST_MARKER();
-    }
+        if( xSpace == ( size_t ) 0 )
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+        xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, pxVectors, xVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
+    }
 
     if( xReturn > ( size_t ) 0 )
     {
@@ -934,12 +1106,48 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
     }
 
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
+                          const void * pvTxData,
+                          size_t xDataLengthBytes,
+                          TickType_t xTicksToWait )
+{
+    size_t xReturn;
+
+    traceENTER_xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
+
+    configASSERT( pvTxData );
+
+    xReturn = prvSendToBuffer( xStreamBuffer, pvTxData, NULL, 0, xDataLengthBytes, xTicksToWait );
+
     traceRETURN_xStreamBufferSend( xReturn );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                           const StreamBufferVector_t * pxVectors,
+                           size_t xVectorCount,
+                           TickType_t xTicksToWait )
+{
+    size_t xReturn;
+
+    traceENTER_xStreamBufferSendV( xStreamBuffer, pxVectors, xVectorCount, xTicksToWait );
+
+    configASSERT( pxVectors );
+
+    xReturn = prvSendToBuffer( xStreamBuffer, NULL, pxVectors, xVectorCount, prvVectorsLength( pxVectors, xVectorCount ), xTicksToWait );
+
+    traceRETURN_xStreamBufferSendV( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
                                  const void * pvTxData,
                                  size_t xDataLengthBytes,
@@ -949,6 +1157,10 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
 
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+        UBaseType_t uxOverwriteInterruptStatus;
+    #endif
+
     traceENTER_xStreamBufferSendFromISR( xStreamBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken );
 
     configASSERT( pvTxData );
@@ -960,15 +1172,30 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
      * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_OVERWRITING ) != ( uint8_t ) 0 )
+        {
+            /* The reader may be reading the oldest data, so discarding it and
+             * writing the new data must be atomic. */
+            uxOverwriteInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                xReturn = prvOverwriteMessageToBuffer( pxStreamBuffer, pvTxData, NULL, 0, xDataLengthBytes );
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxOverwriteInterruptStatus );
+        }
+        else
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+    {
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, NULL, 0, xDataLengthBytes, xSpace, xRequiredSpace );
+    }
 
     if( xReturn > ( size_t ) 0 )
     {
@@ -999,6 +1226,8 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
 
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                        const void * pvTxData,
+                                       const StreamBufferVector_t * pxVectors,
+                                       size_t xVectorCount,
                                        size_t xDataLengthBytes,
                                        size_t xSpace,
                                        size_t xRequiredSpace )
@@ -1022,6 +1251,23 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
              * itself into the buffer.  Start by writing the length of the data, the data
              * itself will be written later in this function. */
             xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+
+            #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+            {
+                if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_TIMESTAMPED ) != ( uint8_t ) 0 )
+                {
+                    /* The send functions are used from both tasks and
+                     * interrupts, so use the interrupt safe tick count. */
+                    const TickType_t xTimeStamp = xTaskGetTickCountFromISR();
+
+                    xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xTimeStamp ), sizeof( TickType_t ), xNextHead );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TIMESTAMPED_MESSAGES */
         }
         else
         {
@@ -1039,28 +1285,44 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 
     if( xDataLengthBytes != ( size_t ) 0 )
     {
-        /* Write the data to the buffer. */
-        /* MISRA Ref 11.5.5 [Void pointer assignment] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-        /* coverity[misra_c_2012_rule_11_5_violation] */
-        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead );
+        if( pxVectors == NULL )
+        {
+            /* Write the data to the buffer. */
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead );
+        }
+        else
+        {
+            /* Gather the data from each vector in turn straight into the
+             * buffer. */
+            pxStreamBuffer->xHead = prvWriteVectorsToBuffer( pxStreamBuffer, pxVectors, xVectorCount, xDataLengthBytes, xNextHead );
+        }
     }
 
     return xDataLengthBytes;
 }
 /*-----------------------------------------------------------*/
 
-size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
-                             void * pvRxData,
-                             size_t xBufferLengthBytes,
-                             TickType_t xTicksToWait )
+static size_t prvReceiveFromBuffer( StreamBufferHandle_t xStreamBuffer,
+                                    void * pvRxData,
+                                    const StreamBufferVector_t * pxVectors,
+                                    size_t xVectorCount,
+                                    size_t xBufferLengthBytes,
+                                    TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 
-    traceENTER_xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        size_t xBytesDiscarded = 0;
+    #endif
+
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+        BaseType_t xIsOverwriting;
+    #endif
 
-    configASSERT( pvRxData );
     configASSERT( pxStreamBuffer );
 
     /* This receive function is used by both message buffers, which store
@@ -1070,7 +1332,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
      * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
     }
     else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BATCHING_BUFFER ) != ( uint8_t ) 0 )
     {
@@ -1134,6 +1396,40 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
     }
 
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+    {
+        /* In overwrite mode the writer also moves xTail, to discard the oldest
+         * data, so the data must be read from a critical section. */
+        xIsOverwriting = ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_OVERWRITING ) != ( uint8_t ) 0 ) ? pdTRUE : pdFALSE;
+
+        if( xIsOverwriting != pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    {
+        /* Messages that have been waiting for too long are dropped rather
+         * than received. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_TIMESTAMPED ) != ( uint8_t ) 0 )
+        {
+            xBytesDiscarded = prvDiscardExpiredMessages( pxStreamBuffer, xBytesAvailable );
+            xBytesAvailable -= xBytesDiscarded;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
     /* Whether receiving a discrete message (where xBytesToStoreMessageLength
      * holds the number of bytes used to store the message length) or a stream of
      * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
@@ -1141,31 +1437,95 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
      * read bytes from the buffer. */
     if( xBytesAvailable > xBytesToStoreMessageLength )
     {
-        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, pxVectors, xVectorCount, xBufferLengthBytes, xBytesAvailable );
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-        /* Was a task waiting for space in the buffer? */
-        if( xReceivedLength != ( size_t ) 0 )
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+    {
+        if( xIsOverwriting != pdFALSE )
         {
-            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
-            prvRECEIVE_COMPLETED( xStreamBuffer );
+            taskEXIT_CRITICAL();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReceivedLength != ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+        prvRECEIVE_COMPLETED( xStreamBuffer );
+    }
     else
     {
-        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
         mtCOVERAGE_TEST_MARKER();
     }
 
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    {
+        /* Discarding expired messages frees space even if no message was
+         * received, so a task waiting to send may be able to proceed. */
+        if( ( xReceivedLength == ( size_t ) 0 ) && ( xBytesDiscarded != ( size_t ) 0 ) )
+        {
+            prvRECEIVE_COMPLETED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+    return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
+                             void * pvRxData,
+                             size_t xBufferLengthBytes,
+                             TickType_t xTicksToWait )
+{
+    size_t xReceivedLength;
+
+    traceENTER_xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
+
+    configASSERT( pvRxData );
+
+    xReceivedLength = prvReceiveFromBuffer( xStreamBuffer, pvRxData, NULL, 0, xBufferLengthBytes, xTicksToWait );
+
     traceRETURN_xStreamBufferReceive( xReceivedLength );
 
     return xReceivedLength;
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+                              const StreamBufferVector_t * pxVectors,
+                              size_t xVectorCount,
+                              TickType_t xTicksToWait )
+{
+    size_t xReceivedLength;
+
+    traceENTER_xStreamBufferReceiveV( xStreamBuffer, pxVectors, xVectorCount, xTicksToWait );
+
+    configASSERT( pxVectors );
+
+    xReceivedLength = prvReceiveFromBuffer( xStreamBuffer, NULL, pxVectors, xVectorCount, prvVectorsLength( pxVectors, xVectorCount ), xTicksToWait );
+
+    traceRETURN_xStreamBufferReceiveV( xReceivedLength );
+
+    return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
@@ -1218,6 +1578,15 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        size_t xBytesDiscarded = 0;
+    #endif
+
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+        BaseType_t xIsOverwriting;
+        UBaseType_t uxOverwriteInterruptStatus = 0;
+    #endif
+
     traceENTER_xStreamBufferReceiveFromISR( xStreamBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken );
 
     configASSERT( pvRxData );
@@ -1230,7 +1599,7 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
      * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
     }
     else
     {
@@ -1239,42 +1608,109 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 
     xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 
-    /* Whether receiving a discrete message (where xBytesToStoreMessageLength
-     * holds the number of bytes used to store the message length) or a stream of
-     * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
-     * available must be greater than xBytesToStoreMessageLength to be able to
-     * read bytes from the buffer. */
-    if( xBytesAvailable > xBytesToStoreMessageLength )
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
     {
-        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+        /* In overwrite mode the writer also moves xTail, to discard the oldest
+         * data, so the data must be read from a critical section. */
+        xIsOverwriting = ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_OVERWRITING ) != ( uint8_t ) 0 ) ? pdTRUE : pdFALSE;
 
-        /* Was a task waiting for space in the buffer? */
-        if( xReceivedLength != ( size_t ) 0 )
+        if( xIsOverwriting != pdFALSE )
         {
-            /* MISRA Ref 4.7.1 [Return value shall be checked] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
-            /* coverity[misra_c_2012_directive_4_7_violation] */
-            prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            uxOverwriteInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
-    else
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
     {
-        mtCOVERAGE_TEST_MARKER();
+        /* Messages that have been waiting for too long are dropped rather
+         * than received. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_TIMESTAMPED ) != ( uint8_t ) 0 )
+        {
+            xBytesDiscarded = prvDiscardExpiredMessages( pxStreamBuffer, xBytesAvailable );
+            xBytesAvailable -= xBytesDiscarded;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
+    #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+    /* Whether receiving a discrete message (where xBytesToStoreMessageLength
+     * holds the number of bytes used to store the message length) or a stream of
+     * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+     * available must be greater than xBytesToStoreMessageLength to be able to
+     * read bytes from the buffer. */
+    if( xBytesAvailable > xBytesToStoreMessageLength )
+    {
+        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, NULL, 0, xBufferLengthBytes, xBytesAvailable );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+    {
+        if( xIsOverwriting != pdFALSE )
+        {
+            taskEXIT_CRITICAL_FROM_ISR( uxOverwriteInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReceivedLength != ( size_t ) 0 )
+    {
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    {
+        /* Discarding expired messages frees space even if no message was
+         * received, so a task waiting to send may be able to proceed. */
+        if( ( xReceivedLength == ( size_t ) 0 ) && ( xBytesDiscarded != ( size_t ) 0 ) )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+    traceRETURN_xStreamBufferReceiveFromISR( xReceivedLength );
+
+    return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
 
-    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
-    traceRETURN_xStreamBufferReceiveFromISR( xReceivedLength );
-
-    return xReceivedLength;
-}
-/*-----------------------------------------------------------*/
-
 static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                         void * pvRxData,
+                                        const StreamBufferVector_t * pxVectors,
+                                        size_t xVectorCount,
                                         size_t xBufferLengthBytes,
                                         size_t xBytesAvailable )
 {
@@ -1282,6 +1718,10 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
     configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
     size_t xNextTail = pxStreamBuffer->xTail;
 
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        TickType_t xTimeStamp = ( TickType_t ) 0;
+    #endif
+
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
         /* A discrete message is being received.  First receive the length
@@ -1293,6 +1733,21 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
          * read out. */
         xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH;
 
+        #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        {
+            if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_TIMESTAMPED ) != ( uint8_t ) 0 )
+            {
+                /* The time at which the message was sent follows its length. */
+                xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTimeStamp, sizeof( TickType_t ), xNextTail );
+                xBytesAvailable -= sizeof( TickType_t );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMESTAMPED_MESSAGES */
+
         /* Check there is enough space in the buffer provided by the
          * user. */
         if( xNextMessageLength > xBufferLengthBytes )
@@ -1317,11 +1772,45 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
 
     if( xCount != ( size_t ) 0 )
     {
-        /* Read the actual data and update the tail to mark the data as officially consumed. */
-        /* MISRA Ref 11.5.5 [Void pointer assignment] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-        /* coverity[misra_c_2012_rule_11_5_violation] */
-        pxStreamBuffer->xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail );
+        if( pxVectors == NULL )
+        {
+            /* Read the actual data and update the tail to mark the data as officially consumed. */
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxStreamBuffer->xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail );
+        }
+        else
+        {
+            /* Scatter the data straight from the buffer into each vector in
+             * turn, then update the tail. */
+            pxStreamBuffer->xTail = prvReadVectorsFromBuffer( pxStreamBuffer, pxVectors, xVectorCount, xCount, xNextTail );
+        }
+
+        #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+        {
+            if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_TIMESTAMPED ) != ( uint8_t ) 0 )
+            {
+                const TickType_t xAge = xTaskGetTickCountFromISR() - xTimeStamp;
+
+                pxStreamBuffer->xAgeStats.uxMessagesReceived++;
+                pxStreamBuffer->xAgeStats.xTotalAge += xAge;
+
+                if( xAge > pxStreamBuffer->xAgeStats.xMaxAge )
+                {
+                    pxStreamBuffer->xAgeStats.xMaxAge = xAge;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMESTAMPED_MESSAGES */
     }
 
     return xCount;
@@ -1372,7 +1861,7 @@ BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
      * sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
     }
     else
     {
@@ -1473,144 +1962,938 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                     const uint8_t * pucData,
-                                     size_t xCount,
-                                     size_t xHead )
+BaseType_t xStreamBufferReserveWrite( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xLengthBytes,
+                                      void ** ppvData,
+                                      size_t * pxContiguousLengthBytes )
 {
-    size_t xFirstLength;
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn = pdFAIL;
+    size_t xSpace;
 
-    configASSERT( xCount > ( size_t ) 0 );
+    traceENTER_xStreamBufferReserveWrite( xStreamBuffer, xLengthBytes, ppvData, pxContiguousLengthBytes );
 
-    /* Calculate the number of bytes that can be added in the first write -
-     * which may be less than the total number of bytes that need to be added if
-     * the buffer will wrap back to the beginning. */
-    xFirstLength = configMIN( pxStreamBuffer->xLength - xHead, xCount );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ppvData );
+    configASSERT( pxContiguousLengthBytes );
 
-    /* Write as many bytes as can be written in the first write. */
-    configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength );
+    /* Message buffers store the length of each message in front of the
+     * message, and the writer to a buffer in overwrite mode moves xTail, so
+     * neither can be written in place. */
+    configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_OVERWRITING ) ) == ( uint8_t ) 0 );
 
-    /* If the number of bytes written was less than the number that could be
-     * written in the first write... */
-    if( xCount > xFirstLength )
+    *ppvData = NULL;
+    *pxContiguousLengthBytes = 0;
+
+    /* Only the writer moves xHead, so the space read here can only grow
+     * before the reservation is committed. */
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+    if( ( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_OVERWRITING ) ) == ( uint8_t ) 0 ) &&
+        ( xSpace > ( size_t ) 0 ) &&
+        ( xSpace >= xLengthBytes ) )
     {
-        /* ...then write the remaining bytes to the start of the buffer. */
-        configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
-        ( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength );
+        /* The free space may wrap around the end of the buffer, in which case
+         * only the part up to the end of the buffer can be written in place. */
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xHead ] );
+        *pxContiguousLengthBytes = configMIN( xSpace, pxStreamBuffer->xLength - pxStreamBuffer->xHead );
+        xReturn = pdPASS;
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    xHead += xCount;
+    traceRETURN_xStreamBufferReserveWrite( xReturn );
 
-    if( xHead >= pxStreamBuffer->xLength )
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCommitWrite( StreamBuffer_t * const pxStreamBuffer,
+                                  size_t xLengthBytes )
+{
+    BaseType_t xReturn = pdFAIL;
+    size_t xNextHead = pxStreamBuffer->xHead;
+
+    /* Only bytes within the contiguous span returned by
+     * xStreamBufferReserveWrite() can have been written in place. */
+    if( ( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_OVERWRITING ) ) == ( uint8_t ) 0 ) &&
+        ( xLengthBytes > ( size_t ) 0 ) &&
+        ( xLengthBytes <= ( pxStreamBuffer->xLength - xNextHead ) ) &&
+        ( xLengthBytes <= xStreamBufferSpacesAvailable( pxStreamBuffer ) ) )
     {
-        xHead -= pxStreamBuffer->xLength;
+        xNextHead += xLengthBytes;
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xHead = xNextHead;
+        xReturn = pdPASS;
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    return xHead;
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
-                                      uint8_t * pucData,
-                                      size_t xCount,
-                                      size_t xTail )
+BaseType_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xLengthBytes )
 {
-    size_t xFirstLength;
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
 
-    configASSERT( xCount != ( size_t ) 0 );
+    traceENTER_xStreamBufferCommitWrite( xStreamBuffer, xLengthBytes );
 
-    /* Calculate the number of bytes that can be read - which may be
-     * less than the number wanted if the data wraps around to the start of
-     * the buffer. */
-    xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
+    configASSERT( pxStreamBuffer );
 
-    /* Obtain the number of bytes it is possible to obtain in the first
-     * read.  Asserts check bounds of read and write. */
-    configASSERT( xFirstLength <= xCount );
-    configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength );
+    xReturn = prvCommitWrite( pxStreamBuffer, xLengthBytes );
+    configASSERT( xReturn == pdPASS );
 
-    /* If the total number of wanted bytes is greater than the number
-     * that could be read in the first read... */
-    if( xCount > xFirstLength )
+    if( xReturn == pdPASS )
     {
-        /* ...then read the remaining bytes from the start of the buffer. */
-        ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength );
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xLengthBytes );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
     else
     {
-        mtCOVERAGE_TEST_MARKER();
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
     }
 
-    /* Move the tail pointer to effectively remove the data read from the buffer. */
-    xTail += xCount;
+    traceRETURN_xStreamBufferCommitWrite( xReturn );
 
-    if( xTail >= pxStreamBuffer->xLength )
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xLengthBytes,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+
+    traceENTER_xStreamBufferCommitWriteFromISR( xStreamBuffer, xLengthBytes, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvCommitWrite( pxStreamBuffer, xLengthBytes );
+    configASSERT( xReturn == pdPASS );
+
+    if( xReturn == pdPASS )
     {
-        xTail -= pxStreamBuffer->xLength;
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
     }
 
-    return xTail;
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, ( ( xReturn == pdPASS ) ? xLengthBytes : ( size_t ) 0 ) );
+    traceRETURN_xStreamBufferCommitWriteFromISR( xReturn );
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+size_t xStreamBufferPeekRead( StreamBufferHandle_t xStreamBuffer,
+                              void ** ppvData )
 {
-    /* Returns the distance between xTail and xHead. */
-    size_t xCount;
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xContiguousLength = 0;
+    size_t xBytesAvailable;
 
-    xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
-    xCount -= pxStreamBuffer->xTail;
+    traceENTER_xStreamBufferPeekRead( xStreamBuffer, ppvData );
 
-    if( xCount >= pxStreamBuffer->xLength )
+    configASSERT( pxStreamBuffer );
+    configASSERT( ppvData );
+
+    /* Message buffers store the length of each message in front of the
+     * message, and the writer to a buffer in overwrite mode can discard data
+     * while it is being read, so neither can be read in place. */
+    configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_OVERWRITING ) ) == ( uint8_t ) 0 );
+
+    *ppvData = NULL;
+
+    /* Only the reader moves xTail, so the bytes counted here remain in the
+     * buffer until they are consumed. */
+    xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+    if( ( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_OVERWRITING ) ) == ( uint8_t ) 0 ) &&
+        ( xBytesAvailable > ( size_t ) 0 ) )
     {
-        xCount -= pxStreamBuffer->xLength;
+        /* The data may wrap around the end of the buffer, in which case only
+         * the part up to the end of the buffer can be read in place. */
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] );
+        xContiguousLength = configMIN( xBytesAvailable, pxStreamBuffer->xLength - pxStreamBuffer->xTail );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    return xCount;
+    traceRETURN_xStreamBufferPeekRead( xContiguousLength );
+
+    return xContiguousLength;
 }
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                          uint8_t * const pucBuffer,
-                                          size_t xBufferSizeBytes,
-                                          size_t xTriggerLevelBytes,
-                                          uint8_t ucFlags,
-                                          StreamBufferCallbackFunction_t pxSendCompletedCallback,
-                                          StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
+static BaseType_t prvConsume( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xLengthBytes )
 {
-    /* Assert here is deliberately writing to the entire buffer to ensure it can
-     * be written to without generating exceptions, and is setting the buffer to a
-     * known value to assist in development/debugging. */
-    #if ( configASSERT_DEFINED == 1 )
+    BaseType_t xReturn = pdFAIL;
+    size_t xNextTail = pxStreamBuffer->xTail;
+
+    /* Any bytes in the buffer can be consumed, including bytes beyond the
+     * contiguous span returned by xStreamBufferPeekRead(). */
+    if( ( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_OVERWRITING ) ) == ( uint8_t ) 0 ) &&
+        ( xLengthBytes > ( size_t ) 0 ) &&
+        ( xLengthBytes <= prvBytesInBuffer( pxStreamBuffer ) ) )
     {
-        /* The value written just has to be identifiable when looking at the
-         * memory.  Don't use 0xA5 as that is the stack fill value and could
-         * result in confusion as to what is actually being observed. */
-        #define STREAM_BUFFER_BUFFER_WRITE_VALUE    ( 0x55 )
-        configASSERT( memset( pucBuffer, ( int ) STREAM_BUFFER_BUFFER_WRITE_VALUE, xBufferSizeBytes ) == pucBuffer );
+        xNextTail += xLengthBytes;
+
+        if( xNextTail >= pxStreamBuffer->xLength )
+        {
+            xNextTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xTail = xNextTail;
+        xReturn = pdPASS;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
     }
-    #endif
 
-    ( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) );
-    pxStreamBuffer->pucBuffer = pucBuffer;
-    pxStreamBuffer->xLength = xBufferSizeBytes;
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xLengthBytes )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+
+    traceENTER_xStreamBufferConsume( xStreamBuffer, xLengthBytes );
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvConsume( pxStreamBuffer, xLengthBytes );
+    configASSERT( xReturn == pdPASS );
+
+    if( xReturn == pdPASS )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xLengthBytes );
+
+        /* Was a task waiting for space in the buffer? */
+        prvRECEIVE_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+    }
+
+    traceRETURN_xStreamBufferConsume( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xLengthBytes,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+
+    traceENTER_xStreamBufferConsumeFromISR( xStreamBuffer, xLengthBytes, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvConsume( pxStreamBuffer, xLengthBytes );
+    configASSERT( xReturn == pdPASS );
+
+    if( xReturn == pdPASS )
+    {
+        /* Was a task waiting for space in the buffer? */
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, ( ( xReturn == pdPASS ) ? xLengthBytes : ( size_t ) 0 ) );
+    traceRETURN_xStreamBufferConsumeFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+
+    BaseType_t xStreamBufferSetMaxMessageAge( StreamBufferHandle_t xStreamBuffer,
+                                              TickType_t xMaxMessageAge )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn = pdFAIL;
+
+        traceENTER_xStreamBufferSetMaxMessageAge( xStreamBuffer, xMaxMessageAge );
+
+        configASSERT( pxStreamBuffer );
+
+        /* Only message buffers hold discrete messages that can be timestamped. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_TIMESTAMPED ) != ( uint8_t ) 0 )
+                {
+                    pxStreamBuffer->xMaxMessageAge = xMaxMessageAge;
+                    xReturn = pdPASS;
+                }
+                else if( ( pxStreamBuffer->xHead == pxStreamBuffer->xTail ) &&
+                         ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) &&
+                         ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+                {
+                    /* Timestamping changes the layout of the messages in the
+                     * buffer, so can only be switched on while the buffer is
+                     * empty and no task is waiting on it. */
+                    pxStreamBuffer->ucFlags |= sbFLAGS_IS_TIMESTAMPED;
+                    pxStreamBuffer->xMaxMessageAge = xMaxMessageAge;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xStreamBufferSetMaxMessageAge( xReturn );
+
+        return xReturn;
+    }
+
+    #endif /* configUSE_TIMESTAMPED_MESSAGES */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+
+    void vStreamBufferGetAgeStats( StreamBufferHandle_t xStreamBuffer,
+                                   StreamBufferAgeStats_t * pxAgeStats,
+                                   BaseType_t xReset )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferGetAgeStats( xStreamBuffer, pxAgeStats, xReset );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxAgeStats );
+
+        taskENTER_CRITICAL();
+        {
+            *pxAgeStats = pxStreamBuffer->xAgeStats;
+
+            if( xReset != pdFALSE )
+            {
+                ( void ) memset( ( void * ) &( pxStreamBuffer->xAgeStats ), 0x00, sizeof( StreamBufferAgeStats_t ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vStreamBufferGetAgeStats();
+    }
+
+    #endif /* configUSE_TIMESTAMPED_MESSAGES */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+
+    static size_t prvDiscardExpiredMessages( StreamBuffer_t * const pxStreamBuffer,
+                                             size_t xBytesAvailable )
+    {
+        const size_t xBytesToStoreMessageHeader = sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
+        const TickType_t xTimeNow = xTaskGetTickCountFromISR();
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+        TickType_t xTimeStamp;
+        size_t xNextTail, xMessageBytes, xBytesDiscarded = 0;
+        BaseType_t xExpired = pdTRUE;
+
+        /* Messages leave the buffer in the order they were sent, so stop at
+         * the first one that has not expired. */
+        while( ( xExpired != pdFALSE ) && ( xBytesAvailable > xBytesToStoreMessageHeader ) )
+        {
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
+            ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTimeStamp, sizeof( TickType_t ), xNextTail );
+
+            if( ( TickType_t ) ( xTimeNow - xTimeStamp ) > pxStreamBuffer->xMaxMessageAge )
+            {
+                xMessageBytes = xBytesToStoreMessageHeader + ( size_t ) xTempMessageLength;
+                configASSERT( xMessageBytes <= xBytesAvailable );
+
+                /* Skip over the whole message without copying it out. */
+                xNextTail = pxStreamBuffer->xTail + xMessageBytes;
+
+                if( xNextTail >= pxStreamBuffer->xLength )
+                {
+                    xNextTail -= pxStreamBuffer->xLength;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxStreamBuffer->xTail = xNextTail;
+                xBytesAvailable -= xMessageBytes;
+                xBytesDiscarded += xMessageBytes;
+                pxStreamBuffer->xAgeStats.uxMessagesExpired++;
+                traceSTREAM_BUFFER_MESSAGE_EXPIRED( pxStreamBuffer );
+            }
+            else
+            {
+                xExpired = pdFALSE;
+            }
+        }
+
+        return xBytesDiscarded;
+    }
+
+    #endif /* configUSE_TIMESTAMPED_MESSAGES */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+
+    BaseType_t xStreamBufferSetOverwrite( StreamBufferHandle_t xStreamBuffer,
+                                          BaseType_t xOverwrite )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn = pdFAIL;
+
+        traceENTER_xStreamBufferSetOverwrite( xStreamBuffer, xOverwrite );
+
+        configASSERT( pxStreamBuffer );
+
+        taskENTER_CRITICAL();
+        {
+            /* A writer waiting for space would not be woken by a writer that
+             * never waits, so the mode cannot change while one is waiting. */
+            if( pxStreamBuffer->xTaskWaitingToSend == NULL )
+            {
+                if( xOverwrite != pdFALSE )
+                {
+                    pxStreamBuffer->ucFlags |= sbFLAGS_IS_OVERWRITING;
+                }
+                else
+                {
+                    pxStreamBuffer->ucFlags &= ( uint8_t ) ~sbFLAGS_IS_OVERWRITING;
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xStreamBufferSetOverwrite( xReturn );
+
+        return xReturn;
+    }
+
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+
+    void vStreamBufferGetDroppedCounts( StreamBufferHandle_t xStreamBuffer,
+                                        size_t * pxBytesDropped,
+                                        UBaseType_t * puxMessagesDropped,
+                                        BaseType_t xReset )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferGetDroppedCounts( xStreamBuffer, pxBytesDropped, puxMessagesDropped, xReset );
+
+        configASSERT( pxStreamBuffer );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxBytesDropped != NULL )
+            {
+                *pxBytesDropped = pxStreamBuffer->xBytesDropped;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( puxMessagesDropped != NULL )
+            {
+                *puxMessagesDropped = pxStreamBuffer->uxMessagesDropped;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xReset != pdFALSE )
+            {
+                pxStreamBuffer->xBytesDropped = 0;
+                pxStreamBuffer->uxMessagesDropped = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vStreamBufferGetDroppedCounts();
+    }
+
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_STREAM_BUFFER_OVERWRITE == 1 )
+
+    static size_t prvOverwriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                               const void * pvTxData,
+                                               const StreamBufferVector_t * pxVectors,
+                                               size_t xVectorCount,
+                                               size_t xDataLengthBytes )
+    {
+        const size_t xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+        StreamBufferVector_t xFirstVector;
+        size_t xRequiredSpace, xSpace, xNextTail, xNextHead, xMessageBytes, x;
+        size_t xBytesDropped = 0, xBytesSkipped = 0, xReturn = 0;
+        const uint8_t * pucTxData;
+
+        /* This function is called from a critical section. */
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xRequiredSpace = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer );
+        }
+        else if( xDataLengthBytes > xMaxReportedSpace )
+        {
+            /* The data is longer than the whole buffer, so only its newest
+             * bytes are kept. */
+            xRequiredSpace = xMaxReportedSpace;
+            xBytesSkipped = xDataLengthBytes - xMaxReportedSpace;
+        }
+        else
+        {
+            xRequiredSpace = xDataLengthBytes;
+        }
+
+        /* A message that does not fit in the empty buffer is rejected without
+         * discarding anything. */
+        if( ( xRequiredSpace <= xMaxReportedSpace ) && ( xRequiredSpace > ( size_t ) 0 ) )
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+            if( xSpace < xRequiredSpace )
+            {
+                if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+                {
+                    /* Discard whole messages, oldest first, until the new
+                     * message fits. */
+                    xNextTail = pxStreamBuffer->xTail;
+
+                    while( xSpace < xRequiredSpace )
+                    {
+                        ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+                        xMessageBytes = sbBYTES_TO_STORE_MESSAGE_HEADER( pxStreamBuffer ) + ( size_t ) xTempMessageLength;
+
+                        xNextTail += xMessageBytes;
+
+                        if( xNextTail >= pxStreamBuffer->xLength )
+                        {
+                            xNextTail -= pxStreamBuffer->xLength;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        xSpace += xMessageBytes;
+                        xBytesDropped += ( size_t ) xTempMessageLength;
+                        pxStreamBuffer->uxMessagesDropped++;
+                    }
+
+                    pxStreamBuffer->xTail = xNextTail;
+                }
+                else
+                {
+                    /* Discard just enough of the oldest bytes. */
+                    xBytesDropped = xRequiredSpace - xSpace;
+                    xNextTail = pxStreamBuffer->xTail + xBytesDropped;
+
+                    if( xNextTail >= pxStreamBuffer->xLength )
+                    {
+                        xNextTail -= pxStreamBuffer->xLength;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxStreamBuffer->xTail = xNextTail;
+                    xSpace = xRequiredSpace;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Bytes of the new data that are not kept count as dropped too. */
+            xBytesDropped += xBytesSkipped;
+
+            if( xBytesSkipped == ( size_t ) 0 )
+            {
+                xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, pxVectors, xVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
+            }
+            else if( pxVectors == NULL )
+            {
+                /* MISRA Ref 11.5.5 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pucTxData = ( const uint8_t * ) pvTxData;
+                ( void ) prvWriteMessageToBuffer( pxStreamBuffer, &( pucTxData[ xBytesSkipped ] ), NULL, 0, xRequiredSpace, xSpace, xRequiredSpace );
+                xReturn = xDataLengthBytes;
+            }
+            else
+            {
+                /* Find the fragment that holds the first byte to keep, then
+                 * write the rest of that fragment followed by the fragments
+                 * after it. */
+                x = 0;
+
+                while( xBytesSkipped >= pxVectors[ x ].xLength )
+                {
+                    xBytesSkipped -= pxVectors[ x ].xLength;
+                    x++;
+                }
+
+                /* MISRA Ref 11.5.5 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pucTxData = ( const uint8_t * ) pxVectors[ x ].pvData;
+                xFirstVector.pvData = ( void * ) &( pucTxData[ xBytesSkipped ] );
+                xFirstVector.xLength = pxVectors[ x ].xLength - xBytesSkipped;
+
+                xNextHead = prvWriteVectorsToBuffer( pxStreamBuffer, &xFirstVector, 1, configMIN( xFirstVector.xLength, xRequiredSpace ), pxStreamBuffer->xHead );
+
+                if( xRequiredSpace > xFirstVector.xLength )
+                {
+                    xNextHead = prvWriteVectorsToBuffer( pxStreamBuffer, &( pxVectors[ x + 1U ] ), xVectorCount - ( x + 1U ), xRequiredSpace - xFirstVector.xLength, xNextHead );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxStreamBuffer->xHead = xNextHead;
+                xReturn = xDataLengthBytes;
+            }
+
+            if( xBytesDropped != ( size_t ) 0 )
+            {
+                pxStreamBuffer->xBytesDropped += xBytesDropped;
+                traceSTREAM_BUFFER_DROPPED_OLDEST( pxStreamBuffer, xBytesDropped );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+    #endif /* configUSE_STREAM_BUFFER_OVERWRITE */
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                     const uint8_t * pucData,
+                                     size_t xCount,
+                                     size_t xHead )
+{
+    size_t xFirstLength;
+
+    configASSERT( xCount > ( size_t ) 0 );
+
+    /* Calculate the number of bytes that can be added in the first write -
+     * which may be less than the total number of bytes that need to be added if
+     * the buffer will wrap back to the beginning. */
+    xFirstLength = configMIN( pxStreamBuffer->xLength - xHead, xCount );
+
+    /* Write as many bytes as can be written in the first write. */
+    configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
+    ( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength );
+
+    /* If the number of bytes written was less than the number that could be
+     * written in the first write... */
+    if( xCount > xFirstLength )
+    {
+        /* ...then write the remaining bytes to the start of the buffer. */
+        configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+        ( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xHead += xCount;
+
+    if( xHead >= pxStreamBuffer->xLength )
+    {
+        xHead -= pxStreamBuffer->xLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                      uint8_t * pucData,
+                                      size_t xCount,
+                                      size_t xTail )
+{
+    size_t xFirstLength;
+
+    configASSERT( xCount != ( size_t ) 0 );
+
+    /* Calculate the number of bytes that can be read - which may be
+     * less than the number wanted if the data wraps around to the start of
+     * the buffer. */
+    xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
+
+    /* Obtain the number of bytes it is possible to obtain in the first
+     * read.  Asserts check bounds of read and write. */
+    configASSERT( xFirstLength <= xCount );
+    configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
+    ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength );
+
+    /* If the total number of wanted bytes is greater than the number
+     * that could be read in the first read... */
+    if( xCount > xFirstLength )
+    {
+        /* ...then read the remaining bytes from the start of the buffer. */
+        ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Move the tail pointer to effectively remove the data read from the buffer. */
+    xTail += xCount;
+
+    if( xTail >= pxStreamBuffer->xLength )
+    {
+        xTail -= pxStreamBuffer->xLength;
+    }
+
+    return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteVectorsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                       const StreamBufferVector_t * pxVectors,
+                                       size_t xVectorCount,
+                                       size_t xCount,
+                                       size_t xHead )
+{
+    size_t x, xFragmentLength;
+
+    for( x = 0; ( x < xVectorCount ) && ( xCount > ( size_t ) 0 ); x++ )
+    {
+        xFragmentLength = configMIN( pxVectors[ x ].xLength, xCount );
+
+        if( xFragmentLength > ( size_t ) 0 )
+        {
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxVectors[ x ].pvData, xFragmentLength, xHead );
+            xCount -= xFragmentLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadVectorsFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                        const StreamBufferVector_t * pxVectors,
+                                        size_t xVectorCount,
+                                        size_t xCount,
+                                        size_t xTail )
+{
+    size_t x, xFragmentLength;
+
+    for( x = 0; ( x < xVectorCount ) && ( xCount > ( size_t ) 0 ); x++ )
+    {
+        xFragmentLength = configMIN( pxVectors[ x ].xLength, xCount );
+
+        if( xFragmentLength > ( size_t ) 0 )
+        {
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pxVectors[ x ].pvData, xFragmentLength, xTail );
+            xCount -= xFragmentLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvVectorsLength( const StreamBufferVector_t * pxVectors,
+                                size_t xVectorCount )
+{
+    size_t x, xLength = 0;
+
+    for( x = 0; x < xVectorCount; x++ )
+    {
+        /* Each vector must describe a buffer unless it is empty. */
+        configASSERT( ( pxVectors[ x ].pvData != NULL ) || ( pxVectors[ x ].xLength == ( size_t ) 0 ) );
+
+        /* Overflow? */
+        configASSERT( ( xLength + pxVectors[ x ].xLength ) >= xLength );
+
+        xLength += pxVectors[ x ].xLength;
+    }
+
+    return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+{
+    /* Returns the distance between xTail and xHead. */
+    size_t xCount;
+
+    xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+    xCount -= pxStreamBuffer->xTail;
+
+    if( xCount >= pxStreamBuffer->xLength )
+    {
+        xCount -= pxStreamBuffer->xLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                          uint8_t * const pucBuffer,
+                                          size_t xBufferSizeBytes,
+                                          size_t xTriggerLevelBytes,
+                                          uint8_t ucFlags,
+                                          StreamBufferCallbackFunction_t pxSendCompletedCallback,
+                                          StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
+{
+    /* Assert here is deliberately writing to the entire buffer to ensure it can
+     * be written to without generating exceptions, and is setting the buffer to a
+     * known value to assist in development/debugging. */
+    #if ( configASSERT_DEFINED == 1 )
+    {
+        /* The value written just has to be identifiable when looking at the
+         * memory.  Don't use 0xA5 as that is the stack fill value and could
+         * result in confusion as to what is actually being observed. */
+        #define STREAM_BUFFER_BUFFER_WRITE_VALUE    ( 0x55 )
+        configASSERT( memset( pucBuffer, ( int ) STREAM_BUFFER_BUFFER_WRITE_VALUE, xBufferSizeBytes ) == pucBuffer );
+    }
+    #endif
+
+    ( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) );
+    pxStreamBuffer->pucBuffer = pucBuffer;
+    pxStreamBuffer->xLength = xBufferSizeBytes;
     pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
     pxStreamBuffer->ucFlags = ucFlags;
     pxStreamBuffer->uxNotificationIndex = tskDEFAULT_INDEX_TO_NOTIFY;
+
+    #if ( configUSE_TIMESTAMPED_MESSAGES == 1 )
+    {
+        pxStreamBuffer->xMaxMessageAge = portMAX_DELAY;
+    }
+    #endif
+
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
     {
         pxStreamBuffer->pxSendCompletedCallback = pxSendCompletedCallback;
@@ -39,6 +39,10 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "isr_timer.h"
+#include "object_pool.h"
+#include "arena.h"
+#include "heap_trace.h"
 #include "stack_macros.h"
 
 /* The default definitions are only available for non-MPU ports. The
@@ -124,6 +128,15 @@
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
 #define tskSTATICALLY_ALLOCATED_STACK_AND_TCB     ( ( uint8_t ) 2 )
 
+/* A task blocked with a microsecond timeout is also given a tick block time
+ * that ends this many ticks after its microsecond wake time, which only
+ * unblocks the task if its wake timer could not be started. */
+#define tskWAKE_TIMER_BACKSTOP_TICKS              ( ( uint64_t ) 2U )
+
+/* How long, in microseconds, a wake timer that expires while the scheduler is
+ * suspended waits before trying to unblock its task again. */
+#define tskWAKE_TIMER_RETRY_US                    ( ( uint64_t ) 10U )
+
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
  * set then don't fill the stack so there is no unnecessary dependency on memset. */
@@ -420,6 +433,16 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
     #endif
 
+    #if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+        ISRTimerHandle_t xWakeTimer;        /**< ISR timer that removes the task from the Blocked state at ullWakeTimeUs. */
+        StaticISRTimer_t xWakeTimerBuffer;  /**< Holds the xWakeTimer data structure. */
+        uint64_t ullWakeTimeUs;             /**< Time, in microseconds, at which the task's next block must end, or 0 if the block time is only in ticks. */
+    #endif
+
+    #if ( ( configUSE_ARENAS == 1 ) && ( INCLUDE_vTaskDelete == 1 ) )
+        struct ArenaDef_t * pxArenas; /**< The first of the arenas attached to the task with xArenaAttachToTask(), which are deleted with the task. */
+    #endif
+
     /* See the comments in FreeRTOS.h with the definition of
      * tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE. */
     #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
@@ -622,6 +645,18 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * Callback of the ISR timer held in each TCB.  Removes the task from the
+ * Blocked state when its microsecond wake time is reached, as if
+ * xTaskAbortDelay() had been called.
+ */
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+
+    static void prvWakeTimerCallback( ISRTimerHandle_t xTimer,
+                                      BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -1512,7 +1547,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = ( TCB_t * ) poolMALLOC( eObjectPoolTask, sizeof( TCB_t ) );
 
             if( pxNewTCB != NULL )
             {
@@ -1639,7 +1674,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = ( TCB_t * ) poolMALLOC( eObjectPoolTask, sizeof( TCB_t ) );
 
             if( pxNewTCB != NULL )
             {
@@ -1651,12 +1686,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* MISRA Ref 11.5.1 [Malloc memory assignment] */
                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                 /* coverity[misra_c_2012_rule_11_5_violation] */
-                pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ) );
+                pxNewTCB->pxStack = ( StackType_t * ) poolMALLOC_STACK( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ) );
 
                 if( pxNewTCB->pxStack == NULL )
                 {
                     /* Could not allocate the stack.  Delete the allocated TCB. */
-                    vPortFree( pxNewTCB );
+                    poolFREE( pxNewTCB );
                     pxNewTCB = NULL;
                 }
             }
@@ -1669,7 +1704,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxStack = pvPortMallocStack( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ) );
+            pxStack = poolMALLOC_STACK( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ) );
 
             if( pxStack != NULL )
             {
@@ -1677,7 +1712,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* MISRA Ref 11.5.1 [Malloc memory assignment] */
                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                 /* coverity[misra_c_2012_rule_11_5_violation] */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+                pxNewTCB = ( TCB_t * ) poolMALLOC( eObjectPoolTask, sizeof( TCB_t ) );
 
                 if( pxNewTCB != NULL )
                 {
@@ -1690,7 +1725,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 {
                     /* The stack cannot be used as the TCB was not created.  Free
                      * it again. */
-                    vPortFreeStack( pxStack );
+                    poolFREE_STACK( pxStack );
                 }
             }
             else
@@ -1920,6 +1955,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority );
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
+    #if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    {
+        pxNewTCB->ullWakeTimeUs = 0U;
+        pxNewTCB->xWakeTimer = xISRTimerCreateStatic( prvWakeTimerCallback, pxNewTCB, &( pxNewTCB->xWakeTimerBuffer ) );
+    }
+    #endif
+
     #if ( portUSING_MPU_WRAPPERS == 1 )
     {
         vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, uxStackDepth );
@@ -2432,6 +2474,76 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+
+    BaseType_t xTaskDelayUntilUs( uint64_t * const pullPreviousWakeTimeUs,
+                                  const uint32_t ulTimeIncrementUs )
+    {
+        uint64_t ullTimeToWakeUs;
+        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
+
+        traceENTER_xTaskDelayUntilUs( pullPreviousWakeTimeUs, ulTimeIncrementUs );
+
+        configASSERT( pullPreviousWakeTimeUs );
+        configASSERT( ( ulTimeIncrementUs > 0U ) );
+
+        /* Generate the time at which the task wants to wake.  The microsecond
+         * time base is 64 bits wide, so unlike xTaskDelayUntil() there is no
+         * overflow to consider. */
+        ullTimeToWakeUs = *pullPreviousWakeTimeUs + ulTimeIncrementUs;
+
+        /* Update the wake time ready for the next call. */
+        *pullPreviousWakeTimeUs = ullTimeToWakeUs;
+
+        vTaskSuspendAll();
+        {
+            configASSERT( uxSchedulerSuspended == 1U );
+
+            if( ullTimeToWakeUs > ullISRTimerGetTimeUs() )
+            {
+                xShouldDelay = pdTRUE;
+
+                traceTASK_DELAY();
+
+                /* The wake timer started by prvAddCurrentTaskToDelayedList()
+                 * unblocks the task, the tick block time is a backstop. */
+                prvAddCurrentTaskToDelayedList( xTaskBeginTimeoutUs( ullTimeToWakeUs ), pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        xAlreadyYielded = xTaskResumeAll();
+
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            taskYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xShouldDelay != pdFALSE )
+        {
+            vTaskEndTimeoutUs();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskDelayUntilUs( xShouldDelay );
+
+        return xShouldDelay;
+    }
+
+#endif /* configUSE_HIGH_RES_TIMEOUTS */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
     void vTaskDelay( const TickType_t xTicksToDelay )
@@ -4671,6 +4783,166 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 #endif /* INCLUDE_xTaskAbortDelay */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+
+    TickType_t xTaskBeginTimeoutUs( uint64_t ullWakeTimeUs )
+    {
+        const uint64_t ullTimeNowUs = ullISRTimerGetTimeUs();
+        uint64_t ullTicksToWait = 0U;
+
+        traceENTER_xTaskBeginTimeoutUs( ullWakeTimeUs );
+
+        /* Only the calling task reads its own wake time, which it does from
+         * prvAddCurrentTaskToDelayedList(), so no critical section is needed. */
+        pxCurrentTCB->ullWakeTimeUs = ullWakeTimeUs;
+
+        if( ullWakeTimeUs > ullTimeNowUs )
+        {
+            /* Round up so the tick block time never ends before the wake
+             * time. */
+            ullTicksToWait = ( ( ( ullWakeTimeUs - ullTimeNowUs ) * ( uint64_t ) configTICK_RATE_HZ ) + 999999U ) / 1000000U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ullTicksToWait += tskWAKE_TIMER_BACKSTOP_TICKS;
+
+        /* Never block indefinitely, even if INCLUDE_vTaskSuspend is 1. */
+        if( ullTicksToWait >= ( uint64_t ) portMAX_DELAY )
+        {
+            ullTicksToWait = ( uint64_t ) portMAX_DELAY - 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskBeginTimeoutUs( ( TickType_t ) ullTicksToWait );
+
+        return ( TickType_t ) ullTicksToWait;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskEndTimeoutUs( void )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        traceENTER_vTaskEndTimeoutUs();
+
+        /* The task may have been unblocked by something other than its wake
+         * timer, or not have blocked at all, so the timer may still be
+         * running. */
+        ( void ) xISRTimerStop( pxTCB->xWakeTimer );
+        pxTCB->ullWakeTimeUs = 0U;
+
+        traceRETURN_vTaskEndTimeoutUs();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWakeTimerCallback( ISRTimerHandle_t xTimer,
+                                      BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        TCB_t * const pxTCB = pvISRTimerGetTimerID( xTimer );
+        const List_t * pxStateList;
+        BaseType_t xRetry = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+
+            if( ( pxStateList != pxDelayedTaskList ) && ( pxStateList != pxOverflowDelayedTaskList ) )
+            {
+                /* The task has already left the Blocked state. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+            else if( uxSchedulerSuspended != ( UBaseType_t ) 0U )
+            {
+                /* Neither the delayed lists nor the event list the task may be
+                 * waiting on can be accessed from an interrupt while the
+                 * scheduler is suspended, so try again shortly. */
+                xRetry = pdTRUE;
+            }
+            else
+            {
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+                /* As in xTaskAbortDelay(), a task removed from an event list is
+                 * told it was forcibly removed so it treats its block time as
+                 * having expired rather than blocking again. */
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                    pxTCB->ucDelayAborted = ( uint8_t ) pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvAddTaskToReadyList( pxTCB );
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* Mark that a yield is pending in case the port does not
+                         * act on pxHigherPriorityTaskWoken. */
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                        xYieldPendings[ 0 ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+                {
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+                }
+                #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+                #if ( configUSE_TICKLESS_IDLE != 0 )
+                {
+                    /* See xTaskRemoveFromEventList(). */
+                    prvResetNextTaskUnblockTime();
+                }
+                #endif
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xRetry != pdFALSE )
+        {
+            ( void ) xISRTimerStartFromISR( xTimer, ullISRTimerGetTimeUs() + tskWAKE_TIMER_RETRY_US, 0U );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_HIGH_RES_TIMEOUTS */
+/*----------------------------------------------------------*/
+
 BaseType_t xTaskIncrementTick( void )
 {
     TCB_t * pxTCB;
@@ -5507,6 +5779,90 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue )
+    {
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, xItemValue );
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  The event group
+         * calling it guarantees no task is accessing the event list, in the same
+         * way a locked queue guarantees it for xTaskRemoveFromEventList(). */
+
+        /* Store the new item value in the event list. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem );
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxUnblockedTCB );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* See xTaskRemoveFromEventList(). */
+                prvResetNextTaskUnblockTime();
+            }
+            #endif
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed, so hold this task
+             * pending until the scheduler is resumed.  The event list item value
+             * is preserved for the task to read once it runs. */
+            listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+            {
+                /* Mark that a yield is pending in case the user is not using the
+                 * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+                 * function. */
+                xReturn = pdTRUE;
+                xYieldPendings[ 0 ] = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+        {
+            xReturn = pdFALSE;
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                prvYieldForTask( pxUnblockedTCB );
+
+                if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+        }
+        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+        traceRETURN_xTaskRemoveFromUnorderedEventListFromISR( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     traceENTER_vTaskSetTimeOutState( pxTimeOut );
@@ -5991,6 +6347,23 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_ARENAS == 1 ) && ( INCLUDE_vTaskDelete == 1 ) )
+
+    struct ArenaDef_t ** ppxTaskGetArenas( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+
+        /* If null is passed in here then the list of the calling task is
+         * being returned. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        return &( pxTCB->pxArenas );
+    }
+
+#endif /* ( configUSE_ARENAS == 1 ) && ( INCLUDE_vTaskDelete == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
     void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
@@ -6418,12 +6791,35 @@ static void prvCheckTasksWaitingTermination( void )
         }
         #endif
 
+        #if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+        {
+            /* The wake timer is held in the TCB, so must be stopped before the
+             * TCB is freed. */
+            vISRTimerDelete( pxTCB->xWakeTimer );
+        }
+        #endif
+
+        #if ( configUSE_ARENAS == 1 )
+        {
+            /* Reclaim the memory of the arenas the task was using. */
+            vArenaDeleteTaskArenas( pxTCB->pxArenas );
+        }
+        #endif
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            /* Blocks the task allocated may outlive it, so their records must
+             * stop referring to the TCB before it is freed. */
+            vHeapTraceTaskDeleted( pxTCB );
+        }
+        #endif
+
         #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
         {
             /* The task can only have been allocated dynamically - free both
              * the stack and TCB. */
-            vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
+            poolFREE_STACK( pxTCB->pxStack );
+            poolFREE( pxTCB );
         }
         #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
         {
@@ -6434,14 +6830,14 @@ static void prvCheckTasksWaitingTermination( void )
             {
                 /* Both the stack and TCB were allocated dynamically, so both
                  * must be freed. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                poolFREE_STACK( pxTCB->pxStack );
+                poolFREE( pxTCB );
             }
             else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
             {
                 /* Only the stack was statically allocated, so the TCB is the
                  * only memory that must be freed. */
-                vPortFree( pxTCB );
+                poolFREE( pxTCB );
             }
             else
             {
@@ -7716,6 +8112,34 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_HIGH_RES_TIMEOUTS == 1 ) )
+
+    uint32_t ulTaskGenericNotifyTakeUs( UBaseType_t uxIndexToWaitOn,
+                                        BaseType_t xClearCountOnExit,
+                                        uint32_t ulTimeoutUs )
+    {
+        uint32_t ulReturn;
+
+        traceENTER_ulTaskGenericNotifyTakeUs( uxIndexToWaitOn, xClearCountOnExit, ulTimeoutUs );
+
+        if( ulTimeoutUs == 0U )
+        {
+            ulReturn = ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, ( TickType_t ) 0U );
+        }
+        else
+        {
+            ulReturn = ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTaskBeginTimeoutUs( ullISRTimerGetTimeUs() + ulTimeoutUs ) );
+            vTaskEndTimeoutUs();
+        }
+
+        traceRETURN_ulTaskGenericNotifyTakeUs( ulReturn );
+
+        return ulReturn;
+    }
+
+#endif /* ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_HIGH_RES_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
@@ -7831,6 +8255,36 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_HIGH_RES_TIMEOUTS == 1 ) )
+
+    BaseType_t xTaskGenericNotifyWaitUs( UBaseType_t uxIndexToWaitOn,
+                                         uint32_t ulBitsToClearOnEntry,
+                                         uint32_t ulBitsToClearOnExit,
+                                         uint32_t * pulNotificationValue,
+                                         uint32_t ulTimeoutUs )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xTaskGenericNotifyWaitUs( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, ulTimeoutUs );
+
+        if( ulTimeoutUs == 0U )
+        {
+            xReturn = xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, ( TickType_t ) 0U );
+        }
+        else
+        {
+            xReturn = xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTaskBeginTimeoutUs( ullISRTimerGetTimeUs() + ulTimeoutUs ) );
+            vTaskEndTimeoutUs();
+        }
+
+        traceRETURN_xTaskGenericNotifyWaitUs( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_HIGH_RES_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
@@ -8532,6 +8986,23 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         ( void ) xCanBlockIndefinitely;
     }
     #endif /* INCLUDE_vTaskSuspend */
+
+    #if ( configUSE_HIGH_RES_TIMEOUTS == 1 )
+    {
+        /* The task is now in a delayed list, so its wake timer can remove it
+         * from the Blocked state before the tick block time ends.  If the wake
+         * time has already passed the timer expires immediately.  If the timer
+         * cannot be started the tick block time still unblocks the task. */
+        if( pxCurrentTCB->ullWakeTimeUs != 0U )
+        {
+            ( void ) xISRTimerStart( pxCurrentTCB->xWakeTimer, pxCurrentTCB->ullWakeTimeUs, 0U );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_HIGH_RES_TIMEOUTS */
 }
 /*-----------------------------------------------------------*/
 
@@ -8638,6 +9109,23 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         *puxTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
     }
 
+    #if ( ( configUSE_TIMERS == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) )
+
+        void vApplicationGetTimerServiceTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                                    StackType_t ** ppxTimerTaskStackBuffer,
+                                                    configSTACK_DEPTH_TYPE * puxTimerTaskStackSize,
+                                                    BaseType_t xTimerServiceTaskIndex )
+        {
+            static StaticTask_t xTimerTaskTCBs[ configTIMER_SERVICE_TASKS - 1 ];
+            static StackType_t uxTimerTaskStacks[ configTIMER_SERVICE_TASKS - 1 ][ configTIMER_TASK_STACK_DEPTH ];
+
+            *ppxTimerTaskTCBBuffer = &( xTimerTaskTCBs[ xTimerServiceTaskIndex ] );
+            *ppxTimerTaskStackBuffer = &( uxTimerTaskStacks[ xTimerServiceTaskIndex ][ 0 ] );
+            *puxTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+        }
+
+    #endif /* #if ( ( configUSE_TIMERS == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) ) */
+
 #endif /* #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configKERNEL_PROVIDED_STATIC_MEMORY == 1 ) && ( portUSING_MPU_WRAPPERS == 0 ) ) */
 /*-----------------------------------------------------------*/
 
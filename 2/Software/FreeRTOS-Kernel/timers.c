@@ -38,6 +38,7 @@
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "object_pool.h"
 
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
     #error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
@@ -60,7 +61,8 @@
     #define tmrMAX_TIME_BEFORE_OVERFLOW    ( ( TickType_t ) -1 )
 
 /* The name assigned to the timer service task. This can be overridden by
- * defining configTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
+ * defining configTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h.  Timer service
+ * task n, for n greater than 0, has n appended to the name. */
     #ifndef configTIMER_SERVICE_TASK_NAME
         #define configTIMER_SERVICE_TASK_NAME    "Tmr Svc"
     #endif
@@ -79,6 +81,15 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( 0x02U )
     #define tmrSTATUS_IS_AUTORELOAD              ( 0x04U )
 
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+/* Bit definitions used in the ucPendingCommand member of a timer structure. */
+        #define tmrPENDING_CHANGE_PERIOD    ( 0x01U )
+        #define tmrPENDING_START            ( 0x02U )
+        #define tmrPENDING_STOP             ( 0x04U )
+        #define tmrPENDING_DELETE           ( 0x08U )
+    #endif
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                                               /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -90,6 +101,18 @@
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxTimerNumber;                                           /**< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
+        #if ( configUSE_TIMER_SLACK == 1 )
+            TickType_t xTimerSlack;                                              /**< How many ticks after its expiry time the timer may be processed. */
+        #endif
+        #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+            struct tmrTimerControl * pxNextPendingTimer;                         /**< The next timer in the list of timers that have a pending command. */
+            TickType_t xPendingCommandValue;                                     /**< The time at which the pending start or reset command was issued. */
+            TickType_t xPendingPeriod;                                           /**< The period set by the pending change period command. */
+            uint8_t ucPendingCommand;                                            /**< Holds bits to say which commands are pending, or 0 if none are. */
+        #endif
+        #if ( configTIMER_SERVICE_TASKS > 1 )
+            uint8_t ucServiceIndex;                                              /**< The timer service task the timer is assigned to. */
+        #endif
         uint8_t ucStatus;                                                        /**< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
     } xTIMER;
 
@@ -134,33 +157,106 @@
         } u;
     } DaemonTaskMessage_t;
 
-/* The list in which active timers are stored.  Timers are referenced in expire
- * time order, with the nearest expiry time at the front of the list.  Only the
- * timer service task is allowed to access these lists.
- * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
- * breaks some kernel aware debuggers, and debuggers that reply on removing the
- * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
-
-/* A queue that is used to send commands to the timer service task. */
-    PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
-    PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* The number of slots in each level of the timer wheel, and the slot of a given
+ * level. */
+        #define tmrWHEEL_SLOTS                                ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK                            ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+        #define tmrWHEEL_SLOT( pxWheel, uxLevel, uxSlot )    ( &( ( pxWheel )->xSlots[ ( ( uxLevel ) * tmrWHEEL_SLOTS ) + ( uxSlot ) ] ) )
+
+/* The number of bits the tick count is shifted by to obtain the slot of a level. */
+        #define tmrWHEEL_LEVEL_SHIFT( uxLevel )               ( ( uxLevel ) * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+
+/* Active timers are held in a hierarchical timing wheel instead of in sorted
+ * lists.  Level 0 has a slot for each of the next tmrWHEEL_SLOTS ticks.  Each
+ * slot of a higher level spans all the slots of the level below it, so holds
+ * timers that expire further in the future.  When the wheel time reaches the
+ * start of a slot in a higher level, the timers in that slot are placed again
+ * ("cascaded") in the level that now matches their distance from expiring.  A
+ * timer therefore moves down the levels until it reaches level 0, where all
+ * the timers in a slot expire on the same tick.  Starting, stopping and
+ * resetting a timer are O(1) regardless of the number of active timers.  Only
+ * the timer service task is allowed to access the wheel. */
+        typedef struct tmrTimerWheel
+        {
+            TickType_t xTime;                                                                  /**< The tick count up to which the wheel has been processed. */
+            UBaseType_t uxTimersInLevel[ configTIMER_WHEEL_LEVELS ];                           /**< The number of timers in each level, so empty levels can be skipped. */
+            List_t xSlots[ ( size_t ) configTIMER_WHEEL_LEVELS * ( size_t ) tmrWHEEL_SLOTS ]; /**< The slots of all the levels, level 0 first. */
+        } TimerWheel_t;
+
+    #endif /* configUSE_TIMER_WHEEL */
+
+/* Everything owned by one timer service task.  There are
+ * configTIMER_SERVICE_TASKS timer service tasks, each running at its own
+ * priority with its own command queue and active timers, so the callbacks of
+ * the timers assigned to one task are not delayed by the callbacks of the
+ * timers assigned to a lower priority one.  Service 0 is the timer service
+ * task that timers are assigned to by default, and that runs pended function
+ * calls. */
+    typedef struct tmrTimerService
+    {
+        #if ( configUSE_TIMER_WHEEL == 1 )
+            TimerWheel_t xWheel;              /**< The active timers. */
+        #else
+
+            /* The lists in which active timers are stored.  Timers are
+             * referenced in expire time order, with the nearest expiry time at
+             * the front of the list. */
+            List_t xActiveTimerList1;
+            List_t xActiveTimerList2;
+            List_t * pxCurrentTimerList;
+            List_t * pxOverflowTimerList;
+            TickType_t xLastTime;             /**< The tick count when the time was last sampled, used to detect an overflow. */
+        #endif
+        QueueHandle_t xTimerQueue;            /**< A queue that is used to send commands to the timer service task. */
+        TaskHandle_t xTimerTaskHandle;        /**< The timer service task. */
+
+        #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+            /* Timer commands are not queued.  Instead each timer records the
+             * net effect of the commands sent to it since the timer service task
+             * last processed it, and is added to this list, in the order
+             * commands are first sent, until it is processed.  A message is only
+             * queued to wake the timer service task when the list becomes
+             * non-empty, so however many commands are sent to the same timer it
+             * is only re-inserted into the active timers once, and sending a
+             * command never has to wait for space in the queue.  Only accessed
+             * from within a critical section. */
+            Timer_t * pxPendingTimersHead;
+            Timer_t * pxPendingTimersTail;
+        #endif
+    } TimerService_t;
+
+/* Only the timer service task that owns them is allowed to access the active
+ * timers of a service.  The services are at file scope rather than function
+ * scope so kernel aware debuggers can find them. */
+    PRIVILEGED_DATA static TimerService_t xTimerServices[ configTIMER_SERVICE_TASKS ];
+
+/* The timer service task a timer is assigned to. */
+    #if ( configTIMER_SERVICE_TASKS > 1 )
+        #define tmrGET_TIMER_SERVICE( pxTimer )    ( &( xTimerServices[ ( pxTimer )->ucServiceIndex ] ) )
+    #else
+        #define tmrGET_TIMER_SERVICE( pxTimer )    ( &( xTimerServices[ 0 ] ) )
+    #endif
 
 /*-----------------------------------------------------------*/
 
 /*
- * Initialise the infrastructure used by the timer service task if it has not
+ * Initialise the infrastructure used by the timer service tasks if it has not
  * been initialised already.
  */
     static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Create the timer service task of the given service.
+ */
+    static BaseType_t prvCreateTimerServiceTask( const UBaseType_t uxTimerService ) PRIVILEGED_FUNCTION;
+
 /*
  * The timer service task (daemon).  Timer functionality is controlled by this
  * task.  Other tasks communicate with the timer service task using the
- * xTimerQueue queue.
+ * xTimerQueue queue of the service passed in as the task parameter.
  */
     static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION;
 
@@ -168,7 +264,35 @@
  * Called by the timer service task to interpret and process a command it
  * received on the timer queue.
  */
-    static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
+    static void prvProcessReceivedCommands( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+
+/*
+ * Apply a single start, reset, stop, change period or delete command to a
+ * timer.
+ */
+    static void prvProcessTimerCommand( Timer_t * const pxTimer,
+                                        const BaseType_t xCommandID,
+                                        const TickType_t xCommandValue ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+/*
+ * Merge a command into the commands pending for a timer, adding the timer to
+ * the list of timers with pending commands if it is not already in it.  Called
+ * from a critical section.  Returns pdTRUE if the list was empty, in which case
+ * the timer service task must be woken.
+ */
+        static BaseType_t prvPendTimerCommand( Timer_t * const pxTimer,
+                                               const BaseType_t xCommandID,
+                                               const TickType_t xCommandValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the timer service task to apply the commands pending for each timer
+ * in the list of timers with pending commands.
+ */
+        static void prvProcessPendingTimerCommands( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_COMMAND_COALESCING */
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
@@ -179,6 +303,20 @@
                                                   const TickType_t xTimeNow,
                                                   const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove the timer from the active timer list, or timer wheel slot, that it
+ * is in.  The timer must be in one.
+ */
+    static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place a timer whose list item value holds its expiry time in the slot of the
+ * timer wheel that matches how far its expiry time is from the wheel time.
+ */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        static void prvPlaceTimerInWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+    #endif
+
 /*
  * Reload the specified auto-reload timer.  If the reloading is backlogged,
  * clear the backlog, calling the callback for each additional reload.  When
@@ -190,22 +328,30 @@
 
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
- * auto-reload timer, then call its callback.
+ * auto-reload timer, then call its callback.  When configUSE_TIMER_WHEEL is 1
+ * the wheel is advanced to xTimeNow instead, and every timer that expires on
+ * the way is processed.
  */
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+    static void prvProcessExpiredTimer( TimerService_t * const pxService,
+                                        const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * current timer list does not still reference some timers.  The timer wheel
+ * does not need switching as slots are selected using unsigned arithmetic
+ * that is correct across an overflow.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+    #if ( configUSE_TIMER_WHEEL == 0 )
+        static void prvSwitchTimerLists( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+    #endif
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
  * if a tick count overflow occurred since prvSampleTimeNow() was last called.
  */
-    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+    static TickType_t prvSampleTimeNow( TimerService_t * const pxService,
+                                        BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
 
 /*
  * If the timer list contains any active timers then return the expire time of
@@ -213,13 +359,25 @@
  * timer list does not contain any timers then return 0 and set *pxListWasEmpty
  * to pdTRUE.
  */
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+    static TickType_t prvGetNextExpireTime( TimerService_t * const pxService,
+                                            BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the latest time the timer service task can sleep until without any
+ * timer being processed later than its expiry time plus its slack.  Only
+ * called when there is at least one active timer and none have expired.
+ */
+    #if ( configUSE_TIMER_SLACK == 1 )
+        static TickType_t prvGetLatestWakeTime( TimerService_t * const pxService,
+                                                const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+    #endif
 
 /*
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
  */
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+    static void prvProcessTimerOrBlockTask( TimerService_t * const pxService,
+                                            TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
 
 /*
@@ -231,101 +389,227 @@
                                        const BaseType_t xAutoReload,
                                        void * const pvTimerID,
                                        TimerCallbackFunction_t pxCallbackFunction,
+                                       const UBaseType_t uxTimerService,
                                        Timer_t * pxNewTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocate and initialise a timer assigned to the given timer service task.
+ */
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        static TimerHandle_t prvCreateTimer( const char * const pcTimerName,
+                                             const TickType_t xTimerPeriodInTicks,
+                                             const BaseType_t xAutoReload,
+                                             void * const pvTimerID,
+                                             TimerCallbackFunction_t pxCallbackFunction,
+                                             const UBaseType_t uxTimerService ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Initialise a timer, assigned to the given timer service task, in the memory
+ * provided.
+ */
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        static TimerHandle_t prvCreateStaticTimer( const char * const pcTimerName,
+                                                   const TickType_t xTimerPeriodInTicks,
+                                                   const BaseType_t xAutoReload,
+                                                   void * const pvTimerID,
+                                                   TimerCallbackFunction_t pxCallbackFunction,
+                                                   StaticTimer_t * pxTimerBuffer,
+                                                   const UBaseType_t uxTimerService ) PRIVILEGED_FUNCTION;
+    #endif
 /*-----------------------------------------------------------*/
 
     BaseType_t xTimerCreateTimerTask( void )
     {
         BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxTimerService;
 
         traceENTER_xTimerCreateTimerTask();
 
         /* This function is called when the scheduler is started if
          * configUSE_TIMERS is set to 1.  Check that the infrastructure used by the
-         * timer service task has been created/initialised.  If timers have already
-         * been created then the initialisation will already have been performed. */
+         * timer service tasks has been created/initialised.  If timers have
+         * already been created then the initialisation will already have been
+         * performed. */
         prvCheckForValidListAndQueue();
 
-        if( xTimerQueue != NULL )
+        if( xTimerServices[ 0 ].xTimerQueue != NULL )
         {
-            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+            xReturn = pdPASS;
+
+            for( uxTimerService = 0; ( uxTimerService < ( UBaseType_t ) configTIMER_SERVICE_TASKS ) && ( xReturn == pdPASS ); uxTimerService++ )
+            {
+                xReturn = prvCreateTimerServiceTask( uxTimerService );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        configASSERT( xReturn );
+
+        traceRETURN_xTimerCreateTimerTask( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCreateTimerServiceTask( const UBaseType_t uxTimerService )
+    {
+        TimerService_t * const pxService = &( xTimerServices[ uxTimerService ] );
+        UBaseType_t uxPriority;
+        BaseType_t xReturn = pdFAIL;
+        char cServiceName[ configMAX_TASK_NAME_LEN ];
+        UBaseType_t uxNameIndex;
+
+        for( uxNameIndex = ( UBaseType_t ) 0; uxNameIndex < ( UBaseType_t ) configMAX_TASK_NAME_LEN; uxNameIndex++ )
+        {
+            cServiceName[ uxNameIndex ] = configTIMER_SERVICE_TASK_NAME[ uxNameIndex ];
+
+            /* Don't copy all configMAX_TASK_NAME_LEN if the string is shorter than
+             * configMAX_TASK_NAME_LEN characters just in case the memory after the
+             * string is not accessible (extremely unlikely). */
+            if( cServiceName[ uxNameIndex ] == ( char ) 0x00 )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        #if ( configTIMER_SERVICE_TASKS > 1 )
+        {
+            /* Append the service number to the names of the additional timer
+             * service tasks, if there is space, so the tasks can be told apart.
+             * Timer service task 0 keeps the plain name. */
+            if( uxTimerService > ( UBaseType_t ) 0U )
             {
-                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                char cDigits[ 3 ];
+                UBaseType_t uxDigits = ( UBaseType_t ) 0U;
+                UBaseType_t uxValue = uxTimerService;
+
+                do
                 {
-                    StaticTask_t * pxTimerTaskTCBBuffer = NULL;
-                    StackType_t * pxTimerTaskStackBuffer = NULL;
-                    configSTACK_DEPTH_TYPE uxTimerTaskStackSize;
+                    cDigits[ uxDigits ] = ( char ) ( '0' + ( char ) ( uxValue % ( UBaseType_t ) 10U ) );
+                    uxDigits++;
+                    uxValue /= ( UBaseType_t ) 10U;
+                } while( uxValue > ( UBaseType_t ) 0U );
 
-                    vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &uxTimerTaskStackSize );
-                    xTimerTaskHandle = xTaskCreateStaticAffinitySet( prvTimerTask,
-                                                                     configTIMER_SERVICE_TASK_NAME,
-                                                                     uxTimerTaskStackSize,
-                                                                     NULL,
-                                                                     ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-                                                                     pxTimerTaskStackBuffer,
-                                                                     pxTimerTaskTCBBuffer,
-                                                                     configTIMER_SERVICE_TASK_CORE_AFFINITY );
-
-                    if( xTimerTaskHandle != NULL )
-                    {
-                        xReturn = pdPASS;
-                    }
+                while( ( uxDigits > ( UBaseType_t ) 0U ) && ( uxNameIndex < ( UBaseType_t ) configMAX_TASK_NAME_LEN ) )
+                {
+                    uxDigits--;
+                    cServiceName[ uxNameIndex ] = cDigits[ uxDigits ];
+                    uxNameIndex++;
                 }
-                #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+
+                /* And append a null character if there is space. */
+                if( uxNameIndex < ( UBaseType_t ) configMAX_TASK_NAME_LEN )
+                {
+                    cServiceName[ uxNameIndex ] = '\0';
+                }
+                else
                 {
-                    xReturn = xTaskCreateAffinitySet( prvTimerTask,
-                                                      configTIMER_SERVICE_TASK_NAME,
-                                                      configTIMER_TASK_STACK_DEPTH,
-                                                      NULL,
-                                                      ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-                                                      configTIMER_SERVICE_TASK_CORE_AFFINITY,
-                                                      &xTimerTaskHandle );
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                #endif /* configSUPPORT_STATIC_ALLOCATION */
             }
-            #else /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+            else
             {
-                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-                {
-                    StaticTask_t * pxTimerTaskTCBBuffer = NULL;
-                    StackType_t * pxTimerTaskStackBuffer = NULL;
-                    configSTACK_DEPTH_TYPE uxTimerTaskStackSize;
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configTIMER_SERVICE_TASKS */
+
+        /* Timer service task 0 runs at configTIMER_TASK_PRIORITY, the others at
+         * the priority given by configTIMER_SERVICE_TASK_PRIORITY(). */
+        if( uxTimerService == ( UBaseType_t ) 0U )
+        {
+            uxPriority = ( UBaseType_t ) configTIMER_TASK_PRIORITY;
+        }
+        else
+        {
+            uxPriority = ( UBaseType_t ) configTIMER_SERVICE_TASK_PRIORITY( uxTimerService );
+        }
 
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            StaticTask_t * pxTimerTaskTCBBuffer = NULL;
+            StackType_t * pxTimerTaskStackBuffer = NULL;
+            configSTACK_DEPTH_TYPE uxTimerTaskStackSize;
+
+            #if ( configTIMER_SERVICE_TASKS > 1 )
+            {
+                if( uxTimerService == ( UBaseType_t ) 0U )
+                {
                     vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &uxTimerTaskStackSize );
-                    xTimerTaskHandle = xTaskCreateStatic( prvTimerTask,
-                                                          configTIMER_SERVICE_TASK_NAME,
-                                                          uxTimerTaskStackSize,
-                                                          NULL,
-                                                          ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-                                                          pxTimerTaskStackBuffer,
-                                                          pxTimerTaskTCBBuffer );
-
-                    if( xTimerTaskHandle != NULL )
-                    {
-                        xReturn = pdPASS;
-                    }
                 }
-                #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+                else
                 {
-                    xReturn = xTaskCreate( prvTimerTask,
-                                           configTIMER_SERVICE_TASK_NAME,
-                                           configTIMER_TASK_STACK_DEPTH,
-                                           NULL,
-                                           ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-                                           &xTimerTaskHandle );
+                    vApplicationGetTimerServiceTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &uxTimerTaskStackSize, ( BaseType_t ) ( uxTimerService - ( UBaseType_t ) 1U ) );
                 }
-                #endif /* configSUPPORT_STATIC_ALLOCATION */
+            }
+            #else
+            {
+                vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &uxTimerTaskStackSize );
+            }
+            #endif /* configTIMER_SERVICE_TASKS */
+
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+            {
+                pxService->xTimerTaskHandle = xTaskCreateStaticAffinitySet( prvTimerTask,
+                                                                            cServiceName,
+                                                                            uxTimerTaskStackSize,
+                                                                            ( void * ) pxService,
+                                                                            uxPriority | portPRIVILEGE_BIT,
+                                                                            pxTimerTaskStackBuffer,
+                                                                            pxTimerTaskTCBBuffer,
+                                                                            configTIMER_SERVICE_TASK_CORE_AFFINITY );
+            }
+            #else
+            {
+                pxService->xTimerTaskHandle = xTaskCreateStatic( prvTimerTask,
+                                                                 cServiceName,
+                                                                 uxTimerTaskStackSize,
+                                                                 ( void * ) pxService,
+                                                                 uxPriority | portPRIVILEGE_BIT,
+                                                                 pxTimerTaskStackBuffer,
+                                                                 pxTimerTaskTCBBuffer );
             }
             #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+
+            if( pxService->xTimerTaskHandle != NULL )
+            {
+                xReturn = pdPASS;
+            }
         }
-        else
+        #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
         {
-            mtCOVERAGE_TEST_MARKER();
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+            {
+                xReturn = xTaskCreateAffinitySet( prvTimerTask,
+                                                  cServiceName,
+                                                  configTIMER_TASK_STACK_DEPTH,
+                                                  ( void * ) pxService,
+                                                  uxPriority | portPRIVILEGE_BIT,
+                                                  configTIMER_SERVICE_TASK_CORE_AFFINITY,
+                                                  &( pxService->xTimerTaskHandle ) );
+            }
+            #else
+            {
+                xReturn = xTaskCreate( prvTimerTask,
+                                       cServiceName,
+                                       configTIMER_TASK_STACK_DEPTH,
+                                       ( void * ) pxService,
+                                       uxPriority | portPRIVILEGE_BIT,
+                                       &( pxService->xTimerTaskHandle ) );
+            }
+            #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
         }
-
-        configASSERT( xReturn );
-
-        traceRETURN_xTimerCreateTimerTask( xReturn );
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
 
         return xReturn;
     }
@@ -339,14 +623,58 @@
                                     void * const pvTimerID,
                                     TimerCallbackFunction_t pxCallbackFunction )
         {
-            Timer_t * pxNewTimer;
+            TimerHandle_t xReturn;
 
             traceENTER_xTimerCreate( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction );
 
+            xReturn = prvCreateTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, ( UBaseType_t ) 0U );
+
+            traceRETURN_xTimerCreate( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) )
+
+        TimerHandle_t xTimerCreateOnService( const char * const pcTimerName,
+                                             const TickType_t xTimerPeriodInTicks,
+                                             const BaseType_t xAutoReload,
+                                             void * const pvTimerID,
+                                             TimerCallbackFunction_t pxCallbackFunction,
+                                             const UBaseType_t uxTimerService )
+        {
+            TimerHandle_t xReturn;
+
+            traceENTER_xTimerCreateOnService( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, uxTimerService );
+
+            xReturn = prvCreateTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, uxTimerService );
+
+            traceRETURN_xTimerCreateOnService( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        static TimerHandle_t prvCreateTimer( const char * const pcTimerName,
+                                             const TickType_t xTimerPeriodInTicks,
+                                             const BaseType_t xAutoReload,
+                                             void * const pvTimerID,
+                                             TimerCallbackFunction_t pxCallbackFunction,
+                                             const UBaseType_t uxTimerService )
+        {
+            Timer_t * pxNewTimer;
+
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) );
+            pxNewTimer = ( Timer_t * ) poolMALLOC( eObjectPoolTimer, sizeof( Timer_t ) );
 
             if( pxNewTimer != NULL )
             {
@@ -354,11 +682,9 @@
                  * and has not been started.  The auto-reload bit may get set in
                  * prvInitialiseNewTimer. */
                 pxNewTimer->ucStatus = 0x00;
-                prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+                prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, uxTimerService, pxNewTimer );
             }
 
-            traceRETURN_xTimerCreate( pxNewTimer );
-
             return pxNewTimer;
         }
 
@@ -374,10 +700,56 @@
                                           TimerCallbackFunction_t pxCallbackFunction,
                                           StaticTimer_t * pxTimerBuffer )
         {
-            Timer_t * pxNewTimer;
+            TimerHandle_t xReturn;
 
             traceENTER_xTimerCreateStatic( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer );
 
+            xReturn = prvCreateStaticTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer, ( UBaseType_t ) 0U );
+
+            traceRETURN_xTimerCreateStatic( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) )
+
+        TimerHandle_t xTimerCreateStaticOnService( const char * const pcTimerName,
+                                                   const TickType_t xTimerPeriodInTicks,
+                                                   const BaseType_t xAutoReload,
+                                                   void * const pvTimerID,
+                                                   TimerCallbackFunction_t pxCallbackFunction,
+                                                   StaticTimer_t * pxTimerBuffer,
+                                                   const UBaseType_t uxTimerService )
+        {
+            TimerHandle_t xReturn;
+
+            traceENTER_xTimerCreateStaticOnService( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer, uxTimerService );
+
+            xReturn = prvCreateStaticTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer, uxTimerService );
+
+            traceRETURN_xTimerCreateStaticOnService( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configTIMER_SERVICE_TASKS > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        static TimerHandle_t prvCreateStaticTimer( const char * const pcTimerName,
+                                                   const TickType_t xTimerPeriodInTicks,
+                                                   const BaseType_t xAutoReload,
+                                                   void * const pvTimerID,
+                                                   TimerCallbackFunction_t pxCallbackFunction,
+                                                   StaticTimer_t * pxTimerBuffer,
+                                                   const UBaseType_t uxTimerService )
+        {
+            Timer_t * pxNewTimer;
+
             #if ( configASSERT_DEFINED == 1 )
             {
                 /* Sanity check that the size of the structure used to declare a
@@ -403,11 +775,9 @@
                  * auto-reload bit may get set in prvInitialiseNewTimer(). */
                 pxNewTimer->ucStatus = ( uint8_t ) tmrSTATUS_IS_STATICALLY_ALLOCATED;
 
-                prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+                prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, uxTimerService, pxNewTimer );
             }
 
-            traceRETURN_xTimerCreateStatic( pxNewTimer );
-
             return pxNewTimer;
         }
 
@@ -419,11 +789,15 @@
                                        const BaseType_t xAutoReload,
                                        void * const pvTimerID,
                                        TimerCallbackFunction_t pxCallbackFunction,
+                                       const UBaseType_t uxTimerService,
                                        Timer_t * pxNewTimer )
     {
         /* 0 is not a valid value for xTimerPeriodInTicks. */
         configASSERT( ( xTimerPeriodInTicks > 0 ) );
 
+        /* The timer must be assigned to a timer service task that exists. */
+        configASSERT( uxTimerService < ( UBaseType_t ) configTIMER_SERVICE_TASKS );
+
         /* Ensure the infrastructure used by the timer service task has been
          * created/initialised. */
         prvCheckForValidListAndQueue();
@@ -436,6 +810,31 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configTIMER_SERVICE_TASKS > 1 )
+        {
+            pxNewTimer->ucServiceIndex = ( uint8_t ) uxTimerService;
+        }
+        #else
+        {
+            ( void ) uxTimerService;
+        }
+        #endif
+
+        #if ( configUSE_TIMER_SLACK == 1 )
+        {
+            pxNewTimer->xTimerSlack = ( TickType_t ) 0U;
+        }
+        #endif
+
+        #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+        {
+            pxNewTimer->pxNextPendingTimer = NULL;
+            pxNewTimer->xPendingCommandValue = ( TickType_t ) 0U;
+            pxNewTimer->xPendingPeriod = ( TickType_t ) 0U;
+            pxNewTimer->ucPendingCommand = ( uint8_t ) 0U;
+        }
+        #endif
+
         if( xAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_AUTORELOAD;
@@ -453,35 +852,75 @@
     {
         BaseType_t xReturn = pdFAIL;
         DaemonTaskMessage_t xMessage;
+        TimerService_t * pxService;
 
         ( void ) pxHigherPriorityTaskWoken;
 
         traceENTER_xTimerGenericCommandFromTask( xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken, xTicksToWait );
 
         configASSERT( xTimer );
+        pxService = tmrGET_TIMER_SERVICE( xTimer );
 
         /* Send a message to the timer service task to perform a particular action
          * on a particular timer definition. */
-        if( xTimerQueue != NULL )
+        if( pxService->xTimerQueue != NULL )
         {
-            /* Send a command to the timer service task to start the xTimer timer. */
-            xMessage.xMessageID = xCommandID;
-            xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
-            xMessage.u.xTimerParameters.pxTimer = xTimer;
-
             configASSERT( xCommandID < tmrFIRST_FROM_ISR_COMMAND );
 
-            if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+            #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
             {
-                if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+                BaseType_t xWakeTimerTask = pdFALSE;
+
+                /* Pending a command never blocks. */
+                ( void ) xTicksToWait;
+
+                if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        xWakeTimerTask = prvPendTimerCommand( xTimer, xCommandID, xOptionalValue );
+                    }
+                    taskEXIT_CRITICAL();
+
+                    xReturn = pdPASS;
+                }
+
+                if( xWakeTimerTask != pdFALSE )
                 {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                    xMessage.xMessageID = tmrCOMMAND_PROCESS_PENDING;
+                    xMessage.u.xTimerParameters.xMessageValue = ( TickType_t ) 0U;
+                    xMessage.u.xTimerParameters.pxTimer = NULL;
+
+                    /* If the queue is full the timer service task is going to
+                     * run anyway, and it processes the pending commands each
+                     * time it empties the queue, so the result is not needed. */
+                    ( void ) xQueueSendToBack( pxService->xTimerQueue, &xMessage, tmrNO_DELAY );
                 }
                 else
                 {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* if ( configUSE_TIMER_COMMAND_COALESCING == 1 ) */
+            {
+                /* Send a command to the timer service task to start the xTimer timer. */
+                xMessage.xMessageID = xCommandID;
+                xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+                xMessage.u.xTimerParameters.pxTimer = xTimer;
+
+                if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+                {
+                    if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+                    {
+                        xReturn = xQueueSendToBack( pxService->xTimerQueue, &xMessage, xTicksToWait );
+                    }
+                    else
+                    {
+                        xReturn = xQueueSendToBack( pxService->xTimerQueue, &xMessage, tmrNO_DELAY );
+                    }
                 }
             }
+            #endif /* configUSE_TIMER_COMMAND_COALESCING */
 
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
         }
@@ -504,28 +943,65 @@
     {
         BaseType_t xReturn = pdFAIL;
         DaemonTaskMessage_t xMessage;
+        TimerService_t * pxService;
 
         ( void ) xTicksToWait;
 
         traceENTER_xTimerGenericCommandFromISR( xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken, xTicksToWait );
 
         configASSERT( xTimer );
+        pxService = tmrGET_TIMER_SERVICE( xTimer );
 
         /* Send a message to the timer service task to perform a particular action
          * on a particular timer definition. */
-        if( xTimerQueue != NULL )
+        if( pxService->xTimerQueue != NULL )
         {
-            /* Send a command to the timer service task to start the xTimer timer. */
-            xMessage.xMessageID = xCommandID;
-            xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
-            xMessage.u.xTimerParameters.pxTimer = xTimer;
-
             configASSERT( xCommandID >= tmrFIRST_FROM_ISR_COMMAND );
 
-            if( xCommandID >= tmrFIRST_FROM_ISR_COMMAND )
+            #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+            {
+                BaseType_t xWakeTimerTask = pdFALSE;
+                UBaseType_t uxSavedInterruptStatus;
+
+                if( xCommandID >= tmrFIRST_FROM_ISR_COMMAND )
+                {
+                    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                    {
+                        xWakeTimerTask = prvPendTimerCommand( xTimer, xCommandID, xOptionalValue );
+                    }
+                    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+                    xReturn = pdPASS;
+                }
+
+                if( xWakeTimerTask != pdFALSE )
+                {
+                    xMessage.xMessageID = tmrCOMMAND_PROCESS_PENDING;
+                    xMessage.u.xTimerParameters.xMessageValue = ( TickType_t ) 0U;
+                    xMessage.u.xTimerParameters.pxTimer = NULL;
+
+                    /* As in xTimerGenericCommandFromTask(), a full queue means
+                     * the pending commands will be processed anyway. */
+                    ( void ) xQueueSendToBackFromISR( pxService->xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* if ( configUSE_TIMER_COMMAND_COALESCING == 1 ) */
             {
-                xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+                /* Send a command to the timer service task to start the xTimer timer. */
+                xMessage.xMessageID = xCommandID;
+                xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+                xMessage.u.xTimerParameters.pxTimer = xTimer;
+
+                if( xCommandID >= tmrFIRST_FROM_ISR_COMMAND )
+                {
+                    xReturn = xQueueSendToBackFromISR( pxService->xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+                }
             }
+            #endif /* configUSE_TIMER_COMMAND_COALESCING */
 
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
         }
@@ -546,36 +1022,73 @@
 
         /* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
          * started, then xTimerTaskHandle will be NULL. */
-        configASSERT( ( xTimerTaskHandle != NULL ) );
+        configASSERT( ( xTimerServices[ 0 ].xTimerTaskHandle != NULL ) );
 
-        traceRETURN_xTimerGetTimerDaemonTaskHandle( xTimerTaskHandle );
+        traceRETURN_xTimerGetTimerDaemonTaskHandle( xTimerServices[ 0 ].xTimerTaskHandle );
 
-        return xTimerTaskHandle;
+        return xTimerServices[ 0 ].xTimerTaskHandle;
     }
 /*-----------------------------------------------------------*/
 
-    TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
-    {
-        Timer_t * pxTimer = xTimer;
+    #if ( configTIMER_SERVICE_TASKS > 1 )
 
-        traceENTER_xTimerGetPeriod( xTimer );
+        TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxTimerService )
+        {
+            traceENTER_xTimerGetTimerServiceTaskHandle( uxTimerService );
 
-        configASSERT( xTimer );
+            configASSERT( uxTimerService < ( UBaseType_t ) configTIMER_SERVICE_TASKS );
 
-        traceRETURN_xTimerGetPeriod( pxTimer->xTimerPeriodInTicks );
+            /* The handle is NULL until the scheduler has been started. */
+            configASSERT( ( xTimerServices[ uxTimerService ].xTimerTaskHandle != NULL ) );
 
-        return pxTimer->xTimerPeriodInTicks;
-    }
-/*-----------------------------------------------------------*/
+            traceRETURN_xTimerGetTimerServiceTaskHandle( xTimerServices[ uxTimerService ].xTimerTaskHandle );
 
-    void vTimerSetReloadMode( TimerHandle_t xTimer,
-                              const BaseType_t xAutoReload )
-    {
-        Timer_t * pxTimer = xTimer;
+            return xTimerServices[ uxTimerService ].xTimerTaskHandle;
+        }
 
-        traceENTER_vTimerSetReloadMode( xTimer, xAutoReload );
+    #endif /* configTIMER_SERVICE_TASKS */
+/*-----------------------------------------------------------*/
 
-        configASSERT( xTimer );
+    #if ( configTIMER_SERVICE_TASKS > 1 )
+
+        UBaseType_t uxTimerGetTimerService( TimerHandle_t xTimer )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            traceENTER_uxTimerGetTimerService( xTimer );
+
+            configASSERT( xTimer );
+
+            traceRETURN_uxTimerGetTimerService( ( UBaseType_t ) pxTimer->ucServiceIndex );
+
+            return ( UBaseType_t ) pxTimer->ucServiceIndex;
+        }
+
+    #endif /* configTIMER_SERVICE_TASKS */
+/*-----------------------------------------------------------*/
+
+    TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
+    {
+        Timer_t * pxTimer = xTimer;
+
+        traceENTER_xTimerGetPeriod( xTimer );
+
+        configASSERT( xTimer );
+
+        traceRETURN_xTimerGetPeriod( pxTimer->xTimerPeriodInTicks );
+
+        return pxTimer->xTimerPeriodInTicks;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTimerSetReloadMode( TimerHandle_t xTimer,
+                              const BaseType_t xAutoReload )
+    {
+        Timer_t * pxTimer = xTimer;
+
+        traceENTER_vTimerSetReloadMode( xTimer, xAutoReload );
+
+        configASSERT( xTimer );
         taskENTER_CRITICAL();
         {
             if( xAutoReload != pdFALSE )
@@ -593,6 +1106,52 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        void vTimerSetSlack( TimerHandle_t xTimer,
+                             const TickType_t xSlack )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            traceENTER_vTimerSetSlack( xTimer, xSlack );
+
+            configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                pxTimer->xTimerSlack = xSlack;
+            }
+            taskEXIT_CRITICAL();
+
+            traceRETURN_vTimerSetSlack();
+        }
+
+    #endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+        {
+            Timer_t * pxTimer = xTimer;
+            TickType_t xReturn;
+
+            traceENTER_xTimerGetSlack( xTimer );
+
+            configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                xReturn = pxTimer->xTimerSlack;
+            }
+            taskEXIT_CRITICAL();
+
+            traceRETURN_xTimerGetSlack( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
     BaseType_t xTimerGetReloadMode( TimerHandle_t xTimer )
     {
         Timer_t * pxTimer = xTimer;
@@ -715,51 +1274,161 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
-                                        const TickType_t xTimeNow )
-    {
-        /* MISRA Ref 11.5.3 [Void pointer assignment] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-        /* coverity[misra_c_2012_rule_11_5_violation] */
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvProcessExpiredTimer( TimerService_t * const pxService,
+                                            const TickType_t xNextExpireTime,
+                                            const TickType_t xTimeNow )
+        {
+            TimerWheel_t * const pxWheel = &( pxService->xWheel );
+            Timer_t * pxTimer;
+            List_t * pxSlot;
+            TickType_t xNextTime;
+            UBaseType_t uxLevel;
 
-        /* Remove the timer from the list of active timers.  A check has already
-         * been performed to ensure the list is not empty. */
+            ( void ) xNextExpireTime;
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            while( pxWheel->xTime != xTimeNow )
+            {
+                /* Find the lowest level that holds any timers.  Nothing can
+                 * happen before the wheel time reaches the start of the next slot
+                 * in that level, so the wheel can move straight there. */
+                uxLevel = 0;
 
-        /* If the timer is an auto-reload timer then calculate the next
-         * expiry time and re-insert the timer in the list of active timers. */
-        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
-        {
-            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+                while( ( uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS ) && ( pxWheel->uxTimersInLevel[ uxLevel ] == ( UBaseType_t ) 0U ) )
+                {
+                    uxLevel++;
+                }
+
+                if( uxLevel == ( UBaseType_t ) configTIMER_WHEEL_LEVELS )
+                {
+                    /* The wheel is empty. */
+                    xNextTime = xTimeNow;
+                }
+                else
+                {
+                    xNextTime = ( ( pxWheel->xTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) + ( TickType_t ) 1U ) << tmrWHEEL_LEVEL_SHIFT( uxLevel );
+
+                    if( ( TickType_t ) ( xNextTime - pxWheel->xTime ) > ( TickType_t ) ( xTimeNow - pxWheel->xTime ) )
+                    {
+                        xNextTime = xTimeNow;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                pxWheel->xTime = xNextTime;
+
+                /* Cascade the slot of each higher level whose start has been
+                 * reached. */
+                for( uxLevel = 1; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                {
+                    if( ( pxWheel->xTime & ( ( ( TickType_t ) 1U << tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1U ) ) != ( TickType_t ) 0U )
+                    {
+                        break;
+                    }
+
+                    pxSlot = tmrWHEEL_SLOT( pxWheel, uxLevel, ( UBaseType_t ) ( ( pxWheel->xTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK ) );
+
+                    while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                    {
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+                        prvRemoveTimerFromActiveList( pxTimer );
+                        prvPlaceTimerInWheel( pxTimer );
+                    }
+                }
+
+                /* Every timer in the level 0 slot of the wheel time expires now. */
+                pxSlot = tmrWHEEL_SLOT( pxWheel, 0U, ( UBaseType_t ) ( pxWheel->xTime & tmrWHEEL_SLOT_MASK ) );
+
+                while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                {
+                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                    /* coverity[misra_c_2012_rule_11_5_violation] */
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+                    prvRemoveTimerFromActiveList( pxTimer );
+
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+                    {
+                        prvReloadTimer( pxTimer, pxWheel->xTime, xTimeNow );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+
+                    /* Call the timer callback. */
+                    traceTIMER_EXPIRED( pxTimer );
+                    pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                }
+            }
         }
-        else
+
+    #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
+
+        static void prvProcessExpiredTimer( TimerService_t * const pxService,
+                                            const TickType_t xNextExpireTime,
+                                            const TickType_t xTimeNow )
         {
-            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
+
+            /* Remove the timer from the list of active timers.  A check has already
+             * been performed to ensure the list is not empty. */
+
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+            /* If the timer is an auto-reload timer then calculate the next
+             * expiry time and re-insert the timer in the list of active timers. */
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+            {
+                prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            }
+
+            /* Call the timer callback. */
+            traceTIMER_EXPIRED( pxTimer );
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
         }
 
-        /* Call the timer callback. */
-        traceTIMER_EXPIRED( pxTimer );
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-    }
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static portTASK_FUNCTION( prvTimerTask, pvParameters )
     {
+        /* MISRA Ref 11.5.4 [Callback function parameter] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        TimerService_t * const pxService = ( TimerService_t * ) pvParameters;
         TickType_t xNextExpireTime;
         BaseType_t xListWasEmpty;
 
-        /* Just to avoid compiler warnings. */
-        ( void ) pvParameters;
-
         #if ( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
         {
             /* Allow the application writer to execute some code in the context of
              * this task at the point the task starts executing.  This is useful if the
              * application includes initialisation code that would benefit from
-             * executing after the scheduler has been started. */
-            vApplicationDaemonTaskStartupHook();
+             * executing after the scheduler has been started.  Only timer service
+             * task 0 calls the hook. */
+            if( pxService == &( xTimerServices[ 0 ] ) )
+            {
+                vApplicationDaemonTaskStartupHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         #endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
 
@@ -767,23 +1436,25 @@
         {
             /* Query the timers list to see if it contains any timers, and if so,
              * obtain the time at which the next timer will expire. */
-            xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+            xNextExpireTime = prvGetNextExpireTime( pxService, &xListWasEmpty );
 
             /* If a timer has expired, process it.  Otherwise, block this task
              * until either a timer does expire, or a command is received. */
-            prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+            prvProcessTimerOrBlockTask( pxService, xNextExpireTime, xListWasEmpty );
 
             /* Empty the command queue. */
-            prvProcessReceivedCommands();
+            prvProcessReceivedCommands( pxService );
         }
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+    static void prvProcessTimerOrBlockTask( TimerService_t * const pxService,
+                                            TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty )
     {
         TickType_t xTimeNow;
         BaseType_t xTimerListsWereSwitched;
+        BaseType_t xTimerHasExpired;
 
         vTaskSuspendAll();
         {
@@ -792,15 +1463,28 @@
              * then don't process this timer as any timers that remained in the list
              * when the lists were switched will have been processed within the
              * prvSampleTimeNow() function. */
-            xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+            xTimeNow = prvSampleTimeNow( pxService, &xTimerListsWereSwitched );
 
             if( xTimerListsWereSwitched == pdFALSE )
             {
                 /* The tick count has not overflowed, has the timer expired? */
-                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    /* The next expire time is never before the wheel time, so
+                     * measuring both times from the wheel time gives the correct
+                     * result across a tick count overflow. */
+                    xTimerHasExpired = ( ( TickType_t ) ( xNextExpireTime - pxService->xWheel.xTime ) <= ( TickType_t ) ( xTimeNow - pxService->xWheel.xTime ) ) ? pdTRUE : pdFALSE;
+                }
+                #else
+                {
+                    xTimerHasExpired = ( xNextExpireTime <= xTimeNow ) ? pdTRUE : pdFALSE;
+                }
+                #endif
+
+                if( ( xListWasEmpty == pdFALSE ) && ( xTimerHasExpired != pdFALSE ) )
                 {
                     ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                    prvProcessExpiredTimer( pxService, xNextExpireTime, xTimeNow );
                 }
                 else
                 {
@@ -810,14 +1494,34 @@
                      * received - whichever comes first.  The following line cannot
                      * be reached unless xNextExpireTime > xTimeNow, except in the
                      * case when the current timer list is empty. */
-                    if( xListWasEmpty != pdFALSE )
+                    #if ( configUSE_TIMER_WHEEL == 0 )
                     {
-                        /* The current timer list is empty - is the overflow list
-                         * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        if( xListWasEmpty != pdFALSE )
+                        {
+                            /* The current timer list is empty - is the overflow list
+                             * also empty? */
+                            xListWasEmpty = listLIST_IS_EMPTY( pxService->pxOverflowTimerList );
+                        }
                     }
+                    #endif
 
-                    vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+                    #if ( configUSE_TIMER_SLACK == 1 )
+                    {
+                        if( xListWasEmpty == pdFALSE )
+                        {
+                            /* Sleep for as long as the slack of the timers that
+                             * expire in the meantime allows, so they are all
+                             * processed in one wake up. */
+                            xNextExpireTime = prvGetLatestWakeTime( pxService, xTimeNow );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_TIMER_SLACK */
+
+                    vQueueWaitForMessageRestricted( pxService->xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
                     if( xTaskResumeAll() == pdFALSE )
                     {
@@ -841,108 +1545,420 @@
     }
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
-    {
-        TickType_t xNextExpireTime;
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static TickType_t prvGetNextExpireTime( TimerService_t * const pxService,
+                                                BaseType_t * const pxListWasEmpty )
+        {
+            TimerWheel_t * const pxWheel = &( pxService->xWheel );
+            TickType_t xTicksToNextEvent = portMAX_DELAY;
+            TickType_t xTicksToSlot;
+            TickType_t xLevelTime;
+            UBaseType_t uxLevel;
+            UBaseType_t uxOffset;
+
+            /* The next event is either the earliest occupied slot in level 0
+             * expiring, or the earliest occupied slot in a higher level being
+             * cascaded.  Either way the time it occurs is the start of the slot.
+             * If there are no active timers then the returned time is not used,
+             * as the task blocks indefinitely. */
+            *pxListWasEmpty = pdTRUE;
+
+            for( uxLevel = 0; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+            {
+                if( pxWheel->uxTimersInLevel[ uxLevel ] != ( UBaseType_t ) 0U )
+                {
+                    *pxListWasEmpty = pdFALSE;
+                    xLevelTime = pxWheel->xTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel );
 
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+                    for( uxOffset = 1; uxOffset <= tmrWHEEL_SLOTS; uxOffset++ )
+                    {
+                        if( listLIST_IS_EMPTY( tmrWHEEL_SLOT( pxWheel, uxLevel, ( UBaseType_t ) ( ( xLevelTime + ( TickType_t ) uxOffset ) & tmrWHEEL_SLOT_MASK ) ) ) == pdFALSE )
+                        {
+                            xTicksToSlot = ( ( xLevelTime + ( TickType_t ) uxOffset ) << tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) - pxWheel->xTime;
+
+                            if( xTicksToSlot < xTicksToNextEvent )
+                            {
+                                xTicksToNextEvent = xTicksToSlot;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
 
-        if( *pxListWasEmpty == pdFALSE )
+                            break;
+                        }
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            return pxWheel->xTime + xTicksToNextEvent;
+        }
+
+    #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
+
+        static TickType_t prvGetNextExpireTime( TimerService_t * const pxService,
+                                                BaseType_t * const pxListWasEmpty )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            TickType_t xNextExpireTime;
+
+            /* Timers are listed in expiry time order, with the head of the list
+             * referencing the task that will expire first.  Obtain the time at which
+             * the timer with the nearest expiry time will expire.  If there are no
+             * active timers then just set the next expire time to 0.  That will cause
+             * this task to unblock when the tick count overflows, at which point the
+             * timer lists will be switched and the next expiry time can be
+             * re-assessed.  */
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxService->pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+
+            return xNextExpireTime;
         }
-        else
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        static TickType_t prvGetLatestWakeTime( TimerService_t * const pxService,
+                                                const TickType_t xTimeNow )
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            /* Times are measured as ticks from xReferenceTime, at or before which
+             * no active timer expires, so they compare correctly across a tick
+             * count overflow. */
+            TickType_t xTicksToWake = portMAX_DELAY;
+            TickType_t xTicksToExpiry;
+            TickType_t xSlack;
+            Timer_t * pxTimer;
+
+            #if ( configUSE_TIMER_WHEEL == 1 )
+                TimerWheel_t * const pxWheel = &( pxService->xWheel );
+                const TickType_t xReferenceTime = pxWheel->xTime;
+                const ListItem_t * pxItem;
+                const ListItem_t * pxEnd;
+                TickType_t xLevelTime;
+                UBaseType_t uxLevel;
+                UBaseType_t uxOffset;
+                List_t * pxSlot;
+
+                ( void ) xTimeNow;
+
+                /* The timers in a slot do not expire before the start of the
+                 * slot, so the search of each level can stop at the first slot
+                 * that starts after the wake time found so far. */
+                for( uxLevel = 0; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                {
+                    if( pxWheel->uxTimersInLevel[ uxLevel ] != ( UBaseType_t ) 0U )
+                    {
+                        xLevelTime = xReferenceTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel );
+
+                        for( uxOffset = 1; uxOffset <= tmrWHEEL_SLOTS; uxOffset++ )
+                        {
+                            if( ( TickType_t ) ( ( ( xLevelTime + ( TickType_t ) uxOffset ) << tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) - xReferenceTime ) >= xTicksToWake )
+                            {
+                                break;
+                            }
+
+                            pxSlot = tmrWHEEL_SLOT( pxWheel, uxLevel, ( UBaseType_t ) ( ( xLevelTime + ( TickType_t ) uxOffset ) & tmrWHEEL_SLOT_MASK ) );
+                            pxEnd = listGET_END_MARKER( pxSlot );
+
+                            for( pxItem = listGET_HEAD_ENTRY( pxSlot ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+                            {
+                                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                                /* coverity[misra_c_2012_rule_11_5_violation] */
+                                pxTimer = ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+                                xTicksToExpiry = listGET_LIST_ITEM_VALUE( pxItem ) - xReferenceTime;
+                                xSlack = pxTimer->xTimerSlack;
+
+                                /* Saturate rather than overflow. */
+                                if( xSlack > ( portMAX_DELAY - xTicksToExpiry ) )
+                                {
+                                    xSlack = portMAX_DELAY - xTicksToExpiry;
+                                }
+
+                                if( ( xTicksToExpiry + xSlack ) < xTicksToWake )
+                                {
+                                    xTicksToWake = xTicksToExpiry + xSlack;
+                                }
+                            }
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
+                const TickType_t xReferenceTime = xTimeNow;
+                List_t * const pxLists[ 2 ] = { pxService->pxCurrentTimerList, pxService->pxOverflowTimerList };
+                const ListItem_t * pxItem;
+                const ListItem_t * pxEnd;
+                BaseType_t xListIndex;
+
+                /* None of the timers have expired, and the timers in the overflow
+                 * list expire after those in the current list, so the lists can
+                 * be searched in order until a timer expires after the wake time
+                 * found so far. */
+                for( xListIndex = 0; xListIndex < 2; xListIndex++ )
+                {
+                    pxEnd = listGET_END_MARKER( pxLists[ xListIndex ] );
+
+                    for( pxItem = listGET_HEAD_ENTRY( pxLists[ xListIndex ] ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+                    {
+                        xTicksToExpiry = listGET_LIST_ITEM_VALUE( pxItem ) - xReferenceTime;
+
+                        if( xTicksToExpiry >= xTicksToWake )
+                        {
+                            break;
+                        }
+
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTimer = ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+                        xSlack = pxTimer->xTimerSlack;
+
+                        /* Saturate rather than overflow. */
+                        if( xSlack > ( portMAX_DELAY - xTicksToExpiry ) )
+                        {
+                            xSlack = portMAX_DELAY - xTicksToExpiry;
+                        }
+
+                        if( ( xTicksToExpiry + xSlack ) < xTicksToWake )
+                        {
+                            xTicksToWake = xTicksToExpiry + xSlack;
+                        }
+                    }
+
+                    if( pxItem != pxEnd )
+                    {
+                        break;
+                    }
+                }
+            #endif /* configUSE_TIMER_WHEEL */
+
+            return xReferenceTime + xTicksToWake;
         }
 
-        return xNextExpireTime;
-    }
+    #endif /* configUSE_TIMER_SLACK */
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+    static TickType_t prvSampleTimeNow( TimerService_t * const pxService,
+                                        BaseType_t * const pxTimerListsWereSwitched )
     {
         TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U;
 
         xTimeNow = xTaskGetTickCount();
 
-        if( xTimeNow < xLastTime )
-        {
-            prvSwitchTimerLists();
-            *pxTimerListsWereSwitched = pdTRUE;
-        }
-        else
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
+            /* The wheel does not have lists to switch. */
+            ( void ) pxService;
             *pxTimerListsWereSwitched = pdFALSE;
         }
+        #else
+        {
+            if( xTimeNow < pxService->xLastTime )
+            {
+                prvSwitchTimerLists( pxService );
+                *pxTimerListsWereSwitched = pdTRUE;
+            }
+            else
+            {
+                *pxTimerListsWereSwitched = pdFALSE;
+            }
 
-        xLastTime = xTimeNow;
+            pxService->xLastTime = xTimeNow;
+        }
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xTimeNow;
     }
 /*-----------------------------------------------------------*/
 
-    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
-                                                  const TickType_t xNextExpiryTime,
-                                                  const TickType_t xTimeNow,
-                                                  const TickType_t xCommandTime )
-    {
-        BaseType_t xProcessTimerNow = pdFALSE;
-
-        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+    #if ( configUSE_TIMER_WHEEL == 1 )
 
-        if( xNextExpiryTime <= xTimeNow )
+        static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                      const TickType_t xNextExpiryTime,
+                                                      const TickType_t xTimeNow,
+                                                      const TickType_t xCommandTime )
         {
+            TimerWheel_t * const pxWheel = &( tmrGET_TIMER_SERVICE( pxTimer )->xWheel );
+            BaseType_t xProcessTimerNow = pdFALSE;
+            UBaseType_t uxLevel;
+            BaseType_t xWheelIsEmpty = pdTRUE;
+
+            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
             /* Has the expiry time elapsed between the command to start/reset a
-             * timer was issued, and the time the command was processed? */
-            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks )
+             * timer was issued, and the time the command was processed?  Measuring
+             * both times from the command time gives the correct result across a
+             * tick count overflow. */
+            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= ( ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) )
             {
-                /* The time between a command being issued and the command being
-                 * processed actually exceeds the timers period.  */
                 xProcessTimerNow = pdTRUE;
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                for( uxLevel = 0; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                {
+                    if( pxWheel->uxTimersInLevel[ uxLevel ] != ( UBaseType_t ) 0U )
+                    {
+                        xWheelIsEmpty = pdFALSE;
+                        break;
+                    }
+                }
+
+                if( xWheelIsEmpty != pdFALSE )
+                {
+                    /* There is nothing to process between the wheel time and
+                     * now, so bring the wheel time up to date rather than have
+                     * the timer placed further out than necessary. */
+                    pxWheel->xTime = xTimeNow;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvPlaceTimerInWheel( pxTimer );
             }
+
+            return xProcessTimerNow;
         }
-        else
+
+    #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
+
+        static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                      const TickType_t xNextExpiryTime,
+                                                      const TickType_t xTimeNow,
+                                                      const TickType_t xCommandTime )
         {
-            if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+            TimerService_t * const pxService = tmrGET_TIMER_SERVICE( pxTimer );
+            BaseType_t xProcessTimerNow = pdFALSE;
+
+            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+            if( xNextExpiryTime <= xTimeNow )
             {
-                /* If, since the command was issued, the tick count has overflowed
-                 * but the expiry time has not, then the timer must have already passed
-                 * its expiry time and should be processed immediately. */
-                xProcessTimerNow = pdTRUE;
+                /* Has the expiry time elapsed between the command to start/reset a
+                 * timer was issued, and the time the command was processed? */
+                if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks )
+                {
+                    /* The time between a command being issued and the command being
+                     * processed actually exceeds the timers period.  */
+                    xProcessTimerNow = pdTRUE;
+                }
+                else
+                {
+                    vListInsert( pxService->pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+                {
+                    /* If, since the command was issued, the tick count has overflowed
+                     * but the expiry time has not, then the timer must have already passed
+                     * its expiry time and should be processed immediately. */
+                    xProcessTimerNow = pdTRUE;
+                }
+                else
+                {
+                    vListInsert( pxService->pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
             }
+
+            return xProcessTimerNow;
         }
 
-        return xProcessTimerNow;
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer )
+    {
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            TimerWheel_t * const pxWheel = &( tmrGET_TIMER_SERVICE( pxTimer )->xWheel );
+            const List_t * const pxSlot = listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+            UBaseType_t uxLevel;
+
+            /* The level is found from the position of the slot in the wheel, so
+             * the timer does not need to store it. */
+            uxLevel = ( UBaseType_t ) ( pxSlot - &( pxWheel->xSlots[ 0 ] ) ) / tmrWHEEL_SLOTS;
+            configASSERT( uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS );
+
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            ( pxWheel->uxTimersInLevel[ uxLevel ] )--;
+        }
+        #else
+        {
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        }
+        #endif /* configUSE_TIMER_WHEEL */
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessReceivedCommands( void )
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvPlaceTimerInWheel( Timer_t * const pxTimer )
+        {
+            TimerWheel_t * const pxWheel = &( tmrGET_TIMER_SERVICE( pxTimer )->xWheel );
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            TickType_t xRemainingTicks;
+            UBaseType_t uxLevel = 0;
+            UBaseType_t uxSlot;
+
+            /* The level is the lowest one whose span of slots covers the number
+             * of ticks from the wheel time to the expiry time. */
+            xRemainingTicks = ( TickType_t ) ( xExpiryTime - pxWheel->xTime ) >> configTIMER_WHEEL_SLOT_BITS;
+
+            while( ( xRemainingTicks != ( TickType_t ) 0U ) && ( uxLevel < ( ( UBaseType_t ) configTIMER_WHEEL_LEVELS - 1U ) ) )
+            {
+                xRemainingTicks >>= configTIMER_WHEEL_SLOT_BITS;
+                uxLevel++;
+            }
+
+            if( xRemainingTicks == ( TickType_t ) 0U )
+            {
+                uxSlot = ( UBaseType_t ) ( ( xExpiryTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK );
+            }
+            else
+            {
+                /* The expiry time is beyond the range of the wheel.  Place the
+                 * timer in the top level slot that is cascaded last, at which
+                 * point it is placed again using its real expiry time. */
+                uxSlot = ( UBaseType_t ) ( ( ( pxWheel->xTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1U ) & tmrWHEEL_SLOT_MASK );
+            }
+
+            vListInsertEnd( tmrWHEEL_SLOT( pxWheel, uxLevel, uxSlot ), &( pxTimer->xTimerListItem ) );
+            ( pxWheel->uxTimersInLevel[ uxLevel ] )++;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    static void prvProcessReceivedCommands( TimerService_t * const pxService )
     {
         DaemonTaskMessage_t xMessage = { 0 };
-        Timer_t * pxTimer;
-        BaseType_t xTimerListsWereSwitched;
-        TickType_t xTimeNow;
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+        while( xQueueReceive( pxService->xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
         {
             #if ( INCLUDE_xTimerPendFunctionCall == 1 )
             {
@@ -956,6 +1972,14 @@
                      * callback be executed.  Check the callback is not NULL. */
                     configASSERT( pxCallback );
 
+                    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+                    {
+                        /* Timer commands sent before the function call was pended
+                         * must take effect before it is called. */
+                        prvProcessPendingTimerCommands( pxService );
+                    }
+                    #endif
+
                     /* Call the function. */
                     pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
                 }
@@ -967,188 +1991,405 @@
             #endif /* INCLUDE_xTimerPendFunctionCall */
 
             /* Commands that are positive are timer commands rather than pended
-             * function calls. */
-            if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+             * function calls.  When configUSE_TIMER_COMMAND_COALESCING is 1 the
+             * only positive command is tmrCOMMAND_PROCESS_PENDING, which just
+             * wakes this task to process the pending commands below. */
+            #if ( configUSE_TIMER_COMMAND_COALESCING == 0 )
             {
-                /* The messages uses the xTimerParameters member to work on a
-                 * software timer. */
-                pxTimer = xMessage.u.xTimerParameters.pxTimer;
+                if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+                {
+                    /* The messages uses the xTimerParameters member to work on a
+                     * software timer. */
+                    prvProcessTimerCommand( xMessage.u.xTimerParameters.pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+                }
+            }
+            #endif
+        }
+
+        #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+        {
+            prvProcessPendingTimerCommands( pxService );
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessTimerCommand( Timer_t * const pxTimer,
+                                        const BaseType_t xCommandID,
+                                        const TickType_t xCommandValue )
+    {
+        BaseType_t xTimerListsWereSwitched;
+        TickType_t xTimeNow;
+
+        if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+        {
+            /* The timer is in a list, remove it. */
+            prvRemoveTimerFromActiveList( pxTimer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+        traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xCommandValue );
+
+        /* In this case the xTimerListsWereSwitched parameter is not used, but
+         *  it must be present in the function call.  prvSampleTimeNow() must be
+         *  called after the message is received from xTimerQueue so there is no
+         *  possibility of a higher priority task adding a message to the message
+         *  queue with a time that is ahead of the timer daemon task (because it
+         *  pre-empted the timer daemon task after the xTimeNow value was set). */
+        xTimeNow = prvSampleTimeNow( tmrGET_TIMER_SERVICE( pxTimer ), &xTimerListsWereSwitched );
+
+        switch( xCommandID )
+        {
+            case tmrCOMMAND_START:
+            case tmrCOMMAND_START_FROM_ISR:
+            case tmrCOMMAND_RESET:
+            case tmrCOMMAND_RESET_FROM_ISR:
+                /* Start or restart a timer. */
+                pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+
+                if( prvInsertTimerInActiveList( pxTimer, xCommandValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xCommandValue ) != pdFALSE )
                 {
-                    /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    /* The timer expired before it was added to the active
+                     * timer list.  Process it now. */
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+                    {
+                        prvReloadTimer( pxTimer, xCommandValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+
+                    /* Call the timer callback. */
+                    traceTIMER_EXPIRED( pxTimer );
+                    pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+                break;
+
+            case tmrCOMMAND_STOP:
+            case tmrCOMMAND_STOP_FROM_ISR:
+                /* The timer has already been removed from the active list. */
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                break;
+
+            case tmrCOMMAND_CHANGE_PERIOD:
+            case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+                pxTimer->xTimerPeriodInTicks = xCommandValue;
+                configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                /* The new period does not really have a reference, and can
+                 * be longer or shorter than the old one.  The command time is
+                 * therefore set to the current time, and as the period cannot
+                 * be zero the next expiry time can only be in the future,
+                 * meaning (unlike for the xTimerStart() case above) there is
+                 * no fail case that needs to be handled here. */
+                ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                break;
+
+            case tmrCOMMAND_DELETE:
+                #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                {
+                    /* The timer has already been removed from the active list,
+                     * just free up the memory if the memory was dynamically
+                     * allocated. */
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                    {
+                        poolFREE( pxTimer );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+                }
+                #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                {
+                    /* If dynamic allocation is not enabled, the memory
+                     * could not have been dynamically allocated. So there is
+                     * no need to free the memory - just mark the timer as
+                     * "not active". */
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                }
+                #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                break;
+
+            default:
+                /* Don't expect to get here. */
+                break;
+        }
+    }
+/*-----------------------------------------------------------*/
 
-                /* In this case the xTimerListsWereSwitched parameter is not used, but
-                 *  it must be present in the function call.  prvSampleTimeNow() must be
-                 *  called after the message is received from xTimerQueue so there is no
-                 *  possibility of a higher priority task adding a message to the message
-                 *  queue with a time that is ahead of the timer daemon task (because it
-                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
-                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+        static BaseType_t prvPendTimerCommand( Timer_t * const pxTimer,
+                                               const BaseType_t xCommandID,
+                                               const TickType_t xCommandValue )
+        {
+            TimerService_t * const pxService = tmrGET_TIMER_SERVICE( pxTimer );
+            BaseType_t xWakeTimerTask = pdFALSE;
+            uint8_t ucPendingCommand = pxTimer->ucPendingCommand;
 
-                switch( xMessage.xMessageID )
+            /* A timer must not be used after it has been deleted. */
+            configASSERT( ( ucPendingCommand & tmrPENDING_DELETE ) == 0U );
+
+            switch( xCommandID )
+            {
+                case tmrCOMMAND_START:
+                case tmrCOMMAND_START_FROM_ISR:
+                case tmrCOMMAND_RESET:
+                case tmrCOMMAND_RESET_FROM_ISR:
+                    /* Only the most recent start time matters, but a pending
+                     * change of period must still be applied first. */
+                    ucPendingCommand = ( uint8_t ) ( ( ucPendingCommand & tmrPENDING_CHANGE_PERIOD ) | tmrPENDING_START );
+                    pxTimer->xPendingCommandValue = xCommandValue;
+                    break;
+
+                case tmrCOMMAND_STOP:
+                case tmrCOMMAND_STOP_FROM_ISR:
+                    ucPendingCommand = ( uint8_t ) ( ( ucPendingCommand & tmrPENDING_CHANGE_PERIOD ) | tmrPENDING_STOP );
+                    break;
+
+                case tmrCOMMAND_CHANGE_PERIOD:
+                case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                    /* Changing the period also starts the timer from the time the
+                     * command is processed, so replaces any pending start or stop. */
+                    ucPendingCommand = ( uint8_t ) tmrPENDING_CHANGE_PERIOD;
+                    pxTimer->xPendingPeriod = xCommandValue;
+                    break;
+
+                case tmrCOMMAND_DELETE:
+                    ucPendingCommand = ( uint8_t ) tmrPENDING_DELETE;
+                    break;
+
+                default:
+                    /* Don't expect to get here. */
+                    break;
+            }
+
+            if( pxTimer->ucPendingCommand == ( uint8_t ) 0U )
+            {
+                /* The timer is not in the list of timers with pending commands
+                 * yet. */
+                pxTimer->pxNextPendingTimer = NULL;
+
+                if( pxService->pxPendingTimersTail == NULL )
                 {
-                    case tmrCOMMAND_START:
-                    case tmrCOMMAND_START_FROM_ISR:
-                    case tmrCOMMAND_RESET:
-                    case tmrCOMMAND_RESET_FROM_ISR:
-                        /* Start or restart a timer. */
-                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
-
-                        if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-                        {
-                            /* The timer expired before it was added to the active
-                             * timer list.  Process it now. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
-                            {
-                                prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
+                    pxService->pxPendingTimersHead = pxTimer;
+                    xWakeTimerTask = pdTRUE;
+                }
+                else
+                {
+                    pxService->pxPendingTimersTail->pxNextPendingTimer = pxTimer;
+                }
+
+                pxService->pxPendingTimersTail = pxTimer;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTimer->ucPendingCommand = ucPendingCommand;
+
+            return xWakeTimerTask;
+        }
+
+    #endif /* configUSE_TIMER_COMMAND_COALESCING */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+        static void prvProcessPendingTimerCommands( TimerService_t * const pxService )
+        {
+            Timer_t * pxTimer;
+            uint8_t ucPendingCommand = ( uint8_t ) 0U;
+            TickType_t xCommandValue = ( TickType_t ) 0U;
+            TickType_t xPeriod = ( TickType_t ) 0U;
+
+            do
+            {
+                /* Take the timers off the list one at a time, so a command sent
+                 * to a timer that is still in the list is merged into the commands
+                 * that are about to be processed. */
+                taskENTER_CRITICAL();
+                {
+                    pxTimer = pxService->pxPendingTimersHead;
 
-                            /* Call the timer callback. */
-                            traceTIMER_EXPIRED( pxTimer );
-                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                    if( pxTimer != NULL )
+                    {
+                        pxService->pxPendingTimersHead = pxTimer->pxNextPendingTimer;
+
+                        if( pxService->pxPendingTimersHead == NULL )
+                        {
+                            pxService->pxPendingTimersTail = NULL;
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
 
-                        break;
-
-                    case tmrCOMMAND_STOP:
-                    case tmrCOMMAND_STOP_FROM_ISR:
-                        /* The timer has already been removed from the active list. */
-                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        break;
-
-                    case tmrCOMMAND_CHANGE_PERIOD:
-                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
-                        pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                        /* The new period does not really have a reference, and can
-                         * be longer or shorter than the old one.  The command time is
-                         * therefore set to the current time, and as the period cannot
-                         * be zero the next expiry time can only be in the future,
-                         * meaning (unlike for the xTimerStart() case above) there is
-                         * no fail case that needs to be handled here. */
-                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                        break;
+                        ucPendingCommand = pxTimer->ucPendingCommand;
+                        xCommandValue = pxTimer->xPendingCommandValue;
+                        xPeriod = pxTimer->xPendingPeriod;
+                        pxTimer->ucPendingCommand = ( uint8_t ) 0U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
 
-                    case tmrCOMMAND_DELETE:
-                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                if( pxTimer != NULL )
+                {
+                    if( ( ucPendingCommand & tmrPENDING_DELETE ) != 0U )
+                    {
+                        prvProcessTimerCommand( pxTimer, tmrCOMMAND_DELETE, ( TickType_t ) 0U );
+                    }
+                    else
+                    {
+                        if( ( ucPendingCommand & tmrPENDING_CHANGE_PERIOD ) != 0U )
                         {
-                            /* The timer has already been removed from the active list,
-                             * just free up the memory if the memory was dynamically
-                             * allocated. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
-                            {
-                                vPortFree( pxTimer );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
+                            prvProcessTimerCommand( pxTimer, tmrCOMMAND_CHANGE_PERIOD, xPeriod );
                         }
-                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                        else
                         {
-                            /* If dynamic allocation is not enabled, the memory
-                             * could not have been dynamically allocated. So there is
-                             * no need to free the memory - just mark the timer as
-                             * "not active". */
-                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                            mtCOVERAGE_TEST_MARKER();
                         }
-                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                        break;
 
-                    default:
-                        /* Don't expect to get here. */
-                        break;
+                        if( ( ucPendingCommand & tmrPENDING_START ) != 0U )
+                        {
+                            prvProcessTimerCommand( pxTimer, tmrCOMMAND_RESET, xCommandValue );
+                        }
+                        else if( ( ucPendingCommand & tmrPENDING_STOP ) != 0U )
+                        {
+                            prvProcessTimerCommand( pxTimer, tmrCOMMAND_STOP, ( TickType_t ) 0U );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
                 }
-            }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            } while( pxTimer != NULL );
         }
-    }
+
+    #endif /* configUSE_TIMER_COMMAND_COALESCING */
 /*-----------------------------------------------------------*/
 
-    static void prvSwitchTimerLists( void )
-    {
-        TickType_t xNextExpireTime;
-        List_t * pxTemp;
+    #if ( configUSE_TIMER_WHEEL == 0 )
 
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        static void prvSwitchTimerLists( TimerService_t * const pxService )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            TickType_t xNextExpireTime;
+            List_t * pxTemp;
+
+            /* The tick count has overflowed.  The timer lists must be switched.
+             * If there are any timers still referenced from the current timer list
+             * then they must have expired and should be processed before the lists
+             * are switched. */
+            while( listLIST_IS_EMPTY( pxService->pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( pxService, xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            pxTemp = pxService->pxCurrentTimerList;
+            pxService->pxCurrentTimerList = pxService->pxOverflowTimerList;
+            pxService->pxOverflowTimerList = pxTemp;
         }
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
-    }
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
     {
-        /* Check that the list from which active timers are referenced, and the
-         * queue used to communicate with the timer service, have been
-         * initialised. */
+        TimerService_t * pxService;
+        UBaseType_t uxTimerService;
+
+        /* Check that the lists from which active timers are referenced, and the
+         * queues used to communicate with the timer service tasks, have been
+         * initialised.  All the services are initialised together. */
         taskENTER_CRITICAL();
         {
-            if( xTimerQueue == NULL )
+            if( xTimerServices[ 0 ].xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
-
-                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                for( uxTimerService = 0; uxTimerService < ( UBaseType_t ) configTIMER_SERVICE_TASKS; uxTimerService++ )
                 {
-                    /* The timer queue is allocated statically in case
-                     * configSUPPORT_DYNAMIC_ALLOCATION is 0. */
-                    PRIVILEGED_DATA static StaticQueue_t xStaticTimerQueue;
-                    PRIVILEGED_DATA static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ];
+                    pxService = &( xTimerServices[ uxTimerService ] );
 
-                    xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
-                }
-                #else
-                {
-                    xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ) );
-                }
-                #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+                    #if ( configUSE_TIMER_WHEEL == 1 )
+                    {
+                        TimerWheel_t * const pxWheel = &( pxService->xWheel );
+                        UBaseType_t uxLevel;
+                        UBaseType_t uxSlot;
 
-                #if ( configQUEUE_REGISTRY_SIZE > 0 )
-                {
-                    if( xTimerQueue != NULL )
+                        for( uxLevel = 0; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                        {
+                            for( uxSlot = 0; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                            {
+                                vListInitialise( tmrWHEEL_SLOT( pxWheel, uxLevel, uxSlot ) );
+                            }
+
+                            pxWheel->uxTimersInLevel[ uxLevel ] = ( UBaseType_t ) 0U;
+                        }
+
+                        pxWheel->xTime = xTaskGetTickCount();
+                    }
+                    #else
                     {
-                        vQueueAddToRegistry( xTimerQueue, "TmrQ" );
+                        vListInitialise( &( pxService->xActiveTimerList1 ) );
+                        vListInitialise( &( pxService->xActiveTimerList2 ) );
+                        pxService->pxCurrentTimerList = &( pxService->xActiveTimerList1 );
+                        pxService->pxOverflowTimerList = &( pxService->xActiveTimerList2 );
                     }
-                    else
+                    #endif /* configUSE_TIMER_WHEEL */
+
+                    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The timer queues are allocated statically in case
+                         * configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+                        PRIVILEGED_DATA static StaticQueue_t xStaticTimerQueues[ configTIMER_SERVICE_TASKS ];
+                        PRIVILEGED_DATA static uint8_t ucStaticTimerQueueStorage[ configTIMER_SERVICE_TASKS ][ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ];
+
+                        pxService->xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ uxTimerService ][ 0 ] ), &( xStaticTimerQueues[ uxTimerService ] ) );
                     }
+                    #else
+                    {
+                        pxService->xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ) );
+                    }
+                    #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+
+                    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                    {
+                        if( pxService->xTimerQueue != NULL )
+                        {
+                            vQueueAddToRegistry( pxService->xTimerQueue, "TmrQ" );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configQUEUE_REGISTRY_SIZE */
                 }
-                #endif /* configQUEUE_REGISTRY_SIZE */
             }
             else
             {
@@ -1247,7 +2488,7 @@
             xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
             xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-            xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+            xReturn = xQueueSendFromISR( xTimerServices[ 0 ].xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 
             tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
             traceRETURN_xTimerPendFunctionCallFromISR( xReturn );
@@ -1273,7 +2514,7 @@
             /* This function can only be called after a timer has been created or
              * after the scheduler has been started because, until then, the timer
              * queue does not exist. */
-            configASSERT( xTimerQueue );
+            configASSERT( xTimerServices[ 0 ].xTimerQueue );
 
             /* Complete the message with the function parameters and post it to the
              * daemon task. */
@@ -1282,7 +2523,7 @@
             xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
             xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-            xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+            xReturn = xQueueSendToBack( xTimerServices[ 0 ].xTimerQueue, &xMessage, xTicksToWait );
 
             tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
             traceRETURN_xTimerPendFunctionCall( xReturn );
@@ -1329,8 +2570,20 @@
  */
     void vTimerResetState( void )
     {
-        xTimerQueue = NULL;
-        xTimerTaskHandle = NULL;
+        UBaseType_t uxTimerService;
+
+        for( uxTimerService = 0; uxTimerService < ( UBaseType_t ) configTIMER_SERVICE_TASKS; uxTimerService++ )
+        {
+            xTimerServices[ uxTimerService ].xTimerQueue = NULL;
+            xTimerServices[ uxTimerService ].xTimerTaskHandle = NULL;
+
+            #if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+            {
+                xTimerServices[ uxTimerService ].pxPendingTimersHead = NULL;
+                xTimerServices[ uxTimerService ].pxPendingTimersTail = NULL;
+            }
+            #endif
+        }
     }
 /*-----------------------------------------------------------*/
 
@@ -0,0 +1,717 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "topic.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include topic functionality.  This #if is closed at the very bottom of this
+ * file.  If you want to include topics then ensure configUSE_TOPICS is set to 1
+ * in FreeRTOSConfig.h. */
+#if ( configUSE_TOPICS == 1 )
+
+/* Bits set in ucFlags. */
+    #define topicFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/* The ring length must be a power of two, see the comment below. */
+    #define topicIS_POWER_OF_TWO( uxLength )       ( ( ( uxLength ) & ( ( uxLength ) - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 )
+    #define topicSEQUENCE_TO_SLOT( ulSequence, uxLength ) \
+    ( ( UBaseType_t ) ( ( ulSequence ) & ( ( uint32_t ) ( uxLength ) - 1UL ) ) )
+
+/*
+ * Items are identified by a free running sequence number - the nth item ever
+ * published has sequence number n - 1 and is stored in slot
+ * ( n - 1 ) % uxLength.  All sequence arithmetic is unsigned so it is correct
+ * across wrap around provided uxLength is less than 2^31.  uxLength must also
+ * be a power of two, as only then does 2^32 divide evenly into slots and the
+ * slot after the one for sequence 0xFFFFFFFF is slot 0.
+ *
+ * ulReserved is advanced before an item is copied into its slot and
+ * ulPublished after the copy completes.  A subscriber reading item s without a
+ * critical section therefore knows its copy is intact if, after copying,
+ * ulReserved has not moved past s + uxLength.
+ */
+    typedef struct TopicDef_t
+    {
+        volatile uint32_t ulReserved;  /**< Number of items whose copy into the ring has started. */
+        volatile uint32_t ulPublished; /**< Number of items whose copy into the ring has completed. */
+        UBaseType_t uxLength;          /**< The number of slots in the ring. */
+        UBaseType_t uxItemSize;        /**< The size of each slot in bytes. */
+        uint8_t * pucStorage;          /**< The ring itself. */
+        List_t xWaitingSubscribers;    /**< Subscribers blocked in xTopicReceive().  The list items live on the waiting tasks' stacks and are removed by the task that notifies them. */
+        uint8_t ucFlags;
+    } Topic_t;
+
+    typedef struct TopicSubscriberDef_t
+    {
+        Topic_t * pxTopic;
+        uint32_t ulNext;     /**< Sequence number of the next item this subscriber will read. */
+        uint32_t ulOverruns; /**< Items skipped because they were overwritten before being read. */
+        uint8_t ucFlags;
+    } TopicSubscriber_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the dynamic and static create functions to initialise a
+ * newly allocated topic structure.
+ */
+    static void prvInitialiseNewTopic( Topic_t * const pxTopic,
+                                       UBaseType_t uxLength,
+                                       UBaseType_t uxItemSize,
+                                       uint8_t * const pucStorage,
+                                       uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both the dynamic and static subscribe functions to initialise a
+ * newly allocated subscriber structure.
+ */
+    static void prvInitialiseNewSubscriber( TopicSubscriber_t * const pxSubscriber,
+                                            Topic_t * const pxTopic,
+                                            uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies pvItem into the next slot of the ring.  Must be called from within a
+ * critical section.
+ */
+    static void prvCopyItemToRing( Topic_t * const pxTopic,
+                                   const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Attempts to copy the subscriber's next unread item into pvBuffer without
+ * entering a critical section.  Returns pdFAIL if the subscriber has already
+ * read every item published.
+ */
+    static BaseType_t prvReadNextItem( TopicSubscriber_t * const pxSubscriber,
+                                       void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewTopic( Topic_t * const pxTopic,
+                                       UBaseType_t uxLength,
+                                       UBaseType_t uxItemSize,
+                                       uint8_t * const pucStorage,
+                                       uint8_t ucFlags )
+    {
+        ( void ) memset( ( void * ) pxTopic, 0x00, sizeof( Topic_t ) );
+        pxTopic->uxLength = uxLength;
+        pxTopic->uxItemSize = uxItemSize;
+        pxTopic->pucStorage = pucStorage;
+        pxTopic->ucFlags = ucFlags;
+        vListInitialise( &( pxTopic->xWaitingSubscribers ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewSubscriber( TopicSubscriber_t * const pxSubscriber,
+                                            Topic_t * const pxTopic,
+                                            uint8_t ucFlags )
+    {
+        pxSubscriber->pxTopic = pxTopic;
+        pxSubscriber->ulNext = pxTopic->ulPublished;
+        pxSubscriber->ulOverruns = 0;
+        pxSubscriber->ucFlags = ucFlags;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCopyItemToRing( Topic_t * const pxTopic,
+                                   const void * pvItem )
+    {
+        const uint32_t ulSequence = pxTopic->ulPublished;
+        const UBaseType_t uxSlot = topicSEQUENCE_TO_SLOT( ulSequence, pxTopic->uxLength );
+
+        pxTopic->ulReserved = ulSequence + 1UL;
+        portDATA_MEMORY_BARRIER();
+
+        ( void ) memcpy( ( void * ) &( pxTopic->pucStorage[ uxSlot * pxTopic->uxItemSize ] ),
+                         pvItem,
+                         ( size_t ) pxTopic->uxItemSize );
+
+        portDATA_MEMORY_BARRIER();
+        pxTopic->ulPublished = ulSequence + 1UL;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReadNextItem( TopicSubscriber_t * const pxSubscriber,
+                                       void * pvBuffer )
+    {
+        const Topic_t * const pxTopic = pxSubscriber->pxTopic;
+        const uint32_t ulLength = ( uint32_t ) pxTopic->uxLength;
+        uint32_t ulNext;
+        uint32_t ulOldest;
+        UBaseType_t uxSlot;
+        BaseType_t xReturn = pdFAIL;
+
+        for( ; ; )
+        {
+            ulNext = pxSubscriber->ulNext;
+
+            if( ulNext == pxTopic->ulPublished )
+            {
+                /* Nothing new to read. */
+                break;
+            }
+
+            /* Items older than ulOldest have been, or are being, overwritten. */
+            ulOldest = pxTopic->ulReserved - ulLength;
+
+            if( ( pxTopic->ulReserved - ulNext ) > ulLength )
+            {
+                pxSubscriber->ulOverruns += ulOldest - ulNext;
+                ulNext = ulOldest;
+            }
+
+            portDATA_MEMORY_BARRIER();
+
+            uxSlot = topicSEQUENCE_TO_SLOT( ulNext, ulLength );
+            ( void ) memcpy( pvBuffer,
+                             ( const void * ) &( pxTopic->pucStorage[ uxSlot * pxTopic->uxItemSize ] ),
+                             ( size_t ) pxTopic->uxItemSize );
+
+            portDATA_MEMORY_BARRIER();
+
+            if( ( pxTopic->ulReserved - ulNext ) <= ulLength )
+            {
+                /* The slot was not overwritten while it was being copied. */
+                pxSubscriber->ulNext = ulNext + 1UL;
+                xReturn = pdPASS;
+                break;
+            }
+
+            /* A publisher on another core overwrote the item while it was
+             * being copied.  Record the skip point and try again with the
+             * oldest item that is still intact. */
+            pxSubscriber->ulNext = ulNext;
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        TopicHandle_t xTopicCreate( UBaseType_t uxLength,
+                                    UBaseType_t uxItemSize )
+        {
+            Topic_t * pxTopic = NULL;
+            uint8_t * pucAllocatedMemory;
+            size_t xRingSizeInBytes;
+
+            traceENTER_xTopicCreate( uxLength, uxItemSize );
+
+            configASSERT( uxLength > ( UBaseType_t ) 0 );
+            configASSERT( topicIS_POWER_OF_TWO( uxLength ) );
+            configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+            /* Check for multiplication and addition overflow before allocating
+             * the structure and the ring in one block. */
+            if( ( uxLength > ( UBaseType_t ) 0 ) &&
+                ( topicIS_POWER_OF_TWO( uxLength ) ) &&
+                ( ( SIZE_MAX / uxLength ) >= uxItemSize ) &&
+                ( ( ( size_t ) uxLength * ( size_t ) uxItemSize ) <= ( SIZE_MAX - sizeof( Topic_t ) ) ) )
+            {
+                xRingSizeInBytes = ( size_t ) uxLength * ( size_t ) uxItemSize;
+
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( Topic_t ) + xRingSizeInBytes );
+
+                if( pucAllocatedMemory != NULL )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxTopic = ( Topic_t * ) pucAllocatedMemory;
+
+                    prvInitialiseNewTopic( pxTopic,
+                                           uxLength,
+                                           uxItemSize,
+                                           pucAllocatedMemory + sizeof( Topic_t ),
+                                           0 );
+
+                    traceTOPIC_CREATE( pxTopic );
+                }
+                else
+                {
+                    traceTOPIC_CREATE_FAILED();
+                }
+            }
+            else
+            {
+                traceTOPIC_CREATE_FAILED();
+            }
+
+            traceRETURN_xTopicCreate( pxTopic );
+
+            return pxTopic;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        TopicHandle_t xTopicCreateStatic( UBaseType_t uxLength,
+                                          UBaseType_t uxItemSize,
+                                          uint8_t * pucTopicStorage,
+                                          StaticTopic_t * pxStaticTopic )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            Topic_t * const pxTopic = ( Topic_t * ) pxStaticTopic;
+            TopicHandle_t xReturn;
+
+            traceENTER_xTopicCreateStatic( uxLength, uxItemSize, pucTopicStorage, pxStaticTopic );
+
+            configASSERT( pucTopicStorage );
+            configASSERT( pxStaticTopic );
+            configASSERT( uxLength > ( UBaseType_t ) 0 );
+            configASSERT( topicIS_POWER_OF_TWO( uxLength ) );
+            configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticTopic_t equals the size of the real
+                 * topic structure. */
+                volatile size_t xSize = sizeof( StaticTopic_t );
+                configASSERT( xSize == sizeof( Topic_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucTopicStorage != NULL ) && ( pxStaticTopic != NULL ) &&
+                ( uxLength > ( UBaseType_t ) 0 ) && ( topicIS_POWER_OF_TWO( uxLength ) ) )
+            {
+                prvInitialiseNewTopic( pxTopic,
+                                       uxLength,
+                                       uxItemSize,
+                                       pucTopicStorage,
+                                       topicFLAGS_IS_STATICALLY_ALLOCATED );
+
+                traceTOPIC_CREATE( pxTopic );
+
+                xReturn = ( TopicHandle_t ) pxStaticTopic;
+            }
+            else
+            {
+                xReturn = NULL;
+                traceTOPIC_CREATE_FAILED();
+            }
+
+            traceRETURN_xTopicCreateStatic( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vTopicDelete( TopicHandle_t xTopic )
+    {
+        Topic_t * const pxTopic = xTopic;
+
+        traceENTER_vTopicDelete( xTopic );
+
+        configASSERT( pxTopic );
+        configASSERT( listLIST_IS_EMPTY( &( pxTopic->xWaitingSubscribers ) ) != pdFALSE );
+
+        traceTOPIC_DELETE( xTopic );
+
+        if( ( pxTopic->ucFlags & topicFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* The structure and the ring were allocated using a single call
+                 * to pvPortMalloc(). */
+                vPortFree( ( void * ) pxTopic );
+            }
+            #else
+            {
+                /* Should not be possible to get here, ucFlags must be corrupt.
+                 * Force an assert. */
+                configASSERT( xTopic == ( TopicHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure was not allocated dynamically and cannot be freed -
+             * just scrub it so future use will assert. */
+            ( void ) memset( pxTopic, 0x00, sizeof( Topic_t ) );
+        }
+
+        traceRETURN_vTopicDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        TopicSubscriberHandle_t xTopicSubscribe( TopicHandle_t xTopic )
+        {
+            TopicSubscriber_t * pxSubscriber;
+
+            traceENTER_xTopicSubscribe( xTopic );
+
+            configASSERT( xTopic );
+
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxSubscriber = ( TopicSubscriber_t * ) pvPortMalloc( sizeof( TopicSubscriber_t ) );
+
+            if( pxSubscriber != NULL )
+            {
+                prvInitialiseNewSubscriber( pxSubscriber, xTopic, 0 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xTopicSubscribe( pxSubscriber );
+
+            return pxSubscriber;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        TopicSubscriberHandle_t xTopicSubscribeStatic( TopicHandle_t xTopic,
+                                                       StaticTopicSubscriber_t * pxStaticSubscriber )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            TopicSubscriber_t * const pxSubscriber = ( TopicSubscriber_t * ) pxStaticSubscriber;
+
+            traceENTER_xTopicSubscribeStatic( xTopic, pxStaticSubscriber );
+
+            configASSERT( xTopic );
+            configASSERT( pxStaticSubscriber );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                volatile size_t xSize = sizeof( StaticTopicSubscriber_t );
+                configASSERT( xSize == sizeof( TopicSubscriber_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( pxSubscriber != NULL )
+            {
+                prvInitialiseNewSubscriber( pxSubscriber, xTopic, topicFLAGS_IS_STATICALLY_ALLOCATED );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xTopicSubscribeStatic( pxSubscriber );
+
+            return pxSubscriber;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vTopicUnsubscribe( TopicSubscriberHandle_t xSubscriber )
+    {
+        TopicSubscriber_t * const pxSubscriber = xSubscriber;
+
+        traceENTER_vTopicUnsubscribe( xSubscriber );
+
+        configASSERT( pxSubscriber );
+
+        if( ( pxSubscriber->ucFlags & topicFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFree( ( void * ) pxSubscriber );
+            }
+            #else
+            {
+                configASSERT( xSubscriber == ( TopicSubscriberHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            ( void ) memset( pxSubscriber, 0x00, sizeof( TopicSubscriber_t ) );
+        }
+
+        traceRETURN_vTopicUnsubscribe();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTopicPublish( TopicHandle_t xTopic,
+                        const void * pvItem )
+    {
+        Topic_t * const pxTopic = xTopic;
+        ListItem_t * pxListItem;
+        TaskHandle_t xTaskToNotify;
+        UBaseType_t uxWaiters;
+
+        traceENTER_vTopicPublish( xTopic, pvItem );
+
+        configASSERT( pxTopic );
+        configASSERT( pvItem );
+
+        taskENTER_CRITICAL();
+        {
+            prvCopyItemToRing( pxTopic, pvItem );
+
+            traceTOPIC_PUBLISH( xTopic );
+
+            /* Unlink each waiting task before notifying it.  Some ports switch
+             * to the notified task immediately, even from within a critical
+             * section, and the list item lives on that task's stack.  Only the
+             * tasks that were waiting on entry are notified - a notified task
+             * that runs and waits again is appended behind them. */
+            for( uxWaiters = listCURRENT_LIST_LENGTH( &( pxTopic->xWaitingSubscribers ) ); uxWaiters > ( UBaseType_t ) 0; uxWaiters-- )
+            {
+                pxListItem = listGET_HEAD_ENTRY( &( pxTopic->xWaitingSubscribers ) );
+                xTaskToNotify = ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxListItem );
+                ( void ) uxListRemove( pxListItem );
+                ( void ) xTaskNotifyGiveIndexed( xTaskToNotify, configTOPIC_NOTIFICATION_INDEX );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTopicPublish();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTopicPublishFromISR( TopicHandle_t xTopic,
+                               const void * pvItem,
+                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        Topic_t * const pxTopic = xTopic;
+        ListItem_t * pxListItem;
+        TaskHandle_t xTaskToNotify;
+        UBaseType_t uxWaiters;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_vTopicPublishFromISR( xTopic, pvItem, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxTopic );
+        configASSERT( pvItem );
+
+        /* See the comments in xQueueGenericSendFromISR() regarding interrupt
+         * priorities. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            prvCopyItemToRing( pxTopic, pvItem );
+
+            traceTOPIC_PUBLISH_FROM_ISR( xTopic );
+
+            for( uxWaiters = listCURRENT_LIST_LENGTH( &( pxTopic->xWaitingSubscribers ) ); uxWaiters > ( UBaseType_t ) 0; uxWaiters-- )
+            {
+                pxListItem = listGET_HEAD_ENTRY( &( pxTopic->xWaitingSubscribers ) );
+                xTaskToNotify = ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxListItem );
+                ( void ) uxListRemove( pxListItem );
+                vTaskNotifyGiveIndexedFromISR( xTaskToNotify, configTOPIC_NOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_vTopicPublishFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTopicReceive( TopicSubscriberHandle_t xSubscriber,
+                              void * pvBuffer,
+                              TickType_t xTicksToWait )
+    {
+        TopicSubscriber_t * const pxSubscriber = xSubscriber;
+        Topic_t * pxTopic;
+        ListItem_t xWaitItem;
+        TimeOut_t xTimeOut;
+        BaseType_t xReturn;
+        BaseType_t xRegistered;
+
+        traceENTER_xTopicReceive( xSubscriber, pvBuffer, xTicksToWait );
+
+        configASSERT( pxSubscriber );
+        configASSERT( pvBuffer );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        pxTopic = pxSubscriber->pxTopic;
+
+        vListInitialiseItem( &xWaitItem );
+        listSET_LIST_ITEM_OWNER( &xWaitItem, xTaskGetCurrentTaskHandle() );
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            xReturn = prvReadNextItem( pxSubscriber, pvBuffer );
+
+            if( xReturn != pdFAIL )
+            {
+                traceTOPIC_RECEIVE( xSubscriber );
+                break;
+            }
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                traceTOPIC_RECEIVE_FAILED( xSubscriber );
+                break;
+            }
+
+            xRegistered = pdFALSE;
+
+            taskENTER_CRITICAL();
+            {
+                /* Publishers copy and notify inside a critical section, so if
+                 * there is still nothing to read here then no publish can be
+                 * missed between clearing any stale notification and joining
+                 * the list. */
+                if( pxSubscriber->ulNext == pxTopic->ulPublished )
+                {
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, configTOPIC_NOTIFICATION_INDEX );
+                    ( void ) ulTaskNotifyValueClearIndexed( NULL, configTOPIC_NOTIFICATION_INDEX, ( uint32_t ) ~0UL );
+                    vListInsertEnd( &( pxTopic->xWaitingSubscribers ), &xWaitItem );
+                    xRegistered = pdTRUE;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xRegistered != pdFALSE )
+            {
+                traceBLOCKING_ON_TOPIC_RECEIVE( xSubscriber );
+
+                ( void ) ulTaskNotifyTakeIndexed( configTOPIC_NOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+
+                taskENTER_CRITICAL();
+                {
+                    /* The item has already been removed if the task was
+                     * notified, rather than timing out. */
+                    if( listLIST_ITEM_CONTAINER( &xWaitItem ) != NULL )
+                    {
+                        ( void ) uxListRemove( &xWaitItem );
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        traceRETURN_xTopicReceive( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTopicMessagesWaiting( TopicSubscriberHandle_t xSubscriber )
+    {
+        const TopicSubscriber_t * const pxSubscriber = xSubscriber;
+        uint32_t ulUnread;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxTopicMessagesWaiting( xSubscriber );
+
+        configASSERT( pxSubscriber );
+
+        ulUnread = pxSubscriber->pxTopic->ulPublished - pxSubscriber->ulNext;
+
+        if( ulUnread > ( uint32_t ) pxSubscriber->pxTopic->uxLength )
+        {
+            uxReturn = pxSubscriber->pxTopic->uxLength;
+        }
+        else
+        {
+            uxReturn = ( UBaseType_t ) ulUnread;
+        }
+
+        traceRETURN_uxTopicMessagesWaiting( uxReturn );
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulTopicGetOverrunCount( TopicSubscriberHandle_t xSubscriber )
+    {
+        const TopicSubscriber_t * const pxSubscriber = xSubscriber;
+        uint32_t ulUnread;
+        uint32_t ulReturn;
+
+        traceENTER_ulTopicGetOverrunCount( xSubscriber );
+
+        configASSERT( pxSubscriber );
+
+        /* Overruns are only added to ulOverruns when the subscriber next reads,
+         * so also count items that have been overwritten since. */
+        ulReturn = pxSubscriber->ulOverruns;
+        ulUnread = pxSubscriber->pxTopic->ulPublished - pxSubscriber->ulNext;
+
+        if( ulUnread > ( uint32_t ) pxSubscriber->pxTopic->uxLength )
+        {
+            ulReturn += ulUnread - ( uint32_t ) pxSubscriber->pxTopic->uxLength;
+        }
+
+        traceRETURN_ulTopicGetOverrunCount( ulReturn );
+
+        return ulReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include topic functionality.  If you want to include topics then ensure
+ * configUSE_TOPICS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TOPICS == 1 */
@@ -3,6 +3,9 @@
 #include "hardware/uart.h"
 #include "psram.h"
 #include "bsp.h"
+#ifdef LIB_FREERTOS_KERNEL
+#include "FreeRTOS.h"
+#endif
 
 /* Add the pragma while debugging. */
 #pragma GCC optimize ("O0")
@@ -160,6 +163,18 @@ void BSP_Init(void) {
      */
     psram_size = psram_setup(PSRAM_CS);
 
+#if defined(LIB_FREERTOS_KERNEL) && (configHEAP_USE_BULK_REGIONS == 1)
+    /*
+     * Give the PSRAM to the FreeRTOS bulk heap, so it can be allocated with pvPortMallocBulk().
+     */
+    if (psram_size > 0) {
+        const HeapRegion_t psram_region[] = {
+            { (uint8_t*) PSRAM_BASE, psram_size },
+            { NULL, 0 }
+        };
+        vPortDefineBulkHeapRegions(psram_region);
+    }
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -18,6 +18,11 @@
  */
 #define PSRAM_CS    8
 
+/**
+ * @brief Address at which the PSRAM is mapped (XIP chip select 1).
+ */
+#define PSRAM_BASE  0x11000000
+
 /**
  * @brief LEDs directly connected to the MCU.
  */
@@ -219,6 +224,9 @@ void BSP_7SegDispFloat(float value);
 /**
  * @brief Function to check if PSRAM is available.
  *
+ * If FreeRTOS is built with heap_6.c and configHEAP_USE_BULK_REGIONS set to 1, BSP_Init() adds the PSRAM
+ * to the bulk heap, and it should only be used through pvPortMallocBulk() and vPortFree().
+ *
  * @return size_t Returns the PSRAM size or 0 if not available.
  */
 size_t BSP_HasPSRAM(void);
@@ -76,6 +76,7 @@
 #define configTOTAL_HEAP_SIZE                   (128*1024)
 #define configAPPLICATION_ALLOCATED_HEAP        0
 #define configKERNEL_PROVIDED_STATIC_MEMORY     1
+#define configHEAP_USE_BULK_REGIONS             1
 
 /* Hook function related definitions. */
 #define configCHECK_FOR_STACK_OVERFLOW          0
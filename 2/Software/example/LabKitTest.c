@@ -486,9 +486,27 @@ void cn1Tx_task(void* args) {
 void psram_task(void* args) {
     TickType_t xLastWakeTime = 0;
     const TickType_t xPeriod = (int)args;   /* Get period (in ticks) from argument. */
+    const size_t xLength = 64 * 1024;
+    uint32_t* pulBuffer;
+    size_t i;
 
     for (;;) {
 
+        /* Allocate a large buffer from the PSRAM, fill it and check it. */
+        pulBuffer = pvPortMallocBulk(xLength);
+        if (pulBuffer != NULL) {
+            for (i = 0; i < xLength / sizeof(uint32_t); i++) {
+                pulBuffer[i] = i ^ 0xA5A5A5A5;
+            }
+            for (i = 0; i < xLength / sizeof(uint32_t); i++) {
+                if (pulBuffer[i] != (i ^ 0xA5A5A5A5)) {
+                    printf("PSRAM error at %p\n", (void*) &pulBuffer[i]);
+                    break;
+                }
+            }
+            vPortFree(pulBuffer);
+        }
+
         vTaskDelayUntil(&xLastWakeTime, xPeriod);   /* Wait for the next release. */
     }
 }